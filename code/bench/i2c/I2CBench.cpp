@@ -0,0 +1,143 @@
+// PBL
+#include <i2c/Controllers.hpp>
+#include <i2c/LinuxTransport.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstdlib>
+
+// Third Party
+#include <benchmark/benchmark.h>
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+/// Creates a bus controller on a simulated bus, the latency emulates the bus speed (0 - bus overhead only).
+BusController makeBus( const std::chrono::nanoseconds perByte, auto&& attach )
+{
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->setLatency( {}, perByte );
+	attach( *bus );
+	return BusController{ std::move( bus ) };
+}
+
+} // namespace
+
+static void BM_BusControllerReadByte( benchmark::State& state )
+{
+	auto busController = makeBus( std::chrono::nanoseconds{ state.range( 0 ) },
+								  []( SimulatedBus& bus ) { bus.attach< SimulatedLM75 >( 0x48 ); } );
+	std::uint8_t value{};
+
+	for( auto _ : state )
+	{
+		benchmark::DoNotOptimize( busController.read( 0x48, 0x01, value ) );
+	}
+}
+BENCHMARK( BM_BusControllerReadByte )->Arg( 0 )->Arg( 90'000 ); // 90us per byte ~ 100kHz
+
+static void BM_LM75GetTemperature( benchmark::State& state )
+{
+	auto busController = makeBus( std::chrono::nanoseconds{ state.range( 0 ) },
+								  []( SimulatedBus& bus ) { bus.attach< SimulatedLM75 >( 0x48 ).setTemperature( 21.5f ); } );
+	LM75Controller lm75{ busController };
+
+	for( auto _ : state )
+	{
+		benchmark::DoNotOptimize( lm75.getTemperatureC() );
+	}
+}
+BENCHMARK( BM_LM75GetTemperature )->Arg( 0 )->Arg( 90'000 );
+
+static void BM_MPU6050Angles( benchmark::State& state )
+{
+	auto busController = makeBus( std::chrono::nanoseconds{ state.range( 0 ) }, []( SimulatedBus& bus ) {
+		auto& imu = bus.attach< SimulatedMPU6050 >( 0x68 );
+		imu.setAccelerometer( 100, -200, 16384 );
+		imu.setGyroscope( 13, -26, 131 );
+	} );
+	MPU6050Controller mpu6050{ busController };
+
+	for( auto _ : state )
+	{
+		benchmark::DoNotOptimize( mpu6050.angles() );
+	}
+}
+BENCHMARK( BM_MPU6050Angles )->Arg( 0 )->Arg( 90'000 );
+
+static void BM_TransactionSubmit( benchmark::State& state )
+{
+	auto busController = makeBus( std::chrono::nanoseconds{ state.range( 0 ) }, []( SimulatedBus& bus ) {
+		bus.attach< SimulatedLM75 >( 0x48 );
+		bus.attach< SimulatedMPU6050 >( 0x68 );
+	} );
+	std::array< std::uint8_t, 2 > temperature{};
+	std::array< std::uint8_t, 14 > motion{};
+
+	for( auto _ : state )
+	{
+		Transaction tx;
+		if( !tx.read( 0x48, 0x00, temperature ) || !tx.read( 0x68, 0x3B, motion ) )
+		{
+			state.SkipWithError( "Transaction capacity exceeded" );
+			break;
+		}
+
+		benchmark::DoNotOptimize( busController.submit( tx ) );
+	}
+}
+BENCHMARK( BM_TransactionSubmit )->Arg( 0 )->Arg( 90'000 );
+
+/**
+ * Register reads on real hardware, I2C_RDWR (Arg 0) against the SMBus fast path (Arg 1).
+ * Set PBL_BENCH_I2C_BUS (i.e. /dev/i2c-1) and PBL_BENCH_I2C_ADDR (i.e. 0x48), the register 0x00 is read.
+ */
+static void BM_LinuxTransportReadRegister( benchmark::State& state )
+{
+	const char* busName = std::getenv( "PBL_BENCH_I2C_BUS" );
+	const char* address = std::getenv( "PBL_BENCH_I2C_ADDR" );
+	if( !busName || !address )
+	{
+		state.SkipWithError( "PBL_BENCH_I2C_BUS or PBL_BENCH_I2C_ADDR not set" );
+		return;
+	}
+
+	const bool smbus = state.range( 0 ) != 0;
+	auto transport = std::make_unique< LinuxTransport >( busName );
+	transport->setSmbusEnabled( smbus );
+	const auto* pTransport = transport.get();
+
+	BusController busController{ std::move( transport ) };
+	const auto deviceAddr = static_cast< std::uint8_t >( std::stoul( address, nullptr, 0 ) );
+	std::array< std::uint8_t, 8 > data{};
+	const auto size = static_cast< std::uint16_t >( state.range( 1 ) );
+
+	for( auto _ : state )
+	{
+		if( busController.read( deviceAddr, 0x00, data.data(), size ) < 0 ) [[unlikely]]
+		{
+			state.SkipWithError( busController.lastError().c_str() );
+			break;
+		}
+	}
+
+	// Adapters without the SMBus functionality, or devices bound to a kernel driver, fall back to I2C_RDWR
+	const auto rdwrTransfers = pTransport->transfers( LinuxTransport::Path::RDWR );
+	if( smbus && rdwrTransfers != 0 ) [[unlikely]]
+	{
+		state.SkipWithError( "The SMBus path is not available, the reads used I2C_RDWR" );
+		return;
+	}
+
+	state.counters[ "smbus" ] = static_cast< double >( rdwrTransfers == 0 );
+}
+BENCHMARK( BM_LinuxTransportReadRegister )->ArgsProduct( { { 0, 1 }, { 1, 2, 8 } } );
+
+} // namespace pbl::i2c
@@ -0,0 +1,108 @@
+// PBL
+#include <spi/BusController.hpp>
+#include <spi/TransferBuffer.hpp>
+
+// C++
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+
+// Third Party
+#include <benchmark/benchmark.h>
+
+namespace pbl::spi
+{
+
+namespace
+{
+
+/// Opens the device given by PBL_BENCH_SPI_DEVICE (i.e. /dev/spidev0.0) at 10MHz, skips the benchmark otherwise.
+std::optional< BusController > openDevice( benchmark::State& state )
+{
+	const char* device = std::getenv( "PBL_BENCH_SPI_DEVICE" );
+	if( !device )
+	{
+		state.SkipWithError( "PBL_BENCH_SPI_DEVICE not set" );
+		return std::nullopt;
+	}
+
+	auto bus = BusController::open( device, BusController::Mode::MODE_0, BusController::Speed::SPEED_10MHZ );
+	if( !bus )
+	{
+		state.SkipWithError( "Failed to open the SPI device" );
+		return std::nullopt;
+	}
+
+	return std::move( *bus );
+}
+
+/// Allocates a page-aligned frame of the benchmark size.
+std::optional< TransferBuffer > allocateFrame( benchmark::State& state )
+{
+	auto frame = TransferBuffer::allocate( static_cast< std::size_t >( state.range( 0 ) ) );
+	if( !frame )
+	{
+		state.SkipWithError( "Failed to allocate the frame" );
+		return std::nullopt;
+	}
+
+	return std::move( *frame );
+}
+
+} // namespace
+
+/// A frame sent the symmetric way, spidev fills and copies back a receive buffer as large as the frame.
+static void BM_SpidevTransfer( benchmark::State& state )
+{
+	auto bus = openDevice( state );
+	auto tx = allocateFrame( state );
+	auto rx = allocateFrame( state );
+	if( !bus || !tx || !rx )
+	{
+		return;
+	}
+
+	for( auto _ : state )
+	{
+		if( !bus->transfer( tx->span(), rx->span() ) ) [[unlikely]]
+		{
+			state.SkipWithError( "Transfer failed" );
+			break;
+		}
+
+		benchmark::DoNotOptimize( rx->data() );
+	}
+
+	// Both benchmarks move the same frame over the wire, the difference is the kernel copying it in and out
+	state.SetBytesProcessed( state.iterations() * state.range( 0 ) );
+	state.counters[ "bytesCopied" ] = benchmark::Counter(
+		static_cast< double >( state.iterations() * state.range( 0 ) * 2 ), benchmark::Counter::kAvgIterations );
+}
+BENCHMARK( BM_SpidevTransfer )->Arg( 4096 )->Arg( 64 * 1024 )->Arg( 1024 * 1024 )->MeasureProcessCPUTime();
+
+/// The same frame transmitted only, no receive buffer is filled nor copied.
+static void BM_SpidevWrite( benchmark::State& state )
+{
+	auto bus = openDevice( state );
+	auto tx = allocateFrame( state );
+	if( !bus || !tx )
+	{
+		return;
+	}
+
+	for( auto _ : state )
+	{
+		if( !bus->write( tx->span() ) ) [[unlikely]]
+		{
+			state.SkipWithError( "Write failed" );
+			break;
+		}
+	}
+
+	state.SetBytesProcessed( state.iterations() * state.range( 0 ) );
+	state.counters[ "bytesCopied" ] = benchmark::Counter(
+		static_cast< double >( state.iterations() * state.range( 0 ) ), benchmark::Counter::kAvgIterations );
+}
+BENCHMARK( BM_SpidevWrite )->Arg( 4096 )->Arg( 64 * 1024 )->Arg( 1024 * 1024 )->MeasureProcessCPUTime();
+
+} // namespace pbl::spi
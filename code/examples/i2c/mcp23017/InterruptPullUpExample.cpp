@@ -9,9 +9,9 @@
  * configuring pins as inputs with pull-up resistors and setting up interrupts to 
  * notify the system of a button press event. Although the MCP23017 automatically generates 
  * an interrupt signal on state changes, this program uses a polling loop to periodically 
- * check the interrupt status and read the state of the pins. At the time of writing, the
- * automatic detection of interrupt via the callback is not implemented, it's planned the
- * next major release.
+ * check the interrupt status and read the state of the pins. For event driven detection
+ * without a polling thread, wire INT to a GPIO line and use MCP23017Controller::listen, which
+ * reads the interrupt registers on each edge and queues the decoded pin changes.
  * 
  * ## Summary
  * The code configures all pins of Port A on the MCP23017 as inputs with pull-up resistors 
@@ -0,0 +1,58 @@
+#ifndef PBL_GPIO_EDGE_EVENT_HPP__
+#define PBL_GPIO_EDGE_EVENT_HPP__
+
+#include <utils/Result.hpp>
+
+// C++
+#include <span>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace pbl::gpio
+{
+
+inline namespace v1
+{
+
+/// Signal edges a line reports.
+enum class Edge : std::uint8_t
+{
+	RISING,
+	FALLING,
+	BOTH ///< Only used to request events, an event is either rising or falling.
+};
+
+/// A level change of an input line, timestamped by the kernel when the interrupt fired.
+struct EdgeEvent
+{
+	Edge edge{ Edge::RISING };
+	std::chrono::steady_clock::time_point timestamp; //!< CLOCK_MONOTONIC, the steady clock epoch on Linux
+};
+
+/**
+ * @class EdgeEventSource
+ * @brief A line delivering edge events through a pollable file descriptor.
+ *
+ * Implemented by GpioLine for lines requested with edge detection, drivers waiting on an interrupt
+ * pin of an IC only depend on this interface (and not on libgpiod), so they can be tested with
+ * any descriptor that becomes readable.
+ */
+class EdgeEventSource
+{
+public:
+	template < typename T >
+	using Result = utils::Result< T >;
+
+	virtual ~EdgeEventSource() = default;
+
+	/// Returns the descriptor becoming readable (POLLIN) while events are pending, -1 if none.
+	[[nodiscard]] virtual int fd() const noexcept = 0;
+
+	/// Reads pending events, oldest first. Blocks if none is pending, poll fd() first.
+	[[nodiscard]] virtual Result< std::size_t > readEvents( std::span< EdgeEvent > events ) = 0;
+};
+
+} // namespace v1
+} // namespace pbl::gpio
+#endif // PBL_GPIO_EDGE_EVENT_HPP__
@@ -1,12 +1,18 @@
 #include "GpioLine.hpp"
 #include "Gpio.hpp"
 
+// C++
+#include <array>
+#include <chrono>
+#include <algorithm>
+
 namespace pbl::gpio
 {
 
 v1::GpioLine::GpioLine( GpioLine&& other ) noexcept
 	: m_pLine{ other.m_pLine }
 	, m_lineNumber{ other.m_lineNumber }
+	, m_direction{ other.m_direction }
 {
 	other.m_pLine = nullptr;
 	other.m_lineNumber = 0;
@@ -24,6 +30,7 @@ GpioLine& v1::GpioLine::operator=( GpioLine&& other ) noexcept
 
 		m_pLine = other.m_pLine;
 		m_lineNumber = other.m_lineNumber;
+		m_direction = other.m_direction;
 
 		other.m_pLine = nullptr;
 		other.m_lineNumber = 0;
@@ -45,6 +52,41 @@ void v1::GpioLine::release()
 	}
 }
 
+int v1::GpioLine::fd() const noexcept
+{
+	// -1 unless the line was requested for events
+	return m_pLine ? ::gpiod_line_event_get_fd( m_pLine ) : -1;
+}
+
+auto v1::GpioLine::readEvents( std::span< EdgeEvent > events ) -> Result< std::size_t >
+{
+	if( fd() < 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	// The kernel buffers up to 16 events per line
+	std::array< ::gpiod_line_event, 16 > buffer{};
+	const auto size = static_cast< unsigned int >( std::min( events.size(), buffer.size() ) );
+	const int count = ::gpiod_line_event_read_multiple( m_pLine, buffer.data(), size );
+	if( count < 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	for( std::size_t i = 0; i < static_cast< std::size_t >( count ); ++i )
+	{
+		const auto& event = buffer[ i ];
+		const auto sinceEpoch = std::chrono::seconds{ event.ts.tv_sec } + std::chrono::nanoseconds{ event.ts.tv_nsec };
+
+		events[ i ].edge = event.event_type == GPIOD_LINE_EVENT_RISING_EDGE ? Edge::RISING : Edge::FALLING;
+		events[ i ].timestamp = std::chrono::steady_clock::time_point{
+			std::chrono::duration_cast< std::chrono::steady_clock::duration >( sinceEpoch ) };
+	}
+
+	return utils::MakeSuccess( static_cast< std::size_t >( count ) );
+}
+
 auto v1::GpioLine::open( gpiod_chip* pChip, std::int32_t lineNumber, Direction direction ) -> Result< GpioLine >
 {
 	auto pLine = ::gpiod_chip_get_line( pChip, lineNumber );
@@ -74,4 +116,38 @@ auto v1::GpioLine::open( gpiod_chip* pChip, std::int32_t lineNumber, Direction d
 	return utils::MakeSuccess< GpioLine >( std::in_place, pLine, lineNumber, direction, PrivateTag{} );
 }
 
+auto v1::GpioLine::openEdgeEvents( gpiod_chip* pChip, std::int32_t lineNumber, Edge edge ) -> Result< GpioLine >
+{
+	auto pLine = ::gpiod_chip_get_line( pChip, lineNumber );
+	if( !pLine )
+	{
+		return utils::MakeError( utils::ErrorCode::HARDWARE_NOT_AVAILABLE );
+	}
+
+	// Event timestamps are CLOCK_MONOTONIC (Linux 5.7 and later)
+	int ret{};
+	switch( edge )
+	{
+		case Edge::RISING: {
+			ret = ::gpiod_line_request_rising_edge_events( pLine, "gpio_events" );
+			break;
+		}
+		case Edge::FALLING: {
+			ret = ::gpiod_line_request_falling_edge_events( pLine, "gpio_events" );
+			break;
+		}
+		case Edge::BOTH: {
+			ret = ::gpiod_line_request_both_edges_events( pLine, "gpio_events" );
+			break;
+		}
+	}
+
+	if( ret < 0 )
+	{
+		return utils::MakeError( utils::ErrorCode::HARDWARE_NOT_AVAILABLE );
+	}
+
+	return utils::MakeSuccess< GpioLine >( std::in_place, pLine, lineNumber, Direction::Input, PrivateTag{} );
+}
+
 } // namespace pbl::gpio
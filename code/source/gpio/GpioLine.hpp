@@ -2,9 +2,11 @@
 #define PBL_GPIO_GPIO_LINE_HPP__
 
 #include "GpioFwd.hpp"
+#include "EdgeEvent.hpp"
 #include <utils/Result.hpp>
 
 // C++
+#include <span>
 #include <cstdint>
 #include <expected>
 
@@ -14,7 +16,7 @@ namespace pbl::gpio
 inline namespace v1
 {
 
-class GpioLine
+class GpioLine final : public EdgeEventSource
 {
 	struct PrivateTag
 	{ };
@@ -41,12 +43,21 @@ public:
 	// Move assignment operator
 	GpioLine& operator=( GpioLine&& other ) noexcept;
 
-	~GpioLine();
+	~GpioLine() override;
 
 	void release();
 
+	/// Returns the event descriptor of a line opened with openEdgeEvents, -1 otherwise.
+	[[nodiscard]] int fd() const noexcept override;
+
+	/// Reads pending edge events, UNSUPPORTED_OPERATION if the line was not opened with openEdgeEvents.
+	[[nodiscard]] Result< std::size_t > readEvents( std::span< EdgeEvent > events ) override;
+
 	static Result< GpioLine > open( gpiod_chip* pChip, std::int32_t lineNumber, Direction direction );
 
+	/// Opens the line as an input reporting the edges, i.e. bound to the interrupt pin of an IC.
+	static Result< GpioLine > openEdgeEvents( gpiod_chip* pChip, std::int32_t lineNumber, Edge edge );
+
 private:
 	GpioLine( const GpioLine& ) = delete;
 	GpioLine& operator=( const GpioLine& ) = delete;
@@ -63,4 +63,34 @@ auto v1::Rpi5Chip0::line( Pin pin, GpioLine::Direction direction ) -> RefResult<
 	return std::ref( lines[ storageIndex ].value() );
 }
 
+auto v1::Rpi5Chip0::line( Pin pin, Edge edge ) -> RefResult< GpioLine >
+{
+	if( !m_pImpl->pChip ) [[unlikely]]
+	{
+		return utils::MakeError< std::reference_wrapper< GpioLine > >( utils::ErrorCode::HARDWARE_NOT_AVAILABLE );
+	}
+
+	const std::uint8_t lineNumber = static_cast< std::uint8_t >( pin );
+	const std::size_t storageIndex = lineNumber - static_cast< std::uint8_t >( Pin::GPIO2 );
+
+	auto& lines = m_pImpl->lines;
+	if( storageIndex >= lines.size() ) [[unlikely]]
+	{
+		return utils::MakeError< std::reference_wrapper< GpioLine > >( utils::ErrorCode::HARDWARE_NOT_AVAILABLE );
+	}
+
+	if( !lines[ storageIndex ].has_value() )
+	{
+		auto line = GpioLine::openEdgeEvents( m_pImpl->pChip.get(), static_cast< std::int32_t >( lineNumber ), edge );
+		if( !line ) [[unlikely]]
+		{
+			return utils::MakeError( utils::ErrorCode::HARDWARE_FAILURE );
+		}
+
+		lines[ storageIndex ].emplace( std::move( *line ) );
+	}
+
+	return std::ref( lines[ storageIndex ].value() );
+}
+
 } // namespace pbl::gpio
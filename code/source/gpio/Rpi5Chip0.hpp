@@ -68,6 +68,9 @@ public:
 	/// TBW, The direction is the default direction, that the pin is configured at first instanciation.
 	[[nodiscard]] RefResult< GpioLine > line( Pin pin, GpioLine::Direction direction = GpioLine::Direction::Output );
 
+	/// Returns the line opened as an edge event input, the edge applies when the line is opened first.
+	[[nodiscard]] RefResult< GpioLine > line( Pin pin, Edge edge );
+
 private:
 	std::unique_ptr< Impl > m_pImpl;
 };
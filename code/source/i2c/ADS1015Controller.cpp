@@ -1,8 +1,11 @@
 #include "ADS1015Controller.hpp"
 #include "BusController.hpp"
+#include "Transaction.hpp"
+#include "EdgeEventLoop.hpp"
 
 // C++
 #include <array>
+#include <optional>
 
 namespace pbl::i2c
 {
@@ -13,6 +16,8 @@ namespace
 // ADS1015 Registers
 constexpr std::uint8_t kPointerConversion = 0x00;
 constexpr std::uint8_t kPointerConfig = 0x01;
+constexpr std::uint8_t kPointerLoThresh = 0x02;
+constexpr std::uint8_t kPointerHiThresh = 0x03;
 
 // ADS1015 Configuration Register Masks
 constexpr std::uint16_t kOsSingle = 0x8000; // Single-shot start conversion
@@ -20,16 +25,46 @@ constexpr std::uint16_t kMuxMask = 0x7000; // MUX Mask
 constexpr std::uint16_t kGainMask = 0x0E00; // Gain Mask
 constexpr std::uint16_t kModeMask = 0x0100; // Mode Mask
 constexpr std::uint16_t kDataRateMask = 0x00E0; // Data rate bits mask (bits 7-5)
+constexpr std::uint16_t kCompPolActiveHigh = 0x0008; // ALERT/RDY active high
 constexpr std::uint16_t kCompQueDisable = 0x0003; // Disable comparator
 
-// Configuration Register Template (default)
-constexpr std::uint16_t kDefaultconfigRegister = kOsSingle | kDataRateMask | kCompQueDisable;
+constexpr std::uint16_t kMuxSingleEnded = 0x4000; // AINx against GND, x added in bits 13-12
+constexpr int kMuxShift = 12;
+
+// The MSB of Hi_thresh set and of Lo_thresh cleared turns ALERT/RDY into a conversion ready signal
+constexpr std::uint16_t kConversionReadyHiThresh = 0x8000;
+constexpr std::uint16_t kConversionReadyLoThresh = 0x0000;
+
+// Conversion time per data rate, including the 10% tolerance of the internal oscillator
+constexpr std::array< std::uint16_t, 8 > kConversionTimeUs{ 8600, 4400, 2250, 1200, 700, 460, 340, 340 };
+
+// Full-scale range per gain, the codes 0b110 and 0b111 repeat the smallest range
+constexpr std::array< float, 8 > kFullScaleRange{ 6.144f, 4.096f, 2.048f, 1.024f, 0.512f, 0.256f, 0.256f, 0.256f };
+
+[[nodiscard]] constexpr std::array< std::uint8_t, 2 > toBytes( const std::uint16_t value ) noexcept
+{
+	return { static_cast< std::uint8_t >( value >> 8 ), static_cast< std::uint8_t >( value & 0xFF ) };
+}
+
+/// The 12-bit result is left aligned in the conversion register.
+[[nodiscard]] constexpr std::int16_t toCode( const std::array< std::uint8_t, 2 >& data ) noexcept
+{
+	return static_cast< std::int16_t >( static_cast< std::int16_t >( ( data[ 0 ] << 8 ) | data[ 1 ] ) >> 4 );
+}
+
+[[nodiscard]] constexpr std::uint16_t singleEndedMux( const ADS1015Controller::Channel channel ) noexcept
+{
+	return static_cast< std::uint16_t >( kMuxSingleEnded | ( static_cast< std::uint16_t >( channel ) << kMuxShift ) );
+}
 
 } // namespace
 
 v1::ADS1015Controller::ADS1015Controller( BusController& busController, Address address )
 	: ICBase{ busController, address }
-{ }
+{
+	// OS reads back set while the device is idle, writing it starts a conversion
+	setCacheable( kPointerConfig, 2, kOsSingle );
+}
 
 auto v1::ADS1015Controller::setGain( Gain gain ) -> Result< void >
 {
@@ -59,13 +94,185 @@ auto v1::ADS1015Controller::setSampleRate( SampleRate rate ) -> Result< void >
 		.and_then( [ this ]( std::uint16_t config ) { return writeConfig( config ); } );
 }
 
+auto v1::ADS1015Controller::readSingleEnded( Channel channel ) -> Result< std::int16_t >
+{
+	return convert( singleEndedMux( channel ) );
+}
+
+auto v1::ADS1015Controller::readDifferential( Channel positive, Channel negative ) -> Result< std::int16_t >
+{
+	using enum Channel;
+
+	std::uint16_t mux{};
+	if( positive == CH0 && negative == CH1 )
+	{
+		mux = 0x0000;
+	}
+	else if( positive == CH0 && negative == CH3 )
+	{
+		mux = 0x1000;
+	}
+	else if( positive == CH1 && negative == CH3 )
+	{
+		mux = 0x2000;
+	}
+	else if( positive == CH2 && negative == CH3 )
+	{
+		mux = 0x3000;
+	}
+	else [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	return convert( mux );
+}
+
+auto v1::ADS1015Controller::startContinuous( Channel channel ) -> Result< void >
+{
+	return enableConversionReady()
+		.and_then( [ this ] { return settings(); } )
+		.and_then( [ this, channel ]( const std::uint16_t base ) {
+			return writeConfig( static_cast< std::uint16_t >( base | singleEndedMux( channel ) | kCompPolActiveHigh ) );
+		} )
+		.transform( [ this ] { m_continuous = true; } );
+}
+
+auto v1::ADS1015Controller::readContinuous() -> Result< std::int16_t >
+{
+	if( !m_continuous ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	return readConversion();
+}
+
+auto v1::ADS1015Controller::readContinuous( EdgeEventLoop& loop, const std::chrono::milliseconds timeout )
+	-> Result< std::int16_t >
+{
+	if( !m_continuous ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	const auto ready = waitReady( loop, timeout );
+	if( !ready ) [[unlikely]]
+	{
+		return std::unexpected( ready.error() );
+	}
+
+	if( !*ready )
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION ); // Stopped
+	}
+
+	return readConversion();
+}
+
+auto v1::ADS1015Controller::stopContinuous() -> Result< void >
+{
+	return settings()
+		.and_then( [ this ]( const std::uint16_t base ) {
+			return writeConfig( static_cast< std::uint16_t >( base | kModeMask | kCompQueDisable ) );
+		} )
+		.transform( [ this ] { m_continuous = false; } );
+}
+
+auto v1::ADS1015Controller::scan( EdgeEventLoop& loop,
+								  std::span< const Channel > channels,
+								  ScanCallback callback,
+								  const std::chrono::milliseconds timeout ) -> Result< void >
+{
+	if( channels.empty() ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	const auto base = enableConversionReady().and_then( [ this ] { return settings(); } );
+	if( !base ) [[unlikely]]
+	{
+		return std::unexpected( base.error() );
+	}
+
+	const auto gain = static_cast< Gain >( *base & kGainMask );
+	const auto start = [ &base ]( const Channel channel ) {
+		return static_cast< std::uint16_t >( *base | kOsSingle | singleEndedMux( channel ) | kModeMask |
+											 kCompPolActiveHigh );
+	};
+
+	if( auto started = writeConfig( start( channels.front() ) ); !started ) [[unlikely]]
+	{
+		return started;
+	}
+
+	m_continuous = false;
+
+	const auto scanned = [ & ]() -> Result< void > {
+		std::array< std::uint8_t, 2 > result{};
+		Transaction transaction;
+		std::size_t current{};
+
+		while( true )
+		{
+			const auto ready = waitReady( loop, timeout );
+			if( !ready ) [[unlikely]]
+			{
+				return std::unexpected( ready.error() );
+			}
+
+			if( !*ready )
+			{
+				return utils::MakeSuccess(); // Stopped
+			}
+
+			// Read the finished conversion and start the next channel in one transfer
+			const auto next = ( current + 1 ) % channels.size();
+			const auto config = toBytes( start( channels[ next ] ) );
+
+			transaction.clear();
+			const bool queued = read( transaction, kPointerConversion, result ) &&
+								write( transaction, kPointerConfig, config );
+			if( !queued || !submit( transaction ) ) [[unlikely]]
+			{
+				return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+			}
+
+			const auto code = toCode( result );
+			const ScanSample sample{ .channel = channels[ current ],
+									 .code = code,
+									 .volts = toVolts( code, gain ),
+									 .timestamp = **ready };
+			if( !callback( sample ) )
+			{
+				return utils::MakeSuccess();
+			}
+
+			current = next;
+		}
+	}();
+
+	// Leave the comparator disabled, a started conversion completes on its own
+	const auto restored = writeConfig( static_cast< std::uint16_t >( *base | kModeMask | kCompQueDisable ) );
+	if( !scanned ) [[unlikely]]
+	{
+		return scanned;
+	}
+
+	return restored;
+}
+
+float v1::ADS1015Controller::toVolts( const std::int16_t code, const Gain gain ) noexcept
+{
+	const auto fsr = kFullScaleRange[ ( static_cast< std::uint16_t >( gain ) & kGainMask ) >> 9 ];
+	return static_cast< float >( code ) * fsr / 2048.0f;
+}
+
 auto v1::ADS1015Controller::readConfig() -> Result< std::uint16_t >
 {
-	std::array< std::uint8_t, 2 > data{};
-	if( read( kPointerConfig, data.data(), 2 ) == 2 )
+	std::uint16_t config{};
+	if( readCachedWord( kPointerConfig, config ) )
 	{
-		// Combine high and low bytes to form the 16-bit config value
-		std::uint16_t config = ( data[ 0 ] << 8 ) | data[ 1 ];
 		return config;
 	}
 
@@ -75,10 +282,7 @@ auto v1::ADS1015Controller::readConfig() -> Result< std::uint16_t >
 auto v1::ADS1015Controller::writeConfig( std::uint16_t config ) -> Result< void >
 {
 	// Split the 16-bit config into two bytes for transmission (big-endian format)
-	std::array< std::uint8_t, 2 > data = {
-		static_cast< std::uint8_t >( config >> 8 ), // High byte
-		static_cast< std::uint8_t >( config & 0xFF ) // Low byte
-	};
+	const auto data = toBytes( config );
 
 	// Use the ICBase write method to send the configuration to the CONFIG register
 	if( !write( kPointerConfig, data ) )
@@ -87,64 +291,94 @@ auto v1::ADS1015Controller::writeConfig( std::uint16_t config ) -> Result< void
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
-	// Update the internal configuration state if the write was successful
-	// currentConfig = config;
 	return utils::MakeSuccess();
 }
 
-// // Helper to configure channel for single-ended reading
-// void configureChannel( Channel channel )
-// {
-// 	configRegister_ = ( configRegister_ & ~kMuxMask ) | ( static_cast< std::uint16_t >( channel ) << 12 );
-// 	writeConfig();
-// }
-
-// // Helper to configure differential reading
-// void configureDifferential( Channel positiveChannel, Channel negativeChannel )
-// {
-// 	std::uint16_t mux;
-// 	if( positiveChannel == Channel::CH0 && negativeChannel == Channel::CH1 )
-// 		mux = 0x0000;
-// 	else if( positiveChannel == Channel::CH0 && negativeChannel == Channel::CH3 )
-// 		mux = 0x1000;
-// 	else if( positiveChannel == Channel::CH1 && negativeChannel == Channel::CH3 )
-// 		mux = 0x2000;
-// 	else if( positiveChannel == Channel::CH2 && negativeChannel == Channel::CH3 )
-// 		mux = 0x3000;
-// 	else
-// 		throw std::invalid_argument( "Invalid differential channel pair" );
-
-// 	configRegister_ = ( configRegister_ & ~kMuxMask ) | mux;
-// 	writeConfig();
-// }
-
-// // Helper to initiate conversion (Single-shot mode)
-// void initiateConversion()
-// {
-// 	configRegister_ |= kOsSingle;
-// 	writeConfig();
-// }
-
-// // Helper to read the conversion result
-// std::int16_t readConversionResult()
-// {
-// 	std::uint8_t rawData[ 2 ];
-// 	if( read( kPointerConversion, rawData, 2 ) != 2 )
-// 	{
-// 		throw std::runtime_error( "Failed to read conversion result" );
-// 	}
-// 	return static_cast< std::int16_t >( ( rawData[ 0 ] << 8 ) | rawData[ 1 ] ) >> 4;
-// }
-
-// // Helper to write configuration register
-// void writeConfig()
-// {
-// 	std::uint8_t configData[ 2 ] = { static_cast< std::uint8_t >( configRegister_ >> 8 ),
-// 									 static_cast< std::uint8_t >( configRegister_ & 0xFF ) };
-// 	if( !write( kPointerConfig, configData, 2 ) )
-// 	{
-// 		throw std::runtime_error( "Failed to write config register" );
-// 	}
-// }
-
-} // namespace pbl::i2c
\ No newline at end of file
+auto v1::ADS1015Controller::settings() -> Result< std::uint16_t >
+{
+	return readConfig().transform(
+		[]( const std::uint16_t config ) { return static_cast< std::uint16_t >( config & ( kGainMask | kDataRateMask ) ); } );
+}
+
+auto v1::ADS1015Controller::convert( const std::uint16_t mux ) -> Result< std::int16_t >
+{
+	if( m_continuous ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	const auto base = settings();
+	if( !base ) [[unlikely]]
+	{
+		return std::unexpected( base.error() );
+	}
+
+	const auto config =
+		static_cast< std::uint16_t >( *base | kOsSingle | ( mux & kMuxMask ) | kModeMask | kCompQueDisable );
+	if( auto started = writeConfig( config ); !started ) [[unlikely]]
+	{
+		return std::unexpected( started.error() );
+	}
+
+	sleep( std::chrono::microseconds{ kConversionTimeUs[ ( *base & kDataRateMask ) >> 5 ] } );
+	return readConversion();
+}
+
+auto v1::ADS1015Controller::readConversion() -> Result< std::int16_t >
+{
+	std::array< std::uint8_t, 2 > data{};
+	if( read( kPointerConversion, data.data(), 2 ) != 2 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	return toCode( data );
+}
+
+auto v1::ADS1015Controller::enableConversionReady() -> Result< void >
+{
+	const auto hi = toBytes( kConversionReadyHiThresh );
+	const auto lo = toBytes( kConversionReadyLoThresh );
+	if( !write( kPointerHiThresh, hi ) || !write( kPointerLoThresh, lo ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto v1::ADS1015Controller::waitReady( EdgeEventLoop& loop, const std::chrono::milliseconds timeout )
+	-> Result< std::optional< Clock::time_point > >
+{
+	std::array< gpio::EdgeEvent, 8 > events{};
+	while( true )
+	{
+		const auto count = loop.wait( events, timeout );
+		if( !count ) [[unlikely]]
+		{
+			return std::unexpected( count.error() );
+		}
+
+		if( *count == 0 )
+		{
+			return std::nullopt;
+		}
+
+		// Pulses read late belong to conversions already superseded, the newest one counts
+		std::optional< Clock::time_point > newest;
+		for( const auto& event : std::span{ events }.first( *count ) )
+		{
+			if( event.edge == gpio::Edge::RISING )
+			{
+				newest = event.timestamp;
+			}
+		}
+
+		if( newest )
+		{
+			return newest;
+		}
+	}
+}
+
+} // namespace pbl::i2c
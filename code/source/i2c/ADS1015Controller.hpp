@@ -5,7 +5,12 @@
 #include <utils/Counter.hpp>
 
 // C++
+#include <span>
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <expected>
+#include <functional>
 
 namespace pbl::i2c
 {
@@ -13,6 +18,8 @@ namespace pbl::i2c
 inline namespace v1
 {
 
+class EdgeEventLoop;
+
 /**
  * @brief Controller for the ADS1015 12-bit ADC with I2C interface.
  * 
@@ -34,6 +41,8 @@ public:
 	template < typename T >
 	using Result = utils::Result< T >;
 
+	using Clock = std::chrono::steady_clock;
+
 	enum class Address : std::uint8_t
 	{
 		H48 = 0x48, // ADDR connected to GND
@@ -98,53 +107,84 @@ public:
 	/// TBW
 	Result< void > setSampleRate( SampleRate rate );
 
-	// We need to think how are we going to pass here a channel, and second channel for differential read ...
-	// [[nodiscard]] Reader makeReader(Reader::Mode mode) { return Reader{ *this, ReaderPrivateTag{} }; }
-
-	// Read a single-ended input
-	// std::int16_t readSingleEnded( Channel channel )
-	// {
-	// 	// Configure only if the channel has changed
-	// 	if( channel != currentChannel_ )
-	// 	{
-	// 		configureChannel( channel );
-	// 		currentChannel_ = channel; // Update the cached current channel
-	// 	}
-	// 	initiateConversion();
-	// 	return readConversionResult();
-	// }
-
-	// // Read differential between channels
-	// std::int16_t readDifferential( Channel positiveChannel, Channel negativeChannel )
-	// {
-	// 	configureDifferential( positiveChannel, negativeChannel );
-	// 	initiateConversion();
-	// 	return readConversionResult();
-	// }
-
-	// // Start continuous read on a specific channel
-	// void startContinuousRead( Channel channel )
-	// {
-	// 	configureChannel( channel, Mode::CONTINUOUS ); // Configure for continuous mode
-	// 	continuousMode_ = true; // Flag to indicate continuous mode is active
-	// }
-
-	// // Retrieve the last conversion result in continuous mode
-	// std::int16_t readContinuous()
-	// {
-	// 	if( !continuousMode_ )
-	// 	{
-	// 		throw std::runtime_error( "Continuous read mode not initialized. Call startContinuousRead() first." );
-	// 	}
-	// 	return readConversionResult();
-	// }
-
-	// // Stop continuous read and reset to single-shot mode
-	// void stopContinuousRead()
-	// {
-	// 	continuousMode_ = false;
-	// 	configureChannel( currentChannel_, Mode::SINGLE_SHOT ); // Reset to single-shot mode
-	// }
+	/**
+	 * @brief Converts a single-ended input once.
+	 *
+	 * Starts a single-shot conversion and waits out the conversion time of the configured sample rate,
+	 * three transfers per sample at most. Use scan to sample several inputs at the full rate.
+	 *
+	 * @return The 12-bit conversion result, -2048 to 2047 over the full-scale range of the gain.
+	 */
+	[[nodiscard]] Result< std::int16_t > readSingleEnded( Channel channel );
+
+	/**
+	 * @brief Converts the difference between two inputs once.
+	 * @note The multiplexer supports CH0-CH1, CH0-CH3, CH1-CH3 and CH2-CH3, other pairs fail with INVALID_ARGUMENT.
+	 */
+	[[nodiscard]] Result< std::int16_t > readDifferential( Channel positive, Channel negative );
+
+	/**
+	 * @brief Starts continuous conversion of a single-ended input.
+	 *
+	 * The comparator is configured as conversion ready signal, ALERT/RDY pulses high at the end of
+	 * each conversion.
+	 */
+	[[nodiscard]] Result< void > startContinuous( Channel channel );
+
+	/// Returns the latest conversion result, fails with UNSUPPORTED_OPERATION unless continuous conversion is running.
+	[[nodiscard]] Result< std::int16_t > readContinuous();
+
+	/**
+	 * @brief Waits for the next conversion ready pulse on ALERT/RDY and returns its result.
+	 * @return The conversion result, TIMEOUT when no pulse arrived in time, UNSUPPORTED_OPERATION when
+	 *		   continuous conversion is not running or the loop was stopped.
+	 */
+	[[nodiscard]] Result< std::int16_t > readContinuous( EdgeEventLoop& loop, std::chrono::milliseconds timeout );
+
+	/// Stops continuous conversion, the ADC powers down between single-shot conversions.
+	[[nodiscard]] Result< void > stopContinuous();
+
+	/// Whether continuous conversion is running.
+	[[nodiscard]] bool continuous() const noexcept { return m_continuous; }
+
+	/// One conversion of a channel scan.
+	struct ScanSample
+	{
+		Channel channel{};
+		std::int16_t code{}; //!< 12-bit conversion result
+		float volts{}; //!< Conversion result scaled by the full-scale range of the gain
+		Clock::time_point timestamp; //!< Kernel timestamp of the conversion ready edge
+	};
+
+	/// Invoked for each conversion of a scan, returning false ends the scan.
+	using ScanCallback = std::move_only_function< bool( const ScanSample& ) >;
+
+	/**
+	 * @brief Converts the single-ended channels in turn, paced by the conversion ready signal on ALERT/RDY.
+	 *
+	 * The comparator is configured as conversion ready signal (active high) and each channel is converted
+	 * single-shot. On every rising edge one transfer reads the result of the current channel and starts
+	 * the conversion of the next one, the thread sleeps in the loop in between. Continuous conversion is
+	 * stopped, the comparator is disabled again when the scan ends.
+	 *
+	 * @param loop Event loop over the GPIO line connected to ALERT/RDY, rising edges requested.
+	 * @param channels Channels to convert, in order, repeated until the callback returns false.
+	 * @param timeout Longest wait for a conversion, TIMEOUT is returned past it.
+	 * @return Success when the callback ended the scan or the loop was stopped.
+	 */
+	[[nodiscard]] Result< void > scan( EdgeEventLoop& loop,
+									   std::span< const Channel > channels,
+									   ScanCallback callback,
+									   std::chrono::milliseconds timeout );
+
+	/// Converts the channels in turn, giving up when a conversion takes longer than 100ms.
+	[[nodiscard]] Result< void > scan( EdgeEventLoop& loop, std::span< const Channel > channels, ScanCallback callback )
+	{
+		return scan( loop, channels, std::move( callback ), std::chrono::milliseconds{ 100 } );
+	}
+
+	/// Scales a conversion result by the full-scale range of the gain.
+	[[nodiscard]] static float toVolts( std::int16_t code, Gain gain ) noexcept;
 
 private:
 	ADS1015Controller( const ADS1015Controller& ) = delete;
@@ -155,8 +195,23 @@ private:
 
 	Result< void > writeConfig( std::uint16_t config );
 
+	/// Returns the gain and data rate bits of the config register.
+	Result< std::uint16_t > settings();
+
+	/// Runs a single-shot conversion of the multiplexer setting.
+	Result< std::int16_t > convert( std::uint16_t mux );
+
+	/// Reads the conversion register.
+	Result< std::int16_t > readConversion();
+
+	/// Sets the threshold registers so that ALERT/RDY signals the end of each conversion.
+	Result< void > enableConversionReady();
+
+	/// Waits for a rising edge on ALERT/RDY and returns its timestamp, empty when the loop was stopped.
+	Result< std::optional< Clock::time_point > > waitReady( EdgeEventLoop& loop, std::chrono::milliseconds timeout );
+
 private:
-	// TODO
+	bool m_continuous{};
 };
 
 class ADS1015Controller::SingleShotReader final
@@ -164,17 +219,10 @@ class ADS1015Controller::SingleShotReader final
 public:
 	explicit SingleShotReader( ADS1015Controller&& ctrl )
 		: controller{ std::move( ctrl ) }
-	{
-		// controller.setMode(Mode::SINGLE_SHOT);
-	}
+	{ }
 
-	std::int16_t read( [[maybe_unused]] Channel channel )
-	{
-		// controller.setChannel(channel);
-		// controller.startConversion();
-		// return controller.readConversionResult();
-		return {};
-	}
+	/// Converts the input once, see ADS1015Controller::readSingleEnded.
+	[[nodiscard]] Result< std::int16_t > read( Channel channel ) { return controller.readSingleEnded( channel ); }
 
 	ADS1015Controller release() { return std::move( controller ); }
 
@@ -189,30 +237,51 @@ private:
 class ADS1015Controller::ContinuousReader final
 {
 public:
-	explicit ContinuousReader( ADS1015Controller&& ctrl )
+	explicit ContinuousReader( ADS1015Controller&& ctrl, Channel channel = Channel::CH0 )
 		: controller{ std::move( ctrl ) }
+		, started{ controller.startContinuous( channel ) }
+	{ }
+
+	~ContinuousReader()
 	{
-		// controller.setMode(Mode::CONTINOUS);
-		// controller.startContinuousRead();
+		if( started )
+		{
+			[[maybe_unused]] const auto rslt = controller.stopContinuous();
+		}
 	}
 
-	~ContinuousReader()
+	/// Returns the latest conversion result, or why continuous conversion could not be started.
+	[[nodiscard]] Result< std::int16_t > read()
 	{
-		// controller.stopContinuousRead();
+		if( !started ) [[unlikely]]
+		{
+			return std::unexpected( started.error() );
+		}
+
+		return controller.readContinuous();
 	}
 
-	/// TBW
-	[[nodiscard]] std::int16_t read()
+	/// Waits for the next conversion ready pulse on ALERT/RDY and returns its result.
+	[[nodiscard]] Result< std::int16_t > read( EdgeEventLoop& loop, std::chrono::milliseconds timeout )
 	{
-		// return controller.readContinuous();
-		return {};
+		if( !started ) [[unlikely]]
+		{
+			return std::unexpected( started.error() );
+		}
+
+		return controller.readContinuous( loop, timeout );
 	}
 
 	/// Returns ownership of the controller after done with continous read
 	ADS1015Controller release()
 	{
 		// Ensure clean stop
-		// controller.stopContinuousRead();
+		if( started )
+		{
+			[[maybe_unused]] const auto rslt = controller.stopContinuous();
+			started = utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+		}
+
 		return std::move( controller );
 	}
 
@@ -222,6 +291,7 @@ private:
 
 private:
 	ADS1015Controller controller;
+	Result< void > started;
 };
 
 class ADS1015Controller::DifferentialReader final
@@ -229,16 +299,12 @@ class ADS1015Controller::DifferentialReader final
 public:
 	explicit DifferentialReader( ADS1015Controller&& ctrl )
 		: controller{ std::move( ctrl ) }
-	{
-		// controller.setMode(Mode::SINGLE_SHOT);
-	}
+	{ }
 
-	std::int16_t read( [[maybe_unused]] Channel positive, [[maybe_unused]] Channel negative )
+	/// Converts the difference once, see ADS1015Controller::readDifferential.
+	[[nodiscard]] Result< std::int16_t > read( Channel positive, Channel negative )
 	{
-		// controller.configureDifferential(positive, negative);
-		// controller.startConversion();
-		// return controller.readConversionResult();
-		return {};
+		return controller.readDifferential( positive, negative );
 	}
 
 	ADS1015Controller release() { return std::move( controller ); }
@@ -252,31 +318,22 @@ private:
 };
 
 // // Create and configure ADS1015
-// ADS1015Controller adc(busController, ADS1015Controller::Address::H48);
-// auto rslt = adc.setGain(ADS1015Controller::Gain::FS_2_048V)
-//    			  .setSampleRate(ADS1015Controller::SampleRate::SPS_920)
-//    			  .setMode(ADS1015Controller::Mode::SINGLE_SHOT);
-// if (!rslt)
+// ADS1015Controller adc( busController, ADS1015Controller::Address::H48 );
+// if( auto rslt = adc.setGain( ADS1015Controller::Gain::FS_4_096V ); !rslt )
 // {
-//		std::println("{}", rlst.message());
 //		return -1;
 // }
 
 // // Perform a single-ended read on channel 0
-// std::int16_t singleResult = adc.readSingleEnded(ADS1015Controller::Channel::CH0);
-// std::cout << "Single-ended reading from CH0: " << singleResult << std::endl;
-
-// // Perform a differential read between channel 0 and channel 1
-// std::int16_t differentialResult = adc.readDifferential(ADS1015Controller::Channel::CH0, ADS1015Controller::Channel::CH1);
-// std::cout << "Differential reading between CH0 and CH1: " << differentialResult << std::endl;
-
-// // Start and read from continuous mode
-// adc.beginContinuousRead(ADS1015Controller::Channel::CH2);
-// for (int i = 0; i < 10; ++i) {
-//     std::int16_t continuousResult = adc.readContinuous();
-//     std::cout << "Continuous reading from CH2: " << continuousResult << std::endl;
-// }
-// adc.endContinuousRead();
+// const auto single = adc.readSingleEnded( ADS1015Controller::Channel::CH0 );
+
+// // Scan all four inputs at 3300 SPS, ALERT/RDY wired to GPIO 17
+// auto alert = gpio::GpioLine::openEdgeEvents( chip, 17, gpio::Edge::RISING );
+// EdgeEventLoop loop{ *alert };
+// using enum ADS1015Controller::Channel;
+// const std::array channels{ CH0, CH1, CH2, CH3 };
+// adc.setSampleRate( ADS1015Controller::SampleRate::SPS_3300 );
+// adc.scan( loop, channels, []( const auto& sample ) { return store( sample ); } );
 
 } // namespace v1
 } // namespace pbl::i2c
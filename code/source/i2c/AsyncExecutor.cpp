@@ -0,0 +1,411 @@
+/**
+ *  @brief Implementation of AsyncExecutor class, a per-bus thread executing queued I2C register operations.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "AsyncExecutor.hpp"
+#include "BusController.hpp"
+
+// C++
+#include <array>
+#include <memory>
+#include <algorithm>
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+// Every request needs at most two messages, a batch never exceeds what one transaction can hold
+constexpr std::size_t kMaxBatchSize{ Transaction::kMaxMessages / 2 };
+
+// Register addresses are 8-bit, a coalesced operation must not wrap around
+constexpr std::size_t kRegisterCount{ 256 };
+
+} // namespace
+
+v1::AsyncExecutor::AsyncExecutor( BusController& busController )
+	: AsyncExecutor{ busController, Options{} }
+{ }
+
+v1::AsyncExecutor::AsyncExecutor( BusController& busController, Options options )
+	: m_busController{ busController }
+	, m_options{ options }
+	, m_thread{ &AsyncExecutor::run, this }
+{ }
+
+v1::AsyncExecutor::~AsyncExecutor()
+{
+	{
+		std::lock_guard _{ m_queueMtx };
+		m_stop = true;
+	}
+
+	m_notEmpty.notify_one();
+	m_thread.join();
+}
+
+auto v1::AsyncExecutor::read( const std::uint8_t deviceAddr,
+							  const std::uint8_t reg,
+							  const std::size_t size,
+							  const Idempotency idempotency ) -> std::future< Result< std::vector< std::uint8_t > > >
+{
+	std::promise< Result< std::vector< std::uint8_t > > > promise;
+	auto future = promise.get_future();
+
+	read(
+		deviceAddr,
+		reg,
+		size,
+		[ promise = std::move( promise ) ]( auto rslt ) mutable { promise.set_value( std::move( rslt ) ); },
+		idempotency );
+
+	return future;
+}
+
+void v1::AsyncExecutor::read( const std::uint8_t deviceAddr,
+							  const std::uint8_t reg,
+							  const std::size_t size,
+							  ReadCallback callback,
+							  const Idempotency idempotency )
+{
+	Request request;
+	request.address = deviceAddr;
+	request.reg = reg;
+	request.read = true;
+	request.idempotency = idempotency;
+	request.data.resize( size );
+	request.completion = [ callback = std::move( callback ) ]( Result< void > rslt,
+															   std::vector< std::uint8_t >& data ) mutable {
+		if( !rslt ) [[unlikely]]
+		{
+			callback( std::unexpected( std::move( rslt.error() ) ) );
+			return;
+		}
+
+		callback( std::move( data ) );
+	};
+
+	enqueue( std::move( request ) );
+}
+
+auto v1::AsyncExecutor::write( const std::uint8_t deviceAddr,
+							   const std::uint8_t reg,
+							   std::span< const std::uint8_t > data,
+							   const Idempotency idempotency ) -> std::future< Result< void > >
+{
+	std::promise< Result< void > > promise;
+	auto future = promise.get_future();
+
+	write(
+		deviceAddr,
+		reg,
+		data,
+		[ promise = std::move( promise ) ]( Result< void > rslt ) mutable { promise.set_value( std::move( rslt ) ); },
+		idempotency );
+
+	return future;
+}
+
+void v1::AsyncExecutor::write( const std::uint8_t deviceAddr,
+							   const std::uint8_t reg,
+							   std::span< const std::uint8_t > data,
+							   WriteCallback callback,
+							   const Idempotency idempotency )
+{
+	Request request;
+	request.address = deviceAddr;
+	request.reg = reg;
+	request.idempotency = idempotency;
+	request.data.assign( data.begin(), data.end() );
+	request.completion = [ callback = std::move( callback ) ]( Result< void > rslt, std::vector< std::uint8_t >& ) mutable {
+		callback( std::move( rslt ) );
+	};
+
+	enqueue( std::move( request ) );
+}
+
+void v1::AsyncExecutor::waitIdle()
+{
+	std::unique_lock lock{ m_queueMtx };
+	m_idle.wait( lock, [ this ] { return m_queue.empty() && m_inFlight == 0; } );
+}
+
+auto v1::AsyncExecutor::statistics() const -> Statistics
+{
+	Statistics stats{
+		.submitted = m_submitted.load( std::memory_order_relaxed ),
+		.completed = m_completed.load( std::memory_order_relaxed ),
+		.failed = m_failed.load( std::memory_order_relaxed ),
+		.coalesced = m_coalesced.load( std::memory_order_relaxed ),
+		.transfers = m_transfers.load( std::memory_order_relaxed ),
+		.maxLatency = std::chrono::nanoseconds{ m_latencyMaxNs.load( std::memory_order_relaxed ) },
+	};
+
+	if( stats.completed > 0 )
+	{
+		const auto total = m_latencyTotalNs.load( std::memory_order_relaxed );
+		stats.meanLatency = std::chrono::nanoseconds{ total / static_cast< std::int64_t >( stats.completed ) };
+	}
+
+	std::lock_guard _{ m_queueMtx };
+	stats.queueDepth = m_queue.size();
+	stats.peakQueueDepth = m_peakQueueDepth;
+
+	return stats;
+}
+
+void v1::AsyncExecutor::enqueue( Request&& request )
+{
+	request.queuedAt = std::chrono::steady_clock::now();
+	m_submitted.fetch_add( 1, std::memory_order_relaxed );
+
+	// Writes carry the register in the same message, both must fit in the transaction write buffer
+	const bool tooLarge = !request.read && request.data.size() + 1 > Transaction::kMaxWriteBytes;
+	if( request.data.empty() || tooLarge ) [[unlikely]]
+	{
+		complete( request, utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT ) );
+		return;
+	}
+
+	{
+		std::unique_lock lock{ m_queueMtx };
+
+		// The bus thread must not wait for itself, callbacks may exceed the capacity
+		if( std::this_thread::get_id() != m_thread.get_id() )
+		{
+			m_notFull.wait( lock, [ this ] { return m_queue.size() < m_options.queueCapacity; } );
+		}
+
+		m_queue.push_back( std::move( request ) );
+		m_peakQueueDepth = std::max( m_peakQueueDepth, m_queue.size() );
+	}
+
+	m_notEmpty.notify_one();
+}
+
+void v1::AsyncExecutor::run()
+{
+	std::vector< Request > batch;
+	batch.reserve( kMaxBatchSize );
+
+	while( true )
+	{
+		{
+			std::unique_lock lock{ m_queueMtx };
+			m_notEmpty.wait( lock, [ this ] { return m_stop || !m_queue.empty(); } );
+
+			if( m_queue.empty() )
+			{
+				return; // Stopped and drained
+			}
+
+			const std::size_t count = std::min( m_queue.size(), kMaxBatchSize );
+			std::move( m_queue.begin(), m_queue.begin() + static_cast< std::ptrdiff_t >( count ), std::back_inserter( batch ) );
+			m_queue.erase( m_queue.begin(), m_queue.begin() + static_cast< std::ptrdiff_t >( count ) );
+			m_inFlight = count;
+		}
+
+		m_notFull.notify_all();
+
+		execute( batch );
+		batch.clear();
+
+		{
+			std::lock_guard _{ m_queueMtx };
+			m_inFlight = 0;
+		}
+
+		m_idle.notify_all();
+	}
+}
+
+void v1::AsyncExecutor::execute( std::vector< Request >& batch )
+{
+	// Split the batch into runs of requests that can be served by one register operation
+	std::vector< Group > groups;
+	groups.reserve( batch.size() );
+
+	for( std::size_t i = 0; i < batch.size(); ++i )
+	{
+		if( !groups.empty() && m_options.coalesce )
+		{
+			auto& group = groups.back();
+			const auto& first = batch[ group.first ];
+			const auto& previous = batch[ group.last - 1 ];
+			const auto& current = batch[ i ];
+
+			const std::size_t groupEnd = previous.reg + previous.data.size();
+			const std::size_t mergedSize = groupEnd + current.data.size() - first.reg;
+
+			const bool adjacent = current.address == first.address && current.read == first.read &&
+								  current.reg == groupEnd && groupEnd + current.data.size() <= kRegisterCount;
+			const bool fits = current.read || mergedSize + 1 <= Transaction::kMaxWriteBytes;
+
+			if( adjacent && fits )
+			{
+				group.last = i + 1;
+				m_coalesced.fetch_add( 1, std::memory_order_relaxed );
+				continue;
+			}
+		}
+
+		groups.push_back( Group{ i, i + 1, {} } );
+	}
+
+	// Merged groups operate on their own buffer, writes gather the payloads up-front
+	for( auto& group : groups )
+	{
+		if( group.last - group.first == 1 )
+		{
+			continue;
+		}
+
+		for( std::size_t i = group.first; i < group.last; ++i )
+		{
+			auto& data = batch[ i ].data;
+			if( batch[ i ].read )
+			{
+				group.buffer.resize( group.buffer.size() + data.size() );
+			}
+			else
+			{
+				group.buffer.insert( group.buffer.end(), data.begin(), data.end() );
+			}
+		}
+	}
+
+	std::size_t pending{};
+	for( std::size_t i = 0; i < groups.size(); ++i )
+	{
+		auto& group = groups[ i ];
+
+		if( !stage( batch, group ) )
+		{
+			// The transaction is full, submit what was queued so far and start over
+			flush( batch, std::span{ groups }.subspan( pending, i - pending ) );
+			pending = i;
+
+			if( !stage( batch, group ) ) [[unlikely]]
+			{
+				// Cannot happen, requests are validated when queued and a batch never exceeds one transaction
+				for( std::size_t r = group.first; r < group.last; ++r )
+				{
+					complete( batch[ r ], utils::MakeError( utils::ErrorCode::DATA_OVERRUN ) );
+				}
+
+				pending = i + 1;
+			}
+		}
+	}
+
+	flush( batch, std::span{ groups }.subspan( pending ) );
+}
+
+bool v1::AsyncExecutor::stage( std::vector< Request >& batch, Group& group )
+{
+	auto& first = batch[ group.first ];
+	const std::span< std::uint8_t > buffer = group.buffer.empty() ? std::span{ first.data } : std::span{ group.buffer };
+
+	return first.read ? m_transaction.read( first.address, first.reg, buffer )
+					  : m_transaction.write( first.address, first.reg, buffer );
+}
+
+void v1::AsyncExecutor::flush( std::vector< Request >& batch, std::span< Group > groups )
+{
+	if( m_transaction.empty() )
+	{
+		return;
+	}
+
+	const bool submitted = m_busController.submit( m_transaction );
+	m_transfers.fetch_add( 1, std::memory_order_relaxed );
+
+	// One device NACKing fails the whole transfer. Operations before the point where the transport reports
+	// it stopped have succeeded, the failed ones of a shared transfer are retried one by one so the error
+	// reaches only the requests it belongs to. An ioctl error names no such point, reads and writes that ran
+	// before the NACK are then repeated, so the non-idempotent ones keep the error instead.
+	std::array< std::size_t, Transaction::kMaxMessages > failed;
+	std::size_t failedCount{};
+
+	for( std::size_t i = 0; i < groups.size(); ++i )
+	{
+		auto rslt = m_transaction.result( i );
+		if( !rslt && !submitted && groups.size() > 1 && repeatable( batch, groups[ i ] ) ) [[unlikely]]
+		{
+			failed[ failedCount++ ] = i;
+			continue;
+		}
+
+		finish( batch, groups[ i ], rslt );
+	}
+
+	m_transaction.clear();
+
+	for( std::size_t f = 0; f < failedCount; ++f )
+	{
+		auto& group = groups[ failed[ f ] ];
+		[[maybe_unused]] const bool staged = stage( batch, group );
+		[[maybe_unused]] const bool retried = m_busController.submit( m_transaction );
+		m_transfers.fetch_add( 1, std::memory_order_relaxed );
+
+		finish( batch, group, m_transaction.result( 0 ) );
+		m_transaction.clear();
+	}
+}
+
+bool v1::AsyncExecutor::repeatable( const std::vector< Request >& batch, const Group& group ) noexcept
+{
+	return std::all_of( batch.begin() + static_cast< std::ptrdiff_t >( group.first ),
+						batch.begin() + static_cast< std::ptrdiff_t >( group.last ),
+						[]( const Request& request ) { return request.idempotency == Idempotency::IDEMPOTENT; } );
+}
+
+void v1::AsyncExecutor::finish( std::vector< Request >& batch, Group& group, const Result< void >& result )
+{
+	std::size_t offset{};
+	for( std::size_t r = group.first; r < group.last; ++r )
+	{
+		auto& request = batch[ r ];
+
+		// Scatter the merged read back to the individual requests
+		if( result && request.read && !group.buffer.empty() )
+		{
+			std::copy_n( group.buffer.begin() + static_cast< std::ptrdiff_t >( offset ),
+						 request.data.size(),
+						 request.data.begin() );
+		}
+
+		offset += request.data.size();
+		complete( request, result );
+	}
+}
+
+void v1::AsyncExecutor::complete( Request& request, Result< void > result )
+{
+	const auto latency = std::chrono::duration_cast< std::chrono::nanoseconds >(
+							 std::chrono::steady_clock::now() - request.queuedAt )
+							 .count();
+
+	m_latencyTotalNs.fetch_add( latency, std::memory_order_relaxed );
+
+	auto currentMax = m_latencyMaxNs.load( std::memory_order_relaxed );
+	while( latency > currentMax && !m_latencyMaxNs.compare_exchange_weak( currentMax, latency, std::memory_order_relaxed ) )
+	{
+	}
+
+	if( !result ) [[unlikely]]
+	{
+		m_failed.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	m_completed.fetch_add( 1, std::memory_order_relaxed );
+
+	request.completion( std::move( result ), request.data );
+}
+
+} // namespace pbl::i2c
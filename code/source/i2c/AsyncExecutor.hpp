@@ -0,0 +1,246 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of AsyncExecutor class, a per-bus thread executing queued I2C register operations.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_ASYNC_EXECUTOR_HPP__
+#define PBL_I2C_ASYNC_EXECUTOR_HPP__
+
+#include "Transaction.hpp"
+#include <utils/Result.hpp>
+
+// C++
+#include <span>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+class BusController;
+
+/**
+ * @class AsyncExecutor
+ * @brief Executes register reads and writes on a dedicated bus thread, completions are delivered as futures or callbacks.
+ *
+ * BusController calls block the caller until the transfer finished, so a slow conversion or a clock-stretching
+ * device stalls every driver sharing the bus. The executor decouples the callers from the bus: requests are
+ * placed in a bounded submission queue, the bus thread drains it and submits everything it took as one
+ * Transaction (one I2C_RDWR ioctl on Linux). Callers can keep several requests in flight and collect the
+ * results later.
+ *
+ * Adjacent requests of the same direction to the same device are coalesced when their registers are
+ * contiguous, i.e. a read of 0x3B-0x40 followed by a read of 0x41-0x42 becomes a single 8 byte read.
+ * This relies on register auto increment, disable it with Options::coalesce for devices that don't
+ * provide it (i.e. PCA9685 with MODE1.AI cleared or MCP23017 with IOCON.SEQOP set).
+ *
+ * Example usage:
+ * @code
+ * BusController busController{ "/dev/i2c-1" };
+ * AsyncExecutor executor{ busController };
+ *
+ * auto temperature = executor.read( 0x48, 0x00, 2 ); // LM75 temperature
+ * auto accel = executor.read( 0x68, 0x3B, 6 ); // MPU6050 accelerometer
+ * auto gyro = executor.read( 0x68, 0x43, 6 ); // MPU6050 gyroscope
+ *
+ * if( auto rslt = temperature.get(); rslt ) { ... } // rslt->size() == 2
+ *
+ * executor.write( 0x40, 0x00, 0x20, []( auto rslt ) { ... } ); // Completion on the bus thread
+ * @endcode
+ *
+ * A transfer fails as a whole when one of its devices NACKs. If the transport reports where the transfer
+ * stopped, the requests before that point complete normally. The failed ones are retried one transfer each,
+ * so a missing device fails only its own requests. A failed ioctl doesn't tell which requests already reached
+ * their devices, so a retry may repeat them. Requests queued as Idempotency::NON_IDEMPOTENT (i.e. reads of
+ * clear-on-read or FIFO registers) are never repeated, they fail with the error of the shared transfer.
+ *
+ * @note Callbacks are invoked on the bus thread and must not block, a callback may queue further requests.
+ * Synchronous calls on the BusController stay possible, they are serialised with the executor transfers.
+ */
+class AsyncExecutor final
+{
+public:
+	template < typename T >
+	using Result = utils::Result< T >;
+
+	using ReadCallback = std::move_only_function< void( Result< std::vector< std::uint8_t > > ) >;
+	using WriteCallback = std::move_only_function< void( Result< void > ) >;
+
+	struct Options
+	{
+		/// Maximum number of queued requests, submitting to a full queue blocks until the bus thread catches up.
+		std::size_t queueCapacity{ 64 };
+
+		/// Whether adjacent requests to contiguous registers of the same device are merged into one operation.
+		bool coalesce{ true };
+	};
+
+	struct Statistics
+	{
+		std::uint64_t submitted{}; //!< Requests accepted into the queue.
+		std::uint64_t completed{}; //!< Requests completed, successfully or not.
+		std::uint64_t failed{}; //!< Requests completed with an error.
+		std::uint64_t coalesced{}; //!< Requests merged into a preceding request.
+		std::uint64_t transfers{}; //!< Transactions submitted to the bus.
+		std::size_t queueDepth{}; //!< Requests currently waiting in the queue.
+		std::size_t peakQueueDepth{}; //!< Highest queue depth observed.
+		std::chrono::nanoseconds meanLatency{}; //!< Mean time from submission to completion.
+		std::chrono::nanoseconds maxLatency{}; //!< Longest time from submission to completion.
+	};
+
+	/// Starts the bus thread with the default options, the bus controller must outlive the executor.
+	explicit AsyncExecutor( BusController& busController );
+
+	/// Starts the bus thread, the bus controller must outlive the executor.
+	AsyncExecutor( BusController& busController, Options options );
+
+	/// Completes all queued requests and stops the bus thread.
+	~AsyncExecutor();
+
+	/// Queues a read of size bytes starting at register reg.
+	[[nodiscard]] std::future< Result< std::vector< std::uint8_t > > >
+	read( const std::uint8_t deviceAddr,
+		  const std::uint8_t reg,
+		  const std::size_t size,
+		  const Idempotency idempotency = Idempotency::IDEMPOTENT );
+
+	/// Queues a read of size bytes starting at register reg, the callback receives the data.
+	void read( const std::uint8_t deviceAddr,
+			   const std::uint8_t reg,
+			   const std::size_t size,
+			   ReadCallback callback,
+			   const Idempotency idempotency = Idempotency::IDEMPOTENT );
+
+	/// Queues a write of data starting at register reg, the data is copied.
+	[[nodiscard]] std::future< Result< void > > write( const std::uint8_t deviceAddr,
+													   const std::uint8_t reg,
+													   std::span< const std::uint8_t > data,
+													   const Idempotency idempotency = Idempotency::IDEMPOTENT );
+
+	/// Queues a single byte register write.
+	[[nodiscard]] std::future< Result< void > > write( const std::uint8_t deviceAddr,
+													   const std::uint8_t reg,
+													   const std::uint8_t value,
+													   const Idempotency idempotency = Idempotency::IDEMPOTENT )
+	{
+		return write( deviceAddr, reg, std::span< const std::uint8_t >{ &value, 1 }, idempotency );
+	}
+
+	/// Queues a write of data starting at register reg, the callback receives the outcome.
+	void write( const std::uint8_t deviceAddr,
+				const std::uint8_t reg,
+				std::span< const std::uint8_t > data,
+				WriteCallback callback,
+				const Idempotency idempotency = Idempotency::IDEMPOTENT );
+
+	/// Queues a single byte register write, the callback receives the outcome.
+	void write( const std::uint8_t deviceAddr,
+				const std::uint8_t reg,
+				const std::uint8_t value,
+				WriteCallback callback,
+				const Idempotency idempotency = Idempotency::IDEMPOTENT )
+	{
+		write( deviceAddr, reg, std::span< const std::uint8_t >{ &value, 1 }, std::move( callback ), idempotency );
+	}
+
+	/// Blocks until every request queued so far has completed.
+	void waitIdle();
+
+	/// Returns a snapshot of the executor statistics.
+	[[nodiscard]] Statistics statistics() const;
+
+private:
+	using Completion = std::move_only_function< void( Result< void >, std::vector< std::uint8_t >& ) >;
+
+	struct Request
+	{
+		std::uint8_t address{};
+		std::uint8_t reg{};
+		bool read{};
+		Idempotency idempotency{ Idempotency::IDEMPOTENT };
+		std::vector< std::uint8_t > data; //!< Write payload or read destination.
+		Completion completion;
+		std::chrono::steady_clock::time_point queuedAt;
+	};
+
+	/// A run of coalesced requests submitted as one operation.
+	struct Group
+	{
+		std::size_t first{};
+		std::size_t last{}; //!< One past the last request.
+		std::vector< std::uint8_t > buffer; //!< Merged payload, empty for a single request.
+	};
+
+	/// Validates and places the request into the queue, blocks while the queue is full.
+	void enqueue( Request&& request );
+
+	/// The bus thread loop.
+	void run();
+
+	/// Coalesces and executes one batch of requests taken from the queue.
+	void execute( std::vector< Request >& batch );
+
+	/// Queues the operation of the group into the transaction, returns false if it is full.
+	[[nodiscard]] bool stage( std::vector< Request >& batch, Group& group );
+
+	/// Submits the transaction and completes the requests of the given groups, retries the failed ones alone.
+	void flush( std::vector< Request >& batch, std::span< Group > groups );
+
+	/// Returns whether every request of the group may be repeated.
+	[[nodiscard]] static bool repeatable( const std::vector< Request >& batch, const Group& group ) noexcept;
+
+	/// Completes the requests of the group with the outcome of its operation.
+	void finish( std::vector< Request >& batch, Group& group, const Result< void >& result );
+
+	/// Completes the request and updates the statistics.
+	void complete( Request& request, Result< void > result );
+
+	// This class is non-copyable and non-movable
+	AsyncExecutor( const AsyncExecutor& ) = delete;
+	AsyncExecutor( AsyncExecutor&& ) = delete;
+	AsyncExecutor& operator=( const AsyncExecutor& ) = delete;
+	AsyncExecutor& operator=( AsyncExecutor&& ) = delete;
+
+private:
+	BusController& m_busController;
+	const Options m_options;
+
+	mutable std::mutex m_queueMtx; //!< Locks the queue and the in-flight counter
+	std::condition_variable m_notEmpty;
+	std::condition_variable m_notFull;
+	std::condition_variable m_idle;
+	std::deque< Request > m_queue;
+	std::size_t m_inFlight{}; //!< Requests taken by the bus thread but not completed yet
+	std::size_t m_peakQueueDepth{};
+	bool m_stop{};
+
+	Transaction m_transaction; //!< Only used by the bus thread
+
+	std::atomic< std::uint64_t > m_submitted{};
+	std::atomic< std::uint64_t > m_completed{};
+	std::atomic< std::uint64_t > m_failed{};
+	std::atomic< std::uint64_t > m_coalesced{};
+	std::atomic< std::uint64_t > m_transfers{};
+	std::atomic< std::int64_t > m_latencyTotalNs{};
+	std::atomic< std::int64_t > m_latencyMaxNs{};
+
+	std::thread m_thread; //!< Started last, joined in the dtor
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_ASYNC_EXECUTOR_HPP__
@@ -1,10 +1,13 @@
 #include "BMP180Controller.hpp"
 #include "BusController.hpp"
+#include "Transaction.hpp"
+#include "CalibrationCache.hpp"
 
 #include <math/Math.hpp>
 #include <math/Dynamics.hpp>
 
 // C++
+#include <span>
 #include <array>
 #include <cmath>
 #include <chrono>
@@ -25,29 +28,13 @@ constexpr std::uint8_t kBmp180OutMsb{ 0xF6 }; //!< Data output - Most Significan
 constexpr std::uint8_t kBmp180OutLsb{ 0xF7 }; //!< Data output - Least Significant Byte.
 constexpr std::uint8_t kBmp180OutXlsb{ 0xF8 }; //!< Data output - Extension Byte (highest resolution).
 
-// Calibration registers
-constexpr std::uint8_t kBmp180CalibAc1{ 0xAA }; //!< Calibration data (AC1 value).
-constexpr std::uint8_t kBmp180CalibAc1Lsb{ 0xAB }; //!< Calibration data (AC1 value).
-constexpr std::uint8_t kBmp180CalibAc2{ 0xAC }; //!< Calibration data (AC2 value).
-constexpr std::uint8_t kBmp180CalibAc2Lsb{ 0xAD }; //!< Calibration data (AC2 value).
-constexpr std::uint8_t kBmp180CalibAc3{ 0xAE }; //!< Calibration data (AC3 value).
-constexpr std::uint8_t kBmp180CalibAc3Lsb{ 0xAF }; //!< Calibration data (AC3 value).
-constexpr std::uint8_t kBmp180CalibAc4{ 0xB0 }; //!< Calibration data (AC4 value).
-constexpr std::uint8_t kBmp180CalibAc4Lsb{ 0xB1 }; //!< Calibration data (AC4 value).
-constexpr std::uint8_t kBmp180CalibAc5{ 0xB2 }; //!< Calibration data (AC5 value).
-constexpr std::uint8_t kBmp180CalibAc5Lsb{ 0xB3 }; //!< Calibration data (AC5 value).
-constexpr std::uint8_t kBmp180CalibAc6{ 0xB4 }; //!< Calibration data (AC6 value).
-constexpr std::uint8_t kBmp180CalibAc6Lsb{ 0xB5 }; //!< Calibration data (AC6 value).
-constexpr std::uint8_t kBmp180CalibB1{ 0xB6 }; //!< Calibration data (B1 value).
-constexpr std::uint8_t kBmp180CalibB1Lsb{ 0xB7 }; //!< Calibration data (B1 value).
-constexpr std::uint8_t kBmp180CalibB2{ 0xB8 }; //!< Calibration data (B2 value).
-constexpr std::uint8_t kBmp180CalibB2Lsb{ 0xB9 }; //!< Calibration data (B2 value).
-constexpr std::uint8_t kBmp180CalibMb{ 0xBA }; //!< Calibration data (MB value).
-constexpr std::uint8_t kBmp180CalibMbLsb{ 0xBB }; //!< Calibration data (MB value).
-constexpr std::uint8_t kBmp180CalibMc{ 0xBC }; //!< Calibration data (MC value).
-constexpr std::uint8_t kBmp180CalibMcLsb{ 0xBD }; //!< Calibration data (MC value).
-constexpr std::uint8_t kBmp180CalibMd{ 0xBE }; //!< Calibration data (MD value).
-constexpr std::uint8_t kBmp180CalibMdLsb{ 0xBF }; //!< Calibration data (MD value).
+// Calibration registers, AC1 to MD as big endian words
+constexpr std::uint8_t kBmp180CalibAc1{ 0xAA }; //!< Calibration data (AC1 value), first of the block.
+constexpr std::size_t kBmp180CalibSize{ 22 }; //!< Calibration data size, 0xAA to 0xBF.
+constexpr std::size_t kBmp180FingerprintSize{ 4 }; //!< AC1 and AC2, compared with a cached calibration.
+
+constexpr std::uint8_t kBmp180ChipId{ 0x55 }; //!< Value of the 'WHO_AM_I' register.
+constexpr std::string_view kBmp180PartName{ "BMP180" }; //!< Part name of the calibration cache entries.
 
 // BMP180 Commands
 constexpr std::uint8_t kBmp180CmdTemp{ 0x2E }; //!< Start temperature measurement.
@@ -56,6 +43,20 @@ constexpr std::uint8_t kBmp180CmdPressStandard{ 0x74 }; //!< Pressure in standar
 constexpr std::uint8_t kBmp180CmdPressHighRes{ 0xB4 }; //!< Pressure in high-res mode.
 constexpr std::uint8_t kBmp180CmdPressUltraHighRes{ 0xF4 }; //!< Pressure in ultra high-res mode.
 
+constexpr std::uint8_t kBmp180StartConversion{ 0x20 }; //!< Control register SCO bit, set while converting.
+
+// Maximum conversion times of the datasheet
+constexpr std::chrono::microseconds kTemperatureConversionTime{ 4500 };
+constexpr std::array kPressureConversionTimes{ std::chrono::microseconds{ 4500 },
+											   std::chrono::microseconds{ 7500 },
+											   std::chrono::microseconds{ 13500 },
+											   std::chrono::microseconds{ 25500 } };
+
+constexpr std::chrono::microseconds pressureConversionTime( BMP180Controller::SamplingAccuracy mode )
+{
+	return kPressureConversionTimes[ static_cast< std::size_t >( mode ) & 0x03 ];
+}
+
 // You need to use this structure in order to be able to figure out which command to use at what sampling parameter
 constexpr std::array kCmdLookupTable = {
 	std::pair{ BMP180Controller::SamplingAccuracy::ULTRA_LOW_POWER, kBmp180CmdPressUltraLow },
@@ -75,37 +76,12 @@ constexpr std::uint8_t commandForMode( BMP180Controller::SamplingAccuracy mode )
 	return kBmp180CmdPressStandard;
 }
 
-template < typename T >
-bool readCalibConst( T& value,
-					 BusController& busController,
-					 const std::uint8_t bmp180Addr,
-					 const std::uint8_t msb,
-					 const std::uint8_t lsb )
-{
-	std::uint8_t highByte{};
-	std::uint8_t lowByte{};
-
-	if( !busController.read( bmp180Addr, msb, highByte ) ) [[unlikely]]
-	{
-		return false;
-	}
-
-	if( !busController.read( bmp180Addr, lsb, lowByte ) ) [[unlikely]]
-	{
-		return false;
-	}
-
-	value = highByte << 8 | lowByte;
-
-	return true;
-}
-
 } // namespace
 
 struct v1::BMP180Controller::CalibrationConstants
 {
-	/// Read calibration constants from BME180 device
-	bool read( BusController& busController, std::uint8_t address );
+	/// Decodes the calibration block (0xAA to 0xBF), returns false if it holds an invalid coefficient.
+	bool decode( std::span< const std::uint8_t, kBmp180CalibSize > data );
 
 	std::int16_t ac1{};
 	std::int16_t ac2{};
@@ -120,21 +96,33 @@ struct v1::BMP180Controller::CalibrationConstants
 	std::int16_t md{};
 };
 
-bool v1::BMP180Controller::CalibrationConstants::read( BusController& busController, std::uint8_t address )
+bool v1::BMP180Controller::CalibrationConstants::decode( std::span< const std::uint8_t, kBmp180CalibSize > data )
 {
-	bool rslt{ true };
-	rslt |= readCalibConst( ac1, busController, address, kBmp180CalibAc1, kBmp180CalibAc1Lsb );
-	rslt |= readCalibConst( ac2, busController, address, kBmp180CalibAc2, kBmp180CalibAc2Lsb );
-	rslt |= readCalibConst( ac3, busController, address, kBmp180CalibAc3, kBmp180CalibAc3Lsb );
-	rslt |= readCalibConst( ac4, busController, address, kBmp180CalibAc4, kBmp180CalibAc4Lsb );
-	rslt |= readCalibConst( ac5, busController, address, kBmp180CalibAc5, kBmp180CalibAc5Lsb );
-	rslt |= readCalibConst( ac6, busController, address, kBmp180CalibAc6, kBmp180CalibAc6Lsb );
-	rslt |= readCalibConst( b1, busController, address, kBmp180CalibB1, kBmp180CalibB1Lsb );
-	rslt |= readCalibConst( b2, busController, address, kBmp180CalibB2, kBmp180CalibB2Lsb );
-	rslt |= readCalibConst( mb, busController, address, kBmp180CalibMb, kBmp180CalibMbLsb );
-	rslt |= readCalibConst( mc, busController, address, kBmp180CalibMc, kBmp180CalibMcLsb );
-	rslt |= readCalibConst( md, busController, address, kBmp180CalibMd, kBmp180CalibMdLsb );
-	return rslt;
+	std::array< std::uint16_t, kBmp180CalibSize / 2 > words{};
+	for( std::size_t i = 0; i < words.size(); ++i )
+	{
+		words[ i ] = static_cast< std::uint16_t >( data[ 2 * i ] << 8 | data[ 2 * i + 1 ] );
+	}
+
+	// The datasheet guarantees no coefficient is 0x0000 or 0xFFFF, these mean a failed communication
+	const auto invalid = []( const std::uint16_t word ) { return word == 0x0000 || word == 0xFFFF; };
+	if( std::ranges::any_of( words, invalid ) ) [[unlikely]]
+	{
+		return false;
+	}
+
+	ac1 = static_cast< std::int16_t >( words[ 0 ] );
+	ac2 = static_cast< std::int16_t >( words[ 1 ] );
+	ac3 = static_cast< std::int16_t >( words[ 2 ] );
+	ac4 = words[ 3 ];
+	ac5 = words[ 4 ];
+	ac6 = words[ 5 ];
+	b1 = static_cast< std::int16_t >( words[ 6 ] );
+	b2 = static_cast< std::int16_t >( words[ 7 ] );
+	mb = static_cast< std::int16_t >( words[ 8 ] );
+	mc = static_cast< std::int16_t >( words[ 9 ] );
+	md = static_cast< std::int16_t >( words[ 10 ] );
+	return true;
 }
 
 v1::BMP180Controller::BMP180Controller( BusController& busController, Address address, SamplingAccuracy sAccuracy )
@@ -142,18 +130,34 @@ v1::BMP180Controller::BMP180Controller( BusController& busController, Address ad
 	, m_samplingAccuracy{ sAccuracy }
 	, m_constants{}
 {
-	if( !m_constants->read( busController, static_cast< std::uint8_t >( address ) ) ) [[unlikely]]
-	{
-		// TODO: We need to do something about this ...
-		// return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
-	}
+	m_calibrated = loadCalibration( nullptr );
+}
+
+v1::BMP180Controller::BMP180Controller( BusController& busController,
+										const CalibrationCache& cache,
+										Address address,
+										SamplingAccuracy sAccuracy )
+	: ICBase{ busController, address }
+	, m_samplingAccuracy{ sAccuracy }
+	, m_constants{}
+	, m_cache{ &cache }
+{
+	m_calibrated = loadCalibration( m_cache );
 }
 
 v1::BMP180Controller::~BMP180Controller() = default;
 
 auto v1::BMP180Controller::getTrueTemperatureC() -> Result< float >
 {
-	using namespace std::chrono_literals;
+	if( m_conversion != Conversion::NONE ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::BUS_BUSY );
+	}
+
+	if( !m_calibrated && !( m_calibrated = loadCalibration( m_cache ) ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
 
 	// Read uncompensated temperature (UT) value
 	if( !write( kBmp180Control, kBmp180CmdTemp ) ) [[unlikely]] // Start temperature measurement
@@ -161,26 +165,18 @@ auto v1::BMP180Controller::getTrueTemperatureC() -> Result< float >
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
-	sleep( 4500us );
+	sleep( kTemperatureConversionTime );
 
 	// Read raw temperature measurement
 	std::array< std::uint8_t, 2 > rawUT{};
-	if( !read( kBmp180OutMsb, rawUT.data(), rawUT.size() ) ) [[unlikely]]
+	if( read( kBmp180OutMsb, rawUT.data(), rawUT.size() ) < 0 ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
 
 	const std::int16_t UT = ( ( int16_t( rawUT[ 0 ] ) << 8 ) | rawUT[ 1 ] );
 
-	// Calculate true temperature
-	const std::int64_t X1 = ( std::int64_t( UT - m_constants->ac6 ) * m_constants->ac5 ) / 32768;
-	const std::int64_t X2 = m_constants->mc * 2048 / ( X1 + m_constants->md );
-	const std::int64_t B5 = X1 + X2;
-
-	// Temperature calculated here will be in units of 0.1 deg C
-	const std::int64_t T = ( B5 + 8 ) / 16;
-
-	return utils::MakeSuccess( static_cast< float >( T ) * 0.1f );
+	return utils::MakeSuccess( computeTemperatureC( computeB5( UT ) ) );
 }
 
 auto v1::BMP180Controller::getTemperatureF() -> Result< float >
@@ -190,10 +186,15 @@ auto v1::BMP180Controller::getTemperatureF() -> Result< float >
 
 auto v1::BMP180Controller::getTruePressurePa() -> Result< float >
 {
-	using namespace std::chrono_literals;
+	if( m_conversion != Conversion::NONE ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::BUS_BUSY );
+	}
 
-	// Pressure resolution (is this correct!?)
-	const std::uint8_t OSS = static_cast< std::uint8_t >( m_samplingAccuracy );
+	if( !m_calibrated && !( m_calibrated = loadCalibration( m_cache ) ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
 
 	// Start temperature measurement
 	if( !write( kBmp180Control, kBmp180CmdTemp ) ) [[unlikely]]
@@ -201,11 +202,11 @@ auto v1::BMP180Controller::getTruePressurePa() -> Result< float >
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
-	sleep( 4500us );
+	sleep( kTemperatureConversionTime );
 
 	// Read uncompensated temperature value
 	std::array< std::uint8_t, 2 > rawUT{};
-	if( !read( kBmp180OutMsb, rawUT.data(), rawUT.size() ) ) [[unlikely]]
+	if( read( kBmp180OutMsb, rawUT.data(), rawUT.size() ) < 0 ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
@@ -219,35 +220,197 @@ auto v1::BMP180Controller::getTruePressurePa() -> Result< float >
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
-	sleep( std::chrono::milliseconds( static_cast< int >( ( 5.0f + 8.0f * OSS ) ) ) );
+	sleep( pressureConversionTime( m_samplingAccuracy ) );
 
 	// Read uncompensated pressure value
-	// UP = ( MSB << 16 + LSB << 8 + XLSB ) >> ( 8 - oss );
 	std::array< std::uint8_t, 3 > upRawData{};
-	if( !read( kBmp180OutMsb, upRawData.data(), upRawData.size() ) ) [[unlikely]]
+	if( read( kBmp180OutMsb, upRawData.data(), upRawData.size() ) < 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	return utils::MakeSuccess( computePressurePa( computeB5( UT ), uncompensatedPressure( upRawData ) ) );
+}
+
+auto v1::BMP180Controller::getAbsoluteAltitude( float localPressure ) -> Result< float >
+{
+	const auto transform = [ = ]( float pressurePa ) { return math::pressureToAltitude( pressurePa, localPressure ); };
+	return getTruePressurePa().transform( transform );
+}
+
+auto v1::BMP180Controller::startSample( const bool continuous ) -> Result< void >
+{
+	if( m_conversion != Conversion::NONE ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::BUS_BUSY );
+	}
+
+	if( !m_calibrated && !( m_calibrated = loadCalibration( m_cache ) ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	m_continuous = continuous;
+
+	// The temperature drifts slowly, a recent reading compensates the pressure as well
+	const bool temperatureStale = !m_ut || Clock::now() - m_utTime >= m_temperatureInterval;
+	return startConversion( temperatureStale ? Conversion::TEMPERATURE : Conversion::PRESSURE );
+}
+
+auto v1::BMP180Controller::pollSample() -> Result< std::optional< Sample > >
+{
+	if( m_conversion == Conversion::NONE ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	const auto now = Clock::now();
+	if( m_completion == Completion::DEADLINE && now < m_deadline )
 	{
+		return std::nullopt;
+	}
+
+	// Control register, reserved 0xF5 and the outputs in one read, the SCO bit tells whether the data is ready
+	std::array< std::uint8_t, 5 > regs{};
+	if( read( kBmp180Control, regs.data(), regs.size() ) < 0 ) [[unlikely]]
+	{
+		m_conversion = Conversion::NONE;
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	// + or | here?
-	const std::int64_t UP = ( ( static_cast< std::int64_t >( upRawData[ 0 ] ) << 16 ) +
-							  ( static_cast< std::int64_t >( upRawData[ 1 ] ) << 8 ) + upRawData[ 2 ] ) >>
-							( 8 - OSS );
+	if( regs[ 0 ] & kBmp180StartConversion )
+	{
+		return std::nullopt;
+	}
+
+	const auto out = std::span< const std::uint8_t, 5 >{ regs }.subspan< 2, 3 >();
+
+	if( m_conversion == Conversion::TEMPERATURE )
+	{
+		m_ut = static_cast< std::int16_t >( ( out[ 0 ] << 8 ) | out[ 1 ] );
+		m_utTime = now;
+
+		if( auto rslt = startConversion( Conversion::PRESSURE ); !rslt ) [[unlikely]]
+		{
+			return std::unexpected( rslt.error() );
+		}
+
+		return std::nullopt;
+	}
+
+	const auto b5 = computeB5( *m_ut );
+	const Sample sample{ .temperatureC = computeTemperatureC( b5 ),
+						 .pressurePa = computePressurePa( b5, uncompensatedPressure( out ) ) };
+
+	m_conversion = Conversion::NONE;
+	if( m_continuous )
+	{
+		if( auto rslt = startSample( true ); !rslt ) [[unlikely]]
+		{
+			return std::unexpected( rslt.error() );
+		}
+	}
+
+	return sample;
+}
+
+auto v1::BMP180Controller::conversionDeadline() const noexcept -> std::optional< Clock::time_point >
+{
+	if( m_conversion == Conversion::NONE )
+	{
+		return std::nullopt;
+	}
+
+	return m_deadline;
+}
+
+bool v1::BMP180Controller::loadCalibration( const CalibrationCache* cache )
+{
+	std::array< std::uint8_t, kBmp180CalibSize > data{};
+	std::array< std::uint8_t, kBmp180FingerprintSize > fingerprint{};
+	std::uint8_t chipId{};
+	const CalibrationCache::Key key{ kBmp180PartName, controller().bus(), address() };
+
+	// Every BMP180 reports the same chip id, the first calibration words tell a replaced sensor apart.
+	// Both are read in one transfer, the cached block spares the 22 byte read.
+	bool cacheable{ false };
+	if( cache )
+	{
+		Transaction transaction;
+		const bool queued = read( transaction, kBmp180WhoIam, std::span{ &chipId, 1 } ) &&
+							read( transaction, kBmp180CalibAc1, fingerprint );
+		cacheable = queued && submit( transaction ) && chipId == kBmp180ChipId;
+	}
+
+	if( cacheable && cache->load( key, chipId, data ) &&
+		std::ranges::equal( fingerprint, std::span{ data }.first< kBmp180FingerprintSize >() ) &&
+		m_constants->decode( data ) )
+	{
+		return true;
+	}
+
+	// The whole block in one burst, the registers are consecutive
+	if( read( kBmp180CalibAc1, data.data(), data.size() ) < 0 || !m_constants->decode( data ) ) [[unlikely]]
+	{
+		return false;
+	}
+
+	if( cacheable )
+	{
+		cache->store( key, chipId, data );
+	}
 
-	// const std::int64_t A1 = static_cast< std::int64_t >( upRawData[ 0 ] );
-	// const std::int64_t A2 = static_cast< std::int64_t >( upRawData[ 1 ] );
-	// const std::int64_t A3 = static_cast< std::int64_t >( upRawData[ 2 ] );
-	// const std::int64_t UP = (A1 << 16 | A2 << 8 | A3) >> (8 - OSS);
+	return true;
+}
 
-	// Calculate true temperature (correct - validated against real temperature calculation)
-	std::int64_t X1 = ( std::int64_t( UT - m_constants->ac6 ) * m_constants->ac5 ) / 32768;
-	std::int64_t X2 = m_constants->mc * 2048 / ( X1 + m_constants->md );
-	std::int64_t B5 = X1 + X2;
+auto v1::BMP180Controller::startConversion( const Conversion conversion ) -> Result< void >
+{
+	const bool temperature = conversion == Conversion::TEMPERATURE;
+	const auto command = temperature ? kBmp180CmdTemp : commandForMode( m_samplingAccuracy );
+
+	if( !write( kBmp180Control, command ) ) [[unlikely]]
+	{
+		m_conversion = Conversion::NONE;
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	m_conversion = conversion;
+	m_deadline = Clock::now() + ( temperature ? kTemperatureConversionTime : pressureConversionTime( m_samplingAccuracy ) );
+
+	return utils::MakeSuccess();
+}
+
+std::int64_t v1::BMP180Controller::computeB5( const std::int16_t ut ) const noexcept
+{
+	const std::int64_t X1 = ( std::int64_t( ut - m_constants->ac6 ) * m_constants->ac5 ) / 32768;
+	const std::int64_t X2 = m_constants->mc * 2048 / ( X1 + m_constants->md );
+	return X1 + X2;
+}
+
+float v1::BMP180Controller::computeTemperatureC( const std::int64_t b5 ) noexcept
+{
+	// Temperature calculated here will be in units of 0.1 deg C
+	const std::int64_t T = ( b5 + 8 ) / 16;
+	return static_cast< float >( T ) * 0.1f;
+}
+
+std::int64_t v1::BMP180Controller::uncompensatedPressure( const std::span< const std::uint8_t, 3 > out ) const noexcept
+{
+	// UP = ( MSB << 16 + LSB << 8 + XLSB ) >> ( 8 - oss );
+	const auto OSS = static_cast< std::uint8_t >( m_samplingAccuracy );
+	return ( ( static_cast< std::int64_t >( out[ 0 ] ) << 16 ) + ( static_cast< std::int64_t >( out[ 1 ] ) << 8 ) +
+			 out[ 2 ] ) >>
+		   ( 8 - OSS );
+}
+
+float v1::BMP180Controller::computePressurePa( const std::int64_t b5, const std::int64_t up ) const noexcept
+{
+	const std::uint8_t OSS = static_cast< std::uint8_t >( m_samplingAccuracy );
 
 	// Calculate true pressure
-	std::int64_t B6 = B5 - 4000;
-	X1 = ( m_constants->b2 * ( B6 * B6 / 4096 ) / 2048 );
-	X2 = m_constants->ac2 * B6 / 2048;
+	std::int64_t B6 = b5 - 4000;
+	std::int64_t X1 = ( m_constants->b2 * ( B6 * B6 / 4096 ) / 2048 );
+	std::int64_t X2 = m_constants->ac2 * B6 / 2048;
 
 	std::int64_t X3 = X1 + X2;
 	std::int64_t B3 = ( ( ( m_constants->ac1 * 4 + X3 ) << OSS ) + 2 ) / 4;
@@ -256,7 +419,7 @@ auto v1::BMP180Controller::getTruePressurePa() -> Result< float >
 	X2 = ( m_constants->b1 * ( B6 * B6 / 4096 ) ) / 65536;
 	X3 = ( ( X1 + X2 ) + 2 ) / 4;
 	const std::uint64_t B4 = ( m_constants->ac4 * std::uint64_t( X3 + 32768 ) / 32768 );
-	const std::uint64_t B7 = ( std::uint64_t( UP ) - B3 ) * ( 50000 >> OSS );
+	const std::uint64_t B7 = ( std::uint64_t( up ) - B3 ) * ( 50000 >> OSS );
 
 	std::int32_t p{};
 	if( B7 < 0x80000000 )
@@ -277,13 +440,7 @@ auto v1::BMP180Controller::getTruePressurePa() -> Result< float >
 	// TODO: Check if this cast is safe
 	p = p + static_cast< std::int32_t >( X1 + X2 + 3791 ) / 16; // Pressure in units of Pa.
 
-	return utils::MakeSuccess( static_cast< float >( p ) );
-}
-
-auto v1::BMP180Controller::getAbsoluteAltitude( float localPressure ) -> Result< float >
-{
-	const auto transform = [ = ]( float pressurePa ) { return math::pressureToAltitude( pressurePa, localPressure ); };
-	return getTruePressurePa().transform( transform );
+	return static_cast< float >( p );
 }
 
 } // namespace pbl::i2c
@@ -14,6 +14,7 @@
 #include <utils/FastPimpl.hpp>
 
 // C++
+#include <chrono>
 #include <optional>
 #include <expected>
 
@@ -23,6 +24,8 @@ namespace pbl::i2c
 inline namespace v1
 {
 
+class CalibrationCache;
+
 /**
  * @class BMP180Controller
  * @brief Controller interface for the BMP180 barometric pressure sensor.
@@ -54,6 +57,21 @@ inline namespace v1
  * float altitude = bmp180.getAbsoluteAltitude(); // Calculate the absolute altitude
  * @endcode
  *
+ * The getters above block for the conversion time, up to 25.5 ms. The non-blocking sampling API
+ * (startSample / pollSample) lets one thread interleave the conversions of many sensors: the
+ * conversion is started, the caller sleeps until conversionDeadline of the earliest sensor and
+ * polls. The temperature is measured only every setTemperatureInterval and reused for the pressure
+ * compensation in between, so a sample normally costs a single (pressure) conversion window.
+ *
+ * @code
+ * bmp180.startSample( true ); // Continuous, the next conversion starts when a sample completes
+ * while( running )
+ * {
+ *     std::this_thread::sleep_until( *bmp180.conversionDeadline() );
+ *     if( auto sample = bmp180.pollSample(); sample && *sample ) { ... } // (*sample)->pressurePa
+ * }
+ * @endcode
+ *
  * @note The class necessitates a proper I2C bus configuration and specific sensor initialization 
  * before retrieving any measurements. The calling environment must ensure that the I2C bus is 
  * available and operational. Furthermore, correct calibration coefficients must be accessible for 
@@ -87,15 +105,46 @@ public:
 		ULTRA_HIGH_RESOLUTION = 3
 	};
 
+	/// How pollSample detects the end of a conversion.
+	enum class Completion : std::uint8_t
+	{
+		DEADLINE, //!< Waits for the datasheet conversion time, no bus traffic before.
+		EOC //!< Polls the start of conversion bit, completes as soon as the sensor is done.
+	};
+
+	/// A compensated sample of the non-blocking API.
+	struct Sample
+	{
+		float temperatureC{};
+		float pressurePa{};
+	};
+
+	using Clock = std::chrono::steady_clock;
+
 	using enum Address;
 	using enum SamplingAccuracy;
 
+	/// Reads the calibration coefficients in one burst, a failed read is retried by the first measurement.
 	explicit BMP180Controller( BusController& busController,
 							   Address address = DEFAULT,
 							   SamplingAccuracy sAccuracy = STANDARD );
 
+	/**
+	 * @brief Loads the calibration coefficients from the cache if its entry matches the chip id of
+	 * the sensor, otherwise reads them from the sensor and stores them in the cache.
+	 *
+	 * @note The cache must outlive the controller, a failed read is retried through it.
+	 */
+	BMP180Controller( BusController& busController,
+					  const CalibrationCache& cache,
+					  Address address = DEFAULT,
+					  SamplingAccuracy sAccuracy = STANDARD );
+
 	~BMP180Controller();
 
+	/// Whether the calibration coefficients are loaded, measurements fail with ErrorCode::FAILED_TO_READ until they are.
+	[[nodiscard]] bool calibrated() const noexcept { return m_calibrated; }
+
 	/// Retrieves the temperature in degrees Celsius
 	[[nodiscard]] Result< float > getTrueTemperatureC();
 
@@ -112,6 +161,64 @@ public:
 	 */
 	[[nodiscard]] Result< float > getAbsoluteAltitude( float localPressure = kPressureAtSeaLevelPa );
 
+	/**
+	 * @brief Starts a non-blocking sample, a temperature conversion if the last one is older than the
+	 * temperature interval, otherwise directly the pressure conversion.
+	 *
+	 * @param continuous Whether the next sample is started as soon as pollSample returned one.
+	 * @return ErrorCode::BUS_BUSY if a sample is already in progress, ErrorCode::FAILED_TO_WRITE on bus failures.
+	 */
+	[[nodiscard]] Result< void > startSample( const bool continuous = false );
+
+	/**
+	 * @brief Advances the sample in progress without blocking.
+	 *
+	 * Completes the pending conversion if it is done, a completed temperature conversion starts the
+	 * pressure conversion. Before the conversion deadline no bus traffic happens in DEADLINE mode.
+	 *
+	 * @return The sample once the pressure conversion completed, std::nullopt while converting,
+	 * ErrorCode::UNSUPPORTED_OPERATION if no sample was started or the bus error, which ends the sample.
+	 */
+	[[nodiscard]] Result< std::optional< Sample > > pollSample();
+
+	/// Abandons the sample in progress, the running conversion completes on the sensor unnoticed.
+	void cancelSample() noexcept { m_conversion = Conversion::NONE; }
+
+	/// Returns the time the pending conversion is complete by, std::nullopt if no sample is in progress.
+	[[nodiscard]] std::optional< Clock::time_point > conversionDeadline() const noexcept;
+
+	/// Sets how long a temperature reading is reused for pressure compensation, zero measures it for every sample.
+	void setTemperatureInterval( const std::chrono::milliseconds interval ) noexcept { m_temperatureInterval = interval; }
+
+	/// Sets how pollSample detects the end of a conversion.
+	void setCompletion( const Completion completion ) noexcept { m_completion = completion; }
+
+private:
+	enum class Conversion : std::uint8_t
+	{
+		NONE,
+		TEMPERATURE,
+		PRESSURE
+	};
+
+	/// Loads the calibration coefficients, from the cache if given and valid, returns false on failure.
+	[[nodiscard]] bool loadCalibration( const CalibrationCache* cache );
+
+	/// Writes the conversion command and sets its deadline.
+	[[nodiscard]] Result< void > startConversion( const Conversion conversion );
+
+	/// Returns the B5 temperature compensation term of an uncompensated temperature.
+	[[nodiscard]] std::int64_t computeB5( const std::int16_t ut ) const noexcept;
+
+	/// Returns the temperature in degrees Celsius of the B5 term.
+	[[nodiscard]] static float computeTemperatureC( const std::int64_t b5 ) noexcept;
+
+	/// Returns the compensated pressure in pascals of an uncompensated pressure.
+	[[nodiscard]] float computePressurePa( const std::int64_t b5, const std::int64_t up ) const noexcept;
+
+	/// Returns the uncompensated pressure of the output registers (MSB, LSB, XLSB).
+	[[nodiscard]] std::int64_t uncompensatedPressure( const std::span< const std::uint8_t, 3 > out ) const noexcept;
+
 private:
 	BMP180Controller( const BMP180Controller& ) = delete;
 	BMP180Controller& operator=( const BMP180Controller& ) = delete;
@@ -119,6 +226,17 @@ private:
 private:
 	SamplingAccuracy m_samplingAccuracy;
 	utils::FastPimpl< CalibrationConstants, kCalibConstSize, kCalibConstAlign > m_constants;
+	const CalibrationCache* m_cache{}; //!< Optional, source of the calibration coefficients.
+	bool m_calibrated{};
+
+	// Non-blocking sampling state
+	Conversion m_conversion{ Conversion::NONE };
+	Completion m_completion{ Completion::DEADLINE };
+	bool m_continuous{};
+	Clock::time_point m_deadline; //!< The pending conversion is complete by then.
+	std::optional< std::int16_t > m_ut; //!< Last uncompensated temperature.
+	Clock::time_point m_utTime; //!< When m_ut was measured.
+	std::chrono::milliseconds m_temperatureInterval{ 1000 }; //!< Datasheet recommends once per second.
 };
 
 } // namespace v1
@@ -1,25 +1,17 @@
 #include "BusController.hpp"
+#include "LinuxTransport.hpp"
 
 // C++
 #include <array>
-#include <thread>
-#include <vector>
 #include <string>
+#include <limits>
 #include <utility>
-#include <sstream>
 #include <algorithm>
 
-// TODO: Debug remove
-#include <iostream>
-
 // C
 extern "C" {
-#include <fcntl.h>
+#include <errno.h>
 #include <string.h>
-#include <unistd.h>
-#include <sys/ioctl.h>
-#include <linux/i2c-dev.h>
-#include <linux/i2c.h>
 }
 
 namespace pbl::i2c
@@ -28,134 +20,80 @@ namespace pbl::i2c
 namespace
 {
 
-[[nodiscard]] bool check( std::uint64_t fs, const std::pair< std::uint64_t, std::string_view >& element )
+using Message = Transaction::Message;
+
+/// Maps an errno value reported by the transport to a library error code.
+[[nodiscard]] constexpr utils::ErrorCode toErrorCode( const int error ) noexcept
 {
-	if( fs & element.first )
-	{
-		std::ostringstream oss;
-		oss << element.second << " SUPPORTED" << std::endl;
-		return true;
+	switch( error )
+	{
+		case ENXIO:
+		case EREMOTEIO: return utils::ErrorCode::NACK_RECEIVED;
+		case ETIMEDOUT: return utils::ErrorCode::TIMEOUT;
+		case EAGAIN: return utils::ErrorCode::ARBITRATION_LOST;
+		case EBUSY: return utils::ErrorCode::BUS_BUSY;
+		case EACCES:
+		case EPERM: return utils::ErrorCode::ACCESS_DENIED;
+		case EINVAL: return utils::ErrorCode::INVALID_ARGUMENT;
+		case EOPNOTSUPP: return utils::ErrorCode::UNSUPPORTED_OPERATION;
+		case ENODEV: return utils::ErrorCode::DEVICE_NOT_FOUND;
+		case EBADF: return utils::ErrorCode::HARDWARE_NOT_AVAILABLE;
+		case EIO: return utils::ErrorCode::HARDWARE_FAILURE;
+		default: return utils::ErrorCode::UNEXPECTED_ERROR;
 	}
-
-	return false;
 }
 
-constexpr std::array< std::pair< std::size_t, std::string_view >, 20 > kFuncsToCheck = {
-	std::pair{ I2C_FUNC_I2C, "I2C_FUNC_I2C" },
-	std::pair{ I2C_FUNC_10BIT_ADDR, "I2C_FUNC_10BIT_ADDR" },
-	std::pair{ I2C_FUNC_PROTOCOL_MANGLING, "I2C_FUNC_PROTOCOL_MANGLING" },
-	std::pair{ I2C_FUNC_SMBUS_PEC, "I2C_FUNC_SMBUS_PEC" },
-	std::pair{ I2C_FUNC_NOSTART, "I2C_FUNC_NOSTART" },
-	std::pair{ I2C_FUNC_SLAVE, "I2C_FUNC_SLAVE" },
-	std::pair{ I2C_FUNC_SMBUS_BLOCK_PROC_CALL, "I2C_FUNC_SMBUS_BLOCK_PROC_CALL" },
-	std::pair{ I2C_FUNC_SMBUS_QUICK, "I2C_FUNC_SMBUS_QUICK" },
-	std::pair{ I2C_FUNC_SMBUS_READ_BYTE, "I2C_FUNC_SMBUS_READ_BYTE" },
-	std::pair{ I2C_FUNC_SMBUS_WRITE_BYTE, "I2C_FUNC_SMBUS_WRITE_BYTE" },
-	std::pair{ I2C_FUNC_SMBUS_READ_BYTE_DATA, "I2C_FUNC_SMBUS_READ_BYTE_DATA" },
-	std::pair{ I2C_FUNC_SMBUS_WRITE_BYTE_DATA, "I2C_FUNC_SMBUS_WRITE_BYTE_DATA" },
-	std::pair{ I2C_FUNC_SMBUS_READ_WORD_DATA, "I2C_FUNC_SMBUS_READ_WORD_DATA" },
-	std::pair{ I2C_FUNC_SMBUS_WRITE_WORD_DATA, "I2C_FUNC_SMBUS_WRITE_WORD_DATA" },
-	std::pair{ I2C_FUNC_SMBUS_PROC_CALL, "I2C_FUNC_SMBUS_PROC_CALL" },
-	std::pair{ I2C_FUNC_SMBUS_READ_BLOCK_DATA, "I2C_FUNC_SMBUS_READ_BLOCK_DATA" },
-	std::pair{ I2C_FUNC_SMBUS_WRITE_BLOCK_DATA, "I2C_FUNC_SMBUS_WRITE_BLOCK_DATA" },
-	std::pair{ I2C_FUNC_SMBUS_READ_I2C_BLOCK, "I2C_FUNC_SMBUS_READ_I2C_BLOCK" },
-	std::pair{ I2C_FUNC_SMBUS_WRITE_I2C_BLOCK, "I2C_FUNC_SMBUS_WRITE_I2C_BLOCK" },
-	std::pair{ I2C_FUNC_SMBUS_HOST_NOTIFY, "I2C_FUNC_SMBUS_HOST_NOTIFY" } };
-
-template < std::size_t N >
-[[nodiscard]] bool
-readN( const int fd, const std::uint8_t slaveAddr, const std::uint8_t reg, std::array< std::uint8_t, N >& result )
+/// Register pointer write followed by a repeated start read of data.size() bytes, the pointer must outlive it.
+[[nodiscard]] std::array< Message, 2 >
+registerRead( const std::uint8_t slaveAddr, std::uint8_t& pointer, std::span< std::uint8_t > data ) noexcept
 {
-	std::uint8_t outbuf[ 2 ];
-	outbuf[ 0 ] = reg;
-
-	::i2c_msg msgs[ 2 ];
-	msgs[ 0 ].addr = slaveAddr;
-	msgs[ 0 ].flags = 0;
-	msgs[ 0 ].len = 1;
-	msgs[ 0 ].buf = outbuf;
-
-	msgs[ 1 ].addr = slaveAddr;
-	msgs[ 1 ].flags = I2C_M_RD | I2C_M_NOSTART;
-	msgs[ 1 ].len = N;
-	msgs[ 1 ].buf = result.data();
-
-	::i2c_rdwr_ioctl_data msgset[ 1 ];
-	msgset[ 0 ].msgs = msgs;
-	msgset[ 0 ].nmsgs = 2;
+	return { Message{ slaveAddr, false, std::span{ &pointer, 1 } }, Message{ slaveAddr, true, data } };
+}
 
-	::memset( result.data(), 0x00, N );
+} // namespace
 
-	if( ::ioctl( fd, I2C_RDWR, &msgset ) < 0 )
+v1::BusController::BusController( const std::string& busName )
+	: BusController{ std::make_unique< LinuxTransport >( busName ) }
+{
+	if( !isOpen() ) [[unlikely]]
 	{
-		return false;
+		reportError( static_cast< const LinuxTransport& >( *m_transport ).openErrno() );
 	}
-
-	return true;
 }
 
-} // namespace
-
-v1::BusController::BusController( const std::string& busName )
-	: m_busName{ busName }
+v1::BusController::BusController( std::unique_ptr< Transport > transport )
+	: m_busName{ transport ? transport->name() : std::string{} }
+	, m_transport{ std::move( transport ) }
+#ifdef PBL_I2C_TELEMETRY
+	, m_telemetry{ std::make_unique< BusTelemetry >() }
+#endif
 {
-	m_fd = ::open( m_busName.c_str(), O_RDWR | O_NONBLOCK );
-	if( m_fd < 0 )
+	if( !m_transport || !m_transport->isOpen() ) [[unlikely]]
 	{
-		reportError();
+		reportError( EBADF );
 		return;
 	}
 
-	checkFunc();
-
 	m_open = true;
 }
 
 v1::BusController::~BusController()
 {
-	::close( m_fd );
 	m_open = false;
 }
 
 bool v1::BusController::read( const std::uint8_t slaveAddr, const std::uint8_t reg, std::uint8_t& result )
 {
-	if( !isOpen() ) [[unlikely]]
-	{
-		setLastError( "I2C bus is closed" );
-		return false;
-	}
-
-	std::lock_guard _{ m_fdMtx };
-
-	std::uint8_t outbuf[ 1 ];
-	std::uint8_t inbuf[ 1 ];
-
-	::i2c_msg msgs[ 2 ];
-	msgs[ 0 ].addr = slaveAddr;
-	msgs[ 0 ].flags = 0;
-	msgs[ 0 ].len = 1;
-	msgs[ 0 ].buf = &outbuf[ 0 ];
+	std::uint8_t pointer{ reg };
+	std::uint8_t value{};
 
-	msgs[ 1 ].addr = slaveAddr;
-	msgs[ 1 ].flags = I2C_M_RD | I2C_M_NOSTART;
-	msgs[ 1 ].len = 1;
-	msgs[ 1 ].buf = inbuf;
-
-	::i2c_rdwr_ioctl_data msgset[ 1 ];
-	msgset[ 0 ].msgs = msgs;
-	msgset[ 0 ].nmsgs = 2;
-
-	outbuf[ 0 ] = reg;
-
-	inbuf[ 0 ] = 0;
-
-	if( ::ioctl( m_fd, I2C_RDWR, &msgset ) < 0 ) [[unlikely]]
+	auto msgs = registerRead( slaveAddr, pointer, std::span{ &value, 1 } );
+	if( !transfer( msgs ) ) [[unlikely]]
 	{
-		reportError();
 		return false;
 	}
 
-	result = inbuf[ 0 ];
+	result = value;
 
 	return true;
 }
@@ -164,42 +102,22 @@ bool v1::BusController::read( const std::uint8_t slaveAddr,
 							  const std::uint8_t reg,
 							  std::array< std::uint8_t, 2 >& result )
 {
-	if( !isOpen() ) [[unlikely]]
-	{
-		setLastError( "I2C bus is closed" );
-		return false;
-	}
+	std::uint8_t pointer{ reg };
+	result.fill( 0x00 );
 
-	std::lock_guard _{ m_fdMtx };
-
-	if( !readN( m_fd, slaveAddr, reg, result ) ) [[unlikely]]
-	{
-		reportError();
-		return false;
-	}
-
-	return true;
+	auto msgs = registerRead( slaveAddr, pointer, result );
+	return transfer( msgs );
 }
 
 bool v1::BusController::read( const std::uint8_t slaveAddr,
 							  const std::uint8_t reg,
 							  std::array< std::uint8_t, 4 >& result )
 {
-	if( !isOpen() ) [[unlikely]]
-	{
-		setLastError( "I2C bus is closed" );
-		return false;
-	}
+	std::uint8_t pointer{ reg };
+	result.fill( 0x00 );
 
-	std::lock_guard _{ m_fdMtx };
-
-	if( !readN( m_fd, slaveAddr, reg, result ) ) [[unlikely]]
-	{
-		reportError();
-		return false;
-	}
-
-	return true;
+	auto msgs = registerRead( slaveAddr, pointer, result );
+	return transfer( msgs );
 }
 
 bool v1::BusController::read( const std::uint8_t slaveAddr,
@@ -271,68 +189,26 @@ std::int16_t v1::BusController::read( const std::uint8_t slaveAddr,
 									  std::uint8_t* pData,
 									  std::uint16_t dataSize )
 {
-	if( !isOpen() ) [[unlikely]]
-	{
-		setLastError( "I2C bus is closed" );
-		return {};
-	}
-
-	std::lock_guard _{ m_fdMtx };
-
-	std::uint8_t outbuf[ 2 ];
-	outbuf[ 0 ] = reg;
-
-	::i2c_msg msgs[ 2 ];
-	msgs[ 0 ].addr = slaveAddr;
-	msgs[ 0 ].flags = 0;
-	msgs[ 0 ].len = 1;
-	msgs[ 0 ].buf = outbuf;
-
-	msgs[ 1 ].addr = slaveAddr;
-	msgs[ 1 ].flags = I2C_M_RD | I2C_M_NOSTART;
-	msgs[ 1 ].len = dataSize;
-	msgs[ 1 ].buf = pData;
-
-	::i2c_rdwr_ioctl_data msgset[ 1 ];
-	msgset[ 0 ].msgs = msgs;
-	msgset[ 0 ].nmsgs = 2;
-
-	::memset( pData, 0x00, dataSize );
+	const std::span< std::uint8_t > data{ pData, dataSize };
+	std::uint8_t pointer{ reg };
+	std::ranges::fill( data, 0x00 );
 
-	if( ::ioctl( m_fd, I2C_RDWR, &msgset ) < 0 ) [[unlikely]]
+	auto msgs = registerRead( slaveAddr, pointer, data );
+	if( !transfer( msgs ) ) [[unlikely]]
 	{
-		reportError();
 		return -1;
 	}
 
-	return dataSize;
+	return static_cast< std::int16_t >( dataSize );
 }
 
 std::int16_t v1::BusController::read( const std::uint8_t deviceAddr, std::span< std::uint8_t > data )
 {
-	if( !isOpen() ) [[unlikely]]
-	{
-		setLastError( "I2C bus is closed" );
-		return -1;
-	}
-
-	std::lock_guard _{ m_fdMtx };
+	std::ranges::fill( data, 0x00 );
 
-	::i2c_msg msgs[ 1 ];
-	msgs[ 0 ].addr = deviceAddr;
-	msgs[ 0 ].flags = I2C_M_RD;
-	msgs[ 0 ].len = static_cast< unsigned short >( data.size() );
-	msgs[ 0 ].buf = data.data();
-
-	::i2c_rdwr_ioctl_data msgset;
-	msgset.msgs = msgs;
-	msgset.nmsgs = 1;
-
-	::memset( data.data(), 0x00, data.size() );
-
-	if( ::ioctl( m_fd, I2C_RDWR, &msgset ) < 0 ) [[unlikely]]
+	std::array msgs{ Message{ deviceAddr, true, data } };
+	if( !transfer( msgs ) ) [[unlikely]]
 	{
-		reportError();
 		return -1;
 	}
 
@@ -341,67 +217,26 @@ std::int16_t v1::BusController::read( const std::uint8_t deviceAddr, std::span<
 
 bool v1::BusController::write( const std::uint8_t deviceAddr, const std::span< const std::uint8_t > data )
 {
-	if( !isOpen() ) [[unlikely]]
-	{
-		setLastError( "I2C bus is closed" );
-		return false;
-	}
-
-	::i2c_msg msgs[ 1 ];
-	msgs[ 0 ].addr = deviceAddr;
-	msgs[ 0 ].flags = 0;
-	msgs[ 0 ].len = static_cast< unsigned short >( data.size() );
-	msgs[ 0 ].buf = const_cast< std::uint8_t* >( data.data() );
-
-	::i2c_rdwr_ioctl_data msgset[ 1 ];
-	msgset[ 0 ].nmsgs = 1;
-	msgset[ 0 ].msgs = msgs;
+	// Write messages are never modified by the transport
+	std::span< std::uint8_t > buffer{ const_cast< std::uint8_t* >( data.data() ), data.size() };
 
-	if( ::ioctl( m_fd, I2C_RDWR, &msgset ) < 0 ) [[unlikely]]
-	{
-		reportError();
-		return false;
-	}
-
-	return true;
+	std::array msgs{ Message{ deviceAddr, false, buffer } };
+	return transfer( msgs );
 }
 
 bool v1::BusController::write( const std::uint8_t slaveAddr, const std::uint8_t reg, const std::uint8_t data )
 {
-	if( !isOpen() ) [[unlikely]]
-	{
-		setLastError( "I2C bus is closed" );
-		return false;
-	}
-
-	std::lock_guard _{ m_fdMtx };
-
 	std::uint8_t outbuf[ 2 ];
 	outbuf[ 0 ] = reg;
 	outbuf[ 1 ] = data;
 
-	::i2c_msg msgs[ 1 ];
-	msgs[ 0 ].addr = slaveAddr;
-	msgs[ 0 ].flags = 0;
-	msgs[ 0 ].len = 2;
-	msgs[ 0 ].buf = outbuf;
-
-	::i2c_rdwr_ioctl_data msgset[ 1 ];
-	msgset[ 0 ].nmsgs = 1;
-	msgset[ 0 ].msgs = msgs;
-
-	if( ::ioctl( m_fd, I2C_RDWR, &msgset ) < 0 ) [[unlikely]]
-	{
-		reportError();
-		return false;
-	}
-
-	return true;
+	std::array msgs{ Message{ slaveAddr, false, std::span{ outbuf } } };
+	return transfer( msgs );
 }
 
-bool BusController::write( const std::uint8_t slaveAddr,
-						   const std::uint8_t reg,
-						   const std::span< const std::uint8_t > data )
+bool v1::BusController::write( const std::uint8_t slaveAddr,
+							   const std::uint8_t reg,
+							   const std::span< const std::uint8_t > data )
 {
 	return write( slaveAddr, reg, data.data(), static_cast< std::uint8_t >( data.size() ) );
 }
@@ -411,87 +246,155 @@ bool v1::BusController::write( const std::uint8_t slaveAddr,
 							   const std::uint8_t* data,
 							   const std::uint8_t size )
 {
-	if( !isOpen() ) [[unlikely]]
-	{
-		setLastError( "I2C bus is closed" );
-		return false;
-	}
-
-	std::lock_guard _{ m_fdMtx };
+	// Register and payload go out as one message, the largest one still fits the stack buffer
+	std::array< std::uint8_t, Transaction::kMaxWriteBytes > buffer;
+	static_assert( Transaction::kMaxWriteBytes >= std::numeric_limits< std::uint8_t >::max() + 1 );
 
-	// TODO: Consider using std::array and fixed maximum buffer size
-	std::vector< std::uint8_t > dataBuffer;
-	dataBuffer.resize( size + 1 ); // + 1 for register
+	buffer[ 0 ] = reg;
+	std::copy_n( data, size, buffer.begin() + 1 );
 
-	// Fill the data buffer
-	dataBuffer[ 0 ] = reg;
+	std::array msgs{ Message{ slaveAddr, false, std::span{ buffer }.first( size + 1u ) } };
+	return transfer( msgs );
+}
 
-	// TODO (MrAviator93): Replace by std::copy_n(data, size, dataBuffer + 1); ?
-	for( int i = 1; i < size + 1; i++ )
+bool v1::BusController::submit( Transaction& transaction )
+{
+	if( transaction.empty() ) [[unlikely]]
 	{
-		dataBuffer[ i ] = data[ i - 1 ];
+		return true;
 	}
 
-	::i2c_msg msgs[ 1 ];
-	msgs[ 0 ].addr = slaveAddr;
-	msgs[ 0 ].flags = 0;
-	msgs[ 0 ].len = static_cast< unsigned short >( dataBuffer.size() );
-	msgs[ 0 ].buf = dataBuffer.data();
+	if( !isOpen() ) [[unlikely]]
+	{
+		reportError( EBADF );
+		transaction.complete( 0, utils::ErrorCode::HARDWARE_NOT_AVAILABLE );
+		return false;
+	}
 
-	::i2c_rdwr_ioctl_data msgset[ 1 ];
-	msgset[ 0 ].nmsgs = 1;
-	msgset[ 0 ].msgs = msgs;
+	const auto messages = transaction.mutableMessages();
+	const int transferred = exchange( messages );
 
-	if( ::ioctl( m_fd, I2C_RDWR, &msgset ) < 0 ) [[unlikely]]
+	if( transferred < 0 ) [[unlikely]]
 	{
-		reportError();
+		reportError( -transferred );
+		transaction.complete( 0, toErrorCode( -transferred ) );
 		return false;
 	}
 
-	return true;
+	// Some adapters stop early without reporting an error, the rest of the operations did not happen
+	transaction.complete( static_cast< std::size_t >( transferred ), utils::ErrorCode::DEVICE_NOT_RESPONDING );
+	return static_cast< std::size_t >( transferred ) == messages.size();
 }
 
 void v1::BusController::sleep( const std::chrono::milliseconds sleepTimeMs )
 {
-	std::this_thread::sleep_for( sleepTimeMs );
+	sleep( std::chrono::duration_cast< std::chrono::microseconds >( sleepTimeMs ) );
 }
 
 void v1::BusController::sleep( const std::chrono::microseconds sleepTimeUs )
 {
-	std::this_thread::sleep_for( sleepTimeUs );
+	m_transport->sleep( sleepTimeUs );
 }
 
-void v1::BusController::reportError()
+bool v1::BusController::transfer( std::span< Transaction::Message > messages )
 {
-	auto e = errno;
-	std::array< char, 256 > err{};
+	if( !isOpen() ) [[unlikely]]
+	{
+		reportError( EBADF );
+		return false;
+	}
+
+	const int transferred = exchange( messages );
 
-	std::lock_guard _{ m_lastErrMtx };
-	m_lastError = ::strerror_r( e, err.data(), err.size() );
+	if( transferred < 0 ) [[unlikely]]
+	{
+		reportError( -transferred );
+		return false;
+	}
+
+	if( static_cast< std::size_t >( transferred ) != messages.size() ) [[unlikely]]
+	{
+		reportError( EIO ); // The adapter stopped early without reporting an error
+		return false;
+	}
+
+	return true;
 }
 
-void v1::BusController::checkFunc()
+int v1::BusController::exchange( std::span< Transaction::Message > messages )
 {
-	std::uint64_t funcs{};
+#ifdef PBL_I2C_TELEMETRY
+	using Clock = std::chrono::steady_clock;
+
+	const auto waitStart = Clock::now();
+	std::unique_lock lock{ m_busMtx };
+
+	const auto transferStart = Clock::now();
+	const int transferred = m_transport->transfer( messages );
+	const auto transferEnd = Clock::now();
+
+	lock.unlock();
 
-	if( ::ioctl( m_fd, I2C_FUNCS, &funcs ) < 0 ) [[unlikely]]
+	std::optional< utils::ErrorCode > error;
+	if( transferred < 0 ) [[unlikely]]
 	{
-		return reportError();
+		error = toErrorCode( -transferred );
 	}
+	else if( static_cast< std::size_t >( transferred ) != messages.size() ) [[unlikely]]
+	{
+		error = utils::ErrorCode::DEVICE_NOT_RESPONDING;
+	}
+
+	m_telemetry->record( messages, transferred, error, transferStart - waitStart, transferEnd - transferStart );
+
+	return transferred;
+#else
+	std::lock_guard _{ m_busMtx };
+	return m_transport->transfer( messages );
+#endif
+}
 
-	std::cerr << "Supported funcions are: " << std::hex << funcs << std::endl;
+BusTelemetry::Snapshot v1::BusController::telemetry() const
+{
+#ifdef PBL_I2C_TELEMETRY
+	return m_telemetry->snapshot();
+#else
+	return {};
+#endif
+}
+
+std::optional< BusTelemetry::DeviceStatistics > v1::BusController::telemetry( [[maybe_unused]] const std::uint8_t deviceAddr ) const
+{
+#ifdef PBL_I2C_TELEMETRY
+	return m_telemetry->snapshot( deviceAddr );
+#else
+	return std::nullopt;
+#endif
+}
 
-	const auto checkLambda = [ &funcs ]( const auto& element ) { return check( funcs, element ); };
-	const bool rslt = std::ranges::all_of( kFuncsToCheck, checkLambda );
+void v1::BusController::resetTelemetry() noexcept
+{
+#ifdef PBL_I2C_TELEMETRY
+	m_telemetry->reset();
+#endif
+}
 
-	if( !rslt )
+std::string v1::BusController::lastError() const
+{
+	const int error = m_lastErrno.load( std::memory_order_relaxed );
+	if( error == 0 )
 	{
-		std::cerr << "Some functions are not supported" << std::endl;
+		return {};
 	}
+
+	std::array< char, 256 > err{};
+	return ::strerror_r( error, err.data(), err.size() );
 }
 
-static_assert( std::is_same_v< __u8, std::uint8_t >, "__u8 definition differs from std::uint8_t definition." );
-static_assert( std::is_same_v< unsigned int, std::uint32_t >,
-			   "unsigned int definition differs from std::uint32_t definition." );
+std::optional< utils::ErrorCode > v1::BusController::lastErrorCode() const noexcept
+{
+	const int error = m_lastErrno.load( std::memory_order_relaxed );
+	return error == 0 ? std::nullopt : std::optional{ toErrorCode( error ) };
+}
 
 } // namespace pbl::i2c
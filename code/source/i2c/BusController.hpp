@@ -1,7 +1,11 @@
 #ifndef PBL_I2C_BUS_CONTROLLER_HPP__
 #define PBL_I2C_BUS_CONTROLLER_HPP__
 
+#include "Transport.hpp"
+#include "Transaction.hpp"
+#include "BusTelemetry.hpp"
 #include <utils/Counter.hpp>
+#include <utils/ErrorCode.hpp>
 
 // C++
 #include <bit>
@@ -12,8 +16,9 @@
 #include <atomic>
 #include <string>
 #include <chrono>
+#include <memory>
 #include <cstdint>
-#include <shared_mutex>
+#include <optional>
 
 namespace pbl::i2c
 {
@@ -28,6 +33,14 @@ inline namespace v1
  * Say, 0 & 1 are available.
  * Then, each bus could be scanned to see what all device addresses exist on each bus.
  * i2cdetect -y 0 or with i2cdetect -y -r 0
+ *
+ * The actual transfers are delegated to a Transport, by default the Linux i2c-dev one. Passing
+ * a SimulatedBus instead runs every IC controller against in-memory device models.
+ *
+ * Register reads and writes don't allocate: write payloads are assembled on the stack and failures
+ * only record the errno value, its description is built when lastError is called.
+ *
+ * With PBL_I2C_TELEMETRY every transfer is accounted per device address, see BusTelemetry.
  * 
  * @todo Rename to BusController
  * 
@@ -36,10 +49,13 @@ inline namespace v1
 class BusController : public utils::Counter< BusController >
 {
 public:
-	/// Default ctor opens a file descriptor.
+	/// Default ctor opens the Linux i2c-dev device, i.e. "/dev/i2c-1".
 	explicit BusController( const std::string& busName );
 
-	/// Default dtor, closes file m_fd file.
+	/// Uses the given transport for all transfers, i.e. a SimulatedBus.
+	explicit BusController( std::unique_ptr< Transport > transport );
+
+	/// Default dtor, releases the transport.
 	virtual ~BusController();
 
 	/// Returns the OS name of the physical bus name
@@ -48,6 +64,9 @@ public:
 	/// Returns whether the I2C is open on the device.
 	[[nodiscard]] bool isOpen() const { return m_open.load(); }
 
+	/// Returns the transport performing the transfers, i.e. to query the LinuxTransport path selection.
+	[[nodiscard]] const Transport* transport() const noexcept { return m_transport.get(); }
+
 	/**
      * @brief Read a single byte from specified register
      * 
@@ -166,12 +185,31 @@ public:
 	bool
 	write( const std::uint8_t deviceAddr, const std::uint8_t reg, const std::uint8_t* data, const std::uint8_t size );
 
-	/// An accessor to the last error
-	[[nodiscard]] std::string lastError() const
-	{
-		std::shared_lock _{ m_lastErrMtx };
-		return m_lastError;
-	}
+	/**
+	 * @brief Submits all queued operations of a transaction as a single I2C_RDWR request.
+	 *
+	 * All messages are handed to the transport as one combined transfer (one ioctl on Linux),
+	 * the outcome of each operation can be queried afterwards using Transaction::result.
+	 *
+	 * @param transaction The transaction to submit, must hold at most Transaction::kMaxMessages messages.
+	 * @return true if every operation was transferred, false otherwise.
+	 */
+	[[nodiscard]] bool submit( Transaction& transaction );
+
+	/// Returns the description of the last error, empty if no transfer has failed so far.
+	[[nodiscard]] std::string lastError() const;
+
+	/// Returns the last error mapped to a library error code, std::nullopt if no transfer has failed so far.
+	[[nodiscard]] std::optional< utils::ErrorCode > lastErrorCode() const noexcept;
+
+	/// Returns the telemetry of all devices addressed so far, always empty without PBL_I2C_TELEMETRY.
+	[[nodiscard]] BusTelemetry::Snapshot telemetry() const;
+
+	/// Returns the telemetry of a single device, std::nullopt if never addressed or without PBL_I2C_TELEMETRY.
+	[[nodiscard]] std::optional< BusTelemetry::DeviceStatistics > telemetry( const std::uint8_t deviceAddr ) const;
+
+	/// Clears the telemetry counters.
+	void resetTelemetry() noexcept;
 
 	/// Puts asleep calling thread for specified sleep time in milliseconds
 	void sleep( const std::chrono::milliseconds sleepTimeMs );
@@ -186,17 +224,14 @@ private:
 	BusController operator=( const BusController& ) = delete;
 	BusController operator=( BusController&& ) = delete;
 
-	/// Retrieves error buffer
-	void reportError();
+	/// Performs a combined transfer under the bus lock, reports the error on failure.
+	[[nodiscard]] bool transfer( std::span< Transaction::Message > messages );
 
-	/// Requesting the bus for capabilities/features/functionality
-	void checkFunc();
+	/// Hands the messages to the transport under the bus lock and records the telemetry, returns the transport result.
+	[[nodiscard]] int exchange( std::span< Transaction::Message > messages );
 
-	void setLastError( std::string&& errorMessage )
-	{
-		std::lock_guard _{ m_lastErrMtx };
-		m_lastError = std::move( errorMessage );
-	}
+	/// Records the given errno value as the last error.
+	void reportError( const int error ) noexcept { m_lastErrno.store( error, std::memory_order_relaxed ); }
 
 	// The idea is to keep track of what IC's are we driving, haven't
 	// we by accident assigned the same address to 2 or more ICs?
@@ -207,11 +242,14 @@ private:
 	const std::string m_busName; //!< I2C Bus name, i.e. "/dev/i2c-1"
 	std::atomic_bool m_open{ false }; //!< Indicates whether the I2C bus is open
 
-	mutable std::mutex m_fdMtx; //!< Locks the read write operations
-	int m_fd{ -1 }; //!< TBW
+	mutable std::mutex m_busMtx; //!< Locks the read write operations
+	const std::unique_ptr< Transport > m_transport; //!< Performs the transfers
+
+	std::atomic_int m_lastErrno{ 0 }; //!< The errno value of the last failure, 0 if none
 
-	mutable std::shared_mutex m_lastErrMtx; //!< Locks the last_error string operations
-	std::string m_lastError; //<! TBW
+#ifdef PBL_I2C_TELEMETRY
+	const std::unique_ptr< BusTelemetry > m_telemetry; //!< Per-device counters, recorded without locking
+#endif
 };
 
 } // namespace v1
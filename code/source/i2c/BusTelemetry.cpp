@@ -0,0 +1,191 @@
+/**
+ *  @brief Implementation of BusTelemetry class, per-device transfer counters and latency histograms of an I2C bus.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "BusTelemetry.hpp"
+
+// C++
+#include <bit>
+#include <bitset>
+#include <cmath>
+#include <algorithm>
+
+namespace pbl::i2c
+{
+
+std::uint64_t v1::BusTelemetry::Histogram::count() const noexcept
+{
+	std::uint64_t total{};
+	for( const auto samples : buckets )
+	{
+		total += samples;
+	}
+
+	return total;
+}
+
+std::chrono::nanoseconds v1::BusTelemetry::Histogram::quantile( const double q ) const noexcept
+{
+	const auto total = count();
+	if( total == 0 )
+	{
+		return {};
+	}
+
+	const auto rank = static_cast< std::uint64_t >( std::ceil( std::clamp( q, 0.0, 1.0 ) * static_cast< double >( total ) ) );
+
+	std::uint64_t seen{};
+	for( std::size_t i = 0; i < buckets.size(); ++i )
+	{
+		seen += buckets[ i ];
+		if( seen >= std::max< std::uint64_t >( rank, 1 ) )
+		{
+			return std::chrono::nanoseconds{ i == 0 ? 0 : std::int64_t{ 1 } << i };
+		}
+	}
+
+	return std::chrono::nanoseconds{ std::int64_t{ 1 } << buckets.size() };
+}
+
+std::size_t v1::BusTelemetry::bucket( const std::chrono::nanoseconds duration ) noexcept
+{
+	const auto ns = static_cast< std::uint64_t >( std::max< std::int64_t >( duration.count(), 0 ) );
+	return std::min< std::size_t >( static_cast< std::size_t >( std::bit_width( ns ) ), kLatencyBuckets - 1 );
+}
+
+void v1::BusTelemetry::record( const std::span< const Transaction::Message > messages,
+							   const int transferred,
+							   const std::optional< utils::ErrorCode > error,
+							   const std::chrono::nanoseconds lockWait,
+							   const std::chrono::nanoseconds transferTime ) noexcept
+{
+	constexpr auto kOrder = std::memory_order_relaxed;
+
+	// Bytes of the messages that made it onto the bus
+	const auto completed = static_cast< std::size_t >( std::max( transferred, 0 ) );
+	for( std::size_t i = 0; i < messages.size() && i < completed; ++i )
+	{
+		const auto& message = messages[ i ];
+		if( message.address >= kAddressCount ) [[unlikely]]
+		{
+			continue;
+		}
+
+		auto& device = m_devices[ message.address ];
+		( message.read ? device.bytesRead : device.bytesWritten ).fetch_add( message.buffer.size(), kOrder );
+	}
+
+	// Transfer wide accounting, once per addressed device
+	std::bitset< kAddressCount > addressed;
+	for( const auto& message : messages )
+	{
+		if( message.address < kAddressCount )
+		{
+			addressed.set( message.address );
+		}
+	}
+
+	const auto transferBucket = bucket( transferTime );
+	const auto lockBucket = bucket( lockWait );
+
+	for( std::size_t address = 0; address < kAddressCount; ++address )
+	{
+		if( !addressed.test( address ) )
+		{
+			continue;
+		}
+
+		auto& device = m_devices[ address ];
+		device.transfers.fetch_add( 1, kOrder );
+		device.transferLatency[ transferBucket ].fetch_add( 1, kOrder );
+		device.lockWait[ lockBucket ].fetch_add( 1, kOrder );
+
+		if( error ) [[unlikely]]
+		{
+			device.failures.fetch_add( 1, kOrder );
+			device.failuresByCode[ std::to_underlying( *error ) ].fetch_add( 1, kOrder );
+		}
+	}
+}
+
+auto v1::BusTelemetry::snapshot() const -> Snapshot
+{
+	Snapshot devices;
+	for( std::size_t address = 0; address < kAddressCount; ++address )
+	{
+		if( m_devices[ address ].transfers.load( std::memory_order_relaxed ) > 0 )
+		{
+			devices.push_back( load( static_cast< std::uint8_t >( address ) ) );
+		}
+	}
+
+	return devices;
+}
+
+auto v1::BusTelemetry::snapshot( const std::uint8_t address ) const -> std::optional< DeviceStatistics >
+{
+	if( address >= kAddressCount || m_devices[ address ].transfers.load( std::memory_order_relaxed ) == 0 )
+	{
+		return std::nullopt;
+	}
+
+	return load( address );
+}
+
+void v1::BusTelemetry::reset() noexcept
+{
+	for( auto& device : m_devices )
+	{
+		device.transfers.store( 0, std::memory_order_relaxed );
+		device.bytesRead.store( 0, std::memory_order_relaxed );
+		device.bytesWritten.store( 0, std::memory_order_relaxed );
+		device.failures.store( 0, std::memory_order_relaxed );
+
+		for( auto& counter : device.failuresByCode )
+		{
+			counter.store( 0, std::memory_order_relaxed );
+		}
+
+		for( auto& counter : device.transferLatency )
+		{
+			counter.store( 0, std::memory_order_relaxed );
+		}
+
+		for( auto& counter : device.lockWait )
+		{
+			counter.store( 0, std::memory_order_relaxed );
+		}
+	}
+}
+
+auto v1::BusTelemetry::load( const std::uint8_t address ) const noexcept -> DeviceStatistics
+{
+	constexpr auto kOrder = std::memory_order_relaxed;
+	const auto& device = m_devices[ address ];
+
+	DeviceStatistics stats;
+	stats.address = address;
+	stats.transfers = device.transfers.load( kOrder );
+	stats.bytesRead = device.bytesRead.load( kOrder );
+	stats.bytesWritten = device.bytesWritten.load( kOrder );
+	stats.failures = device.failures.load( kOrder );
+
+	for( std::size_t i = 0; i < kErrorCodeCount; ++i )
+	{
+		stats.failuresByCode[ i ] = device.failuresByCode[ i ].load( kOrder );
+	}
+
+	for( std::size_t i = 0; i < kLatencyBuckets; ++i )
+	{
+		stats.transferLatency.buckets[ i ] = device.transferLatency[ i ].load( kOrder );
+		stats.lockWait.buckets[ i ] = device.lockWait[ i ].load( kOrder );
+	}
+
+	return stats;
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,148 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of BusTelemetry class, per-device transfer counters and latency histograms of an I2C bus.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_BUS_TELEMETRY_HPP__
+#define PBL_I2C_BUS_TELEMETRY_HPP__
+
+#include "Transaction.hpp"
+#include <utils/ErrorCode.hpp>
+
+// C++
+#include <span>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+/**
+ * @class BusTelemetry
+ * @brief Collects transfer statistics of an I2C bus keyed by the 7-bit device address.
+ *
+ * For every device the telemetry counts the transfers it took part in, the bytes read and written,
+ * the failures by error code and two latency histograms: the time spent in the transport (the ioctl
+ * on Linux) and the time spent waiting for the bus lock. A combined transfer addressing several
+ * devices is accounted to each of them.
+ *
+ * Recording only performs relaxed atomic increments, it never locks nor allocates. A snapshot can
+ * be taken from any thread at any time, the counters of a transfer recorded concurrently may be
+ * partially included.
+ *
+ * The BusController records into its telemetry only when the library is built with PBL_I2C_TELEMETRY
+ * (the CMake option of the same name), otherwise no timing or accounting code is compiled in.
+ */
+class BusTelemetry final
+{
+public:
+	/// Latency histogram bucket i counts durations in [2^(i-1), 2^i) ns, bucket 0 counts 0 ns, the last one is open ended.
+	static constexpr std::size_t kLatencyBuckets{ 32 };
+
+	/// Number of 7-bit device addresses.
+	static constexpr std::size_t kAddressCount{ 128 };
+
+	/// Number of error codes, NOT_IMPLEMENTED is the last enumerator.
+	static constexpr std::size_t kErrorCodeCount{ std::to_underlying( utils::ErrorCode::NOT_IMPLEMENTED ) + 1 };
+
+#ifdef PBL_I2C_TELEMETRY
+	static constexpr bool kEnabled{ true };
+#else
+	static constexpr bool kEnabled{ false };
+#endif
+
+	struct Histogram
+	{
+		std::array< std::uint64_t, kLatencyBuckets > buckets{};
+
+		/// Returns the number of recorded samples.
+		[[nodiscard]] std::uint64_t count() const noexcept;
+
+		/// Returns the upper bound of the bucket containing the given quantile (0.0 - 1.0) of the samples.
+		[[nodiscard]] std::chrono::nanoseconds quantile( const double q ) const noexcept;
+	};
+
+	struct DeviceStatistics
+	{
+		std::uint8_t address{};
+		std::uint64_t transfers{}; //!< Transfers addressing the device, successful or not.
+		std::uint64_t bytesRead{}; //!< Bytes read from the device, including partially completed transfers.
+		std::uint64_t bytesWritten{}; //!< Bytes written to the device, register pointers included.
+		std::uint64_t failures{}; //!< Failed transfers addressing the device.
+		std::array< std::uint64_t, kErrorCodeCount > failuresByCode{}; //!< Indexed by utils::ErrorCode.
+		Histogram transferLatency; //!< Time spent in the transport.
+		Histogram lockWait; //!< Time spent waiting for the bus lock.
+
+		/// Returns the number of failures with the given error code.
+		[[nodiscard]] std::uint64_t failuresWith( const utils::ErrorCode code ) const noexcept
+		{
+			return failuresByCode[ std::to_underlying( code ) ];
+		}
+	};
+
+	/// Statistics of the devices that were addressed at least once, ordered by address.
+	using Snapshot = std::vector< DeviceStatistics >;
+
+	/// Returns the histogram bucket of the given duration.
+	[[nodiscard]] static std::size_t bucket( const std::chrono::nanoseconds duration ) noexcept;
+
+	/**
+	 * @brief Accounts a transfer to every device it addressed.
+	 *
+	 * @param messages The messages of the transfer.
+	 * @param transferred Number of messages transferred, negative if the transfer failed entirely.
+	 * @param error The error of the transfer, std::nullopt if all messages were transferred.
+	 * @param lockWait Time spent waiting for the bus lock.
+	 * @param transferTime Time spent in the transport.
+	 */
+	void record( const std::span< const Transaction::Message > messages,
+				 const int transferred,
+				 const std::optional< utils::ErrorCode > error,
+				 const std::chrono::nanoseconds lockWait,
+				 const std::chrono::nanoseconds transferTime ) noexcept;
+
+	/// Returns the current statistics of the addressed devices.
+	[[nodiscard]] Snapshot snapshot() const;
+
+	/// Returns the current statistics of a single device, std::nullopt if it was never addressed.
+	[[nodiscard]] std::optional< DeviceStatistics > snapshot( const std::uint8_t address ) const;
+
+	/// Clears all counters, transfers recorded concurrently may be partially kept.
+	void reset() noexcept;
+
+private:
+	using Counter = std::atomic< std::uint64_t >;
+
+	/// Counters of one device, aligned to keep devices on separate cache lines.
+	struct alignas( 64 ) DeviceCounters
+	{
+		Counter transfers;
+		Counter bytesRead;
+		Counter bytesWritten;
+		Counter failures;
+		std::array< Counter, kErrorCodeCount > failuresByCode;
+		std::array< Counter, kLatencyBuckets > transferLatency;
+		std::array< Counter, kLatencyBuckets > lockWait;
+	};
+
+	/// Copies the counters of a device.
+	[[nodiscard]] DeviceStatistics load( const std::uint8_t address ) const noexcept;
+
+private:
+	std::array< DeviceCounters, kAddressCount > m_devices{};
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_BUS_TELEMETRY_HPP__
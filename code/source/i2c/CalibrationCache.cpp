@@ -0,0 +1,188 @@
+/**
+ *  @brief Implementation of CalibrationCache class, persists factory calibration data of I2C devices on disk.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "CalibrationCache.hpp"
+
+// C++
+#include <array>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <system_error>
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+constexpr std::array< char, 4 > kMagic{ 'P', 'B', 'L', 'C' };
+constexpr std::uint8_t kVersion{ 1 };
+
+// Magic, version, chip id, size (LE 16-bit) and checksum (LE 32-bit) precede the data
+constexpr std::size_t kHeaderSize{ kMagic.size() + 1 + 1 + 2 + 4 };
+
+/// FNV-1a hash of the data, guards against truncated or corrupted files.
+[[nodiscard]] constexpr std::uint32_t checksum( std::span< const std::uint8_t > data ) noexcept
+{
+	std::uint32_t hash{ 2166136261u };
+	for( const auto byte : data )
+	{
+		hash = ( hash ^ byte ) * 16777619u;
+	}
+
+	return hash;
+}
+
+/// Replaces the characters that can't appear in a file name, i.e. "/dev/i2c-1" becomes "dev_i2c-1".
+[[nodiscard]] std::string sanitize( const std::string_view name )
+{
+	std::string sanitized;
+	for( const char c : name )
+	{
+		const bool safe = ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c >= '0' && c <= '9' ) ||
+						  c == '-' || c == '.';
+
+		if( safe )
+		{
+			sanitized += c;
+		}
+		else if( !sanitized.empty() && sanitized.back() != '_' )
+		{
+			sanitized += '_';
+		}
+	}
+
+	return sanitized;
+}
+
+} // namespace
+
+v1::CalibrationCache::CalibrationCache( std::filesystem::path directory )
+	: m_directory{ std::move( directory ) }
+{ }
+
+std::filesystem::path v1::CalibrationCache::path( const Key& key ) const
+{
+	constexpr std::string_view kHex{ "0123456789ABCDEF" };
+	const std::array< char, 2 > address{ kHex[ key.address >> 4 ], kHex[ key.address & 0x0F ] };
+
+	return m_directory / ( sanitize( key.part ) + '-' + sanitize( key.bus ) + "-0x" +
+						   std::string{ address.data(), address.size() } + ".cal" );
+}
+
+bool v1::CalibrationCache::load( const Key& key, const std::uint8_t chipId, std::span< std::uint8_t > data ) const
+{
+	std::ifstream file{ path( key ), std::ios::binary };
+	if( !file )
+	{
+		return false;
+	}
+
+	std::array< std::uint8_t, kHeaderSize > header{};
+	file.read( reinterpret_cast< char* >( header.data() ), header.size() );
+	if( file.gcount() != static_cast< std::streamsize >( header.size() ) )
+	{
+		return false;
+	}
+
+	const auto size = static_cast< std::size_t >( header[ 6 ] | ( header[ 7 ] << 8 ) );
+	const auto storedChecksum = static_cast< std::uint32_t >( header[ 8 ] | ( header[ 9 ] << 8 ) | ( header[ 10 ] << 16 ) |
+															  ( static_cast< std::uint32_t >( header[ 11 ] ) << 24 ) );
+
+	const bool valid = std::ranges::equal( kMagic, std::span{ header }.first< 4 >(), {}, {}, []( const std::uint8_t b ) {
+		return static_cast< char >( b );
+	} ) && header[ 4 ] == kVersion && header[ 5 ] == chipId && size == data.size();
+
+	if( !valid )
+	{
+		return false;
+	}
+
+	// Read into a scratch buffer first, data stays untouched unless the entry is valid
+	std::array< std::uint8_t, 256 > buffer{};
+	if( size > buffer.size() ) [[unlikely]]
+	{
+		return false;
+	}
+
+	file.read( reinterpret_cast< char* >( buffer.data() ), static_cast< std::streamsize >( size ) );
+	const auto payload = std::span{ buffer }.first( size );
+
+	if( file.gcount() != static_cast< std::streamsize >( size ) || checksum( payload ) != storedChecksum )
+	{
+		return false;
+	}
+
+	std::ranges::copy( payload, data.begin() );
+	return true;
+}
+
+bool v1::CalibrationCache::store( const Key& key, const std::uint8_t chipId, std::span< const std::uint8_t > data ) const
+{
+	if( data.size() > 256 ) [[unlikely]]
+	{
+		return false;
+	}
+
+	std::error_code ec;
+	std::filesystem::create_directories( m_directory, ec );
+	if( ec )
+	{
+		return false;
+	}
+
+	const auto size = static_cast< std::uint16_t >( data.size() );
+	const auto sum = checksum( data );
+
+	std::array< std::uint8_t, kHeaderSize > header{ static_cast< std::uint8_t >( kMagic[ 0 ] ),
+													static_cast< std::uint8_t >( kMagic[ 1 ] ),
+													static_cast< std::uint8_t >( kMagic[ 2 ] ),
+													static_cast< std::uint8_t >( kMagic[ 3 ] ),
+													kVersion,
+													chipId,
+													static_cast< std::uint8_t >( size & 0xFF ),
+													static_cast< std::uint8_t >( size >> 8 ),
+													static_cast< std::uint8_t >( sum & 0xFF ),
+													static_cast< std::uint8_t >( ( sum >> 8 ) & 0xFF ),
+													static_cast< std::uint8_t >( ( sum >> 16 ) & 0xFF ),
+													static_cast< std::uint8_t >( sum >> 24 ) };
+
+	// Written next to the entry and renamed over it, a reader never sees a partially written file
+	const auto target = path( key );
+	auto temporary = target;
+	temporary += ".tmp";
+
+	{
+		std::ofstream file{ temporary, std::ios::binary | std::ios::trunc };
+		file.write( reinterpret_cast< const char* >( header.data() ), header.size() );
+		file.write( reinterpret_cast< const char* >( data.data() ), static_cast< std::streamsize >( data.size() ) );
+		if( !file.flush() )
+		{
+			std::filesystem::remove( temporary, ec );
+			return false;
+		}
+	}
+
+	std::filesystem::rename( temporary, target, ec );
+	if( ec )
+	{
+		std::filesystem::remove( temporary, ec );
+		return false;
+	}
+
+	return true;
+}
+
+bool v1::CalibrationCache::erase( const Key& key ) const
+{
+	std::error_code ec;
+	return std::filesystem::remove( path( key ), ec );
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,85 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of CalibrationCache class, persists factory calibration data of I2C devices on disk.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_CALIBRATION_CACHE_HPP__
+#define PBL_I2C_CALIBRATION_CACHE_HPP__
+
+// C++
+#include <span>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+/**
+ * @class CalibrationCache
+ * @brief Stores the factory calibration of devices in a directory, one file per part, bus and address.
+ *
+ * Drivers that read factory trim when constructed (i.e. BMP180Controller) can take a cache, the first
+ * run reads the calibration from the device and stores it, later runs only read the chip id and a few
+ * calibration bytes and load the rest from disk. An entry is used only if the chip id, the size and the
+ * checksum of the data match.
+ *
+ * Example usage:
+ * @code
+ * CalibrationCache cache{ "/var/cache/protobridge" };
+ * BMP180Controller bmp180{ busController, cache };
+ * @endcode
+ *
+ * @note The chip id identifies the part, not the individual sensor. Drivers compare a few calibration
+ * bytes read from the device with the loaded entry (BMP180Controller reads AC1 and AC2), so a sensor
+ * swapped for another one of the same part reads its own calibration and replaces the entry.
+ */
+class CalibrationCache final
+{
+public:
+	/// Identifies an entry.
+	struct Key
+	{
+		std::string_view part; //!< i.e. "BMP180"
+		std::string_view bus; //!< The bus name, i.e. "/dev/i2c-1"
+		std::uint8_t address{};
+	};
+
+	/// Uses the given directory, it is created when the first entry is stored.
+	explicit CalibrationCache( std::filesystem::path directory );
+
+	/// Returns the cache directory.
+	[[nodiscard]] const auto& directory() const noexcept { return m_directory; }
+
+	/// Returns the file holding the entry of the key.
+	[[nodiscard]] std::filesystem::path path( const Key& key ) const;
+
+	/**
+	 * @brief Loads an entry.
+	 *
+	 * @param key The entry to load.
+	 * @param chipId The chip id just read from the device.
+	 * @param data Receives the calibration data, its size must match the stored one.
+	 * @return true if the entry exists and is valid, data is left untouched otherwise.
+	 */
+	[[nodiscard]] bool load( const Key& key, const std::uint8_t chipId, std::span< std::uint8_t > data ) const;
+
+	/// Stores an entry replacing the previous one, the file is replaced atomically. Returns false on I/O failures.
+	bool store( const Key& key, const std::uint8_t chipId, std::span< const std::uint8_t > data ) const;
+
+	/// Removes an entry, returns false if there was none.
+	bool erase( const Key& key ) const;
+
+private:
+	std::filesystem::path m_directory;
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_CALIBRATION_CACHE_HPP__
@@ -0,0 +1,337 @@
+/**
+ *  @brief Implementation of DeviceRegistry class, discovers the devices attached to the I2C buses of the system.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "DeviceRegistry.hpp"
+#include "LinuxTransport.hpp"
+
+// C++
+#include <array>
+#include <thread>
+#include <charconv>
+#include <algorithm>
+#include <system_error>
+
+// C
+extern "C" {
+#include <linux/i2c.h>
+}
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+/// The address range a part can be strapped to.
+struct AddressRange
+{
+	Part part;
+	std::uint8_t first;
+	std::uint8_t last;
+};
+
+constexpr std::array kAddressRanges{ AddressRange{ Part::MCP23017, 0x20, 0x27 },
+									 AddressRange{ Part::PCA9685, 0x40, 0x47 },
+									 AddressRange{ Part::SHT31, 0x44, 0x45 },
+									 AddressRange{ Part::LM75, 0x48, 0x4F },
+									 AddressRange{ Part::TMP102, 0x48, 0x4B },
+									 AddressRange{ Part::ADS1015, 0x48, 0x4B },
+									 AddressRange{ Part::MPU6050, 0x68, 0x69 },
+									 AddressRange{ Part::MPU9250, 0x68, 0x69 },
+									 AddressRange{ Part::BMP180, 0x77, 0x77 } };
+
+/// A chip id register and the value that identifies a part.
+struct Fingerprint
+{
+	Part part;
+	std::uint8_t reg;
+	std::uint8_t id;
+};
+
+constexpr std::array kFingerprints{ Fingerprint{ Part::BMP180, 0xD0, 0x55 },
+									Fingerprint{ Part::MPU6050, 0x75, 0x68 },
+									Fingerprint{ Part::MPU9250, 0x75, 0x71 },
+									Fingerprint{ Part::MPU9250, 0x75, 0x73 } }; // MPU9255
+
+constexpr std::string_view kAdapterPrefix{ "i2c-" };
+
+/// Returns whether the address belongs to the ranges i2cdetect probes with a read, EEPROMs and write only devices live there.
+[[nodiscard]] constexpr bool readProbed( const std::uint8_t address ) noexcept
+{
+	return ( address >= 0x30 && address <= 0x37 ) || ( address >= 0x50 && address <= 0x5F );
+}
+
+/// Returns whether the adapter can put an empty write on the bus, SMBus-only controllers without quick command can't.
+[[nodiscard]] bool quickWriteSupported( const BusController& busController ) noexcept
+{
+	// Only i2c-dev adapters report their functionality, the other transports accept any message
+	const auto* pLinux = dynamic_cast< const LinuxTransport* >( busController.transport() );
+	return pLinux == nullptr || pLinux->supports( I2C_FUNC_SMBUS_QUICK ) || pLinux->supports( I2C_FUNC_I2C );
+}
+
+/// Returns whether a device acknowledges its address, AUTO falls back to a read when quick writes are unsupported.
+[[nodiscard]] bool
+probe( BusController& busController, const std::uint8_t address, const ProbeMode mode, const bool quickWrite )
+{
+	const bool read = mode == ProbeMode::READ_BYTE ||
+					  ( mode == ProbeMode::AUTO && ( readProbed( address ) || !quickWrite ) );
+	if( read )
+	{
+		std::array< std::uint8_t, 1 > data{};
+		return busController.read( address, data ) == 1;
+	}
+
+	return busController.write( address, std::span< const std::uint8_t >{} );
+}
+
+/// Identifies the part by its chip id register, UNKNOWN if none of the candidates has a matching id.
+[[nodiscard]] Part identify( BusController& busController,
+							 const std::uint8_t address,
+							 const std::span< const Part > candidates )
+{
+	for( const auto& fingerprint : kFingerprints )
+	{
+		if( std::ranges::find( candidates, fingerprint.part ) == candidates.end() )
+		{
+			continue;
+		}
+
+		std::uint8_t id{};
+		if( busController.read( address, fingerprint.reg, id ) && id == fingerprint.id )
+		{
+			return fingerprint.part;
+		}
+	}
+
+	return Part::UNKNOWN;
+}
+
+/// Returns whether the part can only be identified by its chip id register.
+[[nodiscard]] bool hasFingerprint( const Part part ) noexcept
+{
+	return std::ranges::find( kFingerprints, part, &Fingerprint::part ) != kFingerprints.end();
+}
+
+/// Returns the bus number of an i2c-dev adapter name, i.e. 1 for "i2c-1".
+[[nodiscard]] std::optional< unsigned > busNumber( const std::string_view name ) noexcept
+{
+	if( !name.starts_with( kAdapterPrefix ) )
+	{
+		return std::nullopt;
+	}
+
+	const auto digits = name.substr( kAdapterPrefix.size() );
+	unsigned number{};
+	const auto [ end, ec ] = std::from_chars( digits.data(), digits.data() + digits.size(), number );
+	if( digits.empty() || ec != std::errc{} || end != digits.data() + digits.size() )
+	{
+		return std::nullopt;
+	}
+
+	return number;
+}
+
+} // namespace
+
+std::string_view v1::toStringView( const Part part ) noexcept
+{
+	switch( part )
+	{
+		case Part::LM75: return "LM75";
+		case Part::TMP102: return "TMP102";
+		case Part::SHT31: return "SHT31";
+		case Part::BMP180: return "BMP180";
+		case Part::MPU6050: return "MPU6050";
+		case Part::MPU9250: return "MPU9250";
+		case Part::ADS1015: return "ADS1015";
+		case Part::PCA9685: return "PCA9685";
+		case Part::MCP23017: return "MCP23017";
+		case Part::UNKNOWN: break;
+	}
+
+	return "UNKNOWN";
+}
+
+std::vector< std::string > v1::DeviceRegistry::enumerate( const std::filesystem::path& directory )
+{
+	std::vector< std::pair< unsigned, std::string > > adapters;
+
+	std::error_code ec;
+	for( const auto& entry : std::filesystem::directory_iterator{ directory, ec } )
+	{
+		if( const auto number = busNumber( entry.path().filename().native() ) )
+		{
+			adapters.emplace_back( *number, entry.path().string() );
+		}
+	}
+
+	std::ranges::sort( adapters );
+
+	std::vector< std::string > names;
+	names.reserve( adapters.size() );
+	for( auto& [ number, name ] : adapters )
+	{
+		names.push_back( std::move( name ) );
+	}
+
+	return names;
+}
+
+std::vector< v1::DiscoveredDevice > v1::DeviceRegistry::scan( BusController& busController,
+															  const DiscoveryOptions& options )
+{
+	std::vector< DiscoveredDevice > devices;
+	const bool quickWrite = quickWriteSupported( busController );
+
+	for( unsigned address = options.first; address <= options.last; ++address )
+	{
+		const auto addr = static_cast< std::uint8_t >( address );
+		if( !probe( busController, addr, options.probe, quickWrite ) )
+		{
+			continue;
+		}
+
+		DiscoveredDevice device{ .address = addr, .part = Part::UNKNOWN, .candidates = candidates( addr ) };
+
+		if( options.fingerprint )
+		{
+			device.part = identify( busController, addr, device.candidates );
+		}
+
+		// A single candidate is identified by address, unless it has a chip id that didn't match
+		if( device.part == Part::UNKNOWN && device.candidates.size() == 1 &&
+			!( options.fingerprint && hasFingerprint( device.candidates.front() ) ) )
+		{
+			device.part = device.candidates.front();
+		}
+
+		devices.push_back( std::move( device ) );
+	}
+
+	return devices;
+}
+
+v1::DeviceRegistry v1::DeviceRegistry::discover( const DiscoveryOptions& options )
+{
+	std::vector< std::unique_ptr< BusController > > buses;
+	for( const auto& name : enumerate() )
+	{
+		auto busController = std::make_unique< BusController >( name );
+		if( busController->isOpen() )
+		{
+			buses.push_back( std::move( busController ) );
+		}
+	}
+
+	return discover( std::move( buses ), options );
+}
+
+v1::DeviceRegistry v1::DeviceRegistry::discover( std::vector< std::unique_ptr< BusController > > buses,
+												 const DiscoveryOptions& options )
+{
+	std::vector< Bus > scanned( buses.size() );
+
+	{
+		// Every bus is scanned by its own thread, joined when leaving the scope
+		std::vector< std::jthread > scanners;
+		scanners.reserve( buses.size() );
+
+		for( std::size_t i = 0; i < buses.size(); ++i )
+		{
+			scanned[ i ].controller = std::move( buses[ i ] );
+			scanners.emplace_back( [ &bus = scanned[ i ], &options ] { bus.devices = scan( *bus.controller, options ); } );
+		}
+	}
+
+	return DeviceRegistry{ std::move( scanned ) };
+}
+
+std::vector< v1::Part > v1::DeviceRegistry::candidates( const std::uint8_t address )
+{
+	std::vector< Part > parts;
+	for( const auto& range : kAddressRanges )
+	{
+		if( address >= range.first && address <= range.last )
+		{
+			parts.push_back( range.part );
+		}
+	}
+
+	return parts;
+}
+
+std::unique_ptr< v1::ICBase >
+v1::DeviceRegistry::create( BusController& busController, const std::uint8_t address, const Part part )
+{
+	const auto parts = candidates( address );
+	if( std::ranges::find( parts, part ) == parts.end() ) [[unlikely]]
+	{
+		return nullptr;
+	}
+
+	switch( part )
+	{
+		case Part::LM75:
+			return std::make_unique< LM75Controller >( busController, static_cast< LM75Controller::Address >( address ) );
+		case Part::TMP102:
+			return std::make_unique< TMP102Controller >( busController,
+														 static_cast< TMP102Controller::Address >( address ) );
+		case Part::SHT31:
+			return std::make_unique< SHT31Controller >( busController, static_cast< SHT31Controller::Address >( address ) );
+		case Part::BMP180:
+			return std::make_unique< BMP180Controller >( busController,
+														 static_cast< BMP180Controller::Address >( address ) );
+		case Part::MPU6050:
+			return std::make_unique< MPU6050Controller >( busController,
+														  static_cast< MPU6050Controller::Address >( address ) );
+		case Part::MPU9250:
+			return std::make_unique< MPU9250Controller >( busController,
+														  static_cast< MPU9250Controller::Address >( address ) );
+		case Part::ADS1015:
+			return std::make_unique< ADS1015Controller >( busController,
+														  static_cast< ADS1015Controller::Address >( address ) );
+		case Part::PCA9685:
+			return std::make_unique< PCA9685Controller >( busController,
+														  static_cast< PCA9685Controller::Address >( address ) );
+		case Part::MCP23017:
+			return std::make_unique< MCP23017Controller >( busController,
+														   static_cast< MCP23017Controller::Address >( address ) );
+		case Part::UNKNOWN: break;
+	}
+
+	return nullptr;
+}
+
+std::optional< std::pair< v1::BusController*, std::uint8_t > > v1::DeviceRegistry::find( const Part part,
+																						  std::size_t n ) const
+{
+	for( const auto& bus : m_buses )
+	{
+		for( const auto& device : bus.devices )
+		{
+			if( device.part == part && n-- == 0 )
+			{
+				return std::pair{ bus.controller.get(), device.address };
+			}
+		}
+	}
+
+	return std::nullopt;
+}
+
+std::unique_ptr< v1::ICBase > v1::DeviceRegistry::create( const Part part, const std::size_t n ) const
+{
+	if( const auto found = find( part, n ) )
+	{
+		return create( *found->first, found->second, part );
+	}
+
+	return nullptr;
+}
+
+} // namespace pbl::i2c
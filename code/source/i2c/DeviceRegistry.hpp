@@ -0,0 +1,154 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of DeviceRegistry class, discovers the devices attached to the I2C buses of the system.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_DEVICE_REGISTRY_HPP__
+#define PBL_I2C_DEVICE_REGISTRY_HPP__
+
+#include "ICBase.hpp"
+#include "BusController.hpp"
+
+// C++
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <filesystem>
+#include <string_view>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+/// The parts the library provides a controller for.
+enum class Part : std::uint8_t
+{
+	UNKNOWN,
+	LM75,
+	TMP102,
+	SHT31,
+	BMP180,
+	MPU6050,
+	MPU9250,
+	ADS1015,
+	PCA9685,
+	MCP23017
+};
+
+/// Returns the name of the part, i.e. "MPU6050".
+[[nodiscard]] std::string_view toStringView( const Part part ) noexcept;
+
+/// How the presence of a device is probed, mirrors i2cdetect.
+enum class ProbeMode : std::uint8_t
+{
+	AUTO, //!< Read byte for 0x30-0x37, 0x50-0x5F (EEPROMs) and on adapters without quick write, else quick write.
+	QUICK, //!< An empty write, only the address is put on the bus.
+	READ_BYTE //!< A single byte read without a register.
+};
+
+struct DiscoveryOptions
+{
+	ProbeMode probe{ ProbeMode::AUTO };
+	bool fingerprint{ true }; //!< Reads the chip id registers of the parts that have one to identify them.
+	std::uint8_t first{ 0x08 }; //!< First probed address, 0x00-0x07 are reserved.
+	std::uint8_t last{ 0x77 }; //!< Last probed address, 0x78-0x7F are reserved.
+};
+
+/// A device that acknowledged its address.
+struct DiscoveredDevice
+{
+	std::uint8_t address{};
+	Part part{ Part::UNKNOWN }; //!< The identified part, UNKNOWN if several parts may sit at the address.
+	std::vector< Part > candidates; //!< The parts whose address range includes the address.
+};
+
+/**
+ * @class DeviceRegistry
+ * @brief Enumerates the I2C adapters of the system, scans them concurrently and constructs the controllers of the found parts.
+ *
+ * Each bus is scanned on its own thread, buses are independent so the startup time is the one of
+ * the slowest bus rather than the sum of all of them. Parts with a chip id register (BMP180,
+ * MPU6050, MPU9250) are identified by it, the others are identified by address when it is
+ * unambiguous. A device that could not be identified can still be constructed by naming its part.
+ *
+ * @code
+ * auto registry = DeviceRegistry::discover();
+ * if( auto imu = registry.create< MPU6050Controller >() )
+ * {
+ *     auto angles = imu->angles();
+ * }
+ * @endcode
+ *
+ * @note Probing writes to or reads from every address in range, like i2cdetect, some devices
+ *       may react to that. Scanning a bus records NACK failures in its BusController error and telemetry.
+ */
+class DeviceRegistry final
+{
+public:
+	struct Bus
+	{
+		std::unique_ptr< BusController > controller;
+		std::vector< DiscoveredDevice > devices; //!< Ordered by address.
+	};
+
+	/// Returns the i2c-dev adapters in the given directory ordered by bus number, i.e. "/dev/i2c-0", "/dev/i2c-1".
+	[[nodiscard]] static std::vector< std::string > enumerate( const std::filesystem::path& directory = "/dev" );
+
+	/// Probes every address of the options range on the given bus and identifies the responding devices.
+	[[nodiscard]] static std::vector< DiscoveredDevice > scan( BusController& busController,
+															   const DiscoveryOptions& options = {} );
+
+	/// Opens every enumerated adapter and scans them concurrently, adapters that fail to open are skipped.
+	[[nodiscard]] static DeviceRegistry discover( const DiscoveryOptions& options = {} );
+
+	/// Scans the given buses concurrently, i.e. SimulatedBus backed ones.
+	[[nodiscard]] static DeviceRegistry discover( std::vector< std::unique_ptr< BusController > > buses,
+												  const DiscoveryOptions& options = {} );
+
+	/// Returns the parts with a controller that may sit at the given address.
+	[[nodiscard]] static std::vector< Part > candidates( const std::uint8_t address );
+
+	/// Constructs the controller of a part at the given address, nullptr if the part can't sit at the address.
+	[[nodiscard]] static std::unique_ptr< ICBase >
+	create( BusController& busController, const std::uint8_t address, const Part part );
+
+	/// Returns the scanned buses.
+	[[nodiscard]] const auto& buses() const noexcept { return m_buses; }
+
+	/// Returns the bus and the address of the n-th discovered device identified as the given part.
+	[[nodiscard]] std::optional< std::pair< BusController*, std::uint8_t > > find( const Part part,
+																				   const std::size_t n = 0 ) const;
+
+	/// Constructs the controller of the n-th discovered device identified as the given part, nullptr if not found.
+	[[nodiscard]] std::unique_ptr< ICBase > create( const Part part, const std::size_t n = 0 ) const;
+
+	/// Constructs the typed controller of the n-th discovered device of its part, nullptr if not found.
+	template < typename Controller >
+	[[nodiscard]] std::unique_ptr< Controller > create( const std::size_t n = 0 ) const;
+
+private:
+	explicit DeviceRegistry( std::vector< Bus > buses ) noexcept
+		: m_buses{ std::move( buses ) }
+	{ }
+
+	/// Returns the part a controller type manages.
+	template < typename Controller >
+	static constexpr Part partOf() noexcept;
+
+private:
+	std::vector< Bus > m_buses;
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+
+#include "DeviceRegistry.ipp"
+
+#endif // PBL_I2C_DEVICE_REGISTRY_HPP__
@@ -0,0 +1,72 @@
+#ifndef PBL_I2C_DEVICE_REGISTRY_IPP__
+#define PBL_I2C_DEVICE_REGISTRY_IPP__
+
+#include "LM75Controller.hpp"
+#include "SHT31Controller.hpp"
+#include "BMP180Controller.hpp"
+#include "TMP102Controller.hpp"
+#include "ADS1015Controller.hpp"
+#include "MPU6050Controller.hpp"
+#include "MPU9250Controller.hpp"
+#include "PCA9685Controller.hpp"
+#include "MCP23017Controller.hpp"
+
+// C++
+#include <type_traits>
+
+namespace pbl::i2c
+{
+
+template < typename Controller >
+constexpr Part DeviceRegistry::partOf() noexcept
+{
+	if constexpr( std::is_same_v< Controller, LM75Controller > )
+	{
+		return Part::LM75;
+	}
+	else if constexpr( std::is_same_v< Controller, TMP102Controller > )
+	{
+		return Part::TMP102;
+	}
+	else if constexpr( std::is_same_v< Controller, SHT31Controller > )
+	{
+		return Part::SHT31;
+	}
+	else if constexpr( std::is_same_v< Controller, BMP180Controller > )
+	{
+		return Part::BMP180;
+	}
+	else if constexpr( std::is_same_v< Controller, MPU6050Controller > )
+	{
+		return Part::MPU6050;
+	}
+	else if constexpr( std::is_same_v< Controller, MPU9250Controller > )
+	{
+		return Part::MPU9250;
+	}
+	else if constexpr( std::is_same_v< Controller, ADS1015Controller > )
+	{
+		return Part::ADS1015;
+	}
+	else if constexpr( std::is_same_v< Controller, PCA9685Controller > )
+	{
+		return Part::PCA9685;
+	}
+	else
+	{
+		static_assert( std::is_same_v< Controller, MCP23017Controller >, "No part is registered for the controller" );
+		return Part::MCP23017;
+	}
+}
+
+template < typename Controller >
+std::unique_ptr< Controller > DeviceRegistry::create( const std::size_t n ) const
+{
+	// The part matches the controller type, the downcast is safe
+	auto controller = create( partOf< Controller >(), n );
+	return std::unique_ptr< Controller >{ static_cast< Controller* >( controller.release() ) };
+}
+
+} // namespace pbl::i2c
+
+#endif // PBL_I2C_DEVICE_REGISTRY_IPP__
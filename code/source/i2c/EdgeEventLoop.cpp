@@ -0,0 +1,142 @@
+/**
+ *  @brief Implementation of EdgeEventLoop class, waits for the interrupt pin of an IC in an epoll loop.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "EdgeEventLoop.hpp"
+
+// C++
+#include <array>
+#include <algorithm>
+#include <cstdint>
+
+// C
+extern "C" {
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+}
+
+namespace pbl::i2c
+{
+
+v1::EdgeEventLoop::EdgeEventLoop( gpio::EdgeEventSource& source )
+	: m_source{ source }
+{
+	const int lineFd = m_source.fd();
+	if( lineFd < 0 ) [[unlikely]]
+	{
+		return;
+	}
+
+	m_epollFd = ::epoll_create1( EPOLL_CLOEXEC );
+	m_wakeFd = ::eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+
+	::epoll_event lineEvent{ .events = EPOLLIN, .data{ .fd = lineFd } };
+	::epoll_event wakeEvent{ .events = EPOLLIN, .data{ .fd = m_wakeFd } };
+
+	if( m_epollFd < 0 || m_wakeFd < 0 || ::epoll_ctl( m_epollFd, EPOLL_CTL_ADD, lineFd, &lineEvent ) < 0 ||
+		::epoll_ctl( m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &wakeEvent ) < 0 ) [[unlikely]]
+	{
+		if( m_epollFd >= 0 )
+		{
+			::close( m_epollFd );
+			m_epollFd = -1;
+		}
+	}
+}
+
+v1::EdgeEventLoop::~EdgeEventLoop()
+{
+	for( const int fd : { m_epollFd, m_wakeFd } )
+	{
+		if( fd >= 0 )
+		{
+			::close( fd );
+		}
+	}
+}
+
+auto v1::EdgeEventLoop::wait( std::span< gpio::EdgeEvent > events, std::chrono::milliseconds timeout )
+	-> Result< std::size_t >
+{
+	if( !isOpen() ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::HARDWARE_NOT_AVAILABLE );
+	}
+
+	if( events.empty() ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	const int lineFd = m_source.fd();
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+	while( !stopped() )
+	{
+		int remaining{ -1 };
+		if( timeout.count() >= 0 )
+		{
+			const auto left = std::chrono::ceil< std::chrono::milliseconds >( deadline - std::chrono::steady_clock::now() );
+			remaining = static_cast< int >( std::max( left.count(), std::chrono::milliseconds::rep{ 0 } ) );
+		}
+
+		std::array< ::epoll_event, 2 > ready{};
+		const int count = ::epoll_wait( m_epollFd, ready.data(), static_cast< int >( ready.size() ), remaining );
+		if( count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+
+			return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		}
+
+		if( count == 0 )
+		{
+			return utils::MakeError( utils::ErrorCode::TIMEOUT );
+		}
+
+		// The line first, edges that arrived with the stop request are still delivered
+		for( std::size_t i = 0; i < static_cast< std::size_t >( count ); ++i )
+		{
+			if( ready[ i ].data.fd == lineFd )
+			{
+				return m_source.readEvents( events );
+			}
+		}
+	}
+
+	return utils::MakeSuccess( std::size_t{ 0 } );
+}
+
+void v1::EdgeEventLoop::stop() noexcept
+{
+	m_stopped.store( true, std::memory_order_release );
+
+	if( m_wakeFd >= 0 )
+	{
+		const std::uint64_t wake{ 1 };
+		[[maybe_unused]] const auto rslt = ::write( m_wakeFd, &wake, sizeof( wake ) );
+	}
+}
+
+void v1::EdgeEventLoop::reset() noexcept
+{
+	if( m_wakeFd >= 0 )
+	{
+		// Drains the counter, the eventfd stays readable otherwise (non-blocking, it may be zero)
+		std::uint64_t count{};
+		[[maybe_unused]] const auto rslt = ::eventfd_read( m_wakeFd, &count );
+	}
+
+	m_stopped.store( false, std::memory_order_release );
+}
+
+} // namespace pbl::i2c
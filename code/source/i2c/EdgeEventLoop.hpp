@@ -0,0 +1,87 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of EdgeEventLoop class, waits for the interrupt pin of an IC in an epoll loop.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_EDGE_EVENT_LOOP_HPP__
+#define PBL_I2C_EDGE_EVENT_LOOP_HPP__
+
+#include <gpio/EdgeEvent.hpp>
+#include <utils/Result.hpp>
+
+// C++
+#include <span>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+/**
+ * @class EdgeEventLoop
+ * @brief Blocks a thread until an IC signals on its interrupt line (data ready, alert, input change).
+ *
+ * The line is registered with an epoll instance together with an eventfd, so a waiting thread
+ * sleeps in the kernel until an edge arrives and can be woken by stop() from any other thread.
+ * Drivers offering an interrupt driven acquisition take the loop, the caller owns the line and
+ * the loop and decides which thread runs it.
+ *
+ * Example usage:
+ * @code
+ * auto line = chip.line( gpio::Rpi5Chip0::Pin::GPIO17, gpio::Edge::RISING );
+ * EdgeEventLoop loop{ line->get() };
+ * mpu6050.acquire( loop, []( const auto& sample ) { ...; return true; } );
+ * @endcode
+ */
+class EdgeEventLoop final
+{
+public:
+	template < typename T >
+	using Result = utils::Result< T >;
+
+	/// Registers the line, the line must outlive the loop.
+	explicit EdgeEventLoop( gpio::EdgeEventSource& source );
+	~EdgeEventLoop();
+
+	EdgeEventLoop( const EdgeEventLoop& ) = delete;
+	EdgeEventLoop& operator=( const EdgeEventLoop& ) = delete;
+
+	/// Returns whether the line could be registered, waiting fails otherwise.
+	[[nodiscard]] bool isOpen() const noexcept { return m_epollFd >= 0; }
+
+	/**
+	 * @brief Waits for edges and reads the pending ones.
+	 *
+	 * @param events Receives the events, oldest first.
+	 * @param timeout The longest time to wait, negative to wait forever.
+	 * @return The number of events read, TIMEOUT if none arrived in time, zero if the loop was stopped.
+	 */
+	[[nodiscard]] Result< std::size_t > wait( std::span< gpio::EdgeEvent > events,
+											  std::chrono::milliseconds timeout = std::chrono::milliseconds{ -1 } );
+
+	/// Wakes the waiting thread, waits return immediately until reset is called. Thread-safe.
+	void stop() noexcept;
+
+	/// Returns whether stop was called.
+	[[nodiscard]] bool stopped() const noexcept { return m_stopped.load( std::memory_order_acquire ); }
+
+	/// Rearms a stopped loop.
+	void reset() noexcept;
+
+private:
+	gpio::EdgeEventSource& m_source;
+	int m_epollFd{ -1 };
+	int m_wakeFd{ -1 }; //!< eventfd interrupting the wait on stop
+	std::atomic_bool m_stopped{};
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_EDGE_EVENT_LOOP_HPP__
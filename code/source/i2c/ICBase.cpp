@@ -1,27 +1,44 @@
 #include "ICBase.hpp"
 #include "BusController.hpp"
+#include "Transaction.hpp"
+
+// C++
+#include <array>
+#include <algorithm>
 
 namespace pbl::i2c
 {
 
 bool v1::ICBase::write( const std::span< const std::uint8_t > data )
 {
+	// Raw writes (commands, pointer sequences) can't be attributed to a register
+	if( m_registerCache ) [[unlikely]]
+	{
+		m_registerCache->invalidate();
+	}
+
 	return m_busController.write( m_icAddress, data );
 }
 
 bool v1::ICBase::write( const std::uint8_t reg, const std::uint8_t value )
 {
-	return m_busController.write( m_icAddress, reg, value );
+	const bool rslt = m_busController.write( m_icAddress, reg, value );
+	cacheWrite( reg, std::span< const std::uint8_t >{ &value, 1 }, rslt );
+	return rslt;
 }
 
 bool v1::ICBase::write( const std::uint8_t reg, const std::span< const std::uint8_t > data )
 {
-	return m_busController.write( m_icAddress, reg, data );
+	const bool rslt = m_busController.write( m_icAddress, reg, data );
+	cacheWrite( reg, data, rslt );
+	return rslt;
 }
 
 bool v1::ICBase::write( const std::uint8_t reg, const std::uint8_t* pData, const std::uint8_t size )
 {
-	return m_busController.write( m_icAddress, reg, pData, size );
+	const bool rslt = m_busController.write( m_icAddress, reg, pData, size );
+	cacheWrite( reg, std::span< const std::uint8_t >{ pData, size }, rslt );
+	return rslt;
 }
 
 std::int16_t v1::ICBase::read( std::span< std::uint8_t > data )
@@ -31,12 +48,43 @@ std::int16_t v1::ICBase::read( std::span< std::uint8_t > data )
 
 bool v1::ICBase::read( const std::uint8_t reg, std::uint8_t& result )
 {
-	return m_busController.read( m_icAddress, reg, result );
+	const bool rslt = m_busController.read( m_icAddress, reg, result );
+	if( rslt )
+	{
+		cacheRead( reg, std::span< const std::uint8_t >{ &result, 1 } );
+	}
+
+	return rslt;
 }
 
 std::int16_t v1::ICBase::read( const std::uint8_t reg, std::uint8_t* pData, std::uint16_t size )
 {
-	return m_busController.read( m_icAddress, reg, pData, size );
+	const auto rslt = m_busController.read( m_icAddress, reg, pData, size );
+	if( rslt == static_cast< std::int16_t >( size ) )
+	{
+		cacheRead( reg, std::span< const std::uint8_t >{ pData, size } );
+	}
+
+	return rslt;
+}
+
+bool v1::ICBase::read( Transaction& transaction, const std::uint8_t reg, std::span< std::uint8_t > data ) const
+{
+	return transaction.read( m_icAddress, reg, data );
+}
+
+bool v1::ICBase::write( Transaction& transaction,
+						const std::uint8_t reg,
+						const std::span< const std::uint8_t > data ) const
+{
+	// The outcome is only known once submitted, the next access goes to the bus
+	cacheWrite( reg, data, false );
+	return transaction.write( m_icAddress, reg, data );
+}
+
+bool v1::ICBase::submit( Transaction& transaction )
+{
+	return m_busController.submit( transaction );
 }
 
 void v1::ICBase::sleep( const std::chrono::milliseconds sleepTimeMs )
@@ -49,4 +97,153 @@ void v1::ICBase::sleep( const std::chrono::microseconds sleepTimeUs )
 	m_busController.sleep( sleepTimeUs );
 }
 
+void v1::ICBase::setCacheable( const std::uint8_t reg, const std::uint8_t width, const std::uint16_t volatileBits )
+{
+	if( !m_registerCache )
+	{
+		m_registerCache = std::make_unique< RegisterCache >();
+	}
+
+	m_registerCache->declare( reg, width, volatileBits );
+}
+
+void v1::ICBase::invalidateCache() noexcept
+{
+	if( m_registerCache )
+	{
+		m_registerCache->invalidate();
+	}
+}
+
+bool v1::ICBase::readCached( const std::uint8_t reg, std::uint8_t& value )
+{
+	if( m_registerCache && m_registerCache->width( reg ) == 1 )
+	{
+		if( const auto cached = m_registerCache->value( reg ) )
+		{
+			value = static_cast< std::uint8_t >( *cached );
+			return true;
+		}
+	}
+
+	return read( reg, value );
+}
+
+bool v1::ICBase::readCachedWord( const std::uint8_t reg, std::uint16_t& value )
+{
+	if( m_registerCache && m_registerCache->width( reg ) == 2 )
+	{
+		if( const auto cached = m_registerCache->value( reg ) )
+		{
+			value = *cached;
+			return true;
+		}
+	}
+
+	std::array< std::uint8_t, 2 > data{};
+	if( read( reg, data.data(), data.size() ) != 2 ) [[unlikely]]
+	{
+		return false;
+	}
+
+	value = static_cast< std::uint16_t >( ( data[ 0 ] << 8 ) | data[ 1 ] );
+	return true;
+}
+
+bool v1::ICBase::updateRegister( const std::uint8_t reg, const std::uint8_t mask, const std::uint8_t bits )
+{
+	std::uint8_t value{};
+	if( !readCached( reg, value ) ) [[unlikely]]
+	{
+		return false;
+	}
+
+	return write( reg, static_cast< std::uint8_t >( ( value & ~mask ) | ( bits & mask ) ) );
+}
+
+bool v1::ICBase::updateWordRegister( const std::uint8_t reg, const std::uint16_t mask, const std::uint16_t bits )
+{
+	std::uint16_t value{};
+	if( !readCachedWord( reg, value ) ) [[unlikely]]
+	{
+		return false;
+	}
+
+	value = static_cast< std::uint16_t >( ( value & ~mask ) | ( bits & mask ) );
+
+	const std::array< std::uint8_t, 2 > data{ static_cast< std::uint8_t >( value >> 8 ),
+											  static_cast< std::uint8_t >( value & 0xFF ) };
+	return write( reg, data );
+}
+
+bool v1::ICBase::writeSequential( const std::uint8_t reg, const std::span< const std::uint8_t > data )
+{
+	const bool rslt = m_busController.write( m_icAddress, reg, data );
+	if( !m_registerCache )
+	{
+		return rslt;
+	}
+
+	for( std::size_t i = 0; i < data.size() && reg + i < 256; ++i )
+	{
+		const auto r = static_cast< std::uint8_t >( reg + i );
+		if( rslt && m_registerCache->width( r ) == 1 )
+		{
+			m_registerCache->store( r, data[ i ] );
+		}
+		else
+		{
+			m_registerCache->invalidate( r );
+		}
+	}
+
+	return rslt;
+}
+
+std::optional< std::uint16_t > v1::ICBase::cachedValue( const std::uint8_t reg ) const noexcept
+{
+	return m_registerCache ? m_registerCache->value( reg ) : std::nullopt;
+}
+
+void v1::ICBase::cacheStore( const std::uint8_t reg, const std::uint16_t value ) noexcept
+{
+	if( m_registerCache )
+	{
+		m_registerCache->store( reg, value );
+	}
+}
+
+void v1::ICBase::cacheWrite( const std::uint8_t reg,
+							 const std::span< const std::uint8_t > data,
+							 const bool succeeded ) const noexcept
+{
+	if( !m_registerCache )
+	{
+		return;
+	}
+
+	if( succeeded && !data.empty() && m_registerCache->width( reg ) == data.size() )
+	{
+		m_registerCache->store( reg, data.size() == 2 ? static_cast< std::uint16_t >( ( data[ 0 ] << 8 ) | data[ 1 ] )
+													  : data[ 0 ] );
+		return;
+	}
+
+	// Failed or spanning several registers, whether the IC auto increments is not known here
+	const std::size_t end = std::min< std::size_t >( reg + std::max< std::size_t >( data.size(), 1 ), 256 );
+	for( std::size_t r = reg; r < end; ++r )
+	{
+		m_registerCache->invalidate( static_cast< std::uint8_t >( r ) );
+	}
+}
+
+void v1::ICBase::cacheRead( const std::uint8_t reg, const std::span< const std::uint8_t > data ) const noexcept
+{
+	if( m_registerCache && !data.empty() && m_registerCache->width( reg ) == data.size() )
+	{
+		m_registerCache->store( reg, data.size() == 2 ? static_cast< std::uint16_t >( ( data[ 0 ] << 8 ) | data[ 1 ] )
+													  : data[ 0 ] );
+	}
+}
+
 } // namespace pbl::i2c
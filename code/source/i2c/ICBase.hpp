@@ -1,11 +1,14 @@
 #ifndef PBL_I2C_IC_BASE_HPP__
 #define PBL_I2C_IC_BASE_HPP__
 
+#include "RegisterCache.hpp"
 #include <utils/Result.hpp>
 
 // C++
 #include <span>
 #include <chrono>
+#include <memory>
+#include <optional>
 #include <cstdint>
 #include <type_traits>
 
@@ -16,6 +19,7 @@ inline namespace v1
 {
 
 class BusController;
+class Transaction;
 
 namespace detail
 {
@@ -45,6 +49,9 @@ concept AddressType = std::is_same_v< T, std::uint8_t > ||
  * state common to all ICs, such as maintaining a reference to the I2C bus controller, storing the IC's 
  * unique address, and standard methods all IC controllers are expected to leverage (like sleep).
  * Derived classes should provide the specific implementation details for the respective ICs.
+ *
+ * Controllers may declare configuration registers as cacheable (see setCacheable), which turns
+ * read-modify-write sequences into a single bus write.
  * 
  * @todo Rename to I2CDevice
  */
@@ -65,6 +72,16 @@ public:
 	[[nodiscard]] bool read( const std::uint8_t reg, std::uint8_t& result );
 	[[nodiscard]] std::int16_t read( const std::uint8_t reg, std::uint8_t* pData, std::uint16_t size );
 
+	/// Queues a register read from this IC into a transaction, returns false if the transaction is full.
+	[[nodiscard]] bool read( Transaction& transaction, const std::uint8_t reg, std::span< std::uint8_t > data ) const;
+
+	/// Queues a register write to this IC into a transaction, returns false if the transaction is full.
+	[[nodiscard]] bool
+	write( Transaction& transaction, const std::uint8_t reg, const std::span< const std::uint8_t > data ) const;
+
+	/// Submits a transaction on the bus this IC is attached to, see BusController::submit.
+	[[nodiscard]] bool submit( Transaction& transaction );
+
 protected:
 	/**
      * @brief Protected constructor; Initializes the IC controller with a reference to the I2C bus and the IC address.
@@ -79,14 +96,70 @@ protected:
 		, m_icAddress{ static_cast< std::uint8_t >( icAddress ) }
 	{ }
 
+	/// Controllers are movable, the register shadow moves along with them.
+	ICBase( ICBase&& ) noexcept = default;
+
 	void sleep( const std::chrono::milliseconds sleepTimeMs );
 	void sleep( const std::chrono::microseconds sleepTimeUs );
 
 	[[nodiscard]] auto& controller( this auto& self ) noexcept { return self.m_busController; }
 
+	/**
+	 * @brief Declares a register as cacheable, enabling the register shadow of this IC.
+	 *
+	 * Writes through this class keep the shadow of cacheable registers up to date, the read-modify-write
+	 * helpers (updateRegister, updateWordRegister) then only need the write. Plain reads always access
+	 * the bus and refresh the shadow, readCached serves the shadow when the value is known.
+	 *
+	 * @param reg The register address.
+	 * @param width The register width in bytes (1 or 2), 16-bit registers are big endian.
+	 * @param volatileBits Bits the IC changes on its own, they are never cached.
+	 *
+	 * @note Transfers that bypass this class (i.e. BusController calls) are not tracked, call invalidateCache
+	 * after such writes or after a reset of the IC.
+	 */
+	void setCacheable( const std::uint8_t reg, const std::uint8_t width = 1, const std::uint16_t volatileBits = 0 );
+
+	/// Forgets all cached register values, the next access of each register goes to the bus.
+	void invalidateCache() noexcept;
+
+	/// Reads an 8-bit register, served from the shadow when its value is known.
+	[[nodiscard]] bool readCached( const std::uint8_t reg, std::uint8_t& value );
+
+	/// Reads a 16-bit big endian register, served from the shadow when its value is known.
+	[[nodiscard]] bool readCachedWord( const std::uint8_t reg, std::uint16_t& value );
+
+	/// Replaces the masked bits of an 8-bit register, a single write when the register value is cached.
+	[[nodiscard]] bool updateRegister( const std::uint8_t reg, const std::uint8_t mask, const std::uint8_t bits );
+
+	/// Replaces the masked bits of a 16-bit big endian register, a single write when the register value is cached.
+	[[nodiscard]] bool updateWordRegister( const std::uint8_t reg, const std::uint16_t mask, const std::uint16_t bits );
+
+	/**
+	 * @brief Writes consecutive 8-bit registers in one transfer, the IC must auto increment the register address.
+	 *
+	 * Unlike write, which cannot tell whether the IC auto increments, the shadow of every cacheable
+	 * register written is updated.
+	 */
+	[[nodiscard]] bool writeSequential( const std::uint8_t reg, const std::span< const std::uint8_t > data );
+
+	/// Returns the shadow of a register without accessing the bus, std::nullopt when its value is not known.
+	[[nodiscard]] std::optional< std::uint16_t > cachedValue( const std::uint8_t reg ) const noexcept;
+
+	/// Records a value the register took on without being written, i.e. through a broadcast register.
+	void cacheStore( const std::uint8_t reg, const std::uint16_t value ) noexcept;
+
+private:
+	/// Updates the shadow after a register write of the given data, tracked only when the cache is enabled.
+	void cacheWrite( const std::uint8_t reg, const std::span< const std::uint8_t > data, const bool succeeded ) const noexcept;
+
+	/// Updates the shadow after a register read of the given data, tracked only when the cache is enabled.
+	void cacheRead( const std::uint8_t reg, const std::span< const std::uint8_t > data ) const noexcept;
+
 private:
 	BusController& m_busController;
 	std::uint8_t m_icAddress;
+	std::unique_ptr< RegisterCache > m_registerCache; //!< Allocated once the first register is declared cacheable
 };
 
 } // namespace v1
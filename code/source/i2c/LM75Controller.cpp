@@ -38,19 +38,17 @@ constexpr std::size_t kShutdownModeBit = 7; // Bit 7 is used for the shutdown mo
 
 v1::LM75Controller::LM75Controller( BusController& busController, Address address ) noexcept
 	: ICBase{ busController, address }
-{ }
+{
+	// The alert status is the only bit the sensor updates on its own
+	setCacheable( kConfigurationRegister, 1, 1 << kAlertStatusBit );
+}
 
 auto v1::LM75Controller::setPowerMode( PowerMode mode ) -> Result< void >
 {
-	std::uint8_t config{};
-	if( !read( kConfigurationRegister, config ) ) [[unlikely]]
-	{
-		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
-	}
+	constexpr std::uint8_t kMask{ 1 << kShutdownModeBit };
+	const auto bits = static_cast< std::uint8_t >( static_cast< std::uint8_t >( mode ) << kShutdownModeBit );
 
-	std::bitset< 8 > configBits{ config };
-	configBits.set( kShutdownModeBit, static_cast< std::uint8_t >( mode ) );
-	if( !write( kConfigurationRegister, static_cast< std::uint8_t >( configBits.to_ulong() ) ) ) [[unlikely]]
+	if( !updateRegister( kConfigurationRegister, kMask, bits ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
@@ -60,15 +58,10 @@ auto v1::LM75Controller::setPowerMode( PowerMode mode ) -> Result< void >
 
 auto v1::LM75Controller::setThermostatMode( ThermostatMode mode ) -> Result< void >
 {
-	std::uint8_t config{};
-	if( !read( kConfigurationRegister, config ) ) [[unlikely]]
-	{
-		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
-	}
+	constexpr std::uint8_t kMask{ 1 << kThermostatModeBit };
+	const auto bits = static_cast< std::uint8_t >( static_cast< std::uint8_t >( mode ) << kThermostatModeBit );
 
-	std::bitset< 8 > configBits{ config };
-	configBits.set( kThermostatModeBit, static_cast< std::uint8_t >( mode ) );
-	if( !write( kConfigurationRegister, static_cast< std::uint8_t >( configBits.to_ulong() ) ) ) [[unlikely]]
+	if( !updateRegister( kConfigurationRegister, kMask, bits ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
@@ -79,7 +72,7 @@ auto v1::LM75Controller::setThermostatMode( ThermostatMode mode ) -> Result< voi
 auto v1::LM75Controller::getPowerMode() -> Result< PowerMode >
 {
 	std::uint8_t config{};
-	if( !read( kConfigurationRegister, config ) ) [[unlikely]]
+	if( !readCached( kConfigurationRegister, config ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
@@ -96,7 +89,7 @@ auto v1::LM75Controller::getPowerMode() -> Result< PowerMode >
 auto v1::LM75Controller::getThermostatMode() -> Result< ThermostatMode >
 {
 	std::uint8_t config{};
-	if( !read( kConfigurationRegister, config ) ) [[unlikely]]
+	if( !readCached( kConfigurationRegister, config ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
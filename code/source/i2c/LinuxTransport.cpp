@@ -0,0 +1,329 @@
+/**
+ *  @brief Implementation of LinuxTransport class, the Linux i2c-dev backend of the BusController.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "LinuxTransport.hpp"
+
+// C++
+#include <array>
+#include <thread>
+#include <algorithm>
+
+// C
+extern "C" {
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+}
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+using Message = Transaction::Message;
+using Path = LinuxTransport::Path;
+
+/// Returns whether the messages are a register write, the register followed by the payload.
+[[nodiscard]] bool isRegisterWrite( const std::span< const Message > messages ) noexcept
+{
+	return messages.size() == 1 && !messages[ 0 ].read && !messages[ 0 ].noStart && messages[ 0 ].buffer.size() >= 2;
+}
+
+/// Returns whether the messages are a register read, the register pointer write followed by a repeated start read.
+[[nodiscard]] bool isRegisterRead( const std::span< const Message > messages ) noexcept
+{
+	return messages.size() == 2 && !messages[ 0 ].read && messages[ 0 ].buffer.size() == 1 && messages[ 1 ].read &&
+		   !messages[ 1 ].noStart && !messages[ 1 ].buffer.empty() && messages[ 0 ].address == messages[ 1 ].address;
+}
+
+} // namespace
+
+v1::LinuxTransport::LinuxTransport( const std::string& busName )
+	: m_busName{ busName }
+{
+	m_fd = ::open( m_busName.c_str(), O_RDWR | O_NONBLOCK );
+	if( m_fd < 0 )
+	{
+		m_openErrno = errno;
+		return;
+	}
+
+	checkFunc();
+}
+
+v1::LinuxTransport::~LinuxTransport()
+{
+	if( m_fd >= 0 )
+	{
+		::close( m_fd );
+	}
+}
+
+int v1::LinuxTransport::transfer( std::span< Transaction::Message > messages ) noexcept
+{
+	const auto selected = path( messages );
+	if( selected != Path::RDWR )
+	{
+		const int transferred = transferSmbus( selected, messages );
+		if( transferred != -EBUSY )
+		{
+			m_pathCounts[ static_cast< std::size_t >( selected ) ].fetch_add( 1, std::memory_order_relaxed );
+			return transferred;
+		}
+
+		// The device is bound to a kernel driver, I2C_RDWR still reaches it
+	}
+
+	m_pathCounts[ static_cast< std::size_t >( Path::RDWR ) ].fetch_add( 1, std::memory_order_relaxed );
+	return transferRdwr( messages );
+}
+
+bool v1::LinuxTransport::setPec( const std::uint8_t address, const bool enable ) noexcept
+{
+	if( address >= m_pecDevices.size() || ( enable && !supports( I2C_FUNC_SMBUS_PEC ) ) ) [[unlikely]]
+	{
+		return false;
+	}
+
+	m_pecDevices.set( address, enable );
+	return true;
+}
+
+auto v1::LinuxTransport::selectPath( const std::uint64_t functionality,
+									 const std::span< const Transaction::Message > messages ) noexcept -> Path
+{
+	const auto supported = [ functionality ]( const std::uint64_t funcs ) { return ( functionality & funcs ) == funcs; };
+
+	if( messages.empty() || messages[ 0 ].address > 0x7F )
+	{
+		return Path::RDWR;
+	}
+
+	if( messages.size() == 1 && !messages[ 0 ].noStart && messages[ 0 ].buffer.size() <= 1 )
+	{
+		const auto& message = messages[ 0 ];
+
+		if( message.buffer.empty() && !message.read && supported( I2C_FUNC_SMBUS_QUICK ) )
+		{
+			return Path::SMBUS_QUICK;
+		}
+
+		const auto func = message.read ? I2C_FUNC_SMBUS_READ_BYTE : I2C_FUNC_SMBUS_WRITE_BYTE;
+		if( message.buffer.size() == 1 && supported( func ) )
+		{
+			return Path::SMBUS_BYTE;
+		}
+	}
+	else if( isRegisterWrite( messages ) )
+	{
+		const auto size = messages[ 0 ].buffer.size() - 1;
+
+		if( size == 1 && supported( I2C_FUNC_SMBUS_WRITE_BYTE_DATA ) )
+		{
+			return Path::SMBUS_BYTE_DATA;
+		}
+
+		if( size == 2 && supported( I2C_FUNC_SMBUS_WRITE_WORD_DATA ) )
+		{
+			return Path::SMBUS_WORD_DATA;
+		}
+
+		if( size <= kMaxBlockSize && supported( I2C_FUNC_SMBUS_WRITE_I2C_BLOCK ) )
+		{
+			return Path::SMBUS_I2C_BLOCK_DATA;
+		}
+	}
+	else if( isRegisterRead( messages ) )
+	{
+		const auto size = messages[ 1 ].buffer.size();
+
+		if( size == 1 && supported( I2C_FUNC_SMBUS_READ_BYTE_DATA ) )
+		{
+			return Path::SMBUS_BYTE_DATA;
+		}
+
+		if( size == 2 && supported( I2C_FUNC_SMBUS_READ_WORD_DATA ) )
+		{
+			return Path::SMBUS_WORD_DATA;
+		}
+
+		if( size <= kMaxBlockSize && supported( I2C_FUNC_SMBUS_READ_I2C_BLOCK ) )
+		{
+			return Path::SMBUS_I2C_BLOCK_DATA;
+		}
+	}
+
+	return Path::RDWR;
+}
+
+int v1::LinuxTransport::transferRdwr( std::span< Transaction::Message > messages ) noexcept
+{
+	std::array< ::i2c_msg, Transaction::kMaxMessages > msgs{};
+	for( std::size_t i = 0; i < messages.size(); ++i )
+	{
+		const auto& message = messages[ i ];
+
+		msgs[ i ].addr = message.address;
+		msgs[ i ].flags = static_cast< __u16 >( ( message.read ? I2C_M_RD : 0 ) | ( message.noStart ? I2C_M_NOSTART : 0 ) );
+		msgs[ i ].len = static_cast< __u16 >( message.buffer.size() );
+		msgs[ i ].buf = message.buffer.data();
+	}
+
+	::i2c_rdwr_ioctl_data msgset{};
+	msgset.msgs = msgs.data();
+	msgset.nmsgs = static_cast< __u32 >( messages.size() );
+
+	const int transferred = ::ioctl( m_fd, I2C_RDWR, &msgset );
+	if( transferred < 0 ) [[unlikely]]
+	{
+		return -errno;
+	}
+
+	return transferred;
+}
+
+int v1::LinuxTransport::transferSmbus( const Path path, std::span< Transaction::Message > messages ) noexcept
+{
+	const auto address = static_cast< std::uint8_t >( messages[ 0 ].address );
+	if( const int rslt = selectDevice( address ); rslt < 0 ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	::i2c_smbus_data smbusData{};
+	::i2c_smbus_ioctl_data args{};
+	args.data = &smbusData;
+
+	// Quick and byte transfers carry no register, the others start with the register pointer
+	const bool read = messages.back().read;
+	std::span< std::uint8_t > data;
+
+	switch( path )
+	{
+		case Path::SMBUS_QUICK:
+			args.size = I2C_SMBUS_QUICK;
+			args.data = nullptr;
+			break;
+		case Path::SMBUS_BYTE:
+			args.size = I2C_SMBUS_BYTE;
+			data = messages[ 0 ].buffer;
+			args.command = read ? 0 : data[ 0 ];
+			args.data = read ? &smbusData : nullptr;
+			break;
+		case Path::SMBUS_BYTE_DATA:
+		case Path::SMBUS_WORD_DATA:
+		case Path::SMBUS_I2C_BLOCK_DATA:
+			args.command = messages[ 0 ].buffer[ 0 ];
+			data = read ? messages[ 1 ].buffer : messages[ 0 ].buffer.subspan( 1 );
+			break;
+		case Path::RDWR: return -EINVAL;
+	}
+
+	args.read_write = read ? I2C_SMBUS_READ : I2C_SMBUS_WRITE;
+
+	switch( path )
+	{
+		case Path::SMBUS_BYTE_DATA:
+			args.size = I2C_SMBUS_BYTE_DATA;
+			smbusData.byte = data[ 0 ];
+			break;
+		case Path::SMBUS_WORD_DATA:
+			// SMBus words are transferred least significant byte first, the wire order is kept
+			args.size = I2C_SMBUS_WORD_DATA;
+			smbusData.word = static_cast< __u16 >( data[ 0 ] | ( data[ 1 ] << 8 ) );
+			break;
+		case Path::SMBUS_I2C_BLOCK_DATA:
+			args.size = I2C_SMBUS_I2C_BLOCK_DATA;
+			smbusData.block[ 0 ] = static_cast< __u8 >( data.size() );
+			std::ranges::copy( data, std::begin( smbusData.block ) + 1 );
+			break;
+		default: break;
+	}
+
+	if( ::ioctl( m_fd, I2C_SMBUS, &args ) < 0 ) [[unlikely]]
+	{
+		return -errno;
+	}
+
+	if( read )
+	{
+		switch( path )
+		{
+			case Path::SMBUS_BYTE:
+			case Path::SMBUS_BYTE_DATA: data[ 0 ] = smbusData.byte; break;
+			case Path::SMBUS_WORD_DATA:
+				data[ 0 ] = static_cast< std::uint8_t >( smbusData.word & 0xFF );
+				data[ 1 ] = static_cast< std::uint8_t >( smbusData.word >> 8 );
+				break;
+			case Path::SMBUS_I2C_BLOCK_DATA:
+				std::copy_n( std::begin( smbusData.block ) + 1, data.size(), data.begin() );
+				break;
+			default: break;
+		}
+	}
+
+	return static_cast< int >( messages.size() );
+}
+
+int v1::LinuxTransport::selectDevice( const std::uint8_t address ) noexcept
+{
+	if( m_slaveAddress != address )
+	{
+		if( ::ioctl( m_fd, I2C_SLAVE, static_cast< unsigned long >( address ) ) < 0 ) [[unlikely]]
+		{
+			m_slaveAddress = -1;
+			return -errno;
+		}
+
+		m_slaveAddress = address;
+	}
+
+	const bool pec = m_pecDevices.test( address );
+	if( pec != m_pecActive )
+	{
+		if( ::ioctl( m_fd, I2C_PEC, static_cast< unsigned long >( pec ) ) < 0 ) [[unlikely]]
+		{
+			return -errno;
+		}
+
+		m_pecActive = pec;
+	}
+
+	return 0;
+}
+
+void v1::LinuxTransport::sleep( const std::chrono::microseconds sleepTime )
+{
+	std::this_thread::sleep_for( sleepTime );
+}
+
+void v1::LinuxTransport::checkFunc()
+{
+	unsigned long funcs{};
+
+	if( ::ioctl( m_fd, I2C_FUNCS, &funcs ) < 0 ) [[unlikely]]
+	{
+		return;
+	}
+
+	m_functionality = funcs;
+}
+
+static_assert( Transaction::kMaxMessages == I2C_RDWR_IOCTL_MAX_MSGS,
+			   "Transaction::kMaxMessages differs from the kernel I2C_RDWR_IOCTL_MAX_MSGS limit." );
+static_assert( std::is_same_v< __u8, std::uint8_t >, "__u8 definition differs from std::uint8_t definition." );
+static_assert( std::is_same_v< unsigned int, std::uint32_t >,
+			   "unsigned int definition differs from std::uint32_t definition." );
+static_assert( LinuxTransport::kMaxBlockSize == I2C_SMBUS_BLOCK_MAX,
+			   "LinuxTransport::kMaxBlockSize differs from the kernel I2C_SMBUS_BLOCK_MAX limit." );
+
+} // namespace pbl::i2c
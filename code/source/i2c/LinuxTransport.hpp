@@ -0,0 +1,158 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of LinuxTransport class, the Linux i2c-dev backend of the BusController.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_LINUX_TRANSPORT_HPP__
+#define PBL_I2C_LINUX_TRANSPORT_HPP__
+
+#include "Transport.hpp"
+
+// C++
+#include <span>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+/**
+ * @class LinuxTransport
+ * @brief Performs I2C transfers through a Linux i2c-dev character device.
+ *
+ * The adapter functionality (I2C_FUNCS) is queried when opening the device, every transfer is then
+ * dispatched to the cheapest kernel path the adapter supports. Register accesses the BusController
+ * issues (a single byte, a word or up to 32 bytes) map to the SMBus byte data, word data and I2C block
+ * ioctls, probes (empty writes) and single byte reads or writes map to the SMBus quick and byte ioctls.
+ * These put the same bytes on the wire, everything else uses I2C_RDWR. Some adapters (and
+ * SMBus-only controllers) handle the SMBus ioctls natively and faster than a generic I2C_RDWR.
+ *
+ * Packet error checking (PEC) can be enabled per device, it applies to the transfers using the
+ * SMBus path, I2C_RDWR transfers are never protected.
+ *
+ * Configure the transport (setSmbusEnabled, setPec) before handing it to the BusController.
+ *
+ * To list the I2C buses available: i2cdetect -l or you may use also: ls /dev/i2c*
+ */
+class LinuxTransport final : public Transport
+{
+public:
+	/// Kernel interface a transfer is dispatched to.
+	enum class Path : std::uint8_t
+	{
+		RDWR, ///< I2C_RDWR combined transfer, the generic fallback.
+		SMBUS_QUICK, ///< I2C_SMBUS quick write, an empty write addressing the device only (i.e. a probe).
+		SMBUS_BYTE, ///< I2C_SMBUS byte, a single byte read or write without a register.
+		SMBUS_BYTE_DATA, ///< I2C_SMBUS byte data, a single byte register read or write.
+		SMBUS_WORD_DATA, ///< I2C_SMBUS word data, a two byte register read or write.
+		SMBUS_I2C_BLOCK_DATA ///< I2C_SMBUS I2C block data, up to 32 bytes register read or write.
+	};
+
+	/// Number of Path enumerators.
+	static constexpr std::size_t kPathCount{ 6 };
+
+	/// Maximum payload of the SMBus block transfers.
+	static constexpr std::size_t kMaxBlockSize{ 32 };
+
+	/// Opens the given i2c-dev device, i.e. "/dev/i2c-1", check isOpen and openErrno for the outcome.
+	explicit LinuxTransport( const std::string& busName );
+
+	/// Closes the file descriptor.
+	~LinuxTransport() override;
+
+	[[nodiscard]] const std::string& name() const noexcept override { return m_busName; }
+
+	[[nodiscard]] bool isOpen() const noexcept override { return m_fd >= 0; }
+
+	[[nodiscard]] int transfer( std::span< Transaction::Message > messages ) noexcept override;
+
+	void sleep( const std::chrono::microseconds sleepTime ) override;
+
+	/// Returns the errno value of a failed open, 0 otherwise.
+	[[nodiscard]] int openErrno() const noexcept { return m_openErrno; }
+
+	/// Returns the I2C_FUNC_* bitmask reported by the adapter, 0 if it could not be queried.
+	[[nodiscard]] std::uint64_t functionality() const noexcept { return m_functionality; }
+
+	/// Returns whether the adapter supports all of the given I2C_FUNC_* flags.
+	[[nodiscard]] bool supports( const std::uint64_t funcs ) const noexcept { return ( m_functionality & funcs ) == funcs; }
+
+	/// Enables or disables the SMBus fast path (enabled by default), disabled all transfers use I2C_RDWR.
+	void setSmbusEnabled( const bool enable ) noexcept { m_smbusEnabled = enable; }
+
+	/**
+	 * @brief Enables packet error checking for the SMBus transfers of the given device.
+	 *
+	 * @return false if the adapter lacks I2C_FUNC_SMBUS_PEC or the address is not a 7-bit address.
+	 */
+	[[nodiscard]] bool setPec( const std::uint8_t address, const bool enable ) noexcept;
+
+	/// Returns the path the given messages would be transferred with.
+	[[nodiscard]] Path path( const std::span< const Transaction::Message > messages ) const noexcept
+	{
+		return selectPath( m_smbusEnabled ? m_functionality : 0, messages );
+	}
+
+	/// Returns the number of transfers dispatched to the given path so far.
+	[[nodiscard]] std::uint64_t transfers( const Path path ) const noexcept
+	{
+		return m_pathCounts[ static_cast< std::size_t >( path ) ].load( std::memory_order_relaxed );
+	}
+
+	/**
+	 * @brief Selects the cheapest path for the messages given the adapter functionality.
+	 *
+	 * A register write (one write message: register + 1..32 bytes) or a register read (a one byte
+	 * write followed by a 1..32 byte read of the same device) is eligible for the SMBus path, so is
+	 * a single message that is empty (quick) or carries one byte, provided the adapter supports
+	 * the matching transfer.
+	 */
+	[[nodiscard]] static Path selectPath( const std::uint64_t functionality,
+										  const std::span< const Transaction::Message > messages ) noexcept;
+
+private:
+	// This class is non-copyable and non-movable
+	LinuxTransport( const LinuxTransport& ) = delete;
+	LinuxTransport( LinuxTransport&& ) = delete;
+	LinuxTransport& operator=( const LinuxTransport& ) = delete;
+	LinuxTransport& operator=( LinuxTransport&& ) = delete;
+
+	/// Requesting the bus for capabilities/features/functionality
+	void checkFunc();
+
+	/// Transfers the messages using I2C_RDWR.
+	[[nodiscard]] int transferRdwr( std::span< Transaction::Message > messages ) noexcept;
+
+	/// Transfers the messages using the I2C_SMBUS ioctl, returns -EBUSY if the device is bound to a kernel driver.
+	[[nodiscard]] int transferSmbus( const Path path, std::span< Transaction::Message > messages ) noexcept;
+
+	/// Selects the device for SMBus transfers, the I2C_SLAVE and I2C_PEC ioctls are issued only on change.
+	[[nodiscard]] int selectDevice( const std::uint8_t address ) noexcept;
+
+private:
+	const std::string m_busName; //!< I2C Bus name, i.e. "/dev/i2c-1"
+	int m_fd{ -1 }; //!< File descriptor of the opened i2c-dev device
+	int m_openErrno{}; //!< Errno of a failed open
+	std::uint64_t m_functionality{}; //!< I2C_FUNC_* bitmask of the adapter
+	bool m_smbusEnabled{ true }; //!< Whether register accesses may use the SMBus ioctls
+
+	int m_slaveAddress{ -1 }; //!< Device selected with I2C_SLAVE, -1 if none
+	bool m_pecActive{}; //!< Current I2C_PEC state of the file descriptor
+	std::bitset< 128 > m_pecDevices; //!< Devices using packet error checking
+
+	std::array< std::atomic< std::uint64_t >, kPathCount > m_pathCounts{}; //!< Transfers per path
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_LINUX_TRANSPORT_HPP__
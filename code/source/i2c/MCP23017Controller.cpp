@@ -1,5 +1,12 @@
 #include "MCP23017Controller.hpp"
 #include "BusController.hpp"
+#include "Transaction.hpp"
+#include "EdgeEventLoop.hpp"
+
+// C++
+#include <bit>
+#include <array>
+#include <bitset>
 
 namespace pbl::i2c
 {
@@ -30,9 +37,43 @@ constexpr std::uint8_t kGpioBRegister{ 0x13 }; //!< PORT B: Represents logic lev
 constexpr std::uint8_t kOlatARegister{ 0x14 }; //!< PORT A: Output latch register, affects output pins.
 constexpr std::uint8_t kOlatBRegister{ 0x15 }; //!< PORT B: Output latch register, affects output pins.
 
+// IOCON bit definitions
+constexpr std::uint8_t kIoconMirror{ 0x40 }; //!< INTA and INTB internally connected.
+constexpr std::uint8_t kIoconOdr{ 0x04 }; //!< INT pins open drain.
+constexpr std::uint8_t kIoconIntpol{ 0x02 }; //!< INT pins active high.
+
 // Note: There are several other configuration bits within some of these registers that control the behavior of the MCP23017.
 // Please refer to the MCP23017 datasheet for detailed information about each register's function.
 
+// Port A register of each batch target, port B follows (IOCON.BANK = 0)
+constexpr std::array< std::uint8_t, 6 > kBatchRegisters{
+	kOlatARegister, kGppuARegister, kDefvalARegister, kIntconARegister, kIodirARegister, kGpintenARegister };
+
+/// Combines a port A and port B register pair, port A in the low byte.
+[[nodiscard]] constexpr std::uint16_t toPins( const std::array< std::uint8_t, 2 >& pair ) noexcept
+{
+	return static_cast< std::uint16_t >( ( pair[ 1 ] << 8 ) | pair[ 0 ] );
+}
+
+[[nodiscard]] constexpr std::array< std::uint8_t, 2 > toPair( const std::uint16_t pins ) noexcept
+{
+	return { static_cast< std::uint8_t >( pins & 0xFF ), static_cast< std::uint8_t >( pins >> 8 ) };
+}
+
+template < typename Config >
+[[nodiscard]] Config fromRegister( const std::uint8_t value ) noexcept
+{
+	Config config;
+	config.bitset = std::bitset< Config::kMaxPins >{ value };
+	return config;
+}
+
+template < typename Config >
+[[nodiscard]] std::uint8_t toRegister( const Config& config ) noexcept
+{
+	return static_cast< std::uint8_t >( config.bitset.to_ulong() );
+}
+
 } // namespace
 
 MCP23017Controller::MCP23017Controller( BusController& busController, Address address ) noexcept
@@ -40,88 +81,361 @@ MCP23017Controller::MCP23017Controller( BusController& busController, Address ad
 	, m_portA{ *this, Port::Address::PORT_A, PortTag{} }
 	, m_portB{ *this, Port::Address::PORT_B, PortTag{} }
 {
-	// TODO
+	// Configuration and output latches only change when written, GPIO, INTF and INTCAP are volatile
+	for( const auto reg : { kIodirARegister,
+							kIodirBRegister,
+							kIpolaARegister,
+							kIpolaBRegister,
+							kGpintenARegister,
+							kGpintenBRegister,
+							kDefvalARegister,
+							kDefvalBRegister,
+							kIntconARegister,
+							kIntconBRegister,
+							kIoconRegister,
+							kGppuARegister,
+							kGppuBRegister,
+							kOlatARegister,
+							kOlatBRegister } )
+	{
+		setCacheable( reg );
+	}
 }
 
-auto MCP23017Controller::Port::pinModes() -> Result< detail::mcp23017::port::PinModes >
+auto MCP23017Controller::apply( const Batch& batch ) -> Result< void >
+{
+	static_assert( kBatchRegisters.size() == Batch::kTargets );
+
+	std::array< std::array< std::uint8_t, 2 >, Batch::kTargets > current{};
+	std::array< bool, Batch::kTargets > fetched{};
+
+	// Register pairs not in the shadow are read together
+	Transaction reads;
+	for( std::size_t i = 0; i < Batch::kTargets; ++i )
+	{
+		if( !batch.m_changes[ i ].touched() )
+		{
+			continue;
+		}
+
+		const auto a = cachedValue( kBatchRegisters[ i ] );
+		const auto b = cachedValue( static_cast< std::uint8_t >( kBatchRegisters[ i ] + 1 ) );
+		if( a && b )
+		{
+			current[ i ] = { static_cast< std::uint8_t >( *a ), static_cast< std::uint8_t >( *b ) };
+			continue;
+		}
+
+		if( !read( reads, kBatchRegisters[ i ], current[ i ] ) ) [[unlikely]]
+		{
+			return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		}
+
+		fetched[ i ] = true;
+	}
+
+	if( !reads.empty() )
+	{
+		if( !submit( reads ) ) [[unlikely]]
+		{
+			return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		}
+
+		for( std::size_t i = 0; i < Batch::kTargets; ++i )
+		{
+			if( fetched[ i ] )
+			{
+				cacheStore( kBatchRegisters[ i ], current[ i ][ 0 ] );
+				cacheStore( static_cast< std::uint8_t >( kBatchRegisters[ i ] + 1 ), current[ i ][ 1 ] );
+			}
+		}
+	}
+
+	// Changed pairs are written in one transfer, in target order
+	std::array< std::array< std::uint8_t, 2 >, Batch::kTargets > updated{};
+	std::array< bool, Batch::kTargets > changed{};
+	Transaction writes;
+	for( std::size_t i = 0; i < Batch::kTargets; ++i )
+	{
+		if( !batch.m_changes[ i ].touched() )
+		{
+			continue;
+		}
+
+		updated[ i ] = toPair( batch.m_changes[ i ].apply( toPins( current[ i ] ) ) );
+		if( updated[ i ] == current[ i ] )
+		{
+			continue;
+		}
+
+		if( !write( writes, kBatchRegisters[ i ], updated[ i ] ) ) [[unlikely]]
+		{
+			return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+		}
+
+		changed[ i ] = true;
+	}
+
+	if( writes.empty() )
+	{
+		return utils::MakeSuccess();
+	}
+
+	if( !submit( writes ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	for( std::size_t i = 0; i < Batch::kTargets; ++i )
+	{
+		if( changed[ i ] )
+		{
+			cacheStore( kBatchRegisters[ i ], updated[ i ][ 0 ] );
+			cacheStore( static_cast< std::uint8_t >( kBatchRegisters[ i ] + 1 ), updated[ i ][ 1 ] );
+		}
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto MCP23017Controller::readPins() -> Result< std::uint16_t >
 {
-	return utils::MakeError< detail::mcp23017::port::PinModes >( utils::ErrorCode::NOT_IMPLEMENTED );
+	std::array< std::uint8_t, 2 > levels{};
+	if( read( kGpioARegister, levels.data(), levels.size() ) != 2 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	return toPins( levels );
 }
 
-auto MCP23017Controller::Port::setPinModes( [[maybe_unused]] const detail::mcp23017::port::PinModes& modes )
+auto MCP23017Controller::writePins( const std::uint16_t levels ) -> Result< void >
+{
+	if( !writeSequential( kOlatARegister, toPair( levels ) ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto MCP23017Controller::readInterrupts() -> Result< InterruptState >
+{
+	// INTFA, INTFB, INTCAPA and INTCAPB are consecutive
+	std::array< std::uint8_t, 4 > data{};
+	if( read( kIntfARegister, data.data(), data.size() ) != 4 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	return InterruptState{ .flags = toPins( { data[ 0 ], data[ 1 ] } ), .capture = toPins( { data[ 2 ], data[ 3 ] } ) };
+}
+
+auto MCP23017Controller::configureInterruptOutput( const bool mirror, const bool activeHigh, const bool openDrain )
 	-> Result< void >
 {
-	return utils::MakeError< void >( utils::ErrorCode::NOT_IMPLEMENTED );
+	const auto bits = static_cast< std::uint8_t >( ( mirror ? kIoconMirror : 0 ) | ( activeHigh ? kIoconIntpol : 0 ) |
+												   ( openDrain ? kIoconOdr : 0 ) );
+	if( !updateRegister( kIoconRegister, kIoconMirror | kIoconOdr | kIoconIntpol, bits ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	return utils::MakeSuccess();
 }
 
-auto MCP23017Controller::Port::pinStates() -> Result< detail::mcp23017::port::PinStates >
+auto MCP23017Controller::listen( EdgeEventLoop& loop, PinChangeQueue& queue, const std::chrono::milliseconds timeout )
+	-> Result< void >
 {
-	return utils::MakeError< detail::mcp23017::port::PinStates >( utils::Error{ utils::ErrorCode::NOT_IMPLEMENTED } );
+	m_interrupts = {};
+
+	std::array< std::uint8_t, 2 > enabledPair{};
+	if( !readCached( kGpintenARegister, enabledPair[ 0 ] ) || !readCached( kGpintenBRegister, enabledPair[ 1 ] ) )
+		[[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	const auto enabled = toPins( enabledPair );
+
+	// Changes are reported against these levels, reading GPIO also clears a pending interrupt
+	const auto initial = readPins();
+	if( !initial ) [[unlikely]]
+	{
+		return std::unexpected( initial.error() );
+	}
+
+	auto reported = *initial;
+	const auto report = [ & ]( const std::uint16_t pins, const std::uint16_t levels, const Clock::time_point when ) {
+		for( auto changed = static_cast< std::uint16_t >( ( levels ^ reported ) & pins ); changed != 0; )
+		{
+			const auto pin = static_cast< std::uint16_t >( 1u << std::countr_zero( changed ) );
+			changed = static_cast< std::uint16_t >( changed & ~pin );
+			reported = static_cast< std::uint16_t >( reported ^ pin );
+
+			const PinChange change{ .pin = pin,
+									.state = ( levels & pin ) ? Port::PinState::HIGH : Port::PinState::LOW,
+									.timestamp = when };
+			queue.push( change ) ? ++m_interrupts.changes : ++m_interrupts.dropped;
+		}
+	};
+
+	std::array< gpio::EdgeEvent, 16 > events{};
+	while( true )
+	{
+		const auto count = loop.wait( events, timeout );
+		if( !count ) [[unlikely]]
+		{
+			return std::unexpected( count.error() );
+		}
+
+		if( *count == 0 )
+		{
+			return utils::MakeSuccess(); // Stopped
+		}
+
+		m_interrupts.edges += *count;
+
+		// INTFA/B, INTCAPA/B and GPIOA/B are consecutive, reading INTCAP and GPIO clears the interrupt
+		std::array< std::uint8_t, 6 > data{};
+		if( read( kIntfARegister, data.data(), data.size() ) != 6 ) [[unlikely]]
+		{
+			return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		}
+
+		const auto readTime = Clock::now();
+		++m_interrupts.reads;
+
+		// INTCAP holds the levels of the first interrupt since the last clear, signalled by the oldest edge
+		report( toPins( { data[ 0 ], data[ 1 ] } ), toPins( { data[ 2 ], data[ 3 ] } ), events[ 0 ].timestamp );
+
+		// Pins that changed after the capture won't interrupt again once cleared
+		report( enabled, toPins( { data[ 4 ], data[ 5 ] } ), readTime );
+	}
+}
+
+std::uint8_t MCP23017Controller::Port::address( const Register reg ) const noexcept
+{
+	const std::uint8_t offset = m_address == Address::PORT_B ? 1 : 0;
+	return static_cast< std::uint8_t >( static_cast< std::uint8_t >( reg ) + offset );
+}
+
+auto MCP23017Controller::Port::readRegister( const Register reg ) -> Result< std::uint8_t >
+{
+	std::uint8_t value{};
+	if( !m_controller.readCached( address( reg ), value ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	return value;
+}
+
+auto MCP23017Controller::Port::writeRegister( const Register reg, const std::uint8_t value ) -> Result< void >
+{
+	if( !m_controller.write( address( reg ), value ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	return utils::MakeSuccess();
 }
 
-auto MCP23017Controller::Port::setPinStates( [[maybe_unused]] const detail::mcp23017::port::PinStates& states )
+auto MCP23017Controller::Port::updateRegister( const Register reg, const std::uint8_t mask, const bool set )
 	-> Result< void >
 {
-	return utils::MakeError( utils::ErrorCode::NOT_IMPLEMENTED );
+	if( !m_controller.updateRegister( address( reg ), mask, set ? mask : std::uint8_t{} ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto MCP23017Controller::Port::togglePins( const std::uint8_t mask ) -> Result< void >
+{
+	return readRegister( Register::OLAT ).and_then( [ this, mask ]( const std::uint8_t latch ) {
+		return writeRegister( Register::OLAT, static_cast< std::uint8_t >( latch ^ mask ) );
+	} );
+}
+
+auto MCP23017Controller::Port::pinModes() -> Result< detail::mcp23017::port::PinModes >
+{
+	return readRegister( Register::IODIR ).transform( fromRegister< detail::mcp23017::port::PinModes > );
+}
+
+auto MCP23017Controller::Port::setPinModes( const detail::mcp23017::port::PinModes& modes ) -> Result< void >
+{
+	return writeRegister( Register::IODIR, toRegister( modes ) );
+}
+
+auto MCP23017Controller::Port::pinStates() -> Result< detail::mcp23017::port::PinStates >
+{
+	return readRegister( Register::GPIO ).transform( fromRegister< detail::mcp23017::port::PinStates > );
+}
+
+auto MCP23017Controller::Port::setPinStates( const detail::mcp23017::port::PinStates& states ) -> Result< void >
+{
+	return writeRegister( Register::OLAT, toRegister( states ) );
 }
 
 auto MCP23017Controller::Port::pullUps() -> Result< detail::mcp23017::port::PinPullUps >
 {
-	return utils::MakeError< detail::mcp23017::port::PinPullUps >( utils::ErrorCode::NOT_IMPLEMENTED );
+	return readRegister( Register::GPPU ).transform( fromRegister< detail::mcp23017::port::PinPullUps > );
 }
 
-auto MCP23017Controller::Port::setPullUps( [[maybe_unused]] const detail::mcp23017::port::PinPullUps& pullUps )
-	-> Result< void >
+auto MCP23017Controller::Port::setPullUps( const detail::mcp23017::port::PinPullUps& pullUps ) -> Result< void >
 {
-	return utils::MakeError( utils::ErrorCode::NOT_IMPLEMENTED );
+	return writeRegister( Register::GPPU, toRegister( pullUps ) );
 }
 
 auto MCP23017Controller::Port::pinInterruptCapture() -> Result< detail::mcp23017::port::PinInterruptCapture >
 {
-	return utils::MakeError< detail::mcp23017::port::PinInterruptCapture >( utils::ErrorCode::NOT_IMPLEMENTED );
+	return readRegister( Register::INTCAP ).transform( fromRegister< detail::mcp23017::port::PinInterruptCapture > );
 }
 
 auto MCP23017Controller::Port::pinInterruptFlags() -> Result< detail::mcp23017::port::PinInterruptFlags >
 {
-	return utils::MakeError< detail::mcp23017::port::PinInterruptFlags >( utils::ErrorCode::NOT_IMPLEMENTED );
+	return readRegister( Register::INTF ).transform( fromRegister< detail::mcp23017::port::PinInterruptFlags > );
 }
 
 auto MCP23017Controller::Port::clearInterruptFlags() -> Result< void >
 {
-	return utils::MakeError( utils::ErrorCode::NOT_IMPLEMENTED );
+	// Reading INTCAP (or GPIO) clears the interrupt condition
+	return readRegister( Register::INTCAP ).transform( []( std::uint8_t ) { } );
 }
 
 auto MCP23017Controller::Port::interruptEnable() -> Result< detail::mcp23017::port::PinInterruptEnable >
 {
-	return utils::MakeError< detail::mcp23017::port::PinInterruptEnable >( utils::ErrorCode::NOT_IMPLEMENTED );
+	return readRegister( Register::GPINTEN ).transform( fromRegister< detail::mcp23017::port::PinInterruptEnable > );
 }
 
-auto MCP23017Controller::Port::setInterruptEnable(
-	[[maybe_unused]] const detail::mcp23017::port::PinInterruptEnable& mask ) -> Result< void >
+auto MCP23017Controller::Port::setInterruptEnable( const detail::mcp23017::port::PinInterruptEnable& mask )
+	-> Result< void >
 {
-	return utils::MakeError( utils::ErrorCode::NOT_IMPLEMENTED );
+	return writeRegister( Register::GPINTEN, toRegister( mask ) );
 }
 
 auto MCP23017Controller::Port::interruptControl() -> Result< detail::mcp23017::port::PinInterruptControl >
 {
-	return utils::MakeError< detail::mcp23017::port::PinInterruptControl >( utils::ErrorCode::NOT_IMPLEMENTED );
+	return readRegister( Register::INTCON ).transform( fromRegister< detail::mcp23017::port::PinInterruptControl > );
 }
 
-auto MCP23017Controller::Port::setInterruptControl(
-	[[maybe_unused]] const detail::mcp23017::port::PinInterruptControl& control ) -> Result< void >
+auto MCP23017Controller::Port::setInterruptControl( const detail::mcp23017::port::PinInterruptControl& control )
+	-> Result< void >
 {
-	return utils::MakeError( utils::ErrorCode::NOT_IMPLEMENTED );
+	return writeRegister( Register::INTCON, toRegister( control ) );
 }
 
 auto MCP23017Controller::Port::interruptDefaults() -> Result< detail::mcp23017::port::PinDefaultComparison >
 {
-	return utils::MakeError< detail::mcp23017::port::PinDefaultComparison >( utils::ErrorCode::NOT_IMPLEMENTED );
+	return readRegister( Register::DEFVAL ).transform( fromRegister< detail::mcp23017::port::PinDefaultComparison > );
 }
 
-auto MCP23017Controller::Port::setInterruptDefaults(
-	[[maybe_unused]] const detail::mcp23017::port::PinDefaultComparison& defaults ) -> Result< void >
+auto MCP23017Controller::Port::setInterruptDefaults( const detail::mcp23017::port::PinDefaultComparison& defaults )
+	-> Result< void >
 {
-	return utils::MakeError( utils::ErrorCode::NOT_IMPLEMENTED );
+	return writeRegister( Register::DEFVAL, toRegister( defaults ) );
 }
 
 // auto MCP23017Controller::Port::Pin::mode() const -> PinMode
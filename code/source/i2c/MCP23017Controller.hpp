@@ -7,15 +7,24 @@
 #include <utils/Counter.hpp>
 #include <utils/PinConfig.hpp>
 #include <utils/Overloaded.hpp>
+#include <threading/SpscQueue.hpp>
 
 // C++
 #include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <expected>
 #include <functional>
 
 namespace pbl::i2c
 {
 
+inline namespace v1
+{
+class EdgeEventLoop;
+} // namespace v1
+
 // TODO: Add here one more nested namespace detail::mcp23017::port
 namespace detail::mcp23017::port
 {
@@ -150,6 +159,10 @@ using PinInterruptFlags = utils::PinConfig< bool, false >;
  * Additionally, this controller ensures a seamless interaction with the MCP23017 device by abstracting 
  * the I2C communication complexities associated with data writing and retrieval operations.
  *
+ * The configuration registers and the output latches are kept in the register shadow, so changing the
+ * direction, pull-up or output level of a single pin costs one write once the register was accessed.
+ * GPIO, INTF and INTCAP are always read from the device.
+ *
  * Example usage:
  * @code
  * // TBW ...
@@ -185,6 +198,8 @@ public:
 	template < typename T >
 	using Result = utils::Result< T >;
 
+	using Clock = std::chrono::steady_clock;
+
 	class Port
 	{
 		struct PinTag
@@ -274,6 +289,35 @@ public:
 		setInterruptDefaults( const detail::mcp23017::port::PinDefaultComparison& defaults );
 
 	private:
+		/// Port A register addresses (IOCON.BANK = 0), the port B register directly follows each of them.
+		enum class Register : std::uint8_t
+		{
+			IODIR = 0x00,
+			GPINTEN = 0x04,
+			DEFVAL = 0x06,
+			INTCON = 0x08,
+			GPPU = 0x0C,
+			INTF = 0x0E,
+			INTCAP = 0x10,
+			GPIO = 0x12,
+			OLAT = 0x14
+		};
+
+		/// Returns the address of the register for this port.
+		[[nodiscard]] std::uint8_t address( const Register reg ) const noexcept;
+
+		/// Reads the register of this port, cached registers are served from the register shadow.
+		[[nodiscard]] Result< std::uint8_t > readRegister( const Register reg );
+
+		/// Writes the register of this port.
+		[[nodiscard]] Result< void > writeRegister( const Register reg, const std::uint8_t value );
+
+		/// Sets or clears the masked bits of the register, a single write once the register is cached.
+		[[nodiscard]] Result< void > updateRegister( const Register reg, const std::uint8_t mask, const bool set );
+
+		/// Inverts the output latch of the masked pins.
+		[[nodiscard]] Result< void > togglePins( const std::uint8_t mask );
+
 		MCP23017Controller& m_controller;
 		Address m_address;
 
@@ -302,12 +346,95 @@ public:
 
 	using enum Address;
 
+	class Batch;
+
+	/// Interrupt registers of both ports, port A in the low byte.
+	struct InterruptState
+	{
+		std::uint16_t flags{}; //!< INTF, pins that caused the interrupt
+		std::uint16_t capture{}; //!< INTCAP, pin levels when the interrupt occurred
+	};
+
+	/// A change of an input pin, decoded from an interrupt.
+	struct PinChange
+	{
+		std::uint16_t pin{}; //!< Mask of the pin, port A in the low byte (see Batch::mask)
+		Port::PinState state{}; //!< Level the pin changed to
+		Clock::time_point timestamp; //!< Kernel timestamp of the INT edge, the read time if found on the read
+	};
+
+	/// Pin changes handed from the thread listening for interrupts to the consumer.
+	using PinChangeQueue = threading::SpscQueue< PinChange >;
+
+	/// Counters of listen, reset when listening starts.
+	struct InterruptStatistics
+	{
+		std::uint64_t edges{}; //!< INT edges received
+		std::uint64_t reads{}; //!< Interrupt register bursts read
+		std::uint64_t changes{}; //!< Pin changes pushed to the queue
+		std::uint64_t dropped{}; //!< Pin changes lost to a full queue
+	};
+
 	/// Default ctor, all pins are configured as output by default
 	explicit MCP23017Controller( BusController& busController, Address address = H20 ) noexcept;
 
 	[[nodiscard]] auto& portA( this auto& self ) noexcept { return self.m_portA; }
 	[[nodiscard]] auto& portB( this auto& self ) noexcept { return self.m_portB; }
 
+	/**
+	 * @brief Applies the staged pin changes of both ports.
+	 *
+	 * Registers missing from the register shadow are read in one transfer, the changed A/B register
+	 * pairs are then written in one transfer of sequential two byte writes. Output latches are written
+	 * before the directions and interrupt conditions before the enables, so no pin glitches and no
+	 * spurious interrupt is raised in between.
+	 *
+	 * @note Relies on the sequential operation mode (IOCON.SEQOP = 0) and the BANK = 0 register layout.
+	 */
+	[[nodiscard]] Result< void > apply( const Batch& batch );
+
+	/// Reads the levels of all 16 pins (GPIOA and GPIOB) in one transfer, port A in the low byte.
+	[[nodiscard]] Result< std::uint16_t > readPins();
+
+	/// Writes the output latches of both ports (OLATA and OLATB) in one transfer, port A in the low byte.
+	[[nodiscard]] Result< void > writePins( std::uint16_t levels );
+
+	/// Reads INTF and INTCAP of both ports in one transfer, clearing the interrupt condition.
+	[[nodiscard]] Result< InterruptState > readInterrupts();
+
+	/**
+	 * @brief Configures the INT outputs (IOCON).
+	 * @param mirror Whether INTA and INTB are internally connected, either pin then signals both ports.
+	 * @param activeHigh Polarity of the INT pins, active low after power up.
+	 * @param openDrain Whether the INT pins are open drain, overrides the polarity.
+	 */
+	[[nodiscard]] Result< void > configureInterruptOutput( bool mirror, bool activeHigh = false, bool openDrain = false );
+
+	/**
+	 * @brief Pushes the pin changes signalled on INT to the queue until the loop is stopped.
+	 *
+	 * The thread sleeps in the loop until the GPIO line wired to INT (INTA, INTB or both mirrored)
+	 * reports an edge. Each edge is answered with one burst read of INTF, INTCAP and GPIO of both
+	 * ports, which also clears the interrupt. Pins flagged in INTF are reported at their captured
+	 * level with the edge timestamp. Interrupt pins whose level moved on before the interrupt was
+	 * cleared, which the MCP23017 does not signal again, are reported from GPIO with the read time.
+	 * Only level changes are reported, an interrupt repeated for an unchanged pin (INTCON compare
+	 * mode) is not.
+	 *
+	 * @param loop Event loop over the GPIO line connected to INT, edges of the active level requested.
+	 * @param queue Receives the pin changes, single producer is the listening thread.
+	 * @param timeout Longest wait for an edge, negative to wait forever.
+	 * @return Success when the loop was stopped, TIMEOUT or the bus error otherwise.
+	 *
+	 * @note Other calls on the controller must not run concurrently with listen.
+	 */
+	[[nodiscard]] Result< void > listen( EdgeEventLoop& loop,
+										 PinChangeQueue& queue,
+										 std::chrono::milliseconds timeout = std::chrono::milliseconds{ -1 } );
+
+	/// Returns the counters of the last or current listen.
+	[[nodiscard]] const InterruptStatistics& interruptStatistics() const noexcept { return m_interrupts; }
+
 private:
 	MCP23017Controller( const MCP23017Controller& ) = delete;
 	MCP23017Controller& operator=( const MCP23017Controller& ) = delete;
@@ -315,6 +442,7 @@ private:
 private:
 	Port m_portA;
 	Port m_portB;
+	InterruptStatistics m_interrupts;
 };
 
 template < typename Dispatcher >
@@ -361,12 +489,8 @@ public:
 		return std::invoke( m_dispatcher, detail::mcp23017::port::PinState{}, m_pin, state );
 	}
 
-	[[nodiscard]] Result< void > switchPinState()
-	{
-		return pinState()
-			.transform( utils::Toggle< PinState >{ PinState::HIGH, PinState::LOW } )
-			.and_then( [ this ]( PinState newState ) -> Result< void > { return setPinState( newState ); } );
-	}
+	/// Inverts the output latch of the pin, a single write once the latch is cached.
+	[[nodiscard]] Result< void > switchPinState() { return m_port.togglePins( static_cast< std::uint8_t >( m_pin ) ); }
 
 	// Enable or disable the pull-up resistor for this pin
 	[[nodiscard]] Result< void > setPullUpResistor( bool enable )
@@ -378,8 +502,12 @@ public:
 	[[nodiscard]] Result< void >
 	enableInterrupt( bool enable, bool compareWithDefault = false, PinState defaultValue = PinState::LOW )
 	{
-		return std::invoke(
-			m_dispatcher, detail::mcp23017::port::PinInterruptControl{}, enable, compareWithDefault, defaultValue );
+		return std::invoke( m_dispatcher,
+							detail::mcp23017::port::PinInterruptControl{},
+							m_pin,
+							enable,
+							compareWithDefault,
+							defaultValue );
 	}
 
 	[[nodiscard]] Result< void > setInterruptTrigger( detail::mcp23017::port::InterruptControl controlMode,
@@ -409,6 +537,129 @@ private:
 	Dispatcher m_dispatcher;
 };
 
+/**
+ * @brief Pin changes of both ports, staged without bus access and applied by MCP23017Controller::apply.
+ *
+ * Pins are addressed by a 16-bit mask, port A in the low byte and port B in the high byte, the order
+ * in which BANK = 0 interleaves the registers. A later change of a pin replaces an earlier one.
+ *
+ * @code
+ * using Batch = MCP23017Controller::Batch;
+ * auto rslt = mcp23017.apply( Batch{}.setMode( 0x00FF, PinMode::OUTPUT ).setState( 0x00AA, PinState::HIGH ) );
+ * @endcode
+ */
+class MCP23017Controller::Batch final
+{
+public:
+	using Pins = Port::Pins;
+	using PinMode = Port::PinMode;
+	using PinState = Port::PinState;
+	using InterruptControl = detail::mcp23017::port::InterruptControl;
+
+	/// Returns the mask of a single pin.
+	[[nodiscard]] static constexpr std::uint16_t mask( const Port::Address port, const Pins pin ) noexcept
+	{
+		const auto bit = static_cast< std::uint16_t >( pin );
+		return port == Port::Address::PORT_B ? static_cast< std::uint16_t >( bit << 8 ) : bit;
+	}
+
+	/// Stages the direction of the pins (IODIR).
+	constexpr Batch& setMode( const std::uint16_t pins, const PinMode mode ) noexcept
+	{
+		return stage( Target::IODIR, pins, mode == PinMode::INPUT );
+	}
+
+	/// Stages the output level of the pins (OLAT).
+	constexpr Batch& setState( const std::uint16_t pins, const PinState state ) noexcept
+	{
+		return stage( Target::OLAT, pins, state == PinState::HIGH );
+	}
+
+	/// Stages the inversion of the output level of the pins (OLAT).
+	constexpr Batch& toggle( const std::uint16_t pins ) noexcept
+	{
+		auto& change = m_changes[ static_cast< std::size_t >( Target::OLAT ) ];
+		const auto set = static_cast< std::uint16_t >( change.set & pins );
+		const auto clear = static_cast< std::uint16_t >( change.clear & pins );
+		change.set = static_cast< std::uint16_t >( ( change.set & ~pins ) | clear );
+		change.clear = static_cast< std::uint16_t >( ( change.clear & ~pins ) | set );
+		change.toggle ^= static_cast< std::uint16_t >( pins & ~( set | clear ) );
+		return *this;
+	}
+
+	/// Stages the pull-up resistors of the pins (GPPU).
+	constexpr Batch& setPullUp( const std::uint16_t pins, const bool enable ) noexcept
+	{
+		return stage( Target::GPPU, pins, enable );
+	}
+
+	/// Stages the interrupt-on-change configuration of the pins (INTCON, DEFVAL and GPINTEN).
+	constexpr Batch& enableInterrupt( const std::uint16_t pins,
+									  const bool enable,
+									  const InterruptControl control = InterruptControl::PREVIOUS,
+									  const PinState defaultValue = PinState::LOW ) noexcept
+	{
+		return stage( Target::INTCON, pins, control == InterruptControl::COMPARE )
+			.stage( Target::DEFVAL, pins, defaultValue == PinState::HIGH )
+			.stage( Target::GPINTEN, pins, enable );
+	}
+
+	/// Whether no change is staged.
+	[[nodiscard]] constexpr bool empty() const noexcept
+	{
+		for( const auto& change : m_changes )
+		{
+			if( change.touched() )
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+private:
+	friend class MCP23017Controller;
+
+	/// Staged registers, in the order they are written.
+	enum class Target : std::uint8_t
+	{
+		OLAT,
+		GPPU,
+		DEFVAL,
+		INTCON,
+		IODIR,
+		GPINTEN
+	};
+
+	static constexpr std::size_t kTargets{ 6 };
+
+	struct Change
+	{
+		std::uint16_t set{};
+		std::uint16_t clear{};
+		std::uint16_t toggle{};
+
+		[[nodiscard]] constexpr bool touched() const noexcept { return ( set | clear | toggle ) != 0; }
+
+		[[nodiscard]] constexpr std::uint16_t apply( const std::uint16_t value ) const noexcept
+		{
+			return static_cast< std::uint16_t >( ( ( value & ~clear ) | set ) ^ toggle );
+		}
+	};
+
+	constexpr Batch& stage( const Target target, const std::uint16_t pins, const bool value ) noexcept
+	{
+		auto& change = m_changes[ static_cast< std::size_t >( target ) ];
+		change.set = static_cast< std::uint16_t >( value ? change.set | pins : change.set & ~pins );
+		change.clear = static_cast< std::uint16_t >( value ? change.clear & ~pins : change.clear | pins );
+		change.toggle = static_cast< std::uint16_t >( change.toggle & ~pins );
+		return *this;
+	}
+
+	std::array< Change, kTargets > m_changes{};
+};
+
 } // namespace pbl::i2c
 
 #include "MCP23017Controller.ipp"
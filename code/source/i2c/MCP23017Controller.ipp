@@ -1,6 +1,9 @@
 #ifndef PBL_I2C_MCP23017_CONTROLLER_IPP__
 #define PBL_I2C_MCP23017_CONTROLLER_IPP__
 
+// C++
+#include <bit>
+
 namespace pbl::i2c
 {
 
@@ -11,110 +14,49 @@ namespace pbl::i2c
 	auto dispatcher = utils::Overloaded{
 		//  IODIR (PinModes)
 		[ this ]( dmp::PinModes, Pins inPin ) -> Result< PinMode > {
-			return pinModes().and_then( [ inPin ]( const auto& modes ) -> Result< PinMode > {
-				if( auto mode = modes[ static_cast< std::size_t >( inPin ) ] )
-				{
-					return *mode;
-				}
-				return utils::MakeError< PinMode >( utils::ErrorCode::INVALID_ARGUMENT );
+			return pinModes().transform( [ inPin ]( const auto& modes ) {
+				return *modes[ static_cast< std::size_t >( std::countr_zero( static_cast< std::uint8_t >( inPin ) ) ) ];
 			} );
 		},
 		[ this ]( dmp::PinModes, Pins inPin, PinMode mode ) -> Result< void > {
-			return pinModes().and_then( [ this, inPin, mode ]( auto modes ) -> Result< void > {
-				if( !modes.setPin( static_cast< std::size_t >( inPin ), mode ) )
-				{
-					return utils::MakeError< void >( utils::ErrorCode::UNEXPECTED_ERROR );
-				}
-				return setPinModes( modes );
-			} );
+			return updateRegister( Register::IODIR, static_cast< std::uint8_t >( inPin ), mode == PinMode::INPUT );
 		},
 
-		//  GPIO (PinState)
+		//  GPIO (PinState), outputs are driven through the output latch
 		[ this ]( dmp::PinState, Pins inPin ) -> Result< PinState > {
-			return pinStates().and_then( [ inPin ]( const auto& states ) -> Result< PinState > {
-				if( auto state = states[ static_cast< std::size_t >( inPin ) ] )
-				{
-					return *state;
-				}
-				return utils::MakeError< PinState >( utils::ErrorCode::INVALID_ARGUMENT );
+			return pinStates().transform( [ inPin ]( const auto& states ) {
+				return *states[ static_cast< std::size_t >( std::countr_zero( static_cast< std::uint8_t >( inPin ) ) ) ];
 			} );
 		},
 		[ this ]( dmp::PinState, Pins inPin, PinState state ) -> Result< void > {
-			return pinStates().and_then( [ this, inPin, state ]( auto states ) -> Result< void > {
-				if( !states.setPin( static_cast< std::size_t >( inPin ), state ) )
-				{
-					return utils::MakeError< void >( utils::ErrorCode::UNEXPECTED_ERROR );
-				}
-				return setPinStates( states );
-			} );
+			return updateRegister( Register::OLAT, static_cast< std::uint8_t >( inPin ), state == PinState::HIGH );
 		},
 
 		//  GPPU (Pull-Up Resistor)
 		[ this ]( dmp::PinPullUps, Pins inPin, bool enable ) -> Result< void > {
-			return pullUps().and_then( [ this, inPin, enable ]( auto pulls ) -> Result< void > {
-				if( !pulls.setPin( static_cast< std::size_t >( inPin ), enable ) )
-				{
-					return utils::MakeError< void >( utils::ErrorCode::UNEXPECTED_ERROR );
-				}
-				return setPullUps( pulls );
-			} );
+			return updateRegister( Register::GPPU, static_cast< std::uint8_t >( inPin ), enable );
 		},
 
-		// INTCON, DEFVAL, GPINTEN (Interrupt Control)
+		// INTCON, DEFVAL, GPINTEN (Interrupt Control), applied together
 		[ this ]( dmp::PinInterruptControl, Pins inPin, bool enable, bool compareWithDefault, PinState defaultValue )
 			-> Result< void > {
-			return interruptControl()
-				.and_then( [ this, inPin, compareWithDefault ]( auto intcon ) -> Result< void > {
-					if( !intcon.setPin( static_cast< std::size_t >( inPin ),
-										utils::select( compareWithDefault,
-													   dmp::InterruptControl::COMPARE,
-													   dmp::InterruptControl::PREVIOUS ) ) )
-					{
-						return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
-					}
-
-					return setInterruptControl( intcon );
-				} )
-				.and_then( [ this, inPin, defaultValue ] {
-					return interruptDefaults().and_then( [ this, inPin, defaultValue ](
-															 auto defval ) -> Result< void > {
-						if( !defval.setPin( static_cast< std::size_t >( inPin ), defaultValue == dmp::PinState::HIGH ) )
-						{
-							return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
-						}
-
-						return setInterruptDefaults( defval );
-					} );
-				} )
-				.and_then( [ this, inPin, enable, defaultValue ] {
-					return interruptEnable().and_then(
-						[ this, inPin, enable, defaultValue ]( auto enables ) -> Result< void > {
-							if( !enables.setPin( static_cast< std::size_t >( inPin ), enable ) )
-							{
-								return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
-							}
-
-							return setInterruptEnable( enables );
-						} );
-				} );
+			const auto control = compareWithDefault ? dmp::InterruptControl::COMPARE : dmp::InterruptControl::PREVIOUS;
+			return m_controller.apply(
+				Batch{}.enableInterrupt( Batch::mask( m_address, inPin ), enable, control, defaultValue ) );
 		},
 
 		// INTF (Interrupt Flag): check flag
 		[ this ]( dmp::PinInterruptFlags, Pins inPin ) -> Result< bool > {
 			return pinInterruptFlags().transform( [ inPin ]( const auto& flags ) {
-				return flags[ static_cast< std::size_t >( inPin ) ].value_or( false );
+				return flags[ static_cast< std::size_t >( std::countr_zero( static_cast< std::uint8_t >( inPin ) ) ) ]
+					.value_or( false );
 			} );
 		},
 
 		//  INTCAP (Interrupt Capture)
 		[ this ]( dmp::PinInterruptCapture, Pins inPin ) -> Result< PinState > {
-			return pinInterruptCapture().and_then( [ inPin ]( const auto& cap ) -> Result< PinState > {
-				if( auto val = cap[ static_cast< std::size_t >( inPin ) ] )
-				{
-					return *val;
-				}
-
-				return utils::MakeError< PinState >( utils::ErrorCode::INVALID_ARGUMENT );
+			return pinInterruptCapture().transform( [ inPin ]( const auto& cap ) {
+				return *cap[ static_cast< std::size_t >( std::countr_zero( static_cast< std::uint8_t >( inPin ) ) ) ];
 			} );
 		}
 
@@ -1,15 +1,109 @@
 #include "MPU6050Controller.hpp"
 #include "MPU6050Definitions.hpp"
 #include "BusController.hpp"
+#include "Transaction.hpp"
+#include "EdgeEventLoop.hpp"
+
+#include <math/Constants.hpp>
 
 // C++
+#include <array>
 #include <bitset>
+#include <algorithm>
 
 // https://howtomechatronics.com/tutorials/arduino/arduino-and-mpu6050-accelerometer-and-gyroscope-tutorial/
 
 namespace pbl::i2c
 {
 
+namespace
+{
+
+constexpr std::size_t kFifoSize{ 1024 }; //!< FIFO capacity in bytes, also the burst limit
+constexpr std::size_t kAccelGyroFrameSize{ 12 };
+constexpr std::size_t kTemperatureFrameSize{ 2 };
+
+constexpr std::chrono::nanoseconds kGyroOutputPeriod{ 1'000'000 }; //!< 1kHz with the DLPF enabled
+constexpr std::chrono::nanoseconds kGyroOutputPeriodNoDlpf{ 125'000 }; //!< 8kHz with the DLPF disabled
+
+/// Accelerometer LSB per g of the scales (ACCEL_2G to ACCEL_16G).
+constexpr std::array kAccelSensitivity{ 16384.0f, 8192.0f, 4096.0f, 2048.0f };
+
+/// Gyroscope LSB per degree per second of the scales (GYRO_250DPS to GYRO_2000DPS).
+constexpr std::array kGyroSensitivity{ 131.0f, 65.5f, 32.8f, 16.4f };
+
+constexpr float kStandardGravity{ 9.80665f }; //!< m/s² per g
+constexpr float kDegreesToRadians{ math::constants::Pi< float > / 180.0f };
+constexpr float kTemperatureSensitivity{ 340.0f }; //!< LSB per °C
+constexpr float kTemperatureOffset{ 36.53f }; //!< °C at a raw value of zero
+
+/// Number of conversion lanes, the seven outputs of a frame and one padding lane.
+constexpr std::size_t kLanes{ 8 };
+
+/// Units the conversion produces.
+enum class Units : std::uint8_t
+{
+	SI, //!< m/s², °C and rad/s
+	SENSOR //!< g, °C and °/s, the units of the datasheet
+};
+
+/// Per lane factors of the conversion, the lanes follow the registers: accel XYZ, temperature, gyro XYZ, padding.
+struct Factors
+{
+	alignas( 32 ) std::array< float, kLanes > scale{};
+	alignas( 32 ) std::array< float, kLanes > offset{};
+};
+
+using Lanes = std::array< float, kLanes >;
+
+/// Returns the conversion factors of the scales, both accelerometer and gyroscope scales select by their range.
+[[nodiscard]] constexpr Factors
+factors( const MPU6050Controller::Scale accelScale, const MPU6050Controller::Scale gyroScale, const Units units ) noexcept
+{
+	// ACCEL_2G and GYRO_250DPS start a group of four, the low bits select the range
+	const float accel = ( units == Units::SI ? kStandardGravity : 1.0f ) /
+						kAccelSensitivity[ static_cast< std::size_t >( accelScale ) & 0x03 ];
+	const float gyro = ( units == Units::SI ? kDegreesToRadians : 1.0f ) /
+					   kGyroSensitivity[ static_cast< std::size_t >( gyroScale ) & 0x03 ];
+	const float temperature = 1.0f / kTemperatureSensitivity;
+
+	return Factors{ .scale{ accel, accel, accel, temperature, gyro, gyro, gyro, 0.0f },
+					.offset{ 0.0f, 0.0f, 0.0f, kTemperatureOffset, 0.0f, 0.0f, 0.0f, 0.0f } };
+}
+
+/**
+ * @brief Converts raw frames to floating point lanes, a byte swap and a multiply-add per output.
+ *
+ * Every frame is widened to eight big endian words so the inner loop has a fixed trip count and
+ * no dependencies between lanes, which GCC and Clang turn into SSE/AVX or NEON code at -O2/-O3.
+ */
+void convertFrames( const std::span< const MPU6050Controller::RawFrame > frames,
+					const std::span< Lanes > lanes,
+					const Factors& factors ) noexcept
+{
+	for( std::size_t n = 0; n < frames.size(); ++n )
+	{
+		std::array< std::uint8_t, 2 * kLanes > bytes{};
+		std::ranges::copy( frames[ n ], bytes.begin() );
+
+		for( std::size_t lane = 0; lane < kLanes; ++lane )
+		{
+			const auto word = static_cast< std::int16_t >( ( bytes[ 2 * lane ] << 8 ) | bytes[ 2 * lane + 1 ] );
+			lanes[ n ][ lane ] = static_cast< float >( word ) * factors.scale[ lane ] + factors.offset[ lane ];
+		}
+	}
+}
+
+/// Returns the measurement of converted lanes.
+[[nodiscard]] constexpr MPU6050Controller::Measurement toMeasurement( const Lanes& lanes ) noexcept
+{
+	return MPU6050Controller::Measurement{ .acceleration{ lanes[ 0 ], lanes[ 1 ], lanes[ 2 ] },
+										   .temperatureC = lanes[ 3 ],
+										   .angularRate{ lanes[ 4 ], lanes[ 5 ], lanes[ 6 ] } };
+}
+
+} // namespace
+
 v1::MPU6050Controller::MPU6050Controller( BusController& busController, Address address ) noexcept
 	: ICBase{ busController, address }
 { }
@@ -63,6 +157,8 @@ auto v1::MPU6050Controller::configureScales( Scale accelScale, Scale gyroScale )
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
+	m_accelScale = accelScale;
+	m_gyroScale = gyroScale;
 	return utils::MakeSuccess();
 }
 
@@ -150,105 +246,386 @@ auto v1::MPU6050Controller::calculateImuError() -> Result< void >
 	// TODO: Think about flashing/embedding the calibration constants
 	// maybe we could provide them as arguments?
 
-	using namespace mpu6050;
+	// Every iteration is one readAll burst, converted with the configured scales. The angles do not
+	// depend on the acceleration unit, the gyroscope errors are kept in degrees per second.
+	constexpr std::size_t iterations = std::max( kAccelCalibReadIterations, kGyroCalibReadIterations );
+
+	CalibrationConstants calibration{};
+	for( std::size_t count = 0; count < iterations; ++count )
+	{
+		const auto measurement = readAll();
+		if( !measurement ) [[unlikely]]
+		{
+			return std::unexpected( measurement.error() );
+		}
 
-	std::size_t count{};
+		if( count < kAccelCalibReadIterations )
+		{
+			const auto accX = static_cast< double >( measurement->acceleration.x() );
+			const auto accY = static_cast< double >( measurement->acceleration.y() );
+			const auto accZ = static_cast< double >( measurement->acceleration.z() );
+
+			// Calculate angle errors
+			calibration.AccErrorX += std::atan2( accY, std::sqrt( accX * accX + accZ * accZ ) ) * 180.0 / M_PI;
+			calibration.AccErrorY += std::atan2( -accX, std::sqrt( accY * accY + accZ * accZ ) ) * 180.0 / M_PI;
+		}
 
-	double accErrorX{ 0.0 };
-	double accErrorY{ 0.0 };
+		if( count < kGyroCalibReadIterations )
+		{
+			calibration.GyroErrorX += static_cast< double >( measurement->angularRate.x() / kDegreesToRadians );
+			calibration.GyroErrorY += static_cast< double >( measurement->angularRate.y() / kDegreesToRadians );
+			calibration.GyroErrorZ += static_cast< double >( measurement->angularRate.z() / kDegreesToRadians );
+		}
+	}
 
-	// Read accelerometer data
-	for( count = 0; count < kAccelCalibReadIterations; ++count )
+	calibration.AccErrorX /= static_cast< double >( kAccelCalibReadIterations );
+	calibration.AccErrorY /= static_cast< double >( kAccelCalibReadIterations );
+	calibration.GyroErrorX /= static_cast< double >( kGyroCalibReadIterations );
+	calibration.GyroErrorY /= static_cast< double >( kGyroCalibReadIterations );
+	calibration.GyroErrorZ /= static_cast< double >( kGyroCalibReadIterations );
+
+	m_calibration = calibration;
+	return utils::MakeSuccess();
+}
+
+auto v1::MPU6050Controller::readAll() -> Result< Measurement >
+{
+	// ACCEL_XOUT_H (0x3B) to GYRO_ZOUT_L (0x48) in one transfer, a consistent set of outputs
+	std::array< RawFrame, 1 > raw{};
+	if( read( mpu6050::kAccelXOutHRegister, raw[ 0 ].data(), raw[ 0 ].size() ) !=
+		static_cast< std::int16_t >( raw[ 0 ].size() ) ) [[unlikely]]
 	{
-		std::array< uint8_t, 6 > raw{};
-		if( read( kAccelXOutHRegister, raw.data(), raw.size() ) < 6 )
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	std::array< Lanes, 1 > lanes{};
+	convertFrames( raw, lanes, factors( m_accelScale, m_gyroScale, Units::SI ) );
+	return utils::MakeSuccess( toMeasurement( lanes[ 0 ] ) );
+}
+
+std::size_t v1::MPU6050Controller::convert( const std::span< const RawFrame > frames,
+											const std::span< Measurement > measurements,
+											const Scale accelScale,
+											const Scale gyroScale ) noexcept
+{
+	// Blocks keep the lanes on the stack and the kernel free of the Measurement layout
+	constexpr std::size_t kBlockSize{ 64 };
+
+	const Factors conversion = factors( accelScale, gyroScale, Units::SI );
+	const std::size_t count = std::min( frames.size(), measurements.size() );
+
+	std::array< Lanes, kBlockSize > lanes;
+	for( std::size_t first = 0; first < count; first += kBlockSize )
+	{
+		const std::size_t size = std::min( kBlockSize, count - first );
+		convertFrames( frames.subspan( first, size ), std::span{ lanes }.first( size ), conversion );
+
+		for( std::size_t i = 0; i < size; ++i )
 		{
-			return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+			measurements[ first + i ] = toMeasurement( lanes[ i ] );
 		}
+	}
+
+	return count;
+}
+
+auto v1::MPU6050Controller::angles() -> Result< math::Vector3f >
+{
+	const auto measurement = readAll();
+	if( !measurement ) [[unlikely]]
+	{
+		return std::unexpected( measurement.error() );
+	}
+
+	constexpr float kRadiansToDegrees{ 180.0f / math::constants::Pi< float > };
+
+	// Roll and pitch only depend on the direction of gravity, the units cancel out
+	const float accX = measurement->acceleration.x();
+	const float accY = measurement->acceleration.y();
+	const float accZ = measurement->acceleration.z();
+
+	const float roll = std::atan2( accY, std::sqrt( accX * accX + accZ * accZ ) ) * kRadiansToDegrees;
+	const float pitch = std::atan2( -accX, std::sqrt( accY * accY + accZ * accZ ) ) * kRadiansToDegrees;
 
-		const auto rawX = static_cast< std::int16_t >( raw[ 0 ] << 8 | raw[ 1 ] );
-		const auto rawY = static_cast< std::int16_t >( raw[ 2 ] << 8 | raw[ 3 ] );
-		const auto rawZ = static_cast< std::int16_t >( raw[ 4 ] << 8 | raw[ 5 ] );
+	// TODO: Add elapsed time delta for true yaw integration
+	// For now, just return raw gyro Z
+	const float yaw = measurement->angularRate.z() * kRadiansToDegrees;
+
+	return utils::MakeSuccess( math::Vector3f{ roll, pitch, yaw } );
+}
+
+auto v1::MPU6050Controller::startFifo( const FifoOptions& options ) -> Result< void >
+{
+	using namespace mpu6050;
+
+	// SMPLRT_DIV and CONFIG are adjacent
+	std::array< std::uint8_t, 2 > rate{};
+	if( read( kSampleRateDividerRegister, rate.data(), rate.size() ) < 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
 
-		const auto accX = static_cast< double >( rawX ) / 16384.0;
-		const auto accY = static_cast< double >( rawY ) / 16384.0;
-		const auto accZ = static_cast< double >( rawZ ) / 16384.0;
+	std::uint8_t userControl{};
+	if( !read( kUserControlRegister, userControl ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
 
-		// Calculate angle errors
-		accErrorX += std::atan2( accY, std::sqrt( accX * accX + accZ * accZ ) ) * 180.0 / M_PI;
-		accErrorY += std::atan2( -accX, std::sqrt( accY * accY + accZ * accZ ) ) * 180.0 / M_PI;
+	auto sources = static_cast< std::uint8_t >(
+		static_cast< std::uint8_t >( FifoEnable::ACCEL_FIFO_EN ) | static_cast< std::uint8_t >( FifoEnable::XG_FIFO_EN ) |
+		static_cast< std::uint8_t >( FifoEnable::YG_FIFO_EN ) | static_cast< std::uint8_t >( FifoEnable::ZG_FIFO_EN ) );
+	if( options.temperature )
+	{
+		sources |= static_cast< std::uint8_t >( FifoEnable::TEMP_FIFO_EN );
 	}
 
-	accErrorX /= static_cast< double >( kAccelCalibReadIterations );
-	accErrorY /= static_cast< double >( kAccelCalibReadIterations );
+	// Select the sources, then clear and enable the FIFO
+	if( !write( kFifoEnableRegister, sources ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
 
-	// --- Gyroscope Calibration ---
+	if( auto rslt = resetFifo( userControl ); !rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
 
-	count = 0;
+	// DLPF_CFG 0 and 7 disable the low pass filter, the gyroscope then outputs at 8kHz
+	const auto dlpf = rate[ 1 ] & 0x07;
+	const auto outputPeriod = ( dlpf == 0 || dlpf == 7 ) ? kGyroOutputPeriodNoDlpf : kGyroOutputPeriod;
 
-	double gyroErrorX{};
-	double gyroErrorY{};
-	double gyroErrorZ{};
+	m_fifo.running = true;
+	m_fifo.temperature = options.temperature;
+	m_fifo.frameSize = kAccelGyroFrameSize + ( options.temperature ? kTemperatureFrameSize : 0 );
+	m_fifo.period = std::chrono::duration_cast< Clock::duration >( outputPeriod * ( 1 + rate[ 0 ] ) );
+	m_fifo.last.reset();
+	m_fifo.statistics = {};
 
-	for( count = 0; count < kGyroCalibReadIterations; ++count )
+	if( m_fifo.samples.capacity() != options.capacity )
 	{
-		std::array< uint8_t, 6 > raw{};
-		if( read( kGyroXOutHRegister, raw.data(), raw.size() ) < 6 )
+		m_fifo.samples = utils::RingBuffer< FifoSample >{ options.capacity };
+	}
+	m_fifo.samples.clear();
+
+	return utils::MakeSuccess();
+}
+
+auto v1::MPU6050Controller::startFifo() -> Result< void >
+{
+	return startFifo( FifoOptions{} );
+}
+
+auto v1::MPU6050Controller::drainFifo() -> Result< std::size_t >
+{
+	using namespace mpu6050;
+
+	if( !m_fifo.running ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	// The overflow flag and the FIFO count in one combined transfer, reading INT_STATUS clears it
+	std::uint8_t status{};
+	std::array< std::uint8_t, 2 > count{};
+	Transaction transaction;
+	const bool queued = read( transaction, kIntStatusRegister, std::span{ &status, 1 } ) &&
+						read( transaction, kFifoCountHRegister, count );
+	if( !queued || !submit( transaction ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	const auto available = static_cast< std::size_t >( ( count[ 0 ] << 8 ) | count[ 1 ] );
+	const auto now = Clock::now();
+
+	if( status & static_cast< std::uint8_t >( InterruptEnable::FIFO_OFLOW_INT ) || available >= kFifoSize )
+	{
+		// The oldest bytes were overwritten, the frame boundaries are unknown. Start over.
+		std::uint8_t userControl{};
+		if( !read( kUserControlRegister, userControl ) ) [[unlikely]]
+		{
 			return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		}
+
+		if( auto rslt = resetFifo( userControl ); !rslt ) [[unlikely]]
+		{
+			return std::unexpected( rslt.error() );
+		}
 
-		const int16_t rawX = static_cast< int16_t >( raw[ 0 ] << 8 | raw[ 1 ] );
-		const int16_t rawY = static_cast< int16_t >( raw[ 2 ] << 8 | raw[ 3 ] );
-		const int16_t rawZ = static_cast< int16_t >( raw[ 4 ] << 8 | raw[ 5 ] );
+		++m_fifo.statistics.overflows;
+		m_fifo.last.reset();
+		return utils::MakeSuccess( std::size_t{} );
+	}
 
-		gyroErrorX += static_cast< double >( rawX ) / 131.0;
-		gyroErrorY += static_cast< double >( rawY ) / 131.0;
-		gyroErrorZ += static_cast< double >( rawZ ) / 131.0;
+	// Whole frames only, the rest is read by the next drain
+	const auto frames = available / m_fifo.frameSize;
+	if( frames == 0 )
+	{
+		return utils::MakeSuccess( std::size_t{} );
 	}
 
-	gyroErrorX /= static_cast< double >( kGyroCalibReadIterations );
-	gyroErrorY /= static_cast< double >( kGyroCalibReadIterations );
-	gyroErrorZ /= static_cast< double >( kGyroCalibReadIterations );
+	std::array< std::uint8_t, kFifoSize > buffer{};
+	const auto bytes = std::span{ buffer }.first( frames * m_fifo.frameSize );
+	if( read( kFifoReadWriteRegister, bytes.data(), static_cast< std::uint16_t >( bytes.size() ) ) < 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
 
-	// You could store these for compensation later, e.g.:
-	// this->m_calibration = { accErrorX, accErrorY, gyroErrorX, gyroErrorY, gyroErrorZ };
+	++m_fifo.statistics.bursts;
 
-	return utils::MakeSuccess();
+	// The newest sample was taken just before the read, the others one period apart. When that would reach
+	// back before the previous drain (the sensor clock runs faster than nominal), spread them evenly instead.
+	const auto samples = static_cast< Clock::rep >( frames );
+	auto step = m_fifo.period;
+	auto timestamp = now - m_fifo.period * ( samples - 1 );
+	if( m_fifo.last && timestamp <= *m_fifo.last )
+	{
+		step = ( now - *m_fifo.last ) / samples;
+		timestamp = *m_fifo.last + step;
+	}
+
+	for( std::size_t i = 0; i < frames; ++i, timestamp += step )
+	{
+		auto sample = decodeFrame( bytes.subspan( i * m_fifo.frameSize, m_fifo.frameSize ) );
+		sample.timestamp = timestamp;
+		m_fifo.samples.push( sample );
+	}
+
+	m_fifo.last = timestamp - step;
+	m_fifo.statistics.samples += frames;
+	return utils::MakeSuccess( frames );
 }
 
-auto v1::MPU6050Controller::angles() -> Result< math::Vector3f >
+auto v1::MPU6050Controller::acquire( EdgeEventLoop& loop,
+									  DataReadyCallback callback,
+									  const std::chrono::milliseconds timeout ) -> Result< void >
 {
-	// 1. Read raw accelerometer values
-	std::array< uint8_t, 6 > accData{};
-	if( read( mpu6050::kAccelXOutHRegister, accData.data(), accData.size() ) != 6 )
+	using namespace mpu6050;
+
+	std::uint8_t enabled{};
+	if( !read( kIntEnableRegister, enabled ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	auto readWord = []( uint8_t high, uint8_t low ) { return static_cast< int16_t >( ( high << 8 ) | low ); };
+	if( !write( kIntEnableRegister,
+				static_cast< std::uint8_t >( enabled | static_cast< std::uint8_t >( InterruptEnable::DATA_RDY_INT ) ) ) )
+		[[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	m_dataReady = {};
+
+	std::array< gpio::EdgeEvent, 16 > events{};
+	while( true )
+	{
+		const auto count = loop.wait( events, timeout );
+		if( !count ) [[unlikely]]
+		{
+			return std::unexpected( count.error() );
+		}
+
+		if( *count == 0 )
+		{
+			return utils::MakeSuccess(); // Stopped
+		}
+
+		// Only the newest edge has its outputs still in the registers
+		std::optional< Clock::time_point > newest;
+		std::uint64_t edges{};
+		for( const auto& event : std::span{ events }.first( *count ) )
+		{
+			if( event.edge == gpio::Edge::RISING )
+			{
+				newest = event.timestamp;
+				++edges;
+			}
+		}
+
+		if( !newest )
+		{
+			continue;
+		}
+
+		m_dataReady.edges += edges;
+		m_dataReady.missed += edges - 1;
+
+		const auto measurement = readAll();
+		if( !measurement ) [[unlikely]]
+		{
+			return std::unexpected( measurement.error() );
+		}
 
-	const auto accX = static_cast< float >( readWord( accData[ 0 ], accData[ 1 ] ) ) / 16384.0f;
-	const auto accY = static_cast< float >( readWord( accData[ 2 ], accData[ 3 ] ) ) / 16384.0f;
-	const auto accZ = static_cast< float >( readWord( accData[ 4 ], accData[ 5 ] ) ) / 16384.0f;
+		++m_dataReady.samples;
 
-	const float roll =
-		std::atan2( accY, std::sqrt( accX * accX + accZ * accZ ) ) * 180.0f / static_cast< float >( M_PI );
-	const float pitch =
-		std::atan2( -accX, std::sqrt( accY * accY + accZ * accZ ) ) * 180.0f / static_cast< float >( M_PI );
+		if( !callback( DataReadySample{ .timestamp = *newest, .measurement = *measurement } ) )
+		{
+			return utils::MakeSuccess();
+		}
+	}
+}
+
+auto v1::MPU6050Controller::stopFifo() -> Result< void >
+{
+	using namespace mpu6050;
 
-	// 2. Read raw gyroscope values
-	std::array< uint8_t, 6 > gyroData{};
-	if( read( mpu6050::kGyroXOutHRegister, gyroData.data(), gyroData.size() ) != 6 )
+	std::uint8_t userControl{};
+	if( !read( kUserControlRegister, userControl ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	const float gyroZ = static_cast< float >( readWord( gyroData[ 4 ], gyroData[ 5 ] ) ) / 131.0f;
+	userControl &= static_cast< std::uint8_t >( ~static_cast< std::uint8_t >( UserControl::FIFO_EN ) );
+	if( !write( kUserControlRegister, userControl ) || !write( kFifoEnableRegister, 0x00 ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
 
-	// TODO: Add elapsed time delta for true yaw integration
-	// For now, just return raw gyro Z
-	const float yaw = gyroZ;
+	m_fifo.running = false;
+	return utils::MakeSuccess();
+}
 
-	return utils::MakeSuccess( math::Vector3f{ roll, pitch, yaw } );
+auto v1::MPU6050Controller::resetFifo( const std::uint8_t userControl ) -> Result< void >
+{
+	using namespace mpu6050;
+
+	constexpr auto fifoEnable = static_cast< std::uint8_t >( UserControl::FIFO_EN );
+	constexpr auto fifoReset = static_cast< std::uint8_t >( UserControl::FIFO_RESET );
+
+	// The reset only takes effect with FIFO_EN cleared: disable, reset, enable again
+	const auto disabled = static_cast< std::uint8_t >( userControl & ~( fifoEnable | fifoReset ) );
+	const auto reset = static_cast< std::uint8_t >( disabled | fifoReset );
+	const auto enabled = static_cast< std::uint8_t >( disabled | fifoEnable );
+
+	Transaction transaction;
+	const bool queued = write( transaction, kUserControlRegister, std::span{ &disabled, 1 } ) &&
+						write( transaction, kUserControlRegister, std::span{ &reset, 1 } ) &&
+						write( transaction, kUserControlRegister, std::span{ &enabled, 1 } );
+	if( !queued || !submit( transaction ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto v1::MPU6050Controller::decodeFrame( const std::span< const std::uint8_t > frame ) const noexcept -> FifoSample
+{
+	// FIFO order follows the register order: accelerometer, temperature (if streamed), gyroscope
+	RawFrame raw{};
+	const std::size_t gyroOffset = m_fifo.temperature ? 8 : 6;
+	std::ranges::copy( frame.first( gyroOffset ), raw.begin() );
+	std::ranges::copy( frame.subspan( gyroOffset, 6 ), raw.begin() + 8 );
+
+	std::array< Lanes, 1 > lanes{};
+	convertFrames( std::span{ &raw, 1 }, lanes, factors( m_accelScale, m_gyroScale, Units::SENSOR ) );
+
+	FifoSample sample{};
+	sample.acceleration = math::Vector3f{ lanes[ 0 ][ 0 ], lanes[ 0 ][ 1 ], lanes[ 0 ][ 2 ] };
+	sample.temperatureC = m_fifo.temperature ? lanes[ 0 ][ 3 ] : 0.0f;
+	sample.angularRate = math::Vector3f{ lanes[ 0 ][ 4 ], lanes[ 0 ][ 5 ], lanes[ 0 ][ 6 ] };
+	return sample;
 }
 
 // A way to extract the angles
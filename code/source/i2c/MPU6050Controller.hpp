@@ -15,9 +15,17 @@
 #include "ICBase.hpp"
 #include <math/Linear.hpp>
 #include <utils/Counter.hpp>
+#include <utils/RingBuffer.hpp>
 
 // C++
+#include <span>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <expected>
+#include <functional>
 
 namespace pbl::i2c
 {
@@ -25,6 +33,8 @@ namespace pbl::i2c
 inline namespace v1
 {
 
+class EdgeEventLoop;
+
 /**
  * @class MPU6050Controller
  * @brief High-level controller class for the MPU6050 6-axis motion sensor.
@@ -42,6 +52,27 @@ inline namespace v1
  * auto accelData = mpu6050.getAcceleration();
  * auto gyroData = mpu6050.getGyroscope();
  * @endcode
+ *
+ * For high rate acquisition the on-chip FIFO collects the samples at the configured sample rate,
+ * drainFifo reads everything collected since the last call in one burst and decodes it into a
+ * preallocated ring of timestamped samples:
+ * @code
+ * mpu6050.startFifo();
+ * while( running )
+ * {
+ *     std::this_thread::sleep_for( 20ms ); // ~20 samples at 1kHz
+ *     if( mpu6050.drainFifo() )
+ *     {
+ *         while( auto sample = mpu6050.fifoSamples().pop() ) { ... }
+ *     }
+ * }
+ * @endcode
+ *
+ * With the INT pin wired to a GPIO, acquire reads every sample once as soon as it is ready:
+ * @code
+ * EdgeEventLoop loop{ intLine }; // Requested for rising edges
+ * mpu6050.acquire( loop, []( const MPU6050Controller::DataReadySample& sample ) { ...; return true; } );
+ * @endcode
  */
 class MPU6050Controller final : public ICBase, public utils::Counter< MPU6050Controller >
 {
@@ -92,6 +123,61 @@ public:
 	using enum Address;
 	using enum PowerMode;
 
+	using Clock = std::chrono::steady_clock;
+
+	/// The output registers ACCEL_XOUT_H to GYRO_ZOUT_L (0x3B - 0x48) as read from the sensor.
+	using RawFrame = std::array< std::uint8_t, 14 >;
+
+	/// A reading of all sensor outputs in SI units.
+	struct Measurement
+	{
+		math::Vector3f acceleration; //!< In m/s².
+		float temperatureC{};
+		math::Vector3f angularRate; //!< In rad/s.
+	};
+
+	/// A sample decoded from the FIFO.
+	struct FifoSample
+	{
+		Clock::time_point timestamp; //!< Reconstructed from the read time and the sample rate, see drainFifo.
+		math::Vector3f acceleration; //!< In g.
+		float temperatureC{}; //!< Zero unless the temperature is streamed.
+		math::Vector3f angularRate; //!< In degrees per second.
+	};
+
+	/// A reading taken on a data ready interrupt.
+	struct DataReadySample
+	{
+		Clock::time_point timestamp; //!< Kernel timestamp of the data ready edge.
+		Measurement measurement;
+	};
+
+	/// Called for every data ready sample on the acquiring thread, returns false to end the acquisition.
+	using DataReadyCallback = std::move_only_function< bool( const DataReadySample& ) >;
+
+	/// Data ready acquisition counters, since acquire was called.
+	struct DataReadyStatistics
+	{
+		std::uint64_t edges{}; //!< Data ready edges received.
+		std::uint64_t samples{}; //!< Burst reads, one per serviced edge.
+		std::uint64_t missed{}; //!< Edges queued behind a newer one, their outputs were already overwritten.
+	};
+
+	/// FIFO streaming options.
+	struct FifoOptions
+	{
+		bool temperature{ false }; //!< Whether the temperature is streamed along (14 instead of 12 bytes per sample).
+		std::size_t capacity{ 1024 }; //!< Number of samples the ring holds.
+	};
+
+	/// FIFO streaming counters, since startFifo.
+	struct FifoStatistics
+	{
+		std::uint64_t bursts{}; //!< FIFO data reads.
+		std::uint64_t samples{}; //!< Decoded samples.
+		std::uint64_t overflows{}; //!< Overflows, the FIFO was reset and its samples lost.
+	};
+
 	/**
      * @brief Constructs a new MPU6050Controller object, initializing the I2C communication with the provided
      * bus controller and sensor address. It sets up the necessary configurations for the MPU6050 operation.
@@ -124,6 +210,80 @@ public:
      */
 	[[nodiscard]] Result< math::Vector3f > angles();
 
+	/// Reads accelerometer, temperature and gyroscope in one 14 byte transfer, converted with the configured scales.
+	[[nodiscard]] Result< Measurement > readAll();
+
+	/**
+	 * @brief Converts raw frames to SI units, i.e. frames recorded for offline processing.
+	 *
+	 * The conversion byte swaps and scales all seven outputs of a frame at once, written so the
+	 * compiler vectorises it on targets with SIMD units.
+	 *
+	 * @param frames The raw output registers.
+	 * @param measurements Receives the converted frames.
+	 * @param accelScale The accelerometer scale the frames were recorded with.
+	 * @param gyroScale The gyroscope scale the frames were recorded with.
+	 * @return The number of converted frames, the smaller of both sizes.
+	 */
+	static std::size_t convert( std::span< const RawFrame > frames,
+								std::span< Measurement > measurements,
+								Scale accelScale = ACCEL_2G,
+								Scale gyroScale = GYRO_250DPS ) noexcept;
+
+	/**
+	 * @brief Streams the accelerometer and gyroscope (and optionally the temperature) through the on-chip FIFO.
+	 *
+	 * The FIFO is cleared, the sample rate is the one configured on the sensor (gyroscope output rate
+	 * divided by 1 + SMPLRT_DIV). The sample ring is allocated here, once per capacity change.
+	 */
+	[[nodiscard]] Result< void > startFifo( const FifoOptions& options );
+
+	/// Streams the accelerometer and gyroscope with the default options, see startFifo( const FifoOptions& ).
+	[[nodiscard]] Result< void > startFifo();
+
+	/**
+	 * @brief Reads the FIFO contents in one burst (up to 1024 bytes) and appends the samples to the ring.
+	 *
+	 * The FIFO count and the overflow flag are read in one combined transfer first. On overflow the
+	 * frame alignment of the FIFO is lost, it is reset and the samples in it are discarded. Timestamps
+	 * are reconstructed backwards from the read time, one sample period apart, and always increase
+	 * across drains. The newest sample is stamped with the read time.
+	 *
+	 * @return The number of samples appended, ErrorCode::UNSUPPORTED_OPERATION if streaming was not started.
+	 */
+	[[nodiscard]] Result< std::size_t > drainFifo();
+
+	/**
+	 * @brief Samples on the data ready interrupt, the INT pin wired to a GPIO line requested for rising edges.
+	 *
+	 * Enables DATA_RDY_INT and blocks in the loop until the callback returns false or the loop is
+	 * stopped. Every edge triggers exactly one burst read (readAll), stamped with the kernel time of
+	 * the edge. If edges queued up while the callback ran, only the newest is read, the outputs of the
+	 * others were overwritten already and reading them would duplicate a sample.
+	 *
+	 * @param loop The loop waiting on the line wired to INT.
+	 * @param callback Receives the samples.
+	 * @param timeout The longest time to wait for an edge, ErrorCode::TIMEOUT is returned on expiry.
+	 */
+	[[nodiscard]] Result< void > acquire( EdgeEventLoop& loop,
+										  DataReadyCallback callback,
+										  std::chrono::milliseconds timeout = std::chrono::seconds{ 1 } );
+
+	/// Returns the data ready acquisition counters.
+	[[nodiscard]] const DataReadyStatistics& dataReadyStatistics() const noexcept { return m_dataReady; }
+
+	/// Disables the FIFO, the samples in the ring stay available.
+	[[nodiscard]] Result< void > stopFifo();
+
+	/// Whether FIFO streaming is running.
+	[[nodiscard]] bool fifoRunning() const noexcept { return m_fifo.running; }
+
+	/// The decoded samples, oldest first. A full ring drops the oldest samples.
+	[[nodiscard]] auto& fifoSamples( this auto& self ) noexcept { return self.m_fifo.samples; }
+
+	/// Returns the FIFO streaming counters.
+	[[nodiscard]] const FifoStatistics& fifoStatistics() const noexcept { return m_fifo.statistics; }
+
 private:
 	/// TBW
 	[[nodiscard]] Result< void > reset();
@@ -139,8 +299,30 @@ private:
 	MPU6050Controller( const MPU6050Controller& ) = delete;
 	MPU6050Controller& operator=( const MPU6050Controller& ) = delete;
 
+private:
+	/// Decodes one FIFO frame into a sample.
+	[[nodiscard]] FifoSample decodeFrame( const std::span< const std::uint8_t > frame ) const noexcept;
+
+	/// Clears FIFO_EN, resets and enables the FIFO again in one transfer, the reset is ignored while FIFO_EN is set.
+	[[nodiscard]] Result< void > resetFifo( const std::uint8_t userControl );
+
 private:
 	CalibrationConstants m_calibration{};
+	Scale m_accelScale{ ACCEL_2G }; //!< Configured scales, power on defaults
+	Scale m_gyroScale{ GYRO_250DPS };
+
+	struct FifoState
+	{
+		bool running{};
+		bool temperature{};
+		std::size_t frameSize{};
+		Clock::duration period{}; //!< Sample period
+		std::optional< Clock::time_point > last; //!< Timestamp of the newest sample, empty after an overflow
+		utils::RingBuffer< FifoSample > samples;
+		FifoStatistics statistics;
+	} m_fifo;
+
+	DataReadyStatistics m_dataReady;
 };
 
 } // namespace v1
@@ -115,6 +115,15 @@ enum class FIFOBufferMode : std::uint8_t
 	OVERWRITE = 0x02,
 };
 
+enum class FifoEnable : std::uint8_t
+{
+	TEMP_FIFO_EN = 0x80, // Temperature output (TEMP_OUT_H/L).
+	XG_FIFO_EN = 0x40, // Gyroscope X output (GYRO_XOUT_H/L).
+	YG_FIFO_EN = 0x20, // Gyroscope Y output (GYRO_YOUT_H/L).
+	ZG_FIFO_EN = 0x10, // Gyroscope Z output (GYRO_ZOUT_H/L).
+	ACCEL_FIFO_EN = 0x08, // Accelerometer outputs (ACCEL_XOUT_H to ACCEL_ZOUT_L).
+};
+
 enum class InterruptEnable : std::uint8_t
 {
 	DATA_RDY_INT = 0x01, // Data Ready interrupt: Triggered when new data is available.
@@ -1,12 +1,583 @@
 #include "MPU9250Controller.hpp"
 #include "MPU9250Definitions.hpp"
 #include "BusController.hpp"
+#include "Transaction.hpp"
+
+// C++
+#include <array>
+#include <bitset>
+#include <algorithm>
 
 namespace pbl::i2c
 {
 
+namespace
+{
+
+constexpr std::size_t kFifoSize{ 512 };
+constexpr std::size_t kMagnetometerDataSize{ 7 }; //!< HXL to ST2
+constexpr std::size_t kMagnetometerOffset{ 14 }; //!< Of the external sensor data in a sample
+
+/// Slave 4 transactions complete within a few hundred microseconds at 400kHz.
+constexpr std::size_t kSlave4Polls{ 10 };
+constexpr std::chrono::microseconds kSlave4PollInterval{ 100 };
+
+/// Accelerometer LSB per g of the scales (ACCEL_2G to ACCEL_16G).
+constexpr std::array kAccelSensitivity{ 16384.0f, 8192.0f, 4096.0f, 2048.0f };
+
+/// Gyroscope LSB per degree per second of the scales (GYRO_250DPS to GYRO_2000DPS).
+constexpr std::array kGyroSensitivity{ 131.0f, 65.5f, 32.8f, 16.4f };
+
+constexpr float kTemperatureSensitivity{ 333.87f }; //!< LSB per °C
+constexpr float kTemperatureOffset{ 21.0f }; //!< °C at a raw value of zero
+
+constexpr float kMagResolution14Bits{ 0.6f }; //!< µT per LSB
+constexpr float kMagResolution16Bits{ 0.15f }; //!< µT per LSB
+
+[[nodiscard]] constexpr float bigEndian( const std::span< const std::uint8_t > data, const std::size_t offset ) noexcept
+{
+	return static_cast< float >( static_cast< std::int16_t >( ( data[ offset ] << 8 ) | data[ offset + 1 ] ) );
+}
+
+[[nodiscard]] constexpr float littleEndian( const std::span< const std::uint8_t > data, const std::size_t offset ) noexcept
+{
+	return static_cast< float >( static_cast< std::int16_t >( ( data[ offset + 1 ] << 8 ) | data[ offset ] ) );
+}
+
+/// Converts three big endian outputs, X, Y and Z.
+[[nodiscard]] constexpr math::Vector3f toVector( const std::span< const std::uint8_t > data, const float sensitivity ) noexcept
+{
+	return math::Vector3f{
+		bigEndian( data, 0 ) / sensitivity, bigEndian( data, 2 ) / sensitivity, bigEndian( data, 4 ) / sensitivity };
+}
+
+[[nodiscard]] constexpr float toTemperature( const std::span< const std::uint8_t > data ) noexcept
+{
+	return bigEndian( data, 0 ) / kTemperatureSensitivity + kTemperatureOffset;
+}
+
+/// Converts the AK8963 data (HXL to ST2) to µT, in the accelerometer axes.
+[[nodiscard]] constexpr math::Vector3f toMagneticField( const std::span< const std::uint8_t > data,
+														 const std::array< float, 3 >& adjustment,
+														 const float resolution ) noexcept
+{
+	const float x = littleEndian( data, 0 ) * adjustment[ 0 ] * resolution;
+	const float y = littleEndian( data, 2 ) * adjustment[ 1 ] * resolution;
+	const float z = littleEndian( data, 4 ) * adjustment[ 2 ] * resolution;
+
+	// The magnetometer X and Y axes are swapped and its Z axis points the other way
+	return math::Vector3f{ y, x, -z };
+}
+
+} // namespace
+
 v1::MPU9250Controller::MPU9250Controller( BusController& busController, Address address )
 	: ICBase{ busController, address }
 { }
 
+auto v1::MPU9250Controller::initialize() -> Result< void >
+{
+	using namespace mpu9250;
+
+	m_initialized = false;
+
+	std::uint8_t whoAmI{};
+	if( !read( kWhoAmIRegister, whoAmI ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	if( whoAmI != kWhoAmIMpu9250 && whoAmI != kWhoAmIMpu9255 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::DEVICE_NOT_FOUND );
+	}
+
+	// Wake up on the PLL clock, then let the I2C master run the auxiliary bus at 400kHz. The data ready
+	// interrupt waits for the external sensor data, a sample then always holds all nine axes.
+	const auto masterControl = static_cast< std::uint8_t >( static_cast< std::uint8_t >( I2CMasterControl::WAIT_FOR_ES ) |
+															static_cast< std::uint8_t >( I2CMasterControl::I2C_MST_CLK_400KHZ ) );
+	if( !write( kPowerManagement1Register, static_cast< std::uint8_t >( PowerManagement1::CLKSEL_AUTO ) ) ||
+		!write( kI2CMasterControlRegister, masterControl ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	sleep( std::chrono::milliseconds{ 1 } );
+
+	if( auto rslt = setUserControl( static_cast< std::uint8_t >( UserControl::I2C_MST_EN ), 0 ); !rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	const auto magWhoAmI = readMagnetometer( ak8963::kWhoAmIRegister );
+	if( !magWhoAmI ) [[unlikely]]
+	{
+		return std::unexpected( magWhoAmI.error() );
+	}
+
+	if( *magWhoAmI != ak8963::kWhoAmI ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::DEVICE_NOT_FOUND );
+	}
+
+	// The sensitivity adjustment is only readable in fuse ROM access mode, modes change through power down
+	if( auto rslt = writeMagnetometer( ak8963::kControl1Register, static_cast< std::uint8_t >( ak8963::Mode::POWER_DOWN ) );
+		!rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	sleep( std::chrono::microseconds{ 100 } );
+
+	if( auto rslt =
+			writeMagnetometer( ak8963::kControl1Register, static_cast< std::uint8_t >( ak8963::Mode::FUSE_ROM_ACCESS ) );
+		!rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	sleep( std::chrono::microseconds{ 100 } );
+
+	for( std::uint8_t axis = 0; axis < m_magAdjustment.size(); ++axis )
+	{
+		const auto asa = readMagnetometer( static_cast< std::uint8_t >( ak8963::kSensitivityXRegister + axis ) );
+		if( !asa ) [[unlikely]]
+		{
+			return std::unexpected( asa.error() );
+		}
+
+		// Datasheet: Hadj = H * ( ( ASA - 128 ) * 0.5 / 128 + 1 )
+		m_magAdjustment[ axis ] = ( static_cast< float >( *asa ) - 128.0f ) / 256.0f + 1.0f;
+	}
+
+	if( auto rslt = writeMagnetometer( ak8963::kControl1Register, static_cast< std::uint8_t >( ak8963::Mode::POWER_DOWN ) );
+		!rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	sleep( std::chrono::microseconds{ 100 } );
+
+	const auto resolution =
+		m_magScale == MAG_16BITS ? static_cast< std::uint8_t >( ak8963::Mode::OUTPUT_16BIT ) : std::uint8_t{ 0 };
+	if( auto rslt = writeMagnetometer( ak8963::kControl1Register,
+									   static_cast< std::uint8_t >(
+										   static_cast< std::uint8_t >( ak8963::Mode::CONTINUOUS_100HZ ) | resolution ) );
+		!rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	// Slave 0 copies HXL to ST2 into EXT_SENS_DATA_00 at every sample, reading ST2 releases the next measurement
+	const std::array< std::uint8_t, 3 > slave0{
+		static_cast< std::uint8_t >( 0x80 | ak8963::kAddress ),
+		ak8963::kXOutLRegister,
+		static_cast< std::uint8_t >( static_cast< std::uint8_t >( I2CSlaveControl::EN ) | kMagnetometerDataSize ) };
+	if( !write( kI2CSlave0AddressRegister, slave0 ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	m_initialized = true;
+	return utils::MakeSuccess();
+}
+
+auto v1::MPU9250Controller::setPowerMode( PowerMode mode ) -> Result< void >
+{
+	std::uint8_t config{};
+	if( !read( mpu9250::kPowerManagement1Register, config ) )
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	std::bitset< 8 > bits{ config };
+	bits.set( 6, mode == PowerMode::SLEEP ); // Bit 6 controls SLEEP
+
+	if( !write( mpu9250::kPowerManagement1Register, static_cast< std::uint8_t >( bits.to_ulong() ) ) )
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto v1::MPU9250Controller::getPowerMode() -> Result< PowerMode >
+{
+	std::uint8_t config{};
+	if( !read( mpu9250::kPowerManagement1Register, config ) )
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	return utils::MakeSuccess( ( config & static_cast< std::uint8_t >( mpu9250::PowerManagement1::SLEEP ) ) ? SLEEP
+																										   : NORMAL );
+}
+
+auto v1::MPU9250Controller::configureScales( Scale accelScale, Scale gyroScale, Scale magScale ) -> Result< void >
+{
+	using namespace mpu9250;
+
+	std::uint8_t accelConfig{};
+	switch( accelScale )
+	{
+		case Scale::ACCEL_2G: accelConfig = static_cast< uint8_t >( AccelSensitivity::G_2 ); break;
+		case Scale::ACCEL_4G: accelConfig = static_cast< uint8_t >( AccelSensitivity::G_4 ); break;
+		case Scale::ACCEL_8G: accelConfig = static_cast< uint8_t >( AccelSensitivity::G_8 ); break;
+		case Scale::ACCEL_16G: accelConfig = static_cast< uint8_t >( AccelSensitivity::G_16 ); break;
+		default: return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	uint8_t gyroConfig{};
+	switch( gyroScale )
+	{
+		case Scale::GYRO_250DPS: gyroConfig = static_cast< uint8_t >( GyroSensitivity::DPS_250 ); break;
+		case Scale::GYRO_500DPS: gyroConfig = static_cast< uint8_t >( GyroSensitivity::DPS_500 ); break;
+		case Scale::GYRO_1000DPS: gyroConfig = static_cast< uint8_t >( GyroSensitivity::DPS_1000 ); break;
+		case Scale::GYRO_2000DPS: gyroConfig = static_cast< uint8_t >( GyroSensitivity::DPS_2000 ); break;
+		default: return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	if( magScale != Scale::MAG_14BITS && magScale != Scale::MAG_16BITS )
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	const bool success = write( kAccelConfigRegister, accelConfig ) && write( kGyroConfigRegister, gyroConfig );
+	if( !success )
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	m_accelScale = accelScale;
+	m_gyroScale = gyroScale;
+
+	// Before initialize the resolution is applied when the magnetometer is started
+	if( m_initialized && magScale != m_magScale )
+	{
+		const auto resolution =
+			magScale == MAG_16BITS ? static_cast< std::uint8_t >( ak8963::Mode::OUTPUT_16BIT ) : std::uint8_t{ 0 };
+		const auto rslt =
+			writeMagnetometer( ak8963::kControl1Register, static_cast< std::uint8_t >( ak8963::Mode::POWER_DOWN ) )
+				.and_then( [ this, resolution ] {
+					sleep( std::chrono::microseconds{ 100 } );
+					return writeMagnetometer(
+						ak8963::kControl1Register,
+						static_cast< std::uint8_t >( static_cast< std::uint8_t >( ak8963::Mode::CONTINUOUS_100HZ ) |
+													 resolution ) );
+				} );
+		if( !rslt ) [[unlikely]]
+		{
+			return rslt;
+		}
+	}
+
+	m_magScale = magScale;
+	return utils::MakeSuccess();
+}
+
+auto v1::MPU9250Controller::setSampleRate( std::uint8_t divider, DigitalLowPass lowPass ) -> Result< void >
+{
+	using namespace mpu9250;
+
+	// SMPLRT_DIV and CONFIG are adjacent, the accelerometer filter gets the matching bandwidth
+	const std::array< std::uint8_t, 2 > rate{ divider, static_cast< std::uint8_t >( lowPass ) };
+	if( !write( kSampleRateDividerRegister, rate ) ||
+		!write( kAccelConfig2Register, static_cast< std::uint8_t >( lowPass ) ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto v1::MPU9250Controller::readSample() -> Result< Sample >
+{
+	RawSample raw{};
+	if( read( mpu9250::kAccelXOutHRegister, raw.data(), raw.size() ) != static_cast< std::int16_t >( raw.size() ) )
+		[[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	return utils::MakeSuccess( decode( raw ) );
+}
+
+auto v1::MPU9250Controller::getAcceleration() -> Result< math::Vector3f >
+{
+	std::array< std::uint8_t, 6 > raw{};
+	if( read( mpu9250::kAccelXOutHRegister, raw.data(), raw.size() ) != 6 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	return utils::MakeSuccess( toVector( raw, kAccelSensitivity[ static_cast< std::size_t >( m_accelScale ) & 0x03 ] ) );
+}
+
+auto v1::MPU9250Controller::getGyroscope() -> Result< math::Vector3f >
+{
+	std::array< std::uint8_t, 6 > raw{};
+	if( read( mpu9250::kGyroXOutHRegister, raw.data(), raw.size() ) != 6 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	return utils::MakeSuccess( toVector( raw, kGyroSensitivity[ static_cast< std::size_t >( m_gyroScale ) & 0x03 ] ) );
+}
+
+auto v1::MPU9250Controller::getMagnetometer() -> Result< math::Vector3f >
+{
+	if( !m_initialized ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	std::array< std::uint8_t, kMagnetometerDataSize > raw{};
+	if( read( mpu9250::kExtSensorData00Register, raw.data(), raw.size() ) != static_cast< std::int16_t >( raw.size() ) )
+		[[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	if( raw.back() & ak8963::kOverflowBit ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::DATA_OVERRUN );
+	}
+
+	const float resolution = m_magScale == MAG_16BITS ? kMagResolution16Bits : kMagResolution14Bits;
+	return utils::MakeSuccess( toMagneticField( raw, m_magAdjustment, resolution ) );
+}
+
+auto v1::MPU9250Controller::getTemperature() -> Result< float >
+{
+	std::array< std::uint8_t, 2 > raw{};
+	if( read( mpu9250::kTempOutHRegister, raw.data(), raw.size() ) != 2 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	return utils::MakeSuccess( toTemperature( raw ) );
+}
+
+auto v1::MPU9250Controller::decode( std::span< const std::uint8_t, 21 > raw ) const noexcept -> Sample
+{
+	const float resolution = m_magScale == MAG_16BITS ? kMagResolution16Bits : kMagResolution14Bits;
+	const auto magnetometer = raw.subspan< kMagnetometerOffset, kMagnetometerDataSize >();
+
+	Sample sample{};
+	sample.acceleration = toVector( raw.first< 6 >(), kAccelSensitivity[ static_cast< std::size_t >( m_accelScale ) & 0x03 ] );
+	sample.temperatureC = toTemperature( raw.subspan< 6, 2 >() );
+	sample.angularRate = toVector( raw.subspan< 8, 6 >(), kGyroSensitivity[ static_cast< std::size_t >( m_gyroScale ) & 0x03 ] );
+	sample.magneticField = toMagneticField( magnetometer, m_magAdjustment, resolution );
+	sample.magneticOverflow = ( magnetometer.back() & ak8963::kOverflowBit ) != 0;
+	return sample;
+}
+
+auto v1::MPU9250Controller::startFifo() -> Result< void >
+{
+	using namespace mpu9250;
+
+	// Without the slave 0 read the frames would be shorter
+	if( !m_initialized ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	const auto sources = static_cast< std::uint8_t >(
+		static_cast< std::uint8_t >( FifoEnable::ACCEL_FIFO_EN ) | static_cast< std::uint8_t >( FifoEnable::TEMP_FIFO_EN ) |
+		static_cast< std::uint8_t >( FifoEnable::GYRO_FIFO_EN ) | static_cast< std::uint8_t >( FifoEnable::SLV_0_FIFO_EN ) );
+	if( !write( kFifoEnableRegister, sources ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	// Clear and enable the FIFO
+	if( auto rslt = resetFifo(); !rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	m_fifoRunning = true;
+	return utils::MakeSuccess();
+}
+
+auto v1::MPU9250Controller::readFifo( std::span< Sample > samples ) -> Result< std::size_t >
+{
+	using namespace mpu9250;
+
+	if( !m_fifoRunning ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	// The overflow flag and the FIFO count in one combined transfer, reading INT_STATUS clears it
+	std::uint8_t status{};
+	std::array< std::uint8_t, 2 > count{};
+	Transaction transaction;
+	const bool queued = read( transaction, kIntStatusRegister, std::span{ &status, 1 } ) &&
+						read( transaction, kFifoCountHRegister, count );
+	if( !queued || !submit( transaction ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	const auto available = static_cast< std::size_t >( ( ( count[ 0 ] & 0x1F ) << 8 ) | count[ 1 ] );
+	if( status & static_cast< std::uint8_t >( InterruptStatus::FIFO_OFLOW_INT ) || available >= kFifoSize )
+	{
+		// The oldest bytes were overwritten, the frame boundaries are unknown. Start over.
+		if( auto rslt = resetFifo(); !rslt ) [[unlikely]]
+		{
+			return std::unexpected( rslt.error() );
+		}
+
+		return utils::MakeError( utils::ErrorCode::DATA_OVERRUN );
+	}
+
+	// Whole frames only, the rest is read next time
+	const auto frames = std::min( available / std::tuple_size_v< RawSample >, samples.size() );
+	if( frames == 0 )
+	{
+		return utils::MakeSuccess( std::size_t{} );
+	}
+
+	std::array< RawSample, kFifoSize / std::tuple_size_v< RawSample > > buffer{};
+	const auto size = static_cast< std::uint16_t >( frames * std::tuple_size_v< RawSample > );
+	if( read( kFifoReadWriteRegister, buffer[ 0 ].data(), size ) != static_cast< std::int16_t >( size ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	std::ranges::transform( std::span{ buffer }.first( frames ), samples.begin(), [ this ]( const RawSample& raw ) {
+		return decode( raw );
+	} );
+
+	return utils::MakeSuccess( frames );
+}
+
+auto v1::MPU9250Controller::stopFifo() -> Result< void >
+{
+	using namespace mpu9250;
+
+	if( !write( kFifoEnableRegister, 0x00 ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	if( auto rslt = setUserControl( 0, static_cast< std::uint8_t >( UserControl::FIFO_EN ) ); !rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	m_fifoRunning = false;
+	return utils::MakeSuccess();
+}
+
+auto v1::MPU9250Controller::magnetometerTransfer( std::uint8_t reg, std::optional< std::uint8_t > value )
+	-> Result< std::uint8_t >
+{
+	using namespace mpu9250;
+
+	// SLV4_ADDR, SLV4_REG, SLV4_DO and SLV4_CTRL are adjacent, enabling the slave starts the transaction
+	const std::array< std::uint8_t, 4 > request{
+		static_cast< std::uint8_t >( value ? ak8963::kAddress : 0x80 | ak8963::kAddress ),
+		reg,
+		value.value_or( 0x00 ),
+		static_cast< std::uint8_t >( I2CSlaveControl::EN ) };
+	if( !write( kI2CSlave4AddressRegister, request ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	for( std::size_t poll = 0; poll < kSlave4Polls; ++poll )
+	{
+		// Reading I2C_MST_STATUS clears it
+		std::uint8_t status{};
+		if( !read( kI2CMasterStatusRegister, status ) ) [[unlikely]]
+		{
+			return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		}
+
+		if( status & static_cast< std::uint8_t >( I2CMasterStatus::I2C_SLV4_NACK ) ) [[unlikely]]
+		{
+			return utils::MakeError( utils::ErrorCode::NACK_RECEIVED );
+		}
+
+		if( status & static_cast< std::uint8_t >( I2CMasterStatus::I2C_SLV4_DONE ) )
+		{
+			if( value )
+			{
+				return utils::MakeSuccess( *value );
+			}
+
+			std::uint8_t data{};
+			if( !read( kI2CSlave4DataInRegister, data ) ) [[unlikely]]
+			{
+				return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+			}
+
+			return utils::MakeSuccess( data );
+		}
+
+		sleep( kSlave4PollInterval );
+	}
+
+	return utils::MakeError( utils::ErrorCode::TIMEOUT );
+}
+
+auto v1::MPU9250Controller::writeMagnetometer( std::uint8_t reg, std::uint8_t value ) -> Result< void >
+{
+	return magnetometerTransfer( reg, value ).transform( []( std::uint8_t ) { } );
+}
+
+auto v1::MPU9250Controller::readMagnetometer( std::uint8_t reg ) -> Result< std::uint8_t >
+{
+	return magnetometerTransfer( reg, std::nullopt );
+}
+
+auto v1::MPU9250Controller::setUserControl( std::uint8_t set, std::uint8_t clear ) -> Result< void >
+{
+	std::uint8_t userControl{};
+	if( !read( mpu9250::kUserControlRegister, userControl ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	userControl = static_cast< std::uint8_t >( ( userControl | set ) & ~clear );
+	if( !write( mpu9250::kUserControlRegister, userControl ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto v1::MPU9250Controller::resetFifo() -> Result< void >
+{
+	using namespace mpu9250;
+
+	std::uint8_t userControl{};
+	if( !read( kUserControlRegister, userControl ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+	}
+
+	constexpr auto fifoEnable = static_cast< std::uint8_t >( UserControl::FIFO_EN );
+	constexpr auto fifoReset = static_cast< std::uint8_t >( UserControl::FIFO_RST );
+
+	// The reset only takes effect with FIFO_EN cleared: disable, reset, enable again
+	const auto disabled = static_cast< std::uint8_t >( userControl & ~( fifoEnable | fifoReset ) );
+	const auto reset = static_cast< std::uint8_t >( disabled | fifoReset );
+	const auto enabled = static_cast< std::uint8_t >( disabled | fifoEnable );
+
+	Transaction transaction;
+	const bool queued = write( transaction, kUserControlRegister, std::span{ &disabled, 1 } ) &&
+						write( transaction, kUserControlRegister, std::span{ &reset, 1 } ) &&
+						write( transaction, kUserControlRegister, std::span{ &enabled, 1 } );
+	if( !queued || !submit( transaction ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	return utils::MakeSuccess();
+}
+
 } // namespace pbl::i2c
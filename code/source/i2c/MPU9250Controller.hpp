@@ -16,10 +16,15 @@
 #define PBL_I2C_MPU9250_CONTROLLER_HPP__
 
 #include "ICBase.hpp"
+#include <math/Linear.hpp>
 #include <utils/Counter.hpp>
 
 // C++
+#include <span>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <expected>
 
@@ -42,23 +47,34 @@ inline namespace v1
  *  - Configure sensor settings, including full-scale ranges and sampling rates.
  *  - Set power modes for efficient energy management.
  *
+ * The AK8963 magnetometer sits on the auxiliary bus of the MPU9250. The internal I2C master is
+ * set up to copy its measurement into the external sensor data registers at every sample, right
+ * after the gyroscope outputs, so all nine axes (and the temperature) are read in one 21 byte
+ * burst and belong to the same sample. The magnetometer itself is configured through slave 4.
+ *
  * Example usage:
  * @code
  * BusController busController;
  * MPU9250Controller mpu9250(busController, MPU9250Controller::DEFAULT);
- * 
- * auto accelData = mpu9250.getAcceleration();
- * auto gyroData = mpu9250.getGyroscope();
- * auto magData = mpu9250.getMagnetometer();
+ *
+ * if( mpu9250.initialize() )
+ * {
+ *     auto sample = mpu9250.readSample();
+ * }
+ * @endcode
+ *
+ * For higher rates the samples are collected in the 512 byte on-chip FIFO, magnetometer included:
+ * @code
+ * mpu9250.setSampleRate( 4 ); // 200Hz
+ * mpu9250.startFifo();
+ * std::array< MPU9250Controller::Sample, 24 > samples;
+ * auto count = mpu9250.readFifo( samples );
  * @endcode
  *
  * @note This class requires an initialized I2C bus and proper sensor setup for accurate readings.
  */
 class MPU9250Controller final : public ICBase, public utils::Counter< MPU9250Controller >
 {
-	static constexpr std::size_t kAccelCalibReadIterations{ 1'000 };
-	static constexpr std::size_t kGyroCalibReadIterations{ 1'000 };
-
 public:
 	template < typename T >
 	using Result = utils::Result< T >;
@@ -89,36 +105,124 @@ public:
 		MAG_16BITS
 	};
 
+	/// Bandwidth of the gyroscope and temperature low pass filter, the sample rate divider applies with any of them.
+	enum class DigitalLowPass : std::uint8_t
+	{
+		HZ_184 = 1,
+		HZ_92,
+		HZ_41,
+		HZ_20,
+		HZ_10,
+		HZ_5
+	};
+
 	using enum Scale;
 	using enum Address;
 	using enum PowerMode;
 
+	/// The output registers ACCEL_XOUT_H to EXT_SENS_DATA_06 (0x3B - 0x4F), the layout of a FIFO frame too.
+	using RawSample = std::array< std::uint8_t, 21 >;
+
+	/// A reading of all sensor outputs taken at the same sample.
+	struct Sample
+	{
+		math::Vector3f acceleration; //!< In g.
+		float temperatureC{};
+		math::Vector3f angularRate; //!< In degrees per second.
+		math::Vector3f magneticField; //!< In µT, in the accelerometer axes.
+		bool magneticOverflow{}; //!< The magnetic field exceeded the measurement range, magneticField is invalid.
+	};
+
 	explicit MPU9250Controller( class BusController& busController, Address address = Address::DEFAULT );
 
+	/**
+	 * @brief Wakes the sensor and sets the magnetometer up behind the internal I2C master.
+	 *
+	 * Checks both identities, reads the magnetometer sensitivity adjustment from its fuse ROM, starts
+	 * its 100Hz continuous measurement and enables the slave 0 read feeding the external sensor data.
+	 *
+	 * @return ErrorCode::DEVICE_NOT_FOUND if the MPU9250 or the AK8963 does not identify itself.
+	 */
+	[[nodiscard]] Result< void > initialize();
+
+	/// Returns whether initialize succeeded, the magnetometer outputs are zero otherwise.
+	[[nodiscard]] bool initialized() const noexcept { return m_initialized; }
+
 	/// Sets the power mode of the MPU9250 (normal or sleep).
-	// Result<void> setPowerMode( PowerMode mode );
+	[[nodiscard]] Result< void > setPowerMode( PowerMode mode );
+
+	/// Retrieves the current power mode.
+	[[nodiscard]] Result< PowerMode > getPowerMode();
 
 	/// Configures the accelerometer, gyroscope, and magnetometer scales.
-	// Result< void > configureScales( Scale accelScale, Scale gyroScale, Scale magScale );
+	[[nodiscard]] Result< void > configureScales( Scale accelScale, Scale gyroScale, Scale magScale );
 
-	/// Retrieves the current power mode.
-	// [[nodiscard]] Result< PowerMode > getPowerMode();
+	/// Sets the sample rate to 1kHz / ( 1 + divider ), the rate of the outputs, the FIFO and the data ready interrupt.
+	[[nodiscard]] Result< void > setSampleRate( std::uint8_t divider, DigitalLowPass lowPass = DigitalLowPass::HZ_184 );
+
+	/// Reads all outputs in one 21 byte transfer.
+	[[nodiscard]] Result< Sample > readSample();
 
 	/// Reads accelerometer values (X, Y, Z) in g.
-	// [[nodiscard]] Result< std::tuple< float, float, float > > getAcceleration();
+	[[nodiscard]] Result< math::Vector3f > getAcceleration();
 
 	/// Reads gyroscope values (X, Y, Z) in degrees per second.
-	// [[nodiscard]] Result< std::tuple< float, float, float > > getGyroscope();
+	[[nodiscard]] Result< math::Vector3f > getGyroscope();
 
-	/// Reads magnetometer values (X, Y, Z) in microteslas.
-	// [[nodiscard]] Result< std::tuple< float, float, float > > getMagnetometer();
+	/// Reads magnetometer values (X, Y, Z) in microteslas, ErrorCode::DATA_OVERRUN if the field exceeded the range.
+	[[nodiscard]] Result< math::Vector3f > getMagnetometer();
 
 	/// Retrieves the sensor's temperature in degrees Celsius.
-	// [[nodiscard]] Result< float > getTemperature();
+	[[nodiscard]] Result< float > getTemperature();
+
+	/// Converts raw outputs with the configured scales.
+	[[nodiscard]] Sample decode( std::span< const std::uint8_t, 21 > raw ) const noexcept;
+
+	/// Streams all outputs, the magnetometer included, through the FIFO. The FIFO is cleared.
+	[[nodiscard]] Result< void > startFifo();
+
+	/**
+	 * @brief Reads the complete samples in the FIFO, at most samples.size(), in one burst.
+	 *
+	 * 21 byte frames don't divide the 512 byte FIFO, an overflow loses the frame alignment. The FIFO
+	 * is reset then and ErrorCode::DATA_OVERRUN returned, read often enough for the sample rate.
+	 *
+	 * @return The number of samples read, ErrorCode::UNSUPPORTED_OPERATION if streaming was not started.
+	 */
+	[[nodiscard]] Result< std::size_t > readFifo( std::span< Sample > samples );
+
+	/// Disables the FIFO.
+	[[nodiscard]] Result< void > stopFifo();
+
+	/// Whether FIFO streaming is running.
+	[[nodiscard]] bool fifoRunning() const noexcept { return m_fifoRunning; }
 
 private:
 	MPU9250Controller( const MPU9250Controller& ) = delete;
 	MPU9250Controller& operator=( const MPU9250Controller& ) = delete;
+
+	/// Performs a slave 4 transaction on the auxiliary bus and waits for its completion.
+	[[nodiscard]] Result< std::uint8_t > magnetometerTransfer( std::uint8_t reg, std::optional< std::uint8_t > value );
+
+	/// Writes an AK8963 register through slave 4.
+	[[nodiscard]] Result< void > writeMagnetometer( std::uint8_t reg, std::uint8_t value );
+
+	/// Reads an AK8963 register through slave 4.
+	[[nodiscard]] Result< std::uint8_t > readMagnetometer( std::uint8_t reg );
+
+	/// Sets the FIFO enable, FIFO reset and I2C master bits of USER_CTRL.
+	[[nodiscard]] Result< void > setUserControl( std::uint8_t set, std::uint8_t clear );
+
+	/// Clears FIFO_EN, resets and enables the FIFO again in one transfer, the reset is ignored while FIFO_EN is set.
+	[[nodiscard]] Result< void > resetFifo();
+
+private:
+	Scale m_accelScale{ ACCEL_2G }; //!< Configured scales, power on defaults
+	Scale m_gyroScale{ GYRO_250DPS };
+	Scale m_magScale{ MAG_16BITS };
+	std::array< float, 3 > m_magAdjustment{ 1.0f, 1.0f, 1.0f }; //!< Fuse ROM sensitivity adjustment (X, Y, Z)
+	bool m_initialized{};
+	bool m_fifoRunning{};
 };
 
 } // namespace v1
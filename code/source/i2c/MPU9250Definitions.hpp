@@ -7,5 +7,133 @@
 namespace pbl::i2c::mpu9250
 {
 
+// MPU-9250 Register Addresses
+constexpr std::uint8_t kSampleRateDividerRegister{ 0x19 }; //!< Sample Rate Divider
+constexpr std::uint8_t kConfigRegister{ 0x1A }; //!< General configuration, gyroscope DLPF
+constexpr std::uint8_t kGyroConfigRegister{ 0x1B }; //!< Gyroscope configuration
+constexpr std::uint8_t kAccelConfigRegister{ 0x1C }; //!< Accelerometer configuration
+constexpr std::uint8_t kAccelConfig2Register{ 0x1D }; //!< Accelerometer DLPF configuration
+constexpr std::uint8_t kFifoEnableRegister{ 0x23 }; //!< FIFO buffer enable
+constexpr std::uint8_t kI2CMasterControlRegister{ 0x24 }; //!< I2C master control settings
+constexpr std::uint8_t kI2CSlave0AddressRegister{ 0x25 }; //!< I2C slave 0 address, bit 7 selects a read
+constexpr std::uint8_t kI2CSlave0Register{ 0x26 }; //!< I2C slave 0 register
+constexpr std::uint8_t kI2CSlave0ControlRegister{ 0x27 }; //!< I2C slave 0 control
+constexpr std::uint8_t kI2CSlave4AddressRegister{ 0x31 }; //!< I2C slave 4 address, bit 7 selects a read
+constexpr std::uint8_t kI2CSlave4Register{ 0x32 }; //!< I2C slave 4 register
+constexpr std::uint8_t kI2CSlave4DataOutRegister{ 0x33 }; //!< I2C slave 4 data to write
+constexpr std::uint8_t kI2CSlave4ControlRegister{ 0x34 }; //!< I2C slave 4 control
+constexpr std::uint8_t kI2CSlave4DataInRegister{ 0x35 }; //!< I2C slave 4 data read
+constexpr std::uint8_t kI2CMasterStatusRegister{ 0x36 }; //!< I2C master status
+constexpr std::uint8_t kIntPinConfigRegister{ 0x37 }; //!< Interrupt pin configuration
+constexpr std::uint8_t kIntEnableRegister{ 0x38 }; //!< Interrupt enable
+constexpr std::uint8_t kIntStatusRegister{ 0x3A }; //!< Interrupt status
+constexpr std::uint8_t kAccelXOutHRegister{ 0x3B }; //!< Accelerometer X-axis high byte
+constexpr std::uint8_t kTempOutHRegister{ 0x41 }; //!< Temperature high byte
+constexpr std::uint8_t kGyroXOutHRegister{ 0x43 }; //!< Gyroscope X-axis high byte
+constexpr std::uint8_t kExtSensorData00Register{ 0x49 }; //!< External sensor data, filled by the I2C master
+constexpr std::uint8_t kUserControlRegister{ 0x6A }; //!< User control
+constexpr std::uint8_t kPowerManagement1Register{ 0x6B }; //!< Power management 1
+constexpr std::uint8_t kPowerManagement2Register{ 0x6C }; //!< Power management 2
+constexpr std::uint8_t kFifoCountHRegister{ 0x72 }; //!< FIFO count registers (high byte)
+constexpr std::uint8_t kFifoCountLRegister{ 0x73 }; //!< FIFO count registers (low byte)
+constexpr std::uint8_t kFifoReadWriteRegister{ 0x74 }; //!< FIFO read/write
+constexpr std::uint8_t kWhoAmIRegister{ 0x75 }; //!< Device ID (Who Am I)
+
+constexpr std::uint8_t kWhoAmIMpu9250{ 0x71 };
+constexpr std::uint8_t kWhoAmIMpu9255{ 0x73 };
+
+enum class PowerManagement1 : std::uint8_t
+{
+	H_RESET = 0x80, // Reset the internal registers and restore the default settings
+	SLEEP = 0x40, // Put the device in sleep mode
+	CLKSEL_AUTO = 0x01 // Best available clock source, the PLL if ready, else the internal oscillator
+};
+
+enum class FifoEnable : std::uint8_t
+{
+	TEMP_FIFO_EN = 0x80, // Temperature output (TEMP_OUT_H/L).
+	GYRO_FIFO_EN = 0x70, // Gyroscope outputs (GYRO_XOUT_H to GYRO_ZOUT_L).
+	ACCEL_FIFO_EN = 0x08, // Accelerometer outputs (ACCEL_XOUT_H to ACCEL_ZOUT_L).
+	SLV_0_FIFO_EN = 0x01 // External sensor data of slave 0.
+};
+
+enum class I2CMasterControl : std::uint8_t
+{
+	WAIT_FOR_ES = 0x40, // Delays the data ready interrupt until the external sensor data is loaded.
+	I2C_MST_CLK_400KHZ = 0x0D
+};
+
+enum class I2CSlaveControl : std::uint8_t
+{
+	EN = 0x80, // Enables the slave transaction at the sample rate (slave 4: once).
+	BYTE_SW = 0x40,
+	REG_DIS = 0x20,
+	GRP = 0x10,
+	LENGTH = 0x0F // Number of bytes to read (slave 0 to 3).
+};
+
+enum class I2CMasterStatus : std::uint8_t
+{
+	I2C_SLV4_DONE = 0x40,
+	I2C_SLV4_NACK = 0x10
+};
+
+enum class InterruptStatus : std::uint8_t
+{
+	FIFO_OFLOW_INT = 0x10
+};
+
+enum class UserControl : std::uint8_t
+{
+	FIFO_EN = 0x40, // Enable FIFO buffer.
+	I2C_MST_EN = 0x20, // Enable I2C Master mode.
+	FIFO_RST = 0x04,
+	I2C_MST_RST = 0x02
+};
+
+enum class AccelSensitivity : std::uint8_t
+{
+	G_2 = 0x00, // +/- 2g (default)
+	G_4 = 0x08, // +/- 4g
+	G_8 = 0x10, // +/- 8g
+	G_16 = 0x18 // +/- 16g
+};
+
+enum class GyroSensitivity : std::uint8_t
+{
+	DPS_250 = 0x00, // +/- 250 degrees/s (default)
+	DPS_500 = 0x08, // +/- 500 degrees/s
+	DPS_1000 = 0x10, // +/- 1000 degrees/s
+	DPS_2000 = 0x18 // +/- 2000 degrees/s
+};
+
 } // namespace pbl::i2c::mpu9250
+
+namespace pbl::i2c::ak8963
+{
+
+constexpr std::uint8_t kAddress{ 0x0C }; //!< Magnetometer die inside the MPU-9250, on its auxiliary bus
+
+// AK8963 Register Addresses
+constexpr std::uint8_t kWhoAmIRegister{ 0x00 }; //!< Device ID (WIA)
+constexpr std::uint8_t kStatus1Register{ 0x02 }; //!< Data ready (ST1)
+constexpr std::uint8_t kXOutLRegister{ 0x03 }; //!< Measurement data, little endian X, Y, Z (HXL to HZH)
+constexpr std::uint8_t kStatus2Register{ 0x09 }; //!< Overflow (ST2), must be read to release the data
+constexpr std::uint8_t kControl1Register{ 0x0A }; //!< Operation mode and output resolution (CNTL1)
+constexpr std::uint8_t kControl2Register{ 0x0B }; //!< Soft reset (CNTL2)
+constexpr std::uint8_t kSensitivityXRegister{ 0x10 }; //!< Fuse ROM sensitivity adjustment (ASAX to ASAZ)
+
+constexpr std::uint8_t kWhoAmI{ 0x48 };
+constexpr std::uint8_t kOverflowBit{ 0x08 }; //!< ST2 HOFL, the measurement exceeded the range
+
+enum class Mode : std::uint8_t
+{
+	POWER_DOWN = 0x00,
+	CONTINUOUS_8HZ = 0x02,
+	CONTINUOUS_100HZ = 0x06,
+	FUSE_ROM_ACCESS = 0x0F,
+	OUTPUT_16BIT = 0x10 // Output resolution bit, 14-bit if cleared
+};
+
+} // namespace pbl::i2c::ak8963
 #endif // PBL_I2C_MPU9250_DEFINITIONS_HPP__
@@ -1,6 +1,10 @@
 #include "PCA9685Controller.hpp"
 #include "BusController.hpp"
 
+// C++
+#include <array>
+#include <algorithm>
+
 namespace pbl::i2c
 {
 
@@ -11,17 +15,37 @@ constexpr std::uint8_t kMode1 = 0x00; // Mode register 1
 constexpr std::uint8_t kMode2 = 0x01; // Mode register 2
 constexpr std::uint8_t kPrescale = 0xFE; // Prescale register for PWM frequency
 constexpr std::uint8_t kLed0OnL = 0x06; // LED0 output and PWM control, 4 registers per channel
+constexpr std::uint8_t kLed15OffH = 0x45; // Last LED control register
+constexpr std::uint8_t kAllLedOnL = 0xFA; // ALL_LED_ON_L, writes to ALL_LED_* apply to every channel
+
+// LEDn_ON_H / LEDn_OFF_H register bit definitions
+constexpr std::uint8_t kLedFull = 0x10; // Full ON / full OFF bit
+constexpr std::uint16_t kLedFullCount = kLedFull << 8; // Full ON / full OFF bit of a 16-bit count
+
+// kMode2 register bit definitions
+constexpr std::uint8_t kMode2OutDrv = 0x04; // Totem pole output bit
 
 // kMode1 register bit definitions
 constexpr std::uint8_t kMode1Restart = 0x80; // Restart bit
 constexpr std::uint8_t kMode1Sleep = 0x10; // Sleep bit
 constexpr std::uint8_t kMode1Ai = 0x20; // Auto increment bit
+constexpr std::uint8_t kMode1AllCall = 0x01; // All call address bit
 
 } // namespace
 
 v1::PCA9685Controller::PCA9685Controller( BusController& busController, Address address )
 	: ICBase{ busController, address }
-{ }
+{
+	// The restart bit is set by the device once the oscillator stops, every other bit is host controlled
+	setCacheable( kMode1, 1, kMode1Restart );
+	setCacheable( kMode2 );
+	setCacheable( kPrescale );
+
+	for( auto reg = kLed0OnL; reg <= kLed15OffH; ++reg )
+	{
+		setCacheable( reg );
+	}
+}
 
 auto v1::PCA9685Controller::setPWMFrequency( std::uint16_t frequency ) -> Result< void >
 {
@@ -38,7 +62,7 @@ auto v1::PCA9685Controller::setPWMFrequency( std::uint16_t frequency ) -> Result
 	const auto prescale = static_cast< std::uint8_t >( ( 25'000'000.0 / ( 4'096.0 * frequency ) ) - 1.0 );
 
 	std::uint8_t oldmode{};
-	if( !read( kMode1, oldmode ) )
+	if( !readCached( kMode1, oldmode ) )
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
@@ -73,14 +97,20 @@ auto v1::PCA9685Controller::setPWMFrequency( std::uint16_t frequency ) -> Result
 
 auto v1::PCA9685Controller::setPWM( Channel channel, PWMState on, PWMState off ) -> Result< void >
 {
+	if( auto rslt = enableAutoIncrement(); !rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
 	const auto reg = static_cast< std::uint8_t >( kLed0OnL + 4 * static_cast< int >( channel ) );
 	const auto onValue = static_cast< std::uint16_t >( on );
 	const auto offValue = static_cast< std::uint16_t >( off );
 
-	if( !write( reg, static_cast< std::uint8_t >( onValue & 0xFF ) ) ||
-		!write( reg + 1, static_cast< std::uint8_t >( onValue >> 8 ) ) ||
-		!write( reg + 2, static_cast< std::uint8_t >( offValue & 0xFF ) ) ||
-		!write( reg + 3, static_cast< std::uint8_t >( offValue >> 8 ) ) )
+	const std::array< std::uint8_t, 4 > data{ static_cast< std::uint8_t >( onValue & 0xFF ),
+											  static_cast< std::uint8_t >( onValue >> 8 ),
+											  static_cast< std::uint8_t >( offValue & 0xFF ),
+											  static_cast< std::uint8_t >( offValue >> 8 ) };
+	if( !writeSequential( reg, data ) )
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
@@ -102,22 +132,20 @@ auto v1::PCA9685Controller::setPWMPercentage( Channel channel, float dutyPercent
 
 auto v1::PCA9685Controller::setSleepMode( bool enable ) -> Result< void >
 {
-	std::uint8_t mode1{};
-	if( !read( kMode1, mode1 ) )
+	if( !updateRegister( kMode1, kMode1Sleep, enable ? kMode1Sleep : std::uint8_t{} ) )
 	{
-		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
-	if( enable )
-	{
-		mode1 |= kMode1Sleep;
-	}
-	else
-	{
-		mode1 &= ~kMode1Sleep;
-	}
+	return utils::MakeSuccess();
+}
+
+auto v1::PCA9685Controller::setFullOn( Channel channel, bool enable ) -> Result< void >
+{
+	const auto base = kLed0OnL + 4 * static_cast< int >( channel );
+	const auto reg = static_cast< std::uint8_t >( base + 1 ); // LEDn_ON_H
 
-	if( !write( kMode1, mode1 ) )
+	if( !updateRegister( reg, kLedFull, enable ? kLedFull : std::uint8_t{} ) )
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
@@ -125,19 +153,22 @@ auto v1::PCA9685Controller::setSleepMode( bool enable ) -> Result< void >
 	return utils::MakeSuccess();
 }
 
-auto v1::PCA9685Controller::setFullOn( Channel channel, bool enable ) -> Result< void >
+auto v1::PCA9685Controller::setFullOff( Channel channel, bool enable ) -> Result< void >
 {
-	const auto base = 0x06 + 4 * static_cast< int >( channel );
-	const auto reg = static_cast< std::uint8_t >( base + 1 ); // LEDn_ON_H
+	const auto base = kLed0OnL + 4 * static_cast< int >( channel );
+	const auto reg = static_cast< std::uint8_t >( base + 3 ); // LEDn_OFF_H
 
-	std::uint8_t val{};
-	if( !read( reg, val ) )
+	if( !updateRegister( reg, kLedFull, enable ? kLedFull : std::uint8_t{} ) )
 	{
-		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
-	val = enable ? ( val | 0x10 ) : ( val & ~0x10 );
-	if( !write( reg, val ) )
+	return utils::MakeSuccess();
+}
+
+auto v1::PCA9685Controller::setOutputMode( bool totemPole ) -> Result< void >
+{
+	if( !updateRegister( kMode2, kMode2OutDrv, totemPole ? kMode2OutDrv : std::uint8_t{} ) )
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
@@ -145,36 +176,76 @@ auto v1::PCA9685Controller::setFullOn( Channel channel, bool enable ) -> Result<
 	return utils::MakeSuccess();
 }
 
-auto v1::PCA9685Controller::setFullOff( Channel channel, bool enable ) -> Result< void >
+auto v1::PCA9685Controller::enableAllCallAddress( bool enable ) -> Result< void >
 {
-	const auto base = 0x06 + 4 * static_cast< int >( channel );
-	const auto reg = static_cast< std::uint8_t >( base + 3 ); // LEDn_OFF_H
-
-	std::uint8_t val{};
-	if( !read( reg, val ) )
+	if( !updateRegister( kMode1, kMode1AllCall, enable ? kMode1AllCall : std::uint8_t{} ) )
 	{
-		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
-	val = enable ? ( val | 0x10 ) : ( val & ~0x10 );
-	if( !write( reg, val ) )
+	return utils::MakeSuccess();
+}
+
+auto v1::PCA9685Controller::softwareReset() -> Result< void >
+{
+	constexpr std::array< std::uint8_t, 2 > kResetCmd{ 0x06, 0x00 };
+	if( !write( 0x00, kResetCmd.data(), kResetCmd.size() ) )
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
+	// All registers are back at their power on values
+	invalidateCache();
+
+	sleep( std::chrono::milliseconds( 10 ) );
+
 	return utils::MakeSuccess();
 }
 
-auto v1::PCA9685Controller::setOutputMode( bool totemPole ) -> Result< void >
+auto v1::PCA9685Controller::flush( const Frame& frame ) -> Result< void >
 {
-	std::uint8_t mode2{};
-	if( !read( 0x01, mode2 ) )
+	const auto staged = frame.registers();
+
+	// A channel whose registers are not known counts as changed
+	const auto changed = [ & ]( const std::size_t channel ) {
+		const auto base = channel * Frame::kRegistersPerChannel;
+		for( auto i = base; i < base + Frame::kRegistersPerChannel; ++i )
+		{
+			const auto cached = cachedValue( static_cast< std::uint8_t >( kLed0OnL + i ) );
+			if( !cached || *cached != staged[ i ] )
+			{
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	std::size_t first{ 16 };
+	std::size_t last{};
+	for( std::size_t channel = 0; channel < 16; ++channel )
 	{
-		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		if( changed( channel ) )
+		{
+			first = std::min( first, channel );
+			last = channel;
+		}
+	}
+
+	if( first == 16 )
+	{
+		return utils::MakeSuccess(); // Nothing changed
 	}
 
-	mode2 = totemPole ? ( mode2 | 0x04 ) : ( mode2 & ~0x04 );
-	if( !write( 0x01, mode2 ) )
+	if( auto rslt = enableAutoIncrement(); !rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	// Skipping unchanged channels in between would take another transfer, rewriting them is cheaper
+	const auto offset = first * Frame::kRegistersPerChannel;
+	const auto size = ( last - first + 1 ) * Frame::kRegistersPerChannel;
+	if( !writeSequential( static_cast< std::uint8_t >( kLed0OnL + offset ), staged.subspan( offset, size ) ) )
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
@@ -182,16 +253,35 @@ auto v1::PCA9685Controller::setOutputMode( bool totemPole ) -> Result< void >
 	return utils::MakeSuccess();
 }
 
-auto v1::PCA9685Controller::enableAllCallAddress( bool enable ) -> Result< void >
+auto v1::PCA9685Controller::setAllPWM( PWMState on, PWMState off ) -> Result< void >
+{
+	return writeAll( on.steps(), off.steps() );
+}
+
+auto v1::PCA9685Controller::setAllFullOn() -> Result< void >
+{
+	return writeAll( kLedFullCount, 0 );
+}
+
+auto v1::PCA9685Controller::setAllFullOff() -> Result< void >
 {
-	std::uint8_t mode1{};
-	if( !read( 0x00, mode1 ) )
+	return writeAll( 0, kLedFullCount );
+}
+
+auto v1::PCA9685Controller::enableAutoIncrement() -> Result< void >
+{
+	std::uint8_t mode{};
+	if( !readCached( kMode1, mode ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	mode1 = enable ? ( mode1 | 0x01 ) : ( mode1 & ~0x01 );
-	if( !write( 0x00, mode1 ) )
+	if( mode & kMode1Ai )
+	{
+		return utils::MakeSuccess();
+	}
+
+	if( !write( kMode1, static_cast< std::uint8_t >( mode | kMode1Ai ) ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
@@ -199,15 +289,27 @@ auto v1::PCA9685Controller::enableAllCallAddress( bool enable ) -> Result< void
 	return utils::MakeSuccess();
 }
 
-auto v1::PCA9685Controller::softwareReset() -> Result< void >
+auto v1::PCA9685Controller::writeAll( const std::uint16_t on, const std::uint16_t off ) -> Result< void >
 {
-	constexpr std::array< std::uint8_t, 2 > kResetCmd{ 0x06, 0x00 };
-	if( !write( 0x00, kResetCmd.data(), kResetCmd.size() ) )
+	if( auto rslt = enableAutoIncrement(); !rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	const std::array< std::uint8_t, 4 > data{ static_cast< std::uint8_t >( on & 0xFF ),
+											  static_cast< std::uint8_t >( on >> 8 ),
+											  static_cast< std::uint8_t >( off & 0xFF ),
+											  static_cast< std::uint8_t >( off >> 8 ) };
+	if( !write( kAllLedOnL, data ) )
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
-	sleep( std::chrono::milliseconds( 10 ) );
+	// The device copies the ALL_LED registers into every channel
+	for( auto reg = kLed0OnL; reg <= kLed15OffH; ++reg )
+	{
+		cacheStore( reg, data[ ( reg - kLed0OnL ) % 4 ] );
+	}
 
 	return utils::MakeSuccess();
 }
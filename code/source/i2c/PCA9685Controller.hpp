@@ -5,7 +5,10 @@
 #include <utils/Counter.hpp>
 
 // C++
+#include <span>
+#include <array>
 #include <string>
+#include <cstddef>
 #include <expected>
 
 namespace pbl::i2c
@@ -115,6 +118,74 @@ public:
 	using enum Address;
 	using enum Channel;
 
+	/**
+	 * @brief Staged ON/OFF counts of all 16 channels, written to the device by PCA9685Controller::flush.
+	 *
+	 * Holds the contents of the LED0_ON_L to LED15_OFF_H registers, all channels start fully off as
+	 * after power up. Staging touches no bus.
+	 */
+	class Frame final
+	{
+	public:
+		static constexpr std::size_t kRegistersPerChannel{ 4 };
+		static constexpr std::size_t kSize{ 16 * kRegistersPerChannel };
+
+		constexpr Frame() noexcept
+		{
+			for( auto channel = 0u; channel < 16u; ++channel )
+			{
+				m_registers[ channel * kRegistersPerChannel + 3 ] = kFull;
+			}
+		}
+
+		/// Stages the ON and OFF step of the channel, clearing its full ON/OFF flags.
+		constexpr Frame& set( const Channel channel, const PWMState on, const PWMState off ) noexcept
+		{
+			return stage( channel, on.steps(), off.steps() );
+		}
+
+		/// Stages a pulse of the given width starting at step 0.
+		constexpr Frame& set( const Channel channel, const PWMState width ) noexcept
+		{
+			return stage( channel, 0, width.steps() );
+		}
+
+		/// Stages the channel fully on.
+		constexpr Frame& setFullOn( const Channel channel ) noexcept
+		{
+			return stage( channel, kFullCount, 0 );
+		}
+
+		/// Stages the channel fully off.
+		constexpr Frame& setFullOff( const Channel channel ) noexcept
+		{
+			return stage( channel, 0, kFullCount );
+		}
+
+		/// Register contents from LED0_ON_L on, low byte first.
+		[[nodiscard]] constexpr std::span< const std::uint8_t, kSize > registers() const noexcept
+		{
+			return m_registers;
+		}
+
+	private:
+		static constexpr std::uint8_t kFull{ 0x10 }; //!< Full ON / full OFF bit of LEDn_ON_H / LEDn_OFF_H
+		static constexpr std::uint16_t kFullCount{ kFull << 8 };
+
+		constexpr Frame& stage( const Channel channel, const std::uint16_t on, const std::uint16_t off ) noexcept
+		{
+			const auto base = static_cast< std::size_t >( channel ) * kRegistersPerChannel;
+			m_registers[ base ] = static_cast< std::uint8_t >( on & 0xFF );
+			m_registers[ base + 1 ] = static_cast< std::uint8_t >( on >> 8 );
+			m_registers[ base + 2 ] = static_cast< std::uint8_t >( off & 0xFF );
+			m_registers[ base + 3 ] = static_cast< std::uint8_t >( off >> 8 );
+			return *this;
+		}
+
+	private:
+		std::array< std::uint8_t, kSize > m_registers{};
+	};
+
 	/// Construct controller with I2C bus and device address.
 	explicit PCA9685Controller( class BusController& busController, Address address = H40 );
 
@@ -145,6 +216,24 @@ public:
 	/// Send general call software reset.
 	[[nodiscard]] Result< void > softwareReset();
 
+	/**
+	 * @brief Writes the channels of the frame that differ from the device in one auto-increment write.
+	 *
+	 * The staged registers are compared against the register shadow, the write spans the first to the
+	 * last changed channel, at most the 64 bytes from LED0_ON_L. Nothing is written when no channel
+	 * changed. The outputs change together at the stop condition.
+	 */
+	[[nodiscard]] Result< void > flush( const Frame& frame );
+
+	/// Set ON/OFF step timings of all channels with a single write to the ALL_LED registers.
+	[[nodiscard]] Result< void > setAllPWM( PWMState on, PWMState off );
+
+	/// Set all channels fully on with a single write to the ALL_LED registers.
+	[[nodiscard]] Result< void > setAllFullOn();
+
+	/// Set all channels fully off with a single write to the ALL_LED registers.
+	[[nodiscard]] Result< void > setAllFullOff();
+
 	// /// Convert µs pulse width to PWM steps (based on 20ms period).
 	// [[nodiscard]] std::uint16_t pulseWidthToSteps( float pulseWidth )
 	// {
@@ -161,6 +250,13 @@ public:
 private:
 	PCA9685Controller( const PCA9685Controller& ) = delete;
 	PCA9685Controller& operator=( const PCA9685Controller& ) = delete;
+
+private:
+	/// Sets MODE1.AI unless the shadow shows it set already.
+	Result< void > enableAutoIncrement();
+
+	/// Writes ALL_LED_ON_L to ALL_LED_OFF_H and records the broadcast in the shadow of every channel.
+	Result< void > writeAll( std::uint16_t on, std::uint16_t off );
 };
 
 } // namespace v1
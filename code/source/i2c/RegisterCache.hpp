@@ -0,0 +1,96 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of RegisterCache class, a write-through shadow of the IC configuration registers.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_REGISTER_CACHE_HPP__
+#define PBL_I2C_REGISTER_CACHE_HPP__
+
+// C++
+#include <array>
+#include <cstdint>
+#include <optional>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+/**
+ * @class RegisterCache
+ * @brief Holds the last known contents of the registers an IC controller declared as cacheable.
+ *
+ * A cacheable register only changes when written by the host (configuration, output latches, ...),
+ * registers updated by the IC itself (measurements, status, interrupt flags) stay volatile and are
+ * never cached. Bits of a cacheable register that the IC updates on its own (i.e. a one-shot or
+ * restart bit) are declared as volatile bits, they are always stored cleared.
+ *
+ * Registers are 8 or 16 bits wide, 16-bit registers are transferred most significant byte first.
+ *
+ * @note Not thread safe, the cache shares the threading constraints of the owning controller.
+ */
+class RegisterCache final
+{
+public:
+	/// Declares the register as cacheable, the value becomes known with the next read or write.
+	void declare( const std::uint8_t reg, const std::uint8_t width, const std::uint16_t volatileBits ) noexcept
+	{
+		m_entries[ reg ] = Entry{ .volatileBits = volatileBits, .width = width, .cacheable = true };
+	}
+
+	/// Returns whether the register was declared as cacheable.
+	[[nodiscard]] bool cacheable( const std::uint8_t reg ) const noexcept { return m_entries[ reg ].cacheable; }
+
+	/// Returns the width of the register in bytes, 0 if it is not cacheable.
+	[[nodiscard]] std::uint8_t width( const std::uint8_t reg ) const noexcept { return m_entries[ reg ].width; }
+
+	/// Returns the cached value, std::nullopt if the register is volatile or its value is not known.
+	[[nodiscard]] std::optional< std::uint16_t > value( const std::uint8_t reg ) const noexcept
+	{
+		const auto& entry = m_entries[ reg ];
+		return entry.valid ? std::optional{ entry.value } : std::nullopt;
+	}
+
+	/// Stores the value of a cacheable register, the volatile bits are dropped.
+	void store( const std::uint8_t reg, const std::uint16_t value ) noexcept
+	{
+		auto& entry = m_entries[ reg ];
+		if( entry.cacheable )
+		{
+			entry.value = static_cast< std::uint16_t >( value & ~entry.volatileBits );
+			entry.valid = true;
+		}
+	}
+
+	/// Forgets the value of the register, the next access goes to the bus.
+	void invalidate( const std::uint8_t reg ) noexcept { m_entries[ reg ].valid = false; }
+
+	/// Forgets the value of all registers, i.e. after a reset of the IC.
+	void invalidate() noexcept
+	{
+		for( auto& entry : m_entries )
+		{
+			entry.valid = false;
+		}
+	}
+
+private:
+	struct Entry
+	{
+		std::uint16_t value{};
+		std::uint16_t volatileBits{};
+		std::uint8_t width{};
+		bool cacheable{};
+		bool valid{};
+	};
+
+	std::array< Entry, 256 > m_entries{};
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_REGISTER_CACHE_HPP__
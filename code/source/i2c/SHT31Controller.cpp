@@ -10,11 +10,14 @@
 
 #include "SHT31Controller.hpp"
 #include "BusController.hpp"
+#include "Transaction.hpp"
 #include <math/Math.hpp>
 
 // C++
+#include <span>
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <cmath>
 
 namespace pbl::i2c
@@ -29,6 +32,58 @@ constexpr std::uint16_t kSingleShotMediumRepeatability = 0x240B;
 constexpr std::uint16_t kSingleShotLowRepeatability = 0x2416;
 constexpr std::uint16_t kSoftReset = 0x30A2;
 constexpr std::uint16_t kReadStatus = 0xF32D;
+constexpr std::uint16_t kFetchData = 0xE000;
+constexpr std::uint16_t kBreak = 0x3093;
+constexpr std::uint16_t kArt = 0x2B32;
+
+/// Periodic acquisition commands, per rate (0.5, 1, 2, 4 and 10 mps) in HIGH, MEDIUM, LOW repeatability.
+constexpr std::array< std::array< std::uint16_t, 3 >, 5 > kPeriodic{ { { 0x2032, 0x2024, 0x202F },
+																	   { 0x2130, 0x2126, 0x212D },
+																	   { 0x2236, 0x2220, 0x222B },
+																	   { 0x2334, 0x2322, 0x2329 },
+																	   { 0x2737, 0x2721, 0x272A } } };
+
+/// Maximum single-shot measurement durations of the datasheet, in HIGH, MEDIUM, LOW repeatability.
+constexpr std::array< std::chrono::microseconds, 3 > kMeasurementDurations{
+	std::chrono::microseconds{ 15000 }, std::chrono::microseconds{ 6000 }, std::chrono::microseconds{ 4000 } };
+
+/// The sensor accepts the next command this long after a break or a soft reset.
+constexpr std::chrono::microseconds kCommandRecovery{ 1000 };
+
+/// CRC-8 lookup table of the Sensirion polynomial 0x31, generated at compile time.
+constexpr auto kCrcTable = [] {
+	std::array< std::uint8_t, 256 > table{};
+	for( std::size_t i = 0; i < table.size(); ++i )
+	{
+		auto crc = static_cast< std::uint8_t >( i );
+		for( int bit = 0; bit < 8; ++bit )
+		{
+			crc = static_cast< std::uint8_t >( ( crc & 0x80 ) ? ( crc << 1 ) ^ 0x31 : crc << 1 );
+		}
+		table[ i ] = crc;
+	}
+	return table;
+}();
+
+/// CRC-8 of a data word, 0xFF initialisation.
+[[nodiscard]] constexpr std::uint8_t crc8( const std::span< const std::uint8_t > data ) noexcept
+{
+	std::uint8_t crc{ 0xFF };
+	for( const auto byte : data )
+	{
+		crc = kCrcTable[ crc ^ byte ];
+	}
+
+	return crc;
+}
+
+static_assert( crc8( std::array< std::uint8_t, 2 >{ 0xBE, 0xEF } ) == 0x92, "CRC does not match the datasheet example." );
+
+/// Returns whether the CRC following the data word at offset matches.
+[[nodiscard]] constexpr bool crcMatches( const std::span< const std::uint8_t > data, const std::size_t offset ) noexcept
+{
+	return crc8( data.subspan( offset, 2 ) ) == data[ offset + 2 ];
+}
 
 /**
  * @brief Extracts the high (most significant) byte from a 16-bit unsigned value.
@@ -70,6 +125,12 @@ constexpr std::uint16_t kReadStatus = 0xF32D;
 	return static_cast< std::uint8_t >( value & 0xFF );
 }
 
+/// Returns the 16-bit word at the offset of big endian data.
+[[nodiscard]] constexpr std::uint16_t word( const std::span< const std::uint8_t > data, const std::size_t offset ) noexcept
+{
+	return static_cast< std::uint16_t >( ( data[ offset ] << 8 ) | data[ offset + 1 ] );
+}
+
 } // namespace
 
 v1::SHT31Controller::SHT31Controller( BusController& busController, Address address ) noexcept
@@ -78,18 +139,21 @@ v1::SHT31Controller::SHT31Controller( BusController& busController, Address addr
 
 auto v1::SHT31Controller::triggerMeasurement( Repeatability rep ) -> Result< void >
 {
-	std::uint16_t command{};
+	if( m_periodic ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	std::uint16_t cmd{};
 	switch( rep )
 	{
 		using enum Repeatability;
-		case HIGH: command = kSingleShotHighRepeatability; break;
-		case MEDIUM: command = kSingleShotMediumRepeatability; break;
-		case LOW: command = kSingleShotLowRepeatability; break;
+		case HIGH: cmd = kSingleShotHighRepeatability; break;
+		case MEDIUM: cmd = kSingleShotMediumRepeatability; break;
+		case LOW: cmd = kSingleShotLowRepeatability; break;
 	}
 
-	std::array< std::uint8_t, 2 > cmd{ highByte( command ), lowByte( command ) };
-
-	if( !write( cmd ) ) [[unlikely]]
+	if( !command( cmd ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
@@ -97,56 +161,149 @@ auto v1::SHT31Controller::triggerMeasurement( Repeatability rep ) -> Result< voi
 	return utils::MakeSuccess();
 }
 
-auto v1::SHT31Controller::getTemperatureC() -> Result< float >
+auto v1::SHT31Controller::measure( Repeatability rep ) -> Result< Measurement >
 {
-	std::array< std::uint8_t, 6 > data{};
+	if( auto rslt = triggerMeasurement( rep ); !rslt ) [[unlikely]]
+	{
+		return std::unexpected( rslt.error() );
+	}
 
-	if( read( data ) < 6 ) [[unlikely]]
+	sleep( kMeasurementDurations[ static_cast< std::size_t >( rep ) ] );
+	return readMeasurement();
+}
+
+auto v1::SHT31Controller::readMeasurement() -> Result< Measurement >
+{
+	auto rslt = receiveMeasurement();
+	if( !rslt && rslt.error() != utils::ErrorCode::INVALID_DATA ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	const std::uint16_t rawTemp = ( static_cast< std::uint16_t >( data[ 0 ] ) << 8 ) | data[ 1 ];
-	const float tempC = -45.0f + 175.0f * static_cast< float >( rawTemp ) / 65535.0f;
-	return tempC;
+	return rslt;
 }
 
-auto v1::SHT31Controller::getTemperatureF() -> Result< float >
+auto v1::SHT31Controller::receiveMeasurement() -> Result< Measurement >
 {
-	return getTemperatureC().transform( math::CelsiusToFarenheit< float >{} );
+	std::array< std::uint8_t, 6 > data{};
+
+	// The outcome comes from the transaction, the last error of the bus may already be another thread's
+	Transaction transaction;
+	if( !transaction.read( address(), data ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNEXPECTED_ERROR );
+	}
+
+	if( !submit( transaction ) ) [[unlikely]]
+	{
+		return std::unexpected( transaction.result( 0 ).error() );
+	}
+
+	if( !crcMatches( data, 0 ) || !crcMatches( data, 3 ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_DATA );
+	}
+
+	const auto rawTemp = word( data, 0 );
+	const auto rawHumidity = word( data, 3 );
+
+	return Measurement{ .temperatureC = -45.0f + 175.0f * static_cast< float >( rawTemp ) / 65535.0f,
+						.humidity = 100.0f * static_cast< float >( rawHumidity ) / 65535.0f };
 }
 
-auto v1::SHT31Controller::getHumidity() -> Result< float >
+auto v1::SHT31Controller::startPeriodic( Rate rate, Repeatability rep ) -> Result< void >
 {
-	std::array< std::uint8_t, 6 > data{};
+	if( m_periodic )
+	{
+		if( auto rslt = stopPeriodic(); !rslt ) [[unlikely]]
+		{
+			return rslt;
+		}
+	}
 
-	if( read( data ) < 6 ) [[unlikely]]
+	const auto cmd = rate == Rate::ART
+						 ? kArt
+						 : kPeriodic[ static_cast< std::size_t >( rate ) ][ static_cast< std::size_t >( rep ) ];
+
+	if( !command( cmd ) ) [[unlikely]]
 	{
-		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
-	const auto rawHumidity = ( static_cast< std::uint16_t >( data[ 3 ] ) << 8 ) | data[ 4 ];
-	const auto humidity = 100.0f * static_cast< float >( rawHumidity ) / 65535.0f;
-	return humidity;
+	m_periodic = true;
+	return utils::MakeSuccess();
 }
 
-auto v1::SHT31Controller::reset() -> Result< void >
+auto v1::SHT31Controller::fetch() -> Result< std::optional< Measurement > >
 {
-	std::array< std::uint8_t, 2 > cmd{ highByte( kSoftReset ), lowByte( kSoftReset ) };
+	if( !m_periodic ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION );
+	}
+
+	if( !command( kFetchData ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	auto rslt = receiveMeasurement();
+	if( !rslt )
+	{
+		// The sensor does not acknowledge the read when no new measurement is available
+		if( rslt.error() == utils::ErrorCode::NACK_RECEIVED )
+		{
+			return std::optional< Measurement >{};
+		}
+
+		return utils::MakeError( rslt.error() == utils::ErrorCode::INVALID_DATA ? utils::ErrorCode::INVALID_DATA
+																				: utils::ErrorCode::FAILED_TO_READ );
+	}
 
-	if( !write( cmd ) ) [[unlikely]]
+	return std::optional{ *rslt };
+}
+
+auto v1::SHT31Controller::stopPeriodic() -> Result< void >
+{
+	if( !command( kBreak ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
 
+	m_periodic = false;
+	sleep( kCommandRecovery );
 	return utils::MakeSuccess();
 }
 
-auto v1::SHT31Controller::readStatus() -> Result< uint16_t >
+auto v1::SHT31Controller::getTemperatureC() -> Result< float >
 {
-	std::array< std::uint8_t, 2 > cmd{ highByte( kReadStatus ), lowByte( kReadStatus ) };
+	return readMeasurement().transform( []( const Measurement& m ) { return m.temperatureC; } );
+}
 
-	if( !write( cmd ) ) [[unlikely]]
+auto v1::SHT31Controller::getTemperatureF() -> Result< float >
+{
+	return getTemperatureC().transform( math::CelsiusToFarenheit< float >{} );
+}
+
+auto v1::SHT31Controller::getHumidity() -> Result< float >
+{
+	return readMeasurement().transform( []( const Measurement& m ) { return m.humidity; } );
+}
+
+auto v1::SHT31Controller::reset() -> Result< void >
+{
+	if( !command( kSoftReset ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+	}
+
+	m_periodic = false;
+	sleep( kCommandRecovery );
+	return utils::MakeSuccess();
+}
+
+auto v1::SHT31Controller::readStatus() -> Result< uint16_t >
+{
+	if( !command( kReadStatus ) ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
 	}
@@ -158,7 +315,18 @@ auto v1::SHT31Controller::readStatus() -> Result< uint16_t >
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	return static_cast< uint16_t >( ( response[ 0 ] << 8 ) | response[ 1 ] );
+	if( !crcMatches( response, 0 ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_DATA );
+	}
+
+	return word( response, 0 );
+}
+
+bool v1::SHT31Controller::command( const std::uint16_t cmd )
+{
+	const std::array< std::uint8_t, 2 > data{ highByte( cmd ), lowByte( cmd ) };
+	return write( data );
 }
 
-} // namespace pbl::i2c
\ No newline at end of file
+} // namespace pbl::i2c
@@ -13,6 +13,7 @@
 
 // C++
 #include <string>
+#include <optional>
 #include <expected>
 
 namespace pbl::i2c
@@ -32,8 +33,12 @@ inline namespace v1
  *  - Reading ambient temperature in Celsius or Fahrenheit.
  *  - Reading relative humidity in percentage.
  *  - Configuring repeatability and measurement modes.
+ *  - Periodic acquisition (0.5 to 10 measurements per second and ART) read out with FETCH_DATA.
  *  - Soft-reset and status register management.
  *
+ * Temperature and humidity of a measurement are read together in one 6 byte transfer, each word is
+ * followed by a CRC-8 which is validated, a mismatch reports ErrorCode::INVALID_DATA.
+ *
  * Designed for use in embedded and IoT applications, it's well-suited for environmental sensing and monitoring.
  * 
  * @note The SHT31 does not use traditional register addresses like the LM75. Instead,
@@ -44,8 +49,11 @@ inline namespace v1
  * BusController busController;
  * SHT31Controller sht31(busController);
  *
- * auto temperature = sht31.getTemperatureC();
- * auto humidity = sht31.getHumidity();
+ * auto measurement = sht31.measure(); // measurement->temperatureC, measurement->humidity
+ *
+ * // High rate logging, the sensor measures on its own
+ * sht31.startPeriodic( SHT31Controller::MPS_10 );
+ * if( auto rslt = sht31.fetch(); rslt && *rslt ) { ... } // std::nullopt until a new measurement completed
  * @endcode
  */
 class SHT31Controller final : public ICBase, public utils::Counter< SHT31Controller >
@@ -67,21 +75,67 @@ public:
 		LOW
 	};
 
+	/// Measurements per second of the periodic acquisition mode.
+	enum class Rate : std::uint8_t
+	{
+		MPS_0_5,
+		MPS_1,
+		MPS_2,
+		MPS_4,
+		MPS_10,
+		ART //!< Accelerated response time, 4 measurements per second, repeatability does not apply.
+	};
+
+	/// Temperature and humidity of one measurement.
+	struct Measurement
+	{
+		float temperatureC{};
+		float humidity{}; //!< Relative humidity in %
+	};
+
 	using enum Address;
 	using enum Repeatability;
+	using enum Rate;
 
 	explicit SHT31Controller( BusController& busController, Address address = H44 ) noexcept;
 
 	/// Triggers a single-shot measurement and reads temperature and humidity
 	[[nodiscard]] Result< void > triggerMeasurement( Repeatability rep = HIGH );
 
-	/// Gets the last measured temperature in Celsius
+	/// Triggers a single-shot measurement, waits for its completion and reads it
+	[[nodiscard]] Result< Measurement > measure( Repeatability rep = HIGH );
+
+	/// Reads the measurement started by triggerMeasurement, temperature and humidity in one transfer
+	[[nodiscard]] Result< Measurement > readMeasurement();
+
+	/**
+	 * @brief Starts the periodic acquisition mode, single-shot measurements are rejected until it is stopped.
+	 *
+	 * A running periodic mode is stopped first, the sensor only accepts a new mode after a break.
+	 */
+	[[nodiscard]] Result< void > startPeriodic( Rate rate, Repeatability rep = HIGH );
+
+	/**
+	 * @brief Reads the latest periodic measurement (FETCH_DATA), the sensor clears it afterwards.
+	 *
+	 * @return std::nullopt if no new measurement completed since the last fetch (the sensor does not
+	 * acknowledge the read), ErrorCode::UNSUPPORTED_OPERATION if the periodic mode is not running.
+	 */
+	[[nodiscard]] Result< std::optional< Measurement > > fetch();
+
+	/// Stops the periodic acquisition mode (break command)
+	[[nodiscard]] Result< void > stopPeriodic();
+
+	/// Whether the periodic acquisition mode is running
+	[[nodiscard]] bool periodic() const noexcept { return m_periodic; }
+
+	/// Gets the last measured temperature in Celsius, prefer readMeasurement to get both values
 	[[nodiscard]] Result< float > getTemperatureC();
 
 	/// Gets the last measured temperature in Fahrenheit
 	[[nodiscard]] Result< float > getTemperatureF();
 
-	/// Gets the last measured relative humidity in %
+	/// Gets the last measured relative humidity in %, prefer readMeasurement to get both values
 	[[nodiscard]] Result< float > getHumidity();
 
 	/// Sends a soft reset command to the sensor
@@ -90,9 +144,19 @@ public:
 	/// Reads the sensor status register
 	[[nodiscard]] Result< uint16_t > readStatus();
 
+private:
+	/// Sends a 16-bit command
+	[[nodiscard]] bool command( const std::uint16_t cmd );
+
+	/// Reads and checks a measurement, a failed transfer reports the error of this transfer (i.e. NACK_RECEIVED)
+	[[nodiscard]] Result< Measurement > receiveMeasurement();
+
 private:
 	SHT31Controller( const SHT31Controller& ) = delete;
 	SHT31Controller& operator=( const SHT31Controller& ) = delete;
+
+private:
+	bool m_periodic{};
 };
 
 } // namespace v1
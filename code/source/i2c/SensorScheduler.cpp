@@ -0,0 +1,488 @@
+/**
+ *  @brief Implementation of SensorScheduler class, polls registered sensors at individual rates on absolute deadlines.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "SensorScheduler.hpp"
+#include "BusController.hpp"
+
+// C++
+#include <array>
+#include <algorithm>
+
+// C
+extern "C" {
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+}
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+// Register addresses are 8-bit, a read must not wrap around
+constexpr std::size_t kRegisterCount{ 256 };
+
+/// Converts a steady clock time point to a CLOCK_MONOTONIC timespec, both share the epoch on Linux.
+[[nodiscard]] ::timespec toTimespec( const std::chrono::steady_clock::time_point timePoint ) noexcept
+{
+	const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >( timePoint.time_since_epoch() ).count();
+	return ::timespec{ .tv_sec = static_cast< ::time_t >( ns / 1'000'000'000 ), .tv_nsec = ns % 1'000'000'000 };
+}
+
+/// Drains the counter of a readable timerfd or eventfd.
+void drain( const int fd ) noexcept
+{
+	std::uint64_t count{};
+	[[maybe_unused]] const auto rslt = ::read( fd, &count, sizeof( count ) );
+}
+
+} // namespace
+
+v1::SensorScheduler::SensorScheduler( BusController& busController )
+	: SensorScheduler{ busController, Options{} }
+{ }
+
+v1::SensorScheduler::SensorScheduler( BusController& busController, Options options )
+	: m_busController{ busController }
+	, m_options{ options }
+{ }
+
+v1::SensorScheduler::~SensorScheduler()
+{
+	stop();
+
+	for( const int fd : { m_timerFd, m_wakeFd } )
+	{
+		if( fd >= 0 )
+		{
+			::close( fd );
+		}
+	}
+}
+
+auto v1::SensorScheduler::addRead( const std::uint8_t deviceAddr,
+								   const std::uint8_t reg,
+								   const std::size_t size,
+								   const std::chrono::nanoseconds period,
+								   ReadCallback callback,
+								   const Idempotency idempotency ) -> Result< TaskId >
+{
+	if( size == 0 || reg + size > kRegisterCount || period <= std::chrono::nanoseconds::zero() || !callback )
+		[[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	Task task;
+	task.period = period;
+	task.address = deviceAddr;
+	task.reg = reg;
+	task.idempotency = idempotency;
+	task.data.resize( size );
+	task.onRead = std::move( callback );
+
+	return insert( std::move( task ) );
+}
+
+auto v1::SensorScheduler::addTask( const std::chrono::nanoseconds period, Job job ) -> Result< TaskId >
+{
+	if( period <= std::chrono::nanoseconds::zero() || !job ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	Task task;
+	task.period = period;
+	task.job = std::move( job );
+
+	return insert( std::move( task ) );
+}
+
+bool v1::SensorScheduler::remove( const TaskId id )
+{
+	std::lock_guard _{ m_tasksMtx };
+	return std::erase_if( m_tasks, [ id ]( const Task& task ) { return task.id == id; } ) > 0;
+}
+
+auto v1::SensorScheduler::start() -> Result< void >
+{
+	if( running() )
+	{
+		return utils::MakeSuccess();
+	}
+
+	if( m_timerFd < 0 )
+	{
+		m_timerFd = ::timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC );
+	}
+
+	if( m_wakeFd < 0 )
+	{
+		m_wakeFd = ::eventfd( 0, EFD_CLOEXEC );
+	}
+
+	if( m_timerFd < 0 || m_wakeFd < 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::HARDWARE_NOT_AVAILABLE );
+	}
+
+	m_thread = std::jthread{ [ this ]( std::stop_token stopToken ) { run( std::move( stopToken ) ); } };
+	return utils::MakeSuccess();
+}
+
+void v1::SensorScheduler::stop()
+{
+	if( !running() )
+	{
+		return;
+	}
+
+	m_thread.request_stop();
+
+	const std::uint64_t wake{ 1 };
+	[[maybe_unused]] const auto rslt = ::write( m_wakeFd, &wake, sizeof( wake ) );
+
+	m_thread.join();
+}
+
+auto v1::SensorScheduler::runDue( const Clock::time_point now ) -> std::optional< Clock::time_point >
+{
+	std::lock_guard _{ m_tasksMtx };
+
+	m_dueReads.clear();
+	m_dueJobs.clear();
+
+	for( std::size_t i = 0; i < m_tasks.size(); ++i )
+	{
+		auto& task = m_tasks[ i ];
+		if( task.release > now )
+		{
+			continue;
+		}
+
+		// Releases the scheduler slept through are missed, the task is served once on its time grid
+		const auto skipped = ( now - task.release ) / task.period;
+		const auto released = task.release + skipped * task.period;
+		const auto jitter = std::chrono::duration_cast< std::chrono::nanoseconds >( now - released );
+
+		task.deadlineMisses += static_cast< std::uint64_t >( skipped );
+		task.release = released + task.period;
+		task.releases += 1;
+		task.jitterTotal += jitter;
+		task.jitterMax = std::max( task.jitterMax, jitter );
+
+		( task.job ? m_dueJobs : m_dueReads ).push_back( i );
+	}
+
+	if( !m_dueReads.empty() || !m_dueJobs.empty() )
+	{
+		m_cycles.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	serveReads();
+
+	for( const auto index : m_dueJobs )
+	{
+		auto& task = m_tasks[ index ];
+		task.job();
+		complete( task );
+	}
+
+	if( m_tasks.empty() )
+	{
+		return std::nullopt;
+	}
+
+	return std::ranges::min_element( m_tasks, {}, &Task::release )->release;
+}
+
+auto v1::SensorScheduler::statistics( const TaskId id ) const -> std::optional< TaskStatistics >
+{
+	std::lock_guard _{ m_tasksMtx };
+
+	const auto it = std::ranges::find( m_tasks, id, &Task::id );
+	if( it == m_tasks.end() )
+	{
+		return std::nullopt;
+	}
+
+	TaskStatistics stats{
+		.releases = it->releases,
+		.deadlineMisses = it->deadlineMisses,
+		.failures = it->failures,
+		.maxJitter = it->jitterMax,
+	};
+
+	if( it->releases > 0 )
+	{
+		stats.meanJitter = it->jitterTotal / static_cast< std::int64_t >( it->releases );
+	}
+
+	return stats;
+}
+
+auto v1::SensorScheduler::statistics() const noexcept -> Statistics
+{
+	return Statistics{
+		.cycles = m_cycles.load( std::memory_order_relaxed ),
+		.transfers = m_transfers.load( std::memory_order_relaxed ),
+		.coalesced = m_coalesced.load( std::memory_order_relaxed ),
+	};
+}
+
+auto v1::SensorScheduler::insert( Task&& task ) -> TaskId
+{
+	const auto id = [ & ] {
+		std::lock_guard _{ m_tasksMtx };
+
+		const auto taskId = m_nextId++;
+		task.id = taskId;
+		task.release = Clock::now();
+
+		// Equal periods keep the registration order
+		const auto position = std::ranges::upper_bound( m_tasks, task.period, {}, &Task::period );
+		m_scratch.resize( m_scratch.size() + task.data.size() );
+		m_tasks.insert( position, std::move( task ) );
+
+		m_dueReads.reserve( m_tasks.size() );
+		m_dueJobs.reserve( m_tasks.size() );
+		m_members.reserve( m_tasks.size() );
+		m_groups.reserve( m_tasks.size() );
+
+		return taskId;
+	}();
+
+	// The new task is released immediately, wake the scheduler thread up
+	if( m_wakeFd >= 0 )
+	{
+		const std::uint64_t wake{ 1 };
+		[[maybe_unused]] const auto rslt = ::write( m_wakeFd, &wake, sizeof( wake ) );
+	}
+
+	return id;
+}
+
+void v1::SensorScheduler::serveReads()
+{
+	if( m_dueReads.empty() )
+	{
+		return;
+	}
+
+	// Order by device and register so reads that can be merged are next to each other
+	m_members.assign( m_dueReads.begin(), m_dueReads.end() );
+	std::ranges::sort( m_members, [ this ]( const std::size_t lhs, const std::size_t rhs ) {
+		const auto& a = m_tasks[ lhs ];
+		const auto& b = m_tasks[ rhs ];
+		return a.address != b.address ? a.address < b.address : a.reg < b.reg;
+	} );
+
+	m_groups.clear();
+	for( std::size_t i = 0; i < m_members.size(); ++i )
+	{
+		const auto& task = m_tasks[ m_members[ i ] ];
+		const std::size_t end = task.reg + task.data.size();
+
+		if( !m_groups.empty() && m_options.coalesce )
+		{
+			auto& group = m_groups.back();
+			if( group.address == task.address && task.reg <= group.end )
+			{
+				group.end = std::max( group.end, end );
+				group.last = i + 1;
+				group.period = std::min( group.period, task.period );
+				m_coalesced.fetch_add( 1, std::memory_order_relaxed );
+				continue;
+			}
+		}
+
+		m_groups.push_back( Group{ .address = task.address,
+								   .reg = task.reg,
+								   .end = end,
+								   .first = i,
+								   .last = i + 1,
+								   .offset = 0,
+								   .period = task.period } );
+	}
+
+	// Merged reads land in the scratch buffer, it holds all reads of all tasks so every merge fits
+	std::size_t used{};
+	for( auto& group : m_groups )
+	{
+		if( group.last - group.first > 1 )
+		{
+			group.offset = used;
+			used += group.end - group.reg;
+		}
+	}
+
+	// Rate-monotonic, the group with the shortest period is queued first
+	std::ranges::sort( m_groups, []( const Group& lhs, const Group& rhs ) {
+		return lhs.period != rhs.period ? lhs.period < rhs.period : lhs.first < rhs.first;
+	} );
+
+	const std::span< const Group > groups{ m_groups };
+	std::size_t pending{};
+
+	for( std::size_t i = 0; i < groups.size(); ++i )
+	{
+		const auto& group = groups[ i ];
+		if( !stage( group ) )
+		{
+			// The transaction is full, submit what was queued so far, a read always fits an empty one
+			flush( groups.subspan( pending, i - pending ) );
+			pending = i;
+
+			[[maybe_unused]] const bool staged = stage( group );
+		}
+	}
+
+	flush( groups.subspan( pending ) );
+}
+
+bool v1::SensorScheduler::stage( const Group& group )
+{
+	const auto buffer = group.last - group.first == 1
+							? std::span{ m_tasks[ m_members[ group.first ] ].data }
+							: std::span{ m_scratch }.subspan( group.offset, group.end - group.reg );
+
+	return m_transaction.read( group.address, static_cast< std::uint8_t >( group.reg ), buffer );
+}
+
+void v1::SensorScheduler::flush( std::span< const Group > groups )
+{
+	if( m_transaction.empty() )
+	{
+		return;
+	}
+
+	const bool submitted = m_busController.submit( m_transaction );
+	m_transfers.fetch_add( 1, std::memory_order_relaxed );
+
+	// One sensor NACKing fails the whole transfer, the failed reads of a shared transfer are repeated
+	// one by one so the error reaches only the tasks of the sensor that caused it. An ioctl error doesn't
+	// tell which reads ran before the NACK, the non-idempotent ones keep the error instead of being repeated.
+	std::array< std::size_t, Transaction::kMaxMessages > failed;
+	std::size_t failedCount{};
+
+	for( std::size_t i = 0; i < groups.size(); ++i )
+	{
+		const auto rslt = m_transaction.result( i );
+		if( !rslt && !submitted && groups.size() > 1 && repeatable( groups[ i ] ) ) [[unlikely]]
+		{
+			failed[ failedCount++ ] = i;
+			continue;
+		}
+
+		deliver( groups[ i ], rslt );
+	}
+
+	m_transaction.clear();
+
+	for( std::size_t f = 0; f < failedCount; ++f )
+	{
+		const auto& group = groups[ failed[ f ] ];
+		[[maybe_unused]] const bool staged = stage( group );
+		[[maybe_unused]] const bool retried = m_busController.submit( m_transaction );
+		m_transfers.fetch_add( 1, std::memory_order_relaxed );
+
+		deliver( group, m_transaction.result( 0 ) );
+		m_transaction.clear();
+	}
+}
+
+bool v1::SensorScheduler::repeatable( const Group& group ) const noexcept
+{
+	for( std::size_t m = group.first; m < group.last; ++m )
+	{
+		if( m_tasks[ m_members[ m ] ].idempotency == Idempotency::NON_IDEMPOTENT )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void v1::SensorScheduler::deliver( const Group& group, const Result< void >& result )
+{
+	const bool merged = group.last - group.first > 1;
+
+	for( std::size_t m = group.first; m < group.last; ++m )
+	{
+		auto& task = m_tasks[ m_members[ m ] ];
+
+		if( !result ) [[unlikely]]
+		{
+			task.failures += 1;
+			task.onRead( std::unexpected( result.error() ) );
+			complete( task );
+			continue;
+		}
+
+		// Scatter the merged read back to the individual tasks
+		if( merged )
+		{
+			const auto offset = group.offset + task.reg - group.reg;
+			std::copy_n( m_scratch.begin() + static_cast< std::ptrdiff_t >( offset ),
+						 task.data.size(),
+						 task.data.begin() );
+		}
+
+		task.onRead( std::span< const std::uint8_t >{ task.data } );
+		complete( task );
+	}
+}
+
+void v1::SensorScheduler::complete( Task& task ) noexcept
+{
+	// The next release is the deadline of the one served
+	if( Clock::now() > task.release ) [[unlikely]]
+	{
+		task.deadlineMisses += 1;
+	}
+}
+
+void v1::SensorScheduler::run( std::stop_token stopToken )
+{
+	while( !stopToken.stop_requested() )
+	{
+		const auto next = runDue( Clock::now() );
+
+		// Absolute expiry, an expiry in the past fires immediately, a zero one disarms the timer
+		::itimerspec spec{};
+		if( next )
+		{
+			spec.it_value = toTimespec( *next );
+		}
+
+		::timerfd_settime( m_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr );
+
+		std::array fds{ ::pollfd{ .fd = m_timerFd, .events = POLLIN, .revents = 0 },
+						::pollfd{ .fd = m_wakeFd, .events = POLLIN, .revents = 0 } };
+
+		if( ::poll( fds.data(), fds.size(), -1 ) < 0 ) [[unlikely]]
+		{
+			continue; // EINTR
+		}
+
+		for( const auto& fd : fds )
+		{
+			if( fd.revents & POLLIN )
+			{
+				drain( fd.fd );
+			}
+		}
+	}
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,252 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of SensorScheduler class, polls registered sensors at individual rates on absolute deadlines.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_SENSOR_SCHEDULER_HPP__
+#define PBL_I2C_SENSOR_SCHEDULER_HPP__
+
+#include "Transaction.hpp"
+#include <utils/Result.hpp>
+
+// C++
+#include <span>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <functional>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+class BusController;
+
+/**
+ * @class SensorScheduler
+ * @brief Releases periodic sensor reads on absolute deadlines and submits the reads due together as one transfer.
+ *
+ * Every task has its own period, i.e. an MPU6050 sampled at 1 kHz, a BMP180 at 10 Hz and an SHT31 at 2 Hz.
+ * The scheduler thread sleeps on a CLOCK_MONOTONIC timerfd armed with the earliest absolute release time,
+ * so the rate doesn't drift with the execution time of the tasks the way a relative sleep_for loop does.
+ *
+ * Tasks are served rate-monotonically: when several are due, the shorter period goes first. The register
+ * reads due at a release are queued into one Transaction (one I2C_RDWR ioctl on Linux) and served before
+ * the jobs, overlapping or adjacent reads of the same device are coalesced into a single read (see
+ * Options::coalesce). When a device NACKs, the transfer fails as a whole, the failed reads are then
+ * repeated one transfer each, so only the tasks of that device see the error. A failed ioctl doesn't tell
+ * which reads already ran, so reads registered as Idempotency::NON_IDEMPOTENT (i.e. clear-on-read status
+ * or FIFO data) are not repeated, their tasks see the error of the shared transfer instead.
+ *
+ * A task misses its deadline when it completes after its next release, or when releases were skipped
+ * because the scheduler fell behind by more than a period. Skipped releases are not caught up, the task
+ * resumes on its original time grid. The release jitter is the delay between the release time and the
+ * moment the scheduler started serving the task.
+ *
+ * Example usage:
+ * @code
+ * SensorScheduler scheduler{ busController };
+ *
+ * scheduler.addRead( 0x68, 0x3B, 14, 1ms, []( auto rslt ) { ... } ); // MPU6050 accel, temperature, gyro
+ * scheduler.addTask( 100ms, [ & ] { bmp180.getTruePressurePa(); } ); // Controller level polling
+ *
+ * if( auto rslt = scheduler.start(); !rslt ) { ... }
+ * @endcode
+ *
+ * @note Callbacks run on the scheduler thread while it holds the task list, they must not add or remove tasks.
+ */
+class SensorScheduler final
+{
+public:
+	template < typename T >
+	using Result = utils::Result< T >;
+
+	using Clock = std::chrono::steady_clock;
+	using TaskId = std::uint32_t;
+
+	/// Receives the register data, the span is valid during the call only.
+	using ReadCallback = std::move_only_function< void( Result< std::span< const std::uint8_t > > ) >;
+
+	/// A task polling through a controller, i.e. a multi step conversion.
+	using Job = std::move_only_function< void() >;
+
+	struct Options
+	{
+		/// Whether overlapping or adjacent reads of the same device due together are merged into one read.
+		bool coalesce{ true };
+	};
+
+	struct TaskStatistics
+	{
+		std::uint64_t releases{}; //!< Times the task was served.
+		std::uint64_t deadlineMisses{}; //!< Late completions plus skipped releases.
+		std::uint64_t failures{}; //!< Reads completed with an error.
+		std::chrono::nanoseconds meanJitter{}; //!< Mean delay between release and service.
+		std::chrono::nanoseconds maxJitter{}; //!< Longest delay between release and service.
+	};
+
+	struct Statistics
+	{
+		std::uint64_t cycles{}; //!< Scheduler wake-ups that released at least one task.
+		std::uint64_t transfers{}; //!< Transactions submitted to the bus.
+		std::uint64_t coalesced{}; //!< Reads merged into the read of another task.
+	};
+
+	/// Creates a stopped scheduler with the default options, the bus controller must outlive it.
+	explicit SensorScheduler( BusController& busController );
+
+	/// Creates a stopped scheduler, the bus controller must outlive it.
+	SensorScheduler( BusController& busController, Options options );
+
+	/// Stops the scheduler thread.
+	~SensorScheduler();
+
+	/**
+	 * @brief Registers a periodic register read, first released immediately.
+	 *
+	 * @param deviceAddr The 7-bit device address.
+	 * @param reg The first register read.
+	 * @param size Number of bytes read, 1 - 255.
+	 * @param period The release period, must be positive.
+	 * @param callback Receives the data or the error of each read.
+	 * @param idempotency Whether the read may be repeated after a failed shared transfer.
+	 * @return The id of the task or ErrorCode::INVALID_ARGUMENT.
+	 */
+	[[nodiscard]] Result< TaskId > addRead( const std::uint8_t deviceAddr,
+											const std::uint8_t reg,
+											const std::size_t size,
+											const std::chrono::nanoseconds period,
+											ReadCallback callback,
+											const Idempotency idempotency = Idempotency::IDEMPOTENT );
+
+	/// Registers a periodic job, first released immediately, returns ErrorCode::INVALID_ARGUMENT for a non-positive period.
+	[[nodiscard]] Result< TaskId > addTask( const std::chrono::nanoseconds period, Job job );
+
+	/// Unregisters a task, returns false if there is no task with the given id.
+	bool remove( const TaskId id );
+
+	/// Starts the scheduler thread, fails if the timer can't be created.
+	[[nodiscard]] Result< void > start();
+
+	/// Stops the scheduler thread, the tasks stay registered.
+	void stop();
+
+	/// Returns whether the scheduler thread runs.
+	[[nodiscard]] bool running() const noexcept { return m_thread.joinable(); }
+
+	/**
+	 * @brief Serves the tasks released at or before now.
+	 *
+	 * Called by the scheduler thread on every wake-up, it may be called directly instead of start to drive
+	 * the scheduler from an existing loop.
+	 *
+	 * @return The earliest release time of the remaining tasks, std::nullopt if there are none.
+	 */
+	std::optional< Clock::time_point > runDue( const Clock::time_point now );
+
+	/// Returns the statistics of a task, std::nullopt if there is no task with the given id.
+	[[nodiscard]] std::optional< TaskStatistics > statistics( const TaskId id ) const;
+
+	/// Returns the scheduler wide statistics.
+	[[nodiscard]] Statistics statistics() const noexcept;
+
+private:
+	struct Task
+	{
+		TaskId id{};
+		std::chrono::nanoseconds period{};
+		Clock::time_point release; //!< The next release, also the deadline of the current one.
+
+		std::uint8_t address{};
+		std::uint8_t reg{};
+		Idempotency idempotency{ Idempotency::IDEMPOTENT };
+		std::vector< std::uint8_t > data; //!< Read destination, empty for jobs.
+		ReadCallback onRead;
+		Job job;
+
+		std::uint64_t releases{};
+		std::uint64_t deadlineMisses{};
+		std::uint64_t failures{};
+		std::chrono::nanoseconds jitterTotal{};
+		std::chrono::nanoseconds jitterMax{};
+	};
+
+	/// Reads of the same device served by one register read.
+	struct Group
+	{
+		std::uint8_t address{};
+		std::size_t reg{};
+		std::size_t end{}; //!< One past the last register.
+		std::size_t first{}; //!< Index of the first member in m_members.
+		std::size_t last{}; //!< One past the last member.
+		std::size_t offset{}; //!< Offset in the scratch buffer, merged groups only.
+		std::chrono::nanoseconds period{}; //!< The shortest period of the members, the group priority.
+	};
+
+	/// Inserts the task keeping the list ordered by period.
+	TaskId insert( Task&& task );
+
+	/// Queues the due reads into transactions and completes them.
+	void serveReads();
+
+	/// Queues the read of the group into the transaction, returns false if it is full.
+	[[nodiscard]] bool stage( const Group& group );
+
+	/// Submits the queued groups and completes their members, retries the failed reads alone.
+	void flush( std::span< const Group > groups );
+
+	/// Returns whether the reads of every member of the group may be repeated.
+	[[nodiscard]] bool repeatable( const Group& group ) const noexcept;
+
+	/// Completes the members of the group with the outcome of its read.
+	void deliver( const Group& group, const Result< void >& result );
+
+	/// Completes a served task, counting a miss if it completed after its deadline.
+	void complete( Task& task ) noexcept;
+
+	/// The scheduler thread loop.
+	void run( std::stop_token stopToken );
+
+	// This class is non-copyable and non-movable
+	SensorScheduler( const SensorScheduler& ) = delete;
+	SensorScheduler( SensorScheduler&& ) = delete;
+	SensorScheduler& operator=( const SensorScheduler& ) = delete;
+	SensorScheduler& operator=( SensorScheduler&& ) = delete;
+
+private:
+	BusController& m_busController;
+	const Options m_options;
+
+	mutable std::mutex m_tasksMtx; //!< Locks the tasks and the per cycle buffers
+	std::vector< Task > m_tasks; //!< Ordered by period, the rate-monotonic priority
+	TaskId m_nextId{ 1 };
+
+	// Per cycle buffers, sized when tasks are added so serving a release doesn't allocate
+	std::vector< std::size_t > m_dueReads; //!< Indices of the due read tasks
+	std::vector< std::size_t > m_dueJobs; //!< Indices of the due jobs
+	std::vector< std::size_t > m_members; //!< Indices of the group members, grouped
+	std::vector< Group > m_groups;
+	std::vector< std::uint8_t > m_scratch; //!< Destination of the merged reads
+	Transaction m_transaction;
+
+	std::atomic< std::uint64_t > m_cycles{};
+	std::atomic< std::uint64_t > m_transfers{};
+	std::atomic< std::uint64_t > m_coalesced{};
+
+	int m_timerFd{ -1 }; //!< CLOCK_MONOTONIC timerfd armed with the next release
+	int m_wakeFd{ -1 }; //!< eventfd interrupting the wait on task changes and stop
+	std::jthread m_thread;
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_SENSOR_SCHEDULER_HPP__
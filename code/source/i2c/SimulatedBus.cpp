@@ -0,0 +1,87 @@
+/**
+ *  @brief Implementation of SimulatedBus class, an in-memory I2C transport hosting device models.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "SimulatedBus.hpp"
+
+// C
+extern "C" {
+#include <errno.h>
+}
+
+namespace pbl::i2c
+{
+
+v1::SimulatedBus::SimulatedBus( std::string name )
+	: m_name{ std::move( name ) }
+{ }
+
+v1::SimulatedBus::~SimulatedBus() = default;
+
+int v1::SimulatedBus::transfer( std::span< Transaction::Message > messages ) noexcept
+{
+	m_transfers.fetch_add( 1, std::memory_order_relaxed );
+
+	if( messages.size() > Transaction::kMaxMessages ) [[unlikely]]
+	{
+		return -EINVAL;
+	}
+
+	std::size_t bytes{};
+	int transferred{};
+
+	for( auto& message : messages )
+	{
+		if( message.address >= kAddressCount ) [[unlikely]]
+		{
+			return -EINVAL;
+		}
+
+		auto* pDevice = m_devices[ message.address ].get();
+		if( pDevice == nullptr ) [[unlikely]]
+		{
+			delay( bytes );
+			return -ENXIO;
+		}
+
+		const bool acked = message.read ? pDevice->read( message.buffer ) : pDevice->write( message.buffer );
+		if( !acked ) [[unlikely]]
+		{
+			delay( bytes );
+			return -EREMOTEIO;
+		}
+
+		bytes += message.buffer.size() + 1; // + 1 for the address byte
+		++transferred;
+	}
+
+	m_messages.fetch_add( static_cast< std::uint64_t >( transferred ), std::memory_order_relaxed );
+	delay( bytes );
+
+	return transferred;
+}
+
+void v1::SimulatedBus::sleep( const std::chrono::microseconds sleepTime )
+{
+	m_sleptUs.fetch_add( sleepTime.count(), std::memory_order_relaxed );
+}
+
+void v1::SimulatedBus::delay( const std::size_t bytes ) const noexcept
+{
+	const auto latency = m_latencyPerTransfer + m_latencyPerByte * static_cast< std::int64_t >( bytes );
+	if( latency <= std::chrono::nanoseconds::zero() )
+	{
+		return;
+	}
+
+	const auto deadline = std::chrono::steady_clock::now() + latency;
+	while( std::chrono::steady_clock::now() < deadline )
+	{
+	}
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,147 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of SimulatedBus class, an in-memory I2C transport hosting device models.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_SIMULATED_BUS_HPP__
+#define PBL_I2C_SIMULATED_BUS_HPP__
+
+#include "Transport.hpp"
+
+// C++
+#include <span>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <concepts>
+#include <utility>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+/**
+ * @class SimulatedDevice
+ * @brief Base of the device models attached to a SimulatedBus.
+ *
+ * A model sees the messages addressed to it in bus order, a register pointer write followed by
+ * a read message is delivered as write() and then read() within the same transfer.
+ */
+class SimulatedDevice
+{
+public:
+	virtual ~SimulatedDevice() = default;
+
+	/// Handles a write message, returns false to not acknowledge the data.
+	[[nodiscard]] virtual bool write( std::span< const std::uint8_t > data ) = 0;
+
+	/// Handles a read message by filling data, returns false to not acknowledge the read.
+	[[nodiscard]] virtual bool read( std::span< std::uint8_t > data ) = 0;
+};
+
+/**
+ * @class SimulatedBus
+ * @brief An in-memory I2C bus, routes transfers to the device models attached at their addresses.
+ *
+ * Addressing a device that is not attached fails the transfer with ENXIO, the same way i2c-dev
+ * reports an address NACK. An optional per-transfer and per-byte latency makes the timing resemble
+ * a physical bus (i.e. ~90us per byte at 100kHz), the wait is a busy loop so it stays accurate in
+ * the microsecond range. Waits requested by the drivers (BusController::sleep) are only accounted
+ * for, device models complete their conversions instantly.
+ *
+ * Example usage:
+ * @code
+ * auto bus = std::make_unique< SimulatedBus >();
+ * auto& sensor = bus->attach< SimulatedLM75 >( 0x48 );
+ * sensor.setTemperature( 21.5f );
+ *
+ * BusController busController{ std::move( bus ) };
+ * LM75Controller lm75{ busController };
+ * auto temperature = lm75.getTemperatureC(); // 21.5
+ * @endcode
+ *
+ * @note Device models are not synchronised, adjust them from the thread driving the bus or while it is idle.
+ */
+class SimulatedBus final : public Transport
+{
+public:
+	/// The number of 7-bit addresses.
+	static constexpr std::size_t kAddressCount{ 128 };
+
+	explicit SimulatedBus( std::string name = "sim-i2c" );
+
+	~SimulatedBus() override;
+
+	[[nodiscard]] const std::string& name() const noexcept override { return m_name; }
+
+	[[nodiscard]] bool isOpen() const noexcept override { return true; }
+
+	[[nodiscard]] int transfer( std::span< Transaction::Message > messages ) noexcept override;
+
+	void sleep( const std::chrono::microseconds sleepTime ) override;
+
+	/// Constructs a device model at the given 7-bit address, replacing any model attached there.
+	template < std::derived_from< SimulatedDevice > T, typename... Args >
+	T& attach( const std::uint8_t address, Args&&... args )
+	{
+		auto device = std::make_unique< T >( std::forward< Args >( args )... );
+		auto& ref = *device;
+		m_devices.at( address ) = std::move( device );
+		return ref;
+	}
+
+	/// Removes the model at the given address, further transfers to it are not acknowledged.
+	void detach( const std::uint8_t address ) { m_devices.at( address ).reset(); }
+
+	/// Returns the model at the given address, nullptr if none is attached.
+	[[nodiscard]] SimulatedDevice* device( const std::uint8_t address ) const
+	{
+		return address < kAddressCount ? m_devices[ address ].get() : nullptr;
+	}
+
+	/// Sets the time every transfer takes, a fixed part plus a part per transferred byte.
+	void setLatency( const std::chrono::nanoseconds perTransfer, const std::chrono::nanoseconds perByte = {} ) noexcept
+	{
+		m_latencyPerTransfer = perTransfer;
+		m_latencyPerByte = perByte;
+	}
+
+	/// Returns the number of transfers performed, successful or not.
+	[[nodiscard]] std::uint64_t transferCount() const noexcept { return m_transfers.load( std::memory_order_relaxed ); }
+
+	/// Returns the number of messages acknowledged by the device models.
+	[[nodiscard]] std::uint64_t messageCount() const noexcept { return m_messages.load( std::memory_order_relaxed ); }
+
+	/// Returns the total time the drivers asked to wait.
+	[[nodiscard]] std::chrono::microseconds sleptFor() const noexcept
+	{
+		return std::chrono::microseconds{ m_sleptUs.load( std::memory_order_relaxed ) };
+	}
+
+private:
+	/// Busy waits the configured latency for a transfer of the given size.
+	void delay( const std::size_t bytes ) const noexcept;
+
+private:
+	const std::string m_name;
+	std::array< std::unique_ptr< SimulatedDevice >, kAddressCount > m_devices{};
+
+	std::chrono::nanoseconds m_latencyPerTransfer{};
+	std::chrono::nanoseconds m_latencyPerByte{};
+
+	std::atomic< std::uint64_t > m_transfers{};
+	std::atomic< std::uint64_t > m_messages{};
+	std::atomic< std::int64_t > m_sleptUs{};
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_SIMULATED_BUS_HPP__
@@ -0,0 +1,1068 @@
+/**
+ *  @brief Implementation of the register map models of the supported ICs.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "SimulatedDevices.hpp"
+
+// C++
+#include <cmath>
+#include <utility>
+#include <algorithm>
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+// LM75 / TMP102 / ADS1015 pointer registers
+constexpr std::uint8_t kTemperatureRegister{ 0x00 };
+constexpr std::uint8_t kConfigurationRegister{ 0x01 };
+constexpr std::uint8_t kTLowRegister{ 0x02 };
+constexpr std::uint8_t kTHighRegister{ 0x03 };
+
+// TMP102 configuration bits
+constexpr std::uint16_t kTmp102ResolutionBits{ 0x6000 }; //!< R1/R0, read only, always 12-bit
+constexpr std::uint16_t kTmp102ExtendedModeBit{ 0x0010 };
+
+// ADS1015 configuration bits
+constexpr std::uint16_t kAdsOsBit{ 0x8000 };
+constexpr std::uint16_t kAdsSingleShotModeBit{ 0x0100 };
+constexpr std::array kAdsFullScaleRange{ 6.144f, 4.096f, 2.048f, 1.024f, 0.512f, 0.256f, 0.256f, 0.256f };
+
+// SHT31 commands
+constexpr std::uint16_t kShtFetchData{ 0xE000 };
+constexpr std::uint16_t kShtBreak{ 0x3093 };
+constexpr std::uint16_t kShtSoftReset{ 0x30A2 };
+constexpr std::uint16_t kShtReadStatus{ 0xF32D };
+constexpr std::uint16_t kShtClearStatus{ 0x3041 };
+constexpr std::uint16_t kShtHeaterEnable{ 0x306D };
+constexpr std::uint16_t kShtHeaterDisable{ 0x3066 };
+constexpr std::array< std::uint16_t, 6 > kShtSingleShot{ 0x2400, 0x240B, 0x2416, 0x2C06, 0x2C0D, 0x2C10 };
+constexpr std::array< std::uint16_t, 16 > kShtPeriodic{ 0x2032, 0x2024, 0x202F, 0x2130, 0x2126, 0x212D,
+														0x2236, 0x2220, 0x222B, 0x2334, 0x2322, 0x2329,
+														0x2737, 0x2721, 0x272A, 0x2B32 };
+
+/// Measurement periods of the periodic commands, three repeatabilities per rate (0.5, 1, 2, 4 and 10 mps) and ART (4 Hz).
+constexpr std::array< std::chrono::milliseconds, 6 > kShtPeriods{ std::chrono::milliseconds{ 2000 },
+																  std::chrono::milliseconds{ 1000 },
+																  std::chrono::milliseconds{ 500 },
+																  std::chrono::milliseconds{ 250 },
+																  std::chrono::milliseconds{ 100 },
+																  std::chrono::milliseconds{ 250 } };
+
+// SHT31 status bits
+constexpr std::uint16_t kShtAlertPending{ 0x8000 };
+constexpr std::uint16_t kShtHeaterOn{ 0x2000 };
+constexpr std::uint16_t kShtHumidityAlert{ 0x0800 };
+constexpr std::uint16_t kShtTemperatureAlert{ 0x0400 };
+constexpr std::uint16_t kShtResetDetected{ 0x0010 };
+constexpr std::uint16_t kShtCommandFailed{ 0x0002 };
+
+// BMP180 registers
+constexpr std::uint8_t kBmpCalibration{ 0xAA };
+constexpr std::uint8_t kBmpCalibrationEnd{ 0xBF };
+constexpr std::uint8_t kBmpChipId{ 0xD0 };
+constexpr std::uint8_t kBmpSoftReset{ 0xE0 };
+constexpr std::uint8_t kBmpControl{ 0xF4 };
+constexpr std::uint8_t kBmpOutMsb{ 0xF6 };
+constexpr std::uint8_t kBmpOutXlsb{ 0xF8 };
+constexpr std::uint8_t kBmpStartConversionBit{ 0x20 };
+
+/// Calibration EEPROM of the datasheet example (AC1 = 408 ... MD = 2868), big endian.
+constexpr std::array< std::uint8_t, 22 > kBmpDatasheetCalibration{ 0x01, 0x98, 0xFF, 0xB8, 0xC7, 0xD1, 0x7F, 0xE5,
+																   0x7F, 0xF5, 0x5A, 0x71, 0x18, 0x2E, 0x00, 0x04,
+																   0x80, 0x00, 0xDD, 0xF9, 0x0B, 0x34 };
+
+// MPU6050 registers
+constexpr std::uint8_t kMpuAccelOut{ 0x3B };
+constexpr std::uint8_t kMpuTempOut{ 0x41 };
+constexpr std::uint8_t kMpuGyroOut{ 0x43 };
+constexpr std::uint8_t kMpuSensorOutEnd{ 0x48 };
+constexpr std::uint8_t kMpuFifoEnable{ 0x23 };
+constexpr std::uint8_t kMpuIntStatus{ 0x3A };
+constexpr std::uint8_t kMpuUserControl{ 0x6A };
+constexpr std::uint8_t kMpuPowerManagement1{ 0x6B };
+constexpr std::uint8_t kMpuFifoCountH{ 0x72 };
+constexpr std::uint8_t kMpuFifoCountL{ 0x73 };
+constexpr std::uint8_t kMpuFifoReadWrite{ 0x74 };
+constexpr std::uint8_t kMpuWhoAmI{ 0x75 };
+constexpr std::uint8_t kMpuDeviceResetBit{ 0x80 };
+constexpr std::uint8_t kMpuFifoEnBit{ 0x40 };
+constexpr std::uint8_t kMpuFifoResetBit{ 0x04 };
+constexpr std::uint8_t kMpuFifoOverflowBit{ 0x10 };
+constexpr std::size_t kMpuFifoSize{ 1024 };
+
+/// FIFO_EN bits and the output registers they latch, in FIFO order.
+constexpr std::array< std::pair< std::uint8_t, std::pair< std::uint8_t, std::uint8_t > >, 5 > kMpuFifoSources{ {
+	{ 0x08, { kMpuAccelOut, 6 } }, // ACCEL_FIFO_EN
+	{ 0x80, { kMpuTempOut, 2 } }, // TEMP_FIFO_EN
+	{ 0x40, { kMpuGyroOut, 2 } }, // XG_FIFO_EN
+	{ 0x20, { kMpuGyroOut + 2, 2 } }, // YG_FIFO_EN
+	{ 0x10, { kMpuGyroOut + 4, 2 } } // ZG_FIFO_EN
+} };
+
+// PCA9685 registers
+constexpr std::uint8_t kPcaMode1{ 0x00 };
+constexpr std::uint8_t kPcaMode2{ 0x01 };
+constexpr std::uint8_t kPcaLed0OnL{ 0x06 };
+constexpr std::uint8_t kPcaAllLedOnL{ 0xFA };
+constexpr std::uint8_t kPcaAllLedOffH{ 0xFD };
+constexpr std::uint8_t kPcaPrescale{ 0xFE };
+constexpr std::uint8_t kPcaTestMode{ 0xFF };
+constexpr std::uint8_t kPcaRestartBit{ 0x80 };
+constexpr std::uint8_t kPcaAutoIncrementBit{ 0x20 };
+constexpr std::uint8_t kPcaSleepBit{ 0x10 };
+constexpr std::uint8_t kPcaFullBit{ 0x10 };
+
+// MCP23017 registers (IOCON.BANK = 0), port B follows port A
+constexpr std::uint8_t kMcpIodir{ 0x00 };
+constexpr std::uint8_t kMcpIpol{ 0x02 };
+constexpr std::uint8_t kMcpGpinten{ 0x04 };
+constexpr std::uint8_t kMcpDefval{ 0x06 };
+constexpr std::uint8_t kMcpIntcon{ 0x08 };
+constexpr std::uint8_t kMcpIocon{ 0x0A };
+constexpr std::uint8_t kMcpIntf{ 0x0E };
+constexpr std::uint8_t kMcpIntcap{ 0x10 };
+constexpr std::uint8_t kMcpGpio{ 0x12 };
+constexpr std::uint8_t kMcpOlat{ 0x14 };
+constexpr std::uint8_t kMcpSeqopBit{ 0x20 };
+
+/// CRC-8 used by the Sensirion sensors, polynomial 0x31 with 0xFF initialisation.
+[[nodiscard]] constexpr std::uint8_t sensirionCrc( const std::uint8_t msb, const std::uint8_t lsb ) noexcept
+{
+	std::uint8_t crc{ 0xFF };
+	for( const std::uint8_t byte : { msb, lsb } )
+	{
+		crc ^= byte;
+		for( int bit = 0; bit < 8; ++bit )
+		{
+			crc = static_cast< std::uint8_t >( ( crc & 0x80 ) ? ( crc << 1 ) ^ 0x31 : crc << 1 );
+		}
+	}
+
+	return crc;
+}
+
+static_assert( sensirionCrc( 0xBE, 0xEF ) == 0x92, "CRC does not match the SHT3x datasheet example." );
+
+// MPU9250 registers and bits, the MPU6050 ones above apply too
+constexpr std::uint8_t kMpu9250Slave0Address{ 0x25 };
+constexpr std::uint8_t kMpu9250Slave0Control{ 0x27 };
+constexpr std::uint8_t kMpu9250Slave4Address{ 0x31 };
+constexpr std::uint8_t kMpu9250Slave4Register{ 0x32 };
+constexpr std::uint8_t kMpu9250Slave4DataOut{ 0x33 };
+constexpr std::uint8_t kMpu9250Slave4Control{ 0x34 };
+constexpr std::uint8_t kMpu9250Slave4DataIn{ 0x35 };
+constexpr std::uint8_t kMpu9250MasterStatus{ 0x36 };
+constexpr std::uint8_t kMpu9250ExtSensorData{ 0x49 };
+constexpr std::uint8_t kMpu9250ExtSensorDataEnd{ 0x60 };
+constexpr std::uint8_t kMpu9250MasterEnBit{ 0x20 };
+constexpr std::uint8_t kMpu9250SlaveEnBit{ 0x80 };
+constexpr std::uint8_t kMpu9250SlaveReadBit{ 0x80 };
+constexpr std::uint8_t kMpu9250Slave4DoneBit{ 0x40 };
+constexpr std::uint8_t kMpu9250Slave4NackBit{ 0x10 };
+constexpr std::uint8_t kMpu9250Slave0FifoBit{ 0x01 };
+constexpr std::size_t kMpu9250FifoSize{ 512 };
+
+// AK8963 registers
+constexpr std::uint8_t kAkAddress{ 0x0C };
+constexpr std::uint8_t kAkWhoAmI{ 0x00 };
+constexpr std::uint8_t kAkData{ 0x03 };
+constexpr std::uint8_t kAkStatus2{ 0x09 };
+constexpr std::uint8_t kAkSensitivity{ 0x10 };
+constexpr std::uint8_t kAkOverflowBit{ 0x08 };
+
+} // namespace
+
+bool v1::RegisterMapDevice::write( std::span< const std::uint8_t > data )
+{
+	// An empty write only addresses the device (i.e. a probe), it is acknowledged
+	if( data.empty() )
+	{
+		return true;
+	}
+
+	m_pointer = data.front();
+	for( const auto value : data.subspan( 1 ) )
+	{
+		writeRegister( m_pointer, value );
+		if( autoIncrement( m_pointer ) )
+		{
+			++m_pointer;
+		}
+	}
+
+	return true;
+}
+
+bool v1::RegisterMapDevice::read( std::span< std::uint8_t > data )
+{
+	for( auto& value : data )
+	{
+		value = readRegister( m_pointer );
+		if( autoIncrement( m_pointer ) )
+		{
+			++m_pointer;
+		}
+	}
+
+	return true;
+}
+
+bool v1::PointerRegisterDevice::write( std::span< const std::uint8_t > data )
+{
+	if( data.empty() )
+	{
+		return true;
+	}
+
+	m_pointer = data.front() & 0x03;
+
+	const auto payload = data.subspan( 1, std::min< std::size_t >( data.size() - 1, 2 ) );
+	if( payload.empty() )
+	{
+		return true;
+	}
+
+	auto& value = m_registers[ m_pointer ];
+	value = static_cast< std::uint16_t >( ( value & 0x00FF ) | ( payload[ 0 ] << 8 ) );
+	if( payload.size() > 1 )
+	{
+		value = static_cast< std::uint16_t >( ( value & 0xFF00 ) | payload[ 1 ] );
+	}
+
+	registerWritten( m_pointer );
+
+	return true;
+}
+
+bool v1::PointerRegisterDevice::read( std::span< std::uint8_t > data )
+{
+	const auto value = m_registers[ m_pointer ];
+	for( std::size_t i = 0; i < data.size(); ++i )
+	{
+		data[ i ] = static_cast< std::uint8_t >( i % 2 == 0 ? value >> 8 : value & 0xFF );
+	}
+
+	return true;
+}
+
+v1::SimulatedLM75::SimulatedLM75()
+{
+	setRegisterValue( kTLowRegister, 0x4B00 ); // 75°C hysteresis
+	setRegisterValue( kTHighRegister, 0x5000 ); // 80°C over-temperature shutdown
+}
+
+void v1::SimulatedLM75::setTemperature( const float temperatureC ) noexcept
+{
+	const auto steps = std::lround( std::clamp( temperatureC, -55.0f, 125.0f ) * 8.0f );
+	setRegisterValue( kTemperatureRegister, static_cast< std::uint16_t >( steps * 32 ) );
+}
+
+v1::SimulatedTMP102::SimulatedTMP102()
+{
+	setRegisterValue( kConfigurationRegister, 0x60A0 );
+	updateTemperatureRegister();
+}
+
+void v1::SimulatedTMP102::setTemperature( const float temperatureC ) noexcept
+{
+	m_temperatureC = std::clamp( temperatureC, -55.0f, 150.0f );
+	updateTemperatureRegister();
+}
+
+void v1::SimulatedTMP102::registerWritten( const std::uint8_t reg )
+{
+	if( reg == kTemperatureRegister )
+	{
+		// The temperature register is read only
+		updateTemperatureRegister();
+	}
+	else if( reg == kConfigurationRegister )
+	{
+		setRegisterValue( reg, registerValue( reg ) | kTmp102ResolutionBits );
+		updateTemperatureRegister();
+	}
+}
+
+void v1::SimulatedTMP102::updateTemperatureRegister() noexcept
+{
+	const auto steps = std::lround( m_temperatureC / 0.0625f );
+
+	if( registerValue( kConfigurationRegister ) & kTmp102ExtendedModeBit )
+	{
+		// 13-bit, bit 0 flags the extended format
+		setRegisterValue( kTemperatureRegister, static_cast< std::uint16_t >( steps * 8 ) | 0x0001 );
+	}
+	else
+	{
+		setRegisterValue( kTemperatureRegister, static_cast< std::uint16_t >( std::min( steps, 2047L ) * 16 ) );
+	}
+}
+
+v1::SimulatedADS1015::SimulatedADS1015()
+{
+	setRegisterValue( kConfigurationRegister, 0x8583 );
+}
+
+void v1::SimulatedADS1015::setInputVoltage( const std::size_t channel, const float volts )
+{
+	m_inputs.at( channel ) = volts;
+
+	// Continuous conversion mode picks up the new level right away
+	if( !( registerValue( kConfigurationRegister ) & kAdsSingleShotModeBit ) )
+	{
+		convert();
+	}
+}
+
+void v1::SimulatedADS1015::registerWritten( const std::uint8_t reg )
+{
+	if( reg != kConfigurationRegister )
+	{
+		return;
+	}
+
+	const auto config = registerValue( kConfigurationRegister );
+	if( ( config & kAdsOsBit ) || !( config & kAdsSingleShotModeBit ) )
+	{
+		convert();
+	}
+
+	// Conversions complete instantly, the device is never busy
+	setRegisterValue( kConfigurationRegister, config | kAdsOsBit );
+}
+
+void v1::SimulatedADS1015::convert() noexcept
+{
+	const auto config = registerValue( kConfigurationRegister );
+	const auto mux = ( config >> 12 ) & 0x07;
+	const auto fsr = kAdsFullScaleRange[ ( config >> 9 ) & 0x07 ];
+
+	float volts{};
+	switch( mux )
+	{
+		case 0: volts = m_inputs[ 0 ] - m_inputs[ 1 ]; break;
+		case 1: volts = m_inputs[ 0 ] - m_inputs[ 3 ]; break;
+		case 2: volts = m_inputs[ 1 ] - m_inputs[ 3 ]; break;
+		case 3: volts = m_inputs[ 2 ] - m_inputs[ 3 ]; break;
+		default: volts = m_inputs[ static_cast< std::size_t >( mux - 4 ) ]; break;
+	}
+
+	const auto code = std::clamp( std::lround( volts / fsr * 2048.0f ), -2048L, 2047L );
+	setRegisterValue( kTemperatureRegister, static_cast< std::uint16_t >( code * 16 ) );
+}
+
+bool v1::SimulatedSHT31::write( std::span< const std::uint8_t > data )
+{
+	if( data.empty() )
+	{
+		return true;
+	}
+
+	if( data.size() != 2 )
+	{
+		return false;
+	}
+
+	const auto command = static_cast< std::uint16_t >( ( data[ 0 ] << 8 ) | data[ 1 ] );
+
+	m_output.clear();
+	m_hasOutput = false;
+
+	const bool singleShot = std::ranges::find( kShtSingleShot, command ) != kShtSingleShot.end();
+	const auto periodicCommand = std::ranges::find( kShtPeriodic, command );
+	const bool periodic = periodicCommand != kShtPeriodic.end();
+	const auto now = std::chrono::steady_clock::now();
+
+	bool accepted{ true };
+	if( singleShot && !m_periodic )
+	{
+		measure();
+	}
+	else if( periodic && !m_periodic )
+	{
+		m_periodic = true;
+		m_period = kShtPeriods[ static_cast< std::size_t >( periodicCommand - kShtPeriodic.begin() ) / 3 ];
+		m_nextMeasurement = now + m_period;
+	}
+	else if( command == kShtFetchData && m_periodic )
+	{
+		// The latest measurement is read out and cleared, the next one completes on the measurement grid
+		if( now >= m_nextMeasurement )
+		{
+			measure();
+			m_nextMeasurement += ( ( now - m_nextMeasurement ) / m_period + 1 ) * m_period;
+		}
+	}
+	else if( command == kShtBreak )
+	{
+		m_periodic = false;
+	}
+	else if( command == kShtSoftReset )
+	{
+		m_periodic = false;
+		m_status = kShtResetDetected;
+	}
+	else if( command == kShtReadStatus )
+	{
+		output( m_status );
+		m_hasOutput = true;
+	}
+	else if( command == kShtClearStatus )
+	{
+		m_status &= static_cast< std::uint16_t >(
+			~( kShtAlertPending | kShtHumidityAlert | kShtTemperatureAlert | kShtResetDetected ) );
+	}
+	else if( command == kShtHeaterEnable )
+	{
+		m_status |= kShtHeaterOn;
+	}
+	else if( command == kShtHeaterDisable )
+	{
+		m_status &= static_cast< std::uint16_t >( ~kShtHeaterOn );
+	}
+	else
+	{
+		accepted = false;
+	}
+
+	if( accepted )
+	{
+		m_status &= static_cast< std::uint16_t >( ~kShtCommandFailed );
+	}
+	else
+	{
+		m_status |= kShtCommandFailed;
+	}
+
+	return accepted;
+}
+
+bool v1::SimulatedSHT31::read( std::span< std::uint8_t > data )
+{
+	if( !m_hasOutput )
+	{
+		return false;
+	}
+
+	const auto count = std::min( data.size(), m_output.size() );
+	std::ranges::copy_n( m_output.begin(), static_cast< std::ptrdiff_t >( count ), data.begin() );
+	std::ranges::fill( data.subspan( count ), 0xFF );
+
+	return true;
+}
+
+void v1::SimulatedSHT31::output( const std::uint16_t word )
+{
+	const auto msb = static_cast< std::uint8_t >( word >> 8 );
+	const auto lsb = static_cast< std::uint8_t >( word & 0xFF );
+
+	m_output.push_back( msb );
+	m_output.push_back( lsb );
+	m_output.push_back( sensirionCrc( msb, lsb ) );
+}
+
+void v1::SimulatedSHT31::measure()
+{
+	const auto rawTemperature = std::clamp( std::lround( ( m_temperatureC + 45.0f ) / 175.0f * 65535.0f ), 0L, 65535L );
+	const auto rawHumidity = std::clamp( std::lround( m_humidity / 100.0f * 65535.0f ), 0L, 65535L );
+
+	output( static_cast< std::uint16_t >( rawTemperature ) );
+	output( static_cast< std::uint16_t >( rawHumidity ) );
+	m_hasOutput = true;
+}
+
+v1::SimulatedBMP180::SimulatedBMP180()
+{
+	setRegisterValue( kBmpChipId, 0x55 );
+	setCalibration( kBmpDatasheetCalibration );
+}
+
+void v1::SimulatedBMP180::setCalibration( const std::array< std::uint8_t, 22 >& calibration ) noexcept
+{
+	for( std::size_t i = 0; i < calibration.size(); ++i )
+	{
+		setRegisterValue( static_cast< std::uint8_t >( kBmpCalibration + i ), calibration[ i ] );
+	}
+}
+
+void v1::SimulatedBMP180::writeRegister( const std::uint8_t reg, const std::uint8_t value )
+{
+	if( reg == kBmpSoftReset )
+	{
+		if( value == 0xB6 )
+		{
+			setRegisterValue( kBmpControl, 0x00 );
+		}
+
+		return;
+	}
+
+	if( reg == kBmpControl )
+	{
+		if( ( value & 0x1F ) == 0x0E ) // Temperature
+		{
+			setWord( kBmpOutMsb, m_ut );
+			setRegisterValue( kBmpOutXlsb, 0x00 );
+		}
+		else if( ( value & 0x1F ) == 0x14 ) // Pressure, oversampling in bits 7-6
+		{
+			const auto oss = value >> 6;
+			const auto up = ( m_up << ( 8 - oss ) ) & 0xFFFFFF;
+			setWord( kBmpOutMsb, static_cast< std::uint16_t >( up >> 8 ) );
+			setRegisterValue( kBmpOutXlsb, static_cast< std::uint8_t >( up & 0xFF ) );
+		}
+
+		// The conversion completes instantly
+		RegisterMapDevice::writeRegister( reg, value & static_cast< std::uint8_t >( ~kBmpStartConversionBit ) );
+		return;
+	}
+
+	// Calibration EEPROM, chip id and the outputs are read only
+	const bool readOnly =
+		( reg >= kBmpCalibration && reg <= kBmpCalibrationEnd ) || reg == kBmpChipId || reg >= kBmpOutMsb;
+	if( !readOnly )
+	{
+		RegisterMapDevice::writeRegister( reg, value );
+	}
+}
+
+v1::SimulatedMPU6050::SimulatedMPU6050()
+{
+	reset();
+}
+
+void v1::SimulatedMPU6050::setAccelerometer( const std::int16_t x, const std::int16_t y, const std::int16_t z ) noexcept
+{
+	setWord( kMpuAccelOut, static_cast< std::uint16_t >( x ) );
+	setWord( kMpuAccelOut + 2, static_cast< std::uint16_t >( y ) );
+	setWord( kMpuAccelOut + 4, static_cast< std::uint16_t >( z ) );
+}
+
+void v1::SimulatedMPU6050::setGyroscope( const std::int16_t x, const std::int16_t y, const std::int16_t z ) noexcept
+{
+	setWord( kMpuGyroOut, static_cast< std::uint16_t >( x ) );
+	setWord( kMpuGyroOut + 2, static_cast< std::uint16_t >( y ) );
+	setWord( kMpuGyroOut + 4, static_cast< std::uint16_t >( z ) );
+}
+
+void v1::SimulatedMPU6050::setTemperature( const std::int16_t raw ) noexcept
+{
+	setWord( kMpuTempOut, static_cast< std::uint16_t >( raw ) );
+}
+
+void v1::SimulatedMPU6050::sample( const std::size_t count )
+{
+	if( !( registerValue( kMpuUserControl ) & kMpuFifoEnBit ) )
+	{
+		return;
+	}
+
+	const auto enabled = registerValue( kMpuFifoEnable );
+	for( std::size_t i = 0; i < count; ++i )
+	{
+		for( const auto& [ bit, source ] : kMpuFifoSources )
+		{
+			if( !( enabled & bit ) )
+			{
+				continue;
+			}
+
+			for( std::uint8_t offset = 0; offset < source.second; ++offset )
+			{
+				m_fifo.push_back( registerValue( static_cast< std::uint8_t >( source.first + offset ) ) );
+			}
+		}
+	}
+
+	if( m_fifo.size() > kMpuFifoSize )
+	{
+		m_fifo.erase( m_fifo.begin(), m_fifo.begin() + static_cast< std::ptrdiff_t >( m_fifo.size() - kMpuFifoSize ) );
+		setRegisterValue( kMpuIntStatus, registerValue( kMpuIntStatus ) | kMpuFifoOverflowBit );
+	}
+}
+
+void v1::SimulatedMPU6050::writeRegister( const std::uint8_t reg, const std::uint8_t value )
+{
+	if( reg == kMpuPowerManagement1 && ( value & kMpuDeviceResetBit ) )
+	{
+		reset();
+		return;
+	}
+
+	// The FIFO reset bit clears itself, and is ignored while FIFO_EN is set
+	if( reg == kMpuUserControl && ( value & kMpuFifoResetBit ) )
+	{
+		if( !( value & kMpuFifoEnBit ) )
+		{
+			m_fifo.clear();
+		}
+
+		RegisterMapDevice::writeRegister( reg, static_cast< std::uint8_t >( value & ~kMpuFifoResetBit ) );
+		return;
+	}
+
+	// Sensor outputs and the identity are read only
+	if( ( reg >= kMpuAccelOut && reg <= kMpuSensorOutEnd ) || reg == kMpuWhoAmI )
+	{
+		return;
+	}
+
+	RegisterMapDevice::writeRegister( reg, value );
+}
+
+std::uint8_t v1::SimulatedMPU6050::readRegister( const std::uint8_t reg )
+{
+	switch( reg )
+	{
+		case kMpuIntStatus:
+		{
+			// Cleared by reading it
+			const auto status = RegisterMapDevice::readRegister( reg );
+			setRegisterValue( reg, 0x00 );
+			return status;
+		}
+		case kMpuFifoCountH: return static_cast< std::uint8_t >( m_fifo.size() >> 8 );
+		case kMpuFifoCountL: return static_cast< std::uint8_t >( m_fifo.size() & 0xFF );
+		case kMpuFifoReadWrite:
+		{
+			if( m_fifo.empty() )
+			{
+				return 0x00;
+			}
+
+			const auto value = m_fifo.front();
+			m_fifo.pop_front();
+			return value;
+		}
+		default: return RegisterMapDevice::readRegister( reg );
+	}
+}
+
+bool v1::SimulatedMPU6050::autoIncrement( const std::uint8_t reg ) const noexcept
+{
+	// Reads of FIFO_R_W keep draining the FIFO
+	return reg != kMpuFifoReadWrite;
+}
+
+void v1::SimulatedMPU6050::reset() noexcept
+{
+	m_fifo.clear();
+
+	for( std::size_t reg = 0; reg < 256; ++reg )
+	{
+		setRegisterValue( static_cast< std::uint8_t >( reg ), 0x00 );
+	}
+
+	setRegisterValue( kMpuPowerManagement1, 0x40 ); // Sleeping
+	setRegisterValue( kMpuWhoAmI, 0x68 );
+}
+
+v1::SimulatedMPU9250::SimulatedMPU9250()
+{
+	reset();
+
+	m_magnetometer[ kAkWhoAmI ] = 0x48;
+	setMagnetometerAdjustment( { 128, 128, 128 } ); // No adjustment
+}
+
+void v1::SimulatedMPU9250::setAccelerometer( const std::int16_t x, const std::int16_t y, const std::int16_t z ) noexcept
+{
+	setWord( kMpuAccelOut, static_cast< std::uint16_t >( x ) );
+	setWord( kMpuAccelOut + 2, static_cast< std::uint16_t >( y ) );
+	setWord( kMpuAccelOut + 4, static_cast< std::uint16_t >( z ) );
+}
+
+void v1::SimulatedMPU9250::setGyroscope( const std::int16_t x, const std::int16_t y, const std::int16_t z ) noexcept
+{
+	setWord( kMpuGyroOut, static_cast< std::uint16_t >( x ) );
+	setWord( kMpuGyroOut + 2, static_cast< std::uint16_t >( y ) );
+	setWord( kMpuGyroOut + 4, static_cast< std::uint16_t >( z ) );
+}
+
+void v1::SimulatedMPU9250::setTemperature( const std::int16_t raw ) noexcept
+{
+	setWord( kMpuTempOut, static_cast< std::uint16_t >( raw ) );
+}
+
+void v1::SimulatedMPU9250::setMagnetometer( const std::int16_t x,
+											const std::int16_t y,
+											const std::int16_t z,
+											const bool overflow ) noexcept
+{
+	// Little endian, unlike the MPU outputs
+	const std::array values{ x, y, z };
+	for( std::size_t axis = 0; axis < values.size(); ++axis )
+	{
+		const auto value = static_cast< std::uint16_t >( values[ axis ] );
+		m_magnetometer[ kAkData + 2 * axis ] = static_cast< std::uint8_t >( value & 0xFF );
+		m_magnetometer[ kAkData + 2 * axis + 1 ] = static_cast< std::uint8_t >( value >> 8 );
+	}
+
+	m_magnetometer[ kAkStatus2 ] = overflow ? kAkOverflowBit : 0x00;
+}
+
+void v1::SimulatedMPU9250::setMagnetometerAdjustment( const std::array< std::uint8_t, 3 >& adjustment ) noexcept
+{
+	std::ranges::copy( adjustment, m_magnetometer.begin() + kAkSensitivity );
+}
+
+void v1::SimulatedMPU9250::sample( const std::size_t count )
+{
+	readSlave0();
+
+	if( !( registerValue( kMpuUserControl ) & kMpuFifoEnBit ) )
+	{
+		return;
+	}
+
+	const auto enabled = registerValue( kMpuFifoEnable );
+	const auto slave0Size = static_cast< std::uint8_t >( registerValue( kMpu9250Slave0Control ) & 0x0F );
+
+	for( std::size_t i = 0; i < count; ++i )
+	{
+		for( const auto& [ bit, source ] : kMpuFifoSources )
+		{
+			if( !( enabled & bit ) )
+			{
+				continue;
+			}
+
+			for( std::uint8_t offset = 0; offset < source.second; ++offset )
+			{
+				m_fifo.push_back( registerValue( static_cast< std::uint8_t >( source.first + offset ) ) );
+			}
+		}
+
+		if( enabled & kMpu9250Slave0FifoBit )
+		{
+			for( std::uint8_t offset = 0; offset < slave0Size; ++offset )
+			{
+				m_fifo.push_back( registerValue( static_cast< std::uint8_t >( kMpu9250ExtSensorData + offset ) ) );
+			}
+		}
+	}
+
+	if( m_fifo.size() > kMpu9250FifoSize )
+	{
+		m_fifo.erase( m_fifo.begin(),
+					  m_fifo.begin() + static_cast< std::ptrdiff_t >( m_fifo.size() - kMpu9250FifoSize ) );
+		setRegisterValue( kMpuIntStatus, registerValue( kMpuIntStatus ) | kMpuFifoOverflowBit );
+	}
+}
+
+void v1::SimulatedMPU9250::writeRegister( const std::uint8_t reg, const std::uint8_t value )
+{
+	if( reg == kMpuPowerManagement1 && ( value & kMpuDeviceResetBit ) )
+	{
+		reset();
+		return;
+	}
+
+	// The FIFO reset bit clears itself, and is ignored while FIFO_EN is set
+	if( reg == kMpuUserControl && ( value & kMpuFifoResetBit ) )
+	{
+		if( !( value & kMpuFifoEnBit ) )
+		{
+			m_fifo.clear();
+		}
+
+		RegisterMapDevice::writeRegister( reg, static_cast< std::uint8_t >( value & ~kMpuFifoResetBit ) );
+		return;
+	}
+
+	// Sensor outputs, external sensor data and the identity are read only
+	if( ( reg >= kMpuAccelOut && reg <= kMpu9250ExtSensorDataEnd ) || reg == kMpuWhoAmI ||
+		reg == kMpu9250MasterStatus || reg == kMpu9250Slave4DataIn )
+	{
+		return;
+	}
+
+	RegisterMapDevice::writeRegister( reg, value );
+
+	if( reg == kMpu9250Slave4Control && ( value & kMpu9250SlaveEnBit ) )
+	{
+		transferSlave4();
+	}
+	else if( reg == kMpu9250Slave0Control )
+	{
+		readSlave0();
+	}
+}
+
+std::uint8_t v1::SimulatedMPU9250::readRegister( const std::uint8_t reg )
+{
+	switch( reg )
+	{
+		case kMpuIntStatus:
+		case kMpu9250MasterStatus:
+		{
+			// Cleared by reading them
+			const auto status = RegisterMapDevice::readRegister( reg );
+			setRegisterValue( reg, 0x00 );
+			return status;
+		}
+		case kMpuFifoCountH: return static_cast< std::uint8_t >( m_fifo.size() >> 8 );
+		case kMpuFifoCountL: return static_cast< std::uint8_t >( m_fifo.size() & 0xFF );
+		case kMpuFifoReadWrite:
+		{
+			if( m_fifo.empty() )
+			{
+				return 0x00;
+			}
+
+			const auto value = m_fifo.front();
+			m_fifo.pop_front();
+			return value;
+		}
+		default: return RegisterMapDevice::readRegister( reg );
+	}
+}
+
+bool v1::SimulatedMPU9250::autoIncrement( const std::uint8_t reg ) const noexcept
+{
+	// Reads of FIFO_R_W keep draining the FIFO
+	return reg != kMpuFifoReadWrite;
+}
+
+void v1::SimulatedMPU9250::reset() noexcept
+{
+	m_fifo.clear();
+
+	for( std::size_t reg = 0; reg < 256; ++reg )
+	{
+		setRegisterValue( static_cast< std::uint8_t >( reg ), 0x00 );
+	}
+
+	setRegisterValue( kMpuPowerManagement1, 0x01 );
+	setRegisterValue( kMpuWhoAmI, 0x71 );
+}
+
+void v1::SimulatedMPU9250::readSlave0() noexcept
+{
+	const auto control = registerValue( kMpu9250Slave0Control );
+	const auto address = registerValue( kMpu9250Slave0Address );
+	if( !( registerValue( kMpuUserControl ) & kMpu9250MasterEnBit ) || !( control & kMpu9250SlaveEnBit ) ||
+		address != ( kMpu9250SlaveReadBit | kAkAddress ) )
+	{
+		return;
+	}
+
+	const auto first = registerValue( static_cast< std::uint8_t >( kMpu9250Slave0Address + 1 ) );
+	for( std::uint8_t offset = 0; offset < ( control & 0x0F ); ++offset )
+	{
+		setRegisterValue( static_cast< std::uint8_t >( kMpu9250ExtSensorData + offset ),
+						  m_magnetometer[ static_cast< std::uint8_t >( first + offset ) ] );
+	}
+}
+
+void v1::SimulatedMPU9250::transferSlave4() noexcept
+{
+	// The transaction completes at once, the enable bit clears itself
+	setRegisterValue( kMpu9250Slave4Control, registerValue( kMpu9250Slave4Control ) & ~kMpu9250SlaveEnBit );
+
+	const auto address = registerValue( kMpu9250Slave4Address );
+	if( !( registerValue( kMpuUserControl ) & kMpu9250MasterEnBit ) ||
+		( address & ~kMpu9250SlaveReadBit ) != kAkAddress )
+	{
+		setRegisterValue( kMpu9250MasterStatus, kMpu9250Slave4NackBit );
+		return;
+	}
+
+	const auto reg = registerValue( kMpu9250Slave4Register );
+	if( address & kMpu9250SlaveReadBit )
+	{
+		setRegisterValue( kMpu9250Slave4DataIn, m_magnetometer[ reg ] );
+	}
+	else
+	{
+		m_magnetometer[ reg ] = registerValue( kMpu9250Slave4DataOut );
+	}
+
+	setRegisterValue( kMpu9250MasterStatus, kMpu9250Slave4DoneBit );
+}
+
+v1::SimulatedPCA9685::SimulatedPCA9685()
+{
+	setRegisterValue( kPcaMode1, 0x11 ); // Sleeping, responds to the all call address
+	setRegisterValue( kPcaMode2, 0x04 ); // Totem pole outputs
+	setRegisterValue( 0x02, 0xE2 ); // SUBADR1
+	setRegisterValue( 0x03, 0xE4 ); // SUBADR2
+	setRegisterValue( 0x04, 0xE8 ); // SUBADR3
+	setRegisterValue( 0x05, 0xE0 ); // ALLCALLADR
+	setRegisterValue( kPcaPrescale, 0x1E ); // 200Hz
+
+	// All channels start fully off
+	for( std::size_t channel = 0; channel < 16; ++channel )
+	{
+		setRegisterValue( static_cast< std::uint8_t >( kPcaLed0OnL + 4 * channel + 3 ), kPcaFullBit );
+	}
+	setRegisterValue( kPcaAllLedOffH, kPcaFullBit );
+}
+
+std::uint16_t v1::SimulatedPCA9685::onCount( const std::size_t channel ) const noexcept
+{
+	const auto reg = static_cast< std::uint8_t >( kPcaLed0OnL + 4 * ( channel % 16 ) );
+	return static_cast< std::uint16_t >( ( ( registerValue( reg + 1 ) & 0x1F ) << 8 ) | registerValue( reg ) );
+}
+
+std::uint16_t v1::SimulatedPCA9685::offCount( const std::size_t channel ) const noexcept
+{
+	const auto reg = static_cast< std::uint8_t >( kPcaLed0OnL + 4 * ( channel % 16 ) + 2 );
+	return static_cast< std::uint16_t >( ( ( registerValue( reg + 1 ) & 0x1F ) << 8 ) | registerValue( reg ) );
+}
+
+std::uint8_t v1::SimulatedPCA9685::prescale() const noexcept
+{
+	return registerValue( kPcaPrescale );
+}
+
+void v1::SimulatedPCA9685::writeRegister( const std::uint8_t reg, const std::uint8_t value )
+{
+	if( reg == kPcaMode1 )
+	{
+		// Writing the restart bit restarts the PWM channels and clears it
+		RegisterMapDevice::writeRegister( reg, value & static_cast< std::uint8_t >( ~kPcaRestartBit ) );
+		return;
+	}
+
+	if( reg == kPcaPrescale )
+	{
+		// The prescaler can only be changed while the oscillator is off
+		if( registerValue( kPcaMode1 ) & kPcaSleepBit )
+		{
+			RegisterMapDevice::writeRegister( reg, value );
+		}
+
+		return;
+	}
+
+	if( reg >= kPcaAllLedOnL && reg <= kPcaAllLedOffH )
+	{
+		for( std::size_t channel = 0; channel < 16; ++channel )
+		{
+			const auto offset = static_cast< std::size_t >( reg - kPcaAllLedOnL );
+			RegisterMapDevice::writeRegister( static_cast< std::uint8_t >( kPcaLed0OnL + 4 * channel + offset ), value );
+		}
+	}
+
+	if( reg != kPcaTestMode )
+	{
+		RegisterMapDevice::writeRegister( reg, value );
+	}
+}
+
+bool v1::SimulatedPCA9685::autoIncrement( [[maybe_unused]] const std::uint8_t reg ) const noexcept
+{
+	return registerValue( kPcaMode1 ) & kPcaAutoIncrementBit;
+}
+
+v1::SimulatedMCP23017::SimulatedMCP23017()
+{
+	// All pins are inputs after power up
+	setRegisterValue( kMcpIodir, 0xFF );
+	setRegisterValue( kMcpIodir + 1, 0xFF );
+}
+
+void v1::SimulatedMCP23017::setInputs( const Port port, const std::uint8_t levels ) noexcept
+{
+	const auto p = static_cast< std::size_t >( port );
+	const auto offset = static_cast< std::uint8_t >( p );
+
+	const auto previous = m_levels[ p ];
+	m_levels[ p ] = levels;
+
+	const auto inputs = registerValue( kMcpIodir + offset );
+	const auto enabled = registerValue( kMcpGpinten + offset ) & inputs;
+	const auto compareToDefault = registerValue( kMcpIntcon + offset );
+
+	// INTCON selects between comparing against DEFVAL and interrupt on any change
+	const auto againstDefault = ( levels ^ registerValue( kMcpDefval + offset ) ) & compareToDefault;
+	const auto onChange = ( levels ^ previous ) & ~compareToDefault;
+	const auto flags = static_cast< std::uint8_t >( ( againstDefault | onChange ) & enabled );
+
+	if( flags == 0 )
+	{
+		return;
+	}
+
+	const auto intf = registerValue( kMcpIntf + offset );
+	if( intf == 0 )
+	{
+		setRegisterValue( kMcpIntcap + offset, pinLevels( p ) );
+	}
+
+	setRegisterValue( kMcpIntf + offset, intf | flags );
+}
+
+std::uint8_t v1::SimulatedMCP23017::outputs( const Port port ) const noexcept
+{
+	const auto offset = static_cast< std::uint8_t >( port );
+	return registerValue( kMcpOlat + offset ) & static_cast< std::uint8_t >( ~registerValue( kMcpIodir + offset ) );
+}
+
+void v1::SimulatedMCP23017::writeRegister( const std::uint8_t reg, const std::uint8_t value )
+{
+	if( reg == kMcpIocon || reg == kMcpIocon + 1 )
+	{
+		// Both addresses access the same IOCON register
+		RegisterMapDevice::writeRegister( kMcpIocon, value );
+		RegisterMapDevice::writeRegister( kMcpIocon + 1, value );
+		return;
+	}
+
+	if( reg == kMcpGpio || reg == kMcpGpio + 1 )
+	{
+		// Writing GPIO modifies the output latch
+		RegisterMapDevice::writeRegister( static_cast< std::uint8_t >( kMcpOlat + ( reg & 0x01 ) ), value );
+		return;
+	}
+
+	// INTF and INTCAP are read only
+	if( reg >= kMcpIntf && reg < kMcpGpio )
+	{
+		return;
+	}
+
+	RegisterMapDevice::writeRegister( reg, value );
+}
+
+std::uint8_t v1::SimulatedMCP23017::readRegister( const std::uint8_t reg )
+{
+	const auto offset = static_cast< std::uint8_t >( reg & 0x01 );
+
+	if( reg == kMcpGpio || reg == kMcpGpio + 1 )
+	{
+		setRegisterValue( kMcpIntf + offset, 0x00 );
+		return pinLevels( offset );
+	}
+
+	if( reg == kMcpIntcap || reg == kMcpIntcap + 1 )
+	{
+		setRegisterValue( kMcpIntf + offset, 0x00 );
+	}
+
+	return RegisterMapDevice::readRegister( reg );
+}
+
+bool v1::SimulatedMCP23017::autoIncrement( [[maybe_unused]] const std::uint8_t reg ) const noexcept
+{
+	return !( registerValue( kMcpIocon ) & kMcpSeqopBit );
+}
+
+std::uint8_t v1::SimulatedMCP23017::pinLevels( const std::size_t port ) const noexcept
+{
+	const auto offset = static_cast< std::uint8_t >( port );
+	const auto inputs = registerValue( kMcpIodir + offset );
+	const auto levels = static_cast< std::uint8_t >( m_levels[ port ] ^ registerValue( kMcpIpol + offset ) );
+
+	return static_cast< std::uint8_t >( ( levels & inputs ) | ( registerValue( kMcpOlat + offset ) & ~inputs ) );
+}
+
+} // namespace pbl::i2c
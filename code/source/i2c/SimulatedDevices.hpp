@@ -0,0 +1,395 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Register map models of the supported ICs, to be attached to a SimulatedBus.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_SIMULATED_DEVICES_HPP__
+#define PBL_I2C_SIMULATED_DEVICES_HPP__
+
+#include "SimulatedBus.hpp"
+
+// C++
+#include <span>
+#include <deque>
+#include <array>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+/**
+ * @class RegisterMapDevice
+ * @brief Models an IC with up to 256 byte wide registers, the common layout of the I2C sensors.
+ *
+ * The first byte of a write message sets the register pointer, the following bytes are written
+ * to consecutive registers. Reads start at the register pointer, the pointer advances after every
+ * byte while auto increment is enabled. Derived models hook register accesses to add behaviour.
+ */
+class RegisterMapDevice : public SimulatedDevice
+{
+public:
+	[[nodiscard]] bool write( std::span< const std::uint8_t > data ) override;
+	[[nodiscard]] bool read( std::span< std::uint8_t > data ) override;
+
+	/// Returns the raw register contents, bypassing the device behaviour.
+	[[nodiscard]] std::uint8_t registerValue( const std::uint8_t reg ) const noexcept { return m_registers[ reg ]; }
+
+	/// Sets the raw register contents, bypassing the device behaviour.
+	void setRegisterValue( const std::uint8_t reg, const std::uint8_t value ) noexcept { m_registers[ reg ] = value; }
+
+protected:
+	/// Called for every byte written by the bus master, stores the value by default.
+	virtual void writeRegister( const std::uint8_t reg, const std::uint8_t value ) { m_registers[ reg ] = value; }
+
+	/// Called for every byte read by the bus master, returns the stored value by default.
+	[[nodiscard]] virtual std::uint8_t readRegister( const std::uint8_t reg ) { return m_registers[ reg ]; }
+
+	/// Returns whether the register pointer advances after a byte of the register was transferred.
+	[[nodiscard]] virtual bool autoIncrement( [[maybe_unused]] const std::uint8_t reg ) const noexcept { return true; }
+
+	/// Stores a big endian 16-bit value in two consecutive registers.
+	void setWord( const std::uint8_t reg, const std::uint16_t value ) noexcept
+	{
+		m_registers[ reg ] = static_cast< std::uint8_t >( value >> 8 );
+		m_registers[ static_cast< std::uint8_t >( reg + 1 ) ] = static_cast< std::uint8_t >( value & 0xFF );
+	}
+
+private:
+	std::array< std::uint8_t, 256 > m_registers{};
+	std::uint8_t m_pointer{};
+};
+
+/**
+ * @class PointerRegisterDevice
+ * @brief Models an IC with four 16-bit registers selected by a pointer byte (LM75, TMP102, ADS1015).
+ *
+ * Registers are transferred most significant byte first, a read longer than two bytes repeats
+ * the selected register. Eight bit registers live in the most significant byte.
+ */
+class PointerRegisterDevice : public SimulatedDevice
+{
+public:
+	[[nodiscard]] bool write( std::span< const std::uint8_t > data ) override;
+	[[nodiscard]] bool read( std::span< std::uint8_t > data ) override;
+
+	/// Returns the contents of the register.
+	[[nodiscard]] std::uint16_t registerValue( const std::uint8_t reg ) const noexcept { return m_registers[ reg & 0x03 ]; }
+
+	/// Sets the contents of the register, bypassing the device behaviour.
+	void setRegisterValue( const std::uint8_t reg, const std::uint16_t value ) noexcept
+	{
+		m_registers[ reg & 0x03 ] = value;
+	}
+
+protected:
+	/// Called after the bus master wrote to a register.
+	virtual void registerWritten( [[maybe_unused]] const std::uint8_t reg ) { }
+
+private:
+	std::array< std::uint16_t, 4 > m_registers{};
+	std::uint8_t m_pointer{};
+};
+
+/**
+ * @class SimulatedLM75
+ * @brief LM75(B) temperature sensor model, 11-bit temperature with 0.125°C resolution.
+ */
+class SimulatedLM75 final : public PointerRegisterDevice
+{
+public:
+	SimulatedLM75();
+
+	/// Sets the measured temperature, clamped to the -55°C to 125°C range of the sensor.
+	void setTemperature( const float temperatureC ) noexcept;
+};
+
+/**
+ * @class SimulatedTMP102
+ * @brief TMP102 temperature sensor model, 12-bit (13-bit in extended mode) with 0.0625°C resolution.
+ */
+class SimulatedTMP102 final : public PointerRegisterDevice
+{
+public:
+	SimulatedTMP102();
+
+	/// Sets the measured temperature, clamped to the -55°C to 150°C range of the sensor.
+	void setTemperature( const float temperatureC ) noexcept;
+
+protected:
+	void registerWritten( const std::uint8_t reg ) override;
+
+private:
+	/// Encodes the temperature register according to the extended mode bit.
+	void updateTemperatureRegister() noexcept;
+
+private:
+	float m_temperatureC{};
+};
+
+/**
+ * @class SimulatedADS1015
+ * @brief ADS1015 12-bit ADC model, converts the configured input whenever a conversion is started.
+ */
+class SimulatedADS1015 final : public PointerRegisterDevice
+{
+public:
+	SimulatedADS1015();
+
+	/// Sets the voltage applied to the analog input (0 - 3).
+	void setInputVoltage( const std::size_t channel, const float volts );
+
+protected:
+	void registerWritten( const std::uint8_t reg ) override;
+
+private:
+	/// Converts the input selected by the config register into the conversion register.
+	void convert() noexcept;
+
+private:
+	std::array< float, 4 > m_inputs{};
+};
+
+/**
+ * @class SimulatedSHT31
+ * @brief SHT31 humidity and temperature sensor model, command based protocol with CRC-8 protected data.
+ *
+ * Measurement data stays readable until the next command, a read before any measurement is not acknowledged.
+ * In periodic mode the measurements complete in real time at the selected rate, FETCH_DATA returns the latest
+ * one and clears it, a fetch before the next measurement completed leaves nothing to read.
+ */
+class SimulatedSHT31 final : public SimulatedDevice
+{
+public:
+	SimulatedSHT31() = default;
+
+	[[nodiscard]] bool write( std::span< const std::uint8_t > data ) override;
+	[[nodiscard]] bool read( std::span< std::uint8_t > data ) override;
+
+	/// Sets the measured temperature in °C.
+	void setTemperature( const float temperatureC ) noexcept { m_temperatureC = temperatureC; }
+
+	/// Sets the measured relative humidity in %.
+	void setHumidity( const float humidity ) noexcept { m_humidity = humidity; }
+
+	/// Returns the status register.
+	[[nodiscard]] std::uint16_t status() const noexcept { return m_status; }
+
+	/// Returns whether the periodic acquisition mode is running.
+	[[nodiscard]] bool periodic() const noexcept { return m_periodic; }
+
+private:
+	/// Appends a 16-bit word followed by its CRC to the output.
+	void output( const std::uint16_t word );
+
+	/// Replaces the output with a measurement.
+	void measure();
+
+private:
+	std::vector< std::uint8_t > m_output;
+	bool m_hasOutput{};
+	bool m_periodic{};
+	std::chrono::steady_clock::duration m_period{}; //!< Periodic mode measurement period.
+	std::chrono::steady_clock::time_point m_nextMeasurement; //!< Periodic mode, the next fetchable measurement.
+	std::uint16_t m_status{ 0x8010 }; //!< Alert pending and reset detected after power up
+	float m_temperatureC{};
+	float m_humidity{};
+};
+
+/**
+ * @class SimulatedBMP180
+ * @brief BMP180 pressure sensor model, holds the calibration EEPROM and uncompensated readings.
+ *
+ * Defaults to the calibration and readings of the datasheet example, which compensate to 15.0°C
+ * and 69964Pa.
+ */
+class SimulatedBMP180 final : public RegisterMapDevice
+{
+public:
+	SimulatedBMP180();
+
+	/// Sets the calibration EEPROM (AC1 to MD, 0xAA - 0xBF).
+	void setCalibration( const std::array< std::uint8_t, 22 >& calibration ) noexcept;
+
+	/// Sets the uncompensated temperature reported by a temperature conversion.
+	void setUncompensatedTemperature( const std::uint16_t ut ) noexcept { m_ut = ut; }
+
+	/// Sets the uncompensated 19-bit pressure reported by a pressure conversion.
+	void setUncompensatedPressure( const std::uint32_t up ) noexcept { m_up = up; }
+
+protected:
+	void writeRegister( const std::uint8_t reg, const std::uint8_t value ) override;
+
+private:
+	std::uint16_t m_ut{ 27898 };
+	std::uint32_t m_up{ 23843 };
+};
+
+/**
+ * @class SimulatedMPU6050
+ * @brief MPU-6050 IMU model, exposes the sensor output registers and the 1024 byte FIFO.
+ *
+ * The sample clock is driven by the test, sample latches the outputs selected in FIFO_EN into
+ * the FIFO while USER_CTRL enables it. A full FIFO drops its oldest bytes and flags FIFO_OFLOW_INT.
+ */
+class SimulatedMPU6050 final : public RegisterMapDevice
+{
+public:
+	SimulatedMPU6050();
+
+	/// Sets the raw accelerometer outputs.
+	void setAccelerometer( const std::int16_t x, const std::int16_t y, const std::int16_t z ) noexcept;
+
+	/// Sets the raw gyroscope outputs.
+	void setGyroscope( const std::int16_t x, const std::int16_t y, const std::int16_t z ) noexcept;
+
+	/// Sets the raw temperature output.
+	void setTemperature( const std::int16_t raw ) noexcept;
+
+	/// Latches the outputs into the FIFO count times, as the sample clock would, if the FIFO is enabled.
+	void sample( const std::size_t count = 1 );
+
+	/// Returns the number of bytes in the FIFO.
+	[[nodiscard]] std::size_t fifoCount() const noexcept { return m_fifo.size(); }
+
+protected:
+	void writeRegister( const std::uint8_t reg, const std::uint8_t value ) override;
+	[[nodiscard]] std::uint8_t readRegister( const std::uint8_t reg ) override;
+	[[nodiscard]] bool autoIncrement( const std::uint8_t reg ) const noexcept override;
+
+private:
+	/// Restores the power on register values.
+	void reset() noexcept;
+
+private:
+	std::deque< std::uint8_t > m_fifo;
+};
+
+/**
+ * @class SimulatedMPU9250
+ * @brief MPU-9250 IMU model with the AK8963 magnetometer on its auxiliary bus, and the 512 byte FIFO.
+ *
+ * The internal I2C master is modelled: slave 4 transactions complete immediately, the slave 0
+ * read is performed when enabled and at every sample, copying the magnetometer registers into the
+ * external sensor data. sample latches the outputs selected in FIFO_EN into the FIFO, the slave 0
+ * data included.
+ */
+class SimulatedMPU9250 final : public RegisterMapDevice
+{
+public:
+	SimulatedMPU9250();
+
+	/// Sets the raw accelerometer outputs.
+	void setAccelerometer( const std::int16_t x, const std::int16_t y, const std::int16_t z ) noexcept;
+
+	/// Sets the raw gyroscope outputs.
+	void setGyroscope( const std::int16_t x, const std::int16_t y, const std::int16_t z ) noexcept;
+
+	/// Sets the raw temperature output.
+	void setTemperature( const std::int16_t raw ) noexcept;
+
+	/// Sets the raw magnetometer outputs in the magnetometer axes, and the overflow flag.
+	void setMagnetometer( const std::int16_t x, const std::int16_t y, const std::int16_t z, const bool overflow = false ) noexcept;
+
+	/// Sets the magnetometer fuse ROM sensitivity adjustment (ASAX to ASAZ).
+	void setMagnetometerAdjustment( const std::array< std::uint8_t, 3 >& adjustment ) noexcept;
+
+	/// Returns the AK8963 register contents.
+	[[nodiscard]] std::uint8_t magnetometerRegister( const std::uint8_t reg ) const noexcept { return m_magnetometer[ reg ]; }
+
+	/// Runs the slave 0 read and latches the outputs into the FIFO count times, as the sample clock would.
+	void sample( const std::size_t count = 1 );
+
+	/// Returns the number of bytes in the FIFO.
+	[[nodiscard]] std::size_t fifoCount() const noexcept { return m_fifo.size(); }
+
+protected:
+	void writeRegister( const std::uint8_t reg, const std::uint8_t value ) override;
+	[[nodiscard]] std::uint8_t readRegister( const std::uint8_t reg ) override;
+	[[nodiscard]] bool autoIncrement( const std::uint8_t reg ) const noexcept override;
+
+private:
+	/// Restores the power on register values.
+	void reset() noexcept;
+
+	/// Performs the enabled slave 0 read of the I2C master.
+	void readSlave0() noexcept;
+
+	/// Performs the slave 4 transaction of the I2C master.
+	void transferSlave4() noexcept;
+
+private:
+	std::deque< std::uint8_t > m_fifo;
+	std::array< std::uint8_t, 256 > m_magnetometer{}; //!< AK8963 registers
+};
+
+/**
+ * @class SimulatedPCA9685
+ * @brief PCA9685 16 channel PWM driver model.
+ */
+class SimulatedPCA9685 final : public RegisterMapDevice
+{
+public:
+	SimulatedPCA9685();
+
+	/// Returns the ON count of the channel, bit 12 is the full ON flag.
+	[[nodiscard]] std::uint16_t onCount( const std::size_t channel ) const noexcept;
+
+	/// Returns the OFF count of the channel, bit 12 is the full OFF flag.
+	[[nodiscard]] std::uint16_t offCount( const std::size_t channel ) const noexcept;
+
+	/// Returns the PWM frequency prescaler.
+	[[nodiscard]] std::uint8_t prescale() const noexcept;
+
+protected:
+	void writeRegister( const std::uint8_t reg, const std::uint8_t value ) override;
+	[[nodiscard]] bool autoIncrement( const std::uint8_t reg ) const noexcept override;
+};
+
+/**
+ * @class SimulatedMCP23017
+ * @brief MCP23017 16-bit I/O expander model (IOCON.BANK = 0 register layout).
+ *
+ * Input levels are driven with setInputs, interrupt-on-change sets the INTF flags and captures
+ * the port in INTCAP, reading GPIO or INTCAP clears them.
+ */
+class SimulatedMCP23017 final : public RegisterMapDevice
+{
+public:
+	enum class Port : std::uint8_t
+	{
+		A,
+		B
+	};
+
+	SimulatedMCP23017();
+
+	/// Drives the external levels of the port pins, only pins configured as inputs are affected.
+	void setInputs( const Port port, const std::uint8_t levels ) noexcept;
+
+	/// Returns the levels driven on the port pins configured as outputs.
+	[[nodiscard]] std::uint8_t outputs( const Port port ) const noexcept;
+
+protected:
+	void writeRegister( const std::uint8_t reg, const std::uint8_t value ) override;
+	[[nodiscard]] std::uint8_t readRegister( const std::uint8_t reg ) override;
+	[[nodiscard]] bool autoIncrement( const std::uint8_t reg ) const noexcept override;
+
+private:
+	/// Returns the GPIO register value, inputs (after polarity inversion) combined with the output latch.
+	[[nodiscard]] std::uint8_t pinLevels( const std::size_t port ) const noexcept;
+
+private:
+	std::array< std::uint8_t, 2 > m_levels{}; //!< External pin levels
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_SIMULATED_DEVICES_HPP__
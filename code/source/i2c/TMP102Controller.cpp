@@ -14,7 +14,6 @@
 
 // C++
 #include <array>
-#include <bitset>
 
 namespace pbl::i2c
 {
@@ -33,17 +32,19 @@ constexpr std::uint16_t kExtendedModeSignExtendMask = 0xE000;
 constexpr std::uint16_t kStandardModeNegativeMask = 0x0800;
 constexpr std::uint16_t kStandardModeSignExtendMask = 0xF000;
 
-// TMP102 Configuration Bits
-constexpr std::size_t kShutdownBit = 0; // Bit 0: Shutdown Mode
-constexpr std::size_t kExtendedModeBit = 4; // Bit 4: Extended Mode (12-bit vs 13-bit)
-constexpr std::size_t kOneShotBit = 7; // Bit 7: One-Shot (when in shutdown mode)
-constexpr std::size_t kAlertBit = 5; // Bit 5 (read only in some TMP102 variants) for alert
+// TMP102 Configuration Register Bits (first byte is the most significant one)
+constexpr std::uint16_t kShutdownMask{ 0x0100 }; // SD: Shutdown Mode
+constexpr std::uint16_t kOneShotMask{ 0x8000 }; // OS: One-Shot (when in shutdown mode), reads back 0 while converting
+constexpr std::uint16_t kAlertMask{ 0x0020 }; // AL: Alert, read only
+constexpr std::uint16_t kExtendedModeMask{ 0x0010 }; // EM: Extended Mode (13-bit vs 12-bit)
 
 } // namespace
 
 v1::TMP102Controller::TMP102Controller( BusController& busController, Address address ) noexcept
 	: ICBase{ busController, address }
-{ }
+{
+	setCacheable( kConfigurationRegister, 2, kOneShotMask | kAlertMask );
+}
 
 auto v1::TMP102Controller::getTemperatureC() -> Result< float >
 {
@@ -53,13 +54,13 @@ auto v1::TMP102Controller::getTemperatureC() -> Result< float >
 		return std::unexpected( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	std::uint8_t config[ 2 ]{};
-	if( read( kConfigurationRegister, config, 2 ) <= 0 ) [[unlikely]]
+	std::uint16_t config{};
+	if( !readCachedWord( kConfigurationRegister, config ) ) [[unlikely]]
 	{
 		return std::unexpected( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	const bool extendedMode = ( config[ 1 ] & ( 1 << kExtendedModeBit ) ) != 0;
+	const bool extendedMode = ( config & kExtendedModeMask ) != 0;
 
 	std::uint16_t raw = ( static_cast< std::uint16_t >( data[ 0 ] ) << 4 ) | ( data[ 1 ] >> 4 );
 
@@ -92,71 +93,39 @@ auto v1::TMP102Controller::getTemperatureF() -> Result< float >
 
 bool v1::TMP102Controller::setShutdownMode( bool enable )
 {
-	std::uint8_t config[ 2 ]{};
-	if( read( kConfigurationRegister, config, 2 ) < 2 ) [[unlikely]]
-	{
-		return false;
-	}
-
-	std::bitset< 8 > lsb( config[ 1 ] );
-	lsb.set( kShutdownBit, enable );
-	config[ 1 ] = static_cast< std::uint8_t >( lsb.to_ulong() );
-
-	return write( kConfigurationRegister, config, 2 );
+	return updateWordRegister( kConfigurationRegister, kShutdownMask, enable ? kShutdownMask : std::uint16_t{} );
 }
 
 auto v1::TMP102Controller::getShutdownMode() -> Result< bool >
 {
-	std::uint8_t config[ 2 ]{};
-	if( read( kConfigurationRegister, config, 2 ) < 2 ) [[unlikely]]
+	std::uint16_t config{};
+	if( !readCachedWord( kConfigurationRegister, config ) ) [[unlikely]]
 	{
 		return std::unexpected( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	std::bitset< 8 > lsb( config[ 1 ] );
-	return lsb.test( kShutdownBit );
+	return ( config & kShutdownMask ) != 0;
 }
 
 bool v1::TMP102Controller::setExtendedMode( bool enable )
 {
-	std::uint8_t config[ 2 ]{};
-	if( read( kConfigurationRegister, config, 2 ) < 2 ) [[unlikely]]
-	{
-		return false;
-	}
-
-	std::bitset< 8 > msb( config[ 0 ] );
-	msb.set( kExtendedModeBit, enable );
-	config[ 0 ] = static_cast< std::uint8_t >( msb.to_ulong() );
-
-	return write( kConfigurationRegister, config, 2 );
+	return updateWordRegister( kConfigurationRegister, kExtendedModeMask, enable ? kExtendedModeMask : std::uint16_t{} );
 }
 
 auto v1::TMP102Controller::getExtendedMode() -> Result< bool >
 {
-	std::uint8_t config[ 2 ]{};
-	if( read( kConfigurationRegister, config, 2 ) < 2 ) [[unlikely]]
+	std::uint16_t config{};
+	if( !readCachedWord( kConfigurationRegister, config ) ) [[unlikely]]
 	{
 		return std::unexpected( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	std::bitset< 8 > msb( config[ 0 ] );
-	return msb.test( kExtendedModeBit );
+	return ( config & kExtendedModeMask ) != 0;
 }
 
 bool v1::TMP102Controller::triggerOneShot()
 {
-	std::uint8_t config[ 2 ]{};
-	if( read( kConfigurationRegister, config, 2 ) < 2 ) [[unlikely]]
-	{
-		return false;
-	}
-
-	std::bitset< 8 > msb( config[ 0 ] );
-	msb.set( kOneShotBit );
-	config[ 0 ] = static_cast< std::uint8_t >( msb.to_ulong() );
-
-	return write( kConfigurationRegister, config, 2 );
+	return updateWordRegister( kConfigurationRegister, kOneShotMask, kOneShotMask );
 }
 
 auto v1::TMP102Controller::getAlertStatus() -> Result< bool >
@@ -169,8 +138,8 @@ auto v1::TMP102Controller::getAlertStatus() -> Result< bool >
 		return std::unexpected( utils::ErrorCode::FAILED_TO_READ );
 	}
 
-	std::bitset< 8 > lsb( config[ 1 ] );
-	return lsb.test( kAlertBit );
+	const std::uint16_t value = static_cast< std::uint16_t >( ( config[ 0 ] << 8 ) | config[ 1 ] );
+	return ( value & kAlertMask ) != 0;
 }
 
 } // namespace pbl::i2c
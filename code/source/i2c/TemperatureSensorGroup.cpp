@@ -0,0 +1,142 @@
+/**
+ *  @brief Implementation of TemperatureSensorGroup class, samples LM75 and TMP102 sensors in one bus transfer.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "TemperatureSensorGroup.hpp"
+#include "BusController.hpp"
+#include "LM75Controller.hpp"
+#include "TMP102Controller.hpp"
+
+// C++
+#include <limits>
+#include <algorithm>
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+// LM75 and TMP102 share the temperature register address and its left-justified format
+constexpr std::uint8_t kTemperatureRegister{ 0x00 };
+constexpr std::size_t kTemperatureSize{ 2 };
+
+constexpr std::uint8_t kMinLm75Resolution{ 9 };
+constexpr std::uint8_t kMaxLm75Resolution{ 12 };
+
+// TMP102, 12-bit or 13-bit with EM set in bit 0, 0.0625°C per LSB in both formats
+constexpr std::uint8_t kTmp102Shift{ 4 };
+constexpr std::uint8_t kTmp102ExtendedShift{ 3 };
+constexpr float kTmp102Resolution{ 0.0625f };
+constexpr std::uint16_t kTmp102ExtendedFlag{ 0x0001 };
+
+} // namespace
+
+v1::TemperatureSensorGroup::TemperatureSensorGroup( BusController& busController )
+	: m_busController{ busController }
+{ }
+
+auto v1::TemperatureSensorGroup::add( const LM75Controller& lm75, const std::uint8_t resolution )
+	-> Result< std::size_t >
+{
+	if( resolution < kMinLm75Resolution || resolution > kMaxLm75Resolution ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	// The integer part takes the high byte, each further bit halves the LSB
+	const auto fractionBits = resolution - 8;
+	return insert( Sensor{ .device = &lm75,
+						   .shift = static_cast< std::uint8_t >( 16 - resolution ),
+						   .resolution = 1.0f / static_cast< float >( 1 << fractionBits ) } );
+}
+
+auto v1::TemperatureSensorGroup::add( const TMP102Controller& tmp102 ) -> Result< std::size_t >
+{
+	return insert(
+		Sensor{ .device = &tmp102, .shift = kTmp102Shift, .resolution = kTmp102Resolution, .extendedFlag = true } );
+}
+
+auto v1::TemperatureSensorGroup::insert( const Sensor& sensor ) -> Result< std::size_t >
+{
+	const bool duplicate = std::ranges::any_of(
+		m_sensors, [ & ]( const Sensor& other ) { return other.device->address() == sensor.device->address(); } );
+
+	if( duplicate || m_sensors.size() == kMaxSensors ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	m_sensors.push_back( sensor );
+	m_raw.resize( m_sensors.size() * kTemperatureSize );
+	return utils::MakeSuccess( m_sensors.size() - 1 );
+}
+
+void v1::TemperatureSensorGroup::clear() noexcept
+{
+	m_sensors.clear();
+	m_raw.clear();
+	m_transaction.clear();
+}
+
+auto v1::TemperatureSensorGroup::readTemperaturesC( std::span< float > temperaturesC ) -> Result< std::size_t >
+{
+	if( temperaturesC.size() < m_sensors.size() ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	if( m_sensors.empty() ) [[unlikely]]
+	{
+		return utils::MakeSuccess( std::size_t{ 0 } );
+	}
+
+	m_transaction.clear();
+	for( std::size_t i{}; i < m_sensors.size(); ++i )
+	{
+		const std::span< std::uint8_t > data{ m_raw.data() + i * kTemperatureSize, kTemperatureSize };
+		[[maybe_unused]] const bool queued = m_sensors[ i ].device->read( m_transaction, kTemperatureRegister, data );
+	}
+
+	// A failed transfer is reported per sensor, the adapter may have completed the first reads
+	[[maybe_unused]] const bool submitted = m_busController.submit( m_transaction );
+
+	if( const auto count = decode( temperaturesC ); count > 0 )
+	{
+		return utils::MakeSuccess( count );
+	}
+
+	return std::unexpected( m_transaction.result( 0 ).error() );
+}
+
+std::size_t v1::TemperatureSensorGroup::decode( std::span< float > temperaturesC ) const
+{
+	std::size_t count{};
+
+	for( std::size_t i{}; i < m_sensors.size(); ++i )
+	{
+		if( !m_transaction.result( i ) ) [[unlikely]]
+		{
+			temperaturesC[ i ] = std::numeric_limits< float >::quiet_NaN();
+			continue;
+		}
+
+		const auto& sensor = m_sensors[ i ];
+		const auto raw = static_cast< std::int16_t >( ( m_raw[ i * kTemperatureSize ] << 8 ) |
+													  m_raw[ i * kTemperatureSize + 1 ] );
+
+		// Arithmetic shift, sign extends the value
+		const bool extended = sensor.extendedFlag && ( raw & kTmp102ExtendedFlag ) != 0;
+		const auto shift = extended ? kTmp102ExtendedShift : sensor.shift;
+		temperaturesC[ i ] = static_cast< float >( raw >> shift ) * sensor.resolution;
+		++count;
+	}
+
+	return count;
+}
+
+} // namespace pbl::i2c
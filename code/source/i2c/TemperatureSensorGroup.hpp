@@ -0,0 +1,132 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of TemperatureSensorGroup class, samples LM75 and TMP102 sensors in one bus transfer.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_TEMPERATURE_SENSOR_GROUP_HPP__
+#define PBL_I2C_TEMPERATURE_SENSOR_GROUP_HPP__
+
+#include "Transaction.hpp"
+#include <utils/Result.hpp>
+
+// C++
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+class ICBase;
+class BusController;
+class LM75Controller;
+class TMP102Controller;
+
+/**
+ * @class TemperatureSensorGroup
+ * @brief Reads the temperature register of every member sensor with a single combined transfer.
+ *
+ * Calling getTemperatureC on each of N sensors costs N transfers (N ioctls on Linux), each one locking
+ * the bus. The group queues one temperature register read per sensor into a Transaction, submits it
+ * once, and decodes the left-justified two's-complement values in one pass:
+ *  - LM75, 9 to 12 bits depending on the variant (11 bits, 0.125°C for the LM75B),
+ *  - TMP102, 12 bits or 13 bits in extended mode, 0.0625°C. The mode is taken from the EM flag in
+ *    bit 0 of the register, so no configuration read is needed.
+ *
+ * A sweep fits at most kMaxSensors sensors, more than the eight addresses LM75 and TMP102
+ * sensors can take on one bus.
+ *
+ * Example usage:
+ * @code
+ * TemperatureSensorGroup group{ busController };
+ * group.add( lm75 );
+ * group.add( tmp102 );
+ *
+ * std::array< float, 2 > temperatures{};
+ * if( auto rslt = group.readTemperaturesC( temperatures ); rslt ) { ... }
+ * @endcode
+ *
+ * @note Not thread-safe, the group reuses its transaction and buffers between sweeps.
+ */
+class TemperatureSensorGroup final
+{
+public:
+	template < typename T >
+	using Result = utils::Result< T >;
+
+	/// Maximum number of sensors in a group, each register read occupies two messages.
+	static constexpr std::size_t kMaxSensors{ Transaction::kMaxMessages / 2 };
+
+	/// Creates an empty group, the bus controller and the sensors added must outlive it.
+	explicit TemperatureSensorGroup( BusController& busController );
+
+	/**
+	 * @brief Adds an LM75 to the group.
+	 *
+	 * @param lm75 The sensor, must be attached to the bus controller of the group.
+	 * @param resolution The temperature resolution in bits, 9 - 12, the LM75B provides 11 bits.
+	 * @return The index of the sensor in the sweep, ErrorCode::INVALID_ARGUMENT if the resolution is out of range,
+	 * the address is already in the group or the group is full.
+	 */
+	[[nodiscard]] Result< std::size_t > add( const LM75Controller& lm75, const std::uint8_t resolution = 11 );
+
+	/// Adds a TMP102 to the group, returns its index in the sweep or ErrorCode::INVALID_ARGUMENT (see above).
+	[[nodiscard]] Result< std::size_t > add( const TMP102Controller& tmp102 );
+
+	/// Removes all sensors from the group.
+	void clear() noexcept;
+
+	/// Returns the number of sensors in the group.
+	[[nodiscard]] std::size_t size() const noexcept { return m_sensors.size(); }
+
+	/// Returns true if the group has no sensors.
+	[[nodiscard]] bool empty() const noexcept { return m_sensors.empty(); }
+
+	/**
+	 * @brief Reads the temperature of every sensor in one transfer.
+	 *
+	 * @param temperaturesC Receives the temperatures in degrees Celsius in the order the sensors were added,
+	 * must hold at least size() values. Sensors whose read didn't complete report NaN, note that a sensor
+	 * not acknowledging its address fails the whole transfer on Linux.
+	 * @return The number of sensors read, ErrorCode::INVALID_ARGUMENT if the span is too small,
+	 * or the error of the transfer if no sensor was read.
+	 */
+	[[nodiscard]] Result< std::size_t > readTemperaturesC( std::span< float > temperaturesC );
+
+private:
+	struct Sensor
+	{
+		const ICBase* device{};
+		std::uint8_t shift{}; //!< Right shift aligning the value, the register is left-justified.
+		float resolution{}; //!< Degrees Celsius per LSB.
+		bool extendedFlag{}; //!< Whether bit 0 flags the 13-bit format (TMP102).
+	};
+
+	/// Appends the sensor unless its address is already in the group or the group is full.
+	[[nodiscard]] Result< std::size_t > insert( const Sensor& sensor );
+
+	/// Decodes the raw register values of the sweep into degrees Celsius.
+	[[nodiscard]] std::size_t decode( std::span< float > temperaturesC ) const;
+
+	// This class is non-copyable and non-movable
+	TemperatureSensorGroup( const TemperatureSensorGroup& ) = delete;
+	TemperatureSensorGroup( TemperatureSensorGroup&& ) = delete;
+	TemperatureSensorGroup& operator=( const TemperatureSensorGroup& ) = delete;
+	TemperatureSensorGroup& operator=( TemperatureSensorGroup&& ) = delete;
+
+private:
+	BusController& m_busController;
+	std::vector< Sensor > m_sensors;
+	std::vector< std::uint8_t > m_raw; //!< Temperature registers, two bytes per sensor, MSB first
+	Transaction m_transaction;
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_TEMPERATURE_SENSOR_GROUP_HPP__
@@ -0,0 +1,119 @@
+/**
+ *  @brief Implementation of Transaction class, a batch of I2C register operations submitted as one transfer.
+ *  @author MrAviator93
+ *  @date 16 October 2026
+ *
+ *  For license details, see the LICENSE file in the project root.
+ */
+
+#include "Transaction.hpp"
+
+// C++
+#include <algorithm>
+
+namespace pbl::i2c
+{
+
+bool v1::Transaction::read( const std::uint8_t deviceAddr, const std::uint8_t reg, std::span< std::uint8_t > data )
+{
+	// Register pointer write followed by the (repeated start) read
+	if( m_messageCount + 2 > kMaxMessages || m_writeBufferUsed + 1 > kMaxWriteBytes || data.empty() ) [[unlikely]]
+	{
+		return false;
+	}
+
+	std::uint8_t* pReg = &m_writeBuffer[ m_writeBufferUsed++ ];
+	*pReg = reg;
+
+	m_messages[ m_messageCount++ ] = Message{ deviceAddr, false, std::span< std::uint8_t >{ pReg, 1 } };
+	m_messages[ m_messageCount++ ] = Message{ deviceAddr, true, data };
+
+	m_operations[ m_operationCount++ ] = Operation{ static_cast< std::uint8_t >( m_messageCount - 1 ) };
+
+	return true;
+}
+
+bool v1::Transaction::read( const std::uint8_t deviceAddr, std::span< std::uint8_t > data )
+{
+	if( m_messageCount + 1 > kMaxMessages || data.empty() ) [[unlikely]]
+	{
+		return false;
+	}
+
+	m_messages[ m_messageCount++ ] = Message{ deviceAddr, true, data };
+
+	m_operations[ m_operationCount++ ] = Operation{ static_cast< std::uint8_t >( m_messageCount - 1 ) };
+
+	return true;
+}
+
+bool v1::Transaction::write( const std::uint8_t deviceAddr,
+							 const std::uint8_t reg,
+							 std::span< const std::uint8_t > data )
+{
+	const std::size_t length = data.size() + 1; // + 1 for register
+	if( m_messageCount + 1 > kMaxMessages || m_writeBufferUsed + length > kMaxWriteBytes ) [[unlikely]]
+	{
+		return false;
+	}
+
+	std::uint8_t* pBuffer = &m_writeBuffer[ m_writeBufferUsed ];
+	pBuffer[ 0 ] = reg;
+	std::ranges::copy( data, pBuffer + 1 );
+	m_writeBufferUsed += length;
+
+	m_messages[ m_messageCount++ ] = Message{ deviceAddr, false, std::span< std::uint8_t >{ pBuffer, length } };
+
+	m_operations[ m_operationCount++ ] = Operation{ static_cast< std::uint8_t >( m_messageCount - 1 ) };
+
+	return true;
+}
+
+auto v1::Transaction::result( const std::size_t index ) const -> Result< void >
+{
+	if( index >= m_operationCount ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	const auto& operation = m_operations[ index ];
+	switch( operation.state )
+	{
+		case State::SUCCEEDED: return utils::MakeSuccess();
+		case State::FAILED: return utils::MakeError( operation.error );
+		case State::PENDING: return utils::MakeError( utils::ErrorCode::BUS_BUSY );
+	}
+
+	return utils::MakeError( utils::ErrorCode::UNEXPECTED_ERROR );
+}
+
+bool v1::Transaction::succeeded() const noexcept
+{
+	const auto ops = std::span{ m_operations.data(), m_operationCount };
+	return std::ranges::all_of( ops, []( const Operation& op ) { return op.state == State::SUCCEEDED; } );
+}
+
+void v1::Transaction::clear() noexcept
+{
+	m_messageCount = 0;
+	m_operationCount = 0;
+	m_writeBufferUsed = 0;
+}
+
+void v1::Transaction::complete( const std::size_t transferredMessages, const utils::ErrorCode error ) noexcept
+{
+	for( auto& operation : std::span{ m_operations.data(), m_operationCount } )
+	{
+		if( operation.lastMessage < transferredMessages )
+		{
+			operation.state = State::SUCCEEDED;
+		}
+		else
+		{
+			operation.state = State::FAILED;
+			operation.error = error;
+		}
+	}
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,181 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of Transaction class, a batch of I2C register operations submitted as one transfer.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_TRANSACTION_HPP__
+#define PBL_I2C_TRANSACTION_HPP__
+
+#include <utils/Result.hpp>
+
+// C++
+#include <span>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+class BusController;
+
+/**
+ * @brief Whether an operation may be repeated after the shared transfer it was part of failed.
+ *
+ * When a combined transfer fails, the kernel reports neither the message that failed nor the data of the
+ * reads that ran before it. Repeating such a read loses the first result, which matters for registers
+ * with side effects.
+ */
+enum class Idempotency : std::uint8_t
+{
+	IDEMPOTENT, //!< Accessing it again has no side effect, i.e. configuration and output registers.
+	NON_IDEMPOTENT //!< Accessing it has a side effect, i.e. clear-on-read status, interrupt capture or FIFO data.
+};
+
+/**
+ * @class Transaction
+ * @brief Queues register reads and writes, possibly to different devices, and submits them as one I2C transfer.
+ *
+ * Every BusController::read/write call issues its own I2C_RDWR ioctl and takes the bus lock. When dozens of
+ * registers are sampled each control tick the syscall and locking overhead dominate. A Transaction collects
+ * the operations up-front and BusController::submit hands all of them to the kernel in a single
+ * i2c_rdwr_ioctl_data request holding up to kMaxMessages messages.
+ *
+ * A register read occupies two messages (register pointer write + read), a register write occupies one.
+ * Read results are scattered straight into the caller owned spans, so those spans must stay valid until
+ * the transaction has been submitted. Write payloads are copied into the transaction.
+ *
+ * Example usage:
+ * @code
+ * Transaction tx;
+ * std::array< std::uint8_t, 2 > lm75{};
+ * std::array< std::uint8_t, 6 > accel{};
+ *
+ * bool queued = tx.read( 0x48, 0x00, lm75 ) && tx.read( 0x68, 0x3B, accel ) && tx.write( 0x40, 0x00, 0x20 );
+ * if( queued && busController.submit( tx ) ) { ... }
+ *
+ * if( auto rslt = tx.result( 1 ); !rslt ) { ... } // Per operation outcome
+ * @endcode
+ *
+ * @note The kernel treats a combined transfer as a unit, if the adapter aborts, all operations that were not
+ * transferred are reported as failed.
+ */
+class Transaction final
+{
+public:
+	template < typename T >
+	using Result = utils::Result< T >;
+
+	/// Maximum number of messages the kernel accepts in one I2C_RDWR request (I2C_RDWR_IOCTL_MAX_MSGS).
+	static constexpr std::size_t kMaxMessages{ 42 };
+
+	/// Capacity of the internal buffer that holds register addresses and write payloads.
+	static constexpr std::size_t kMaxWriteBytes{ 256 };
+
+	/// A single I2C message, mirrors the kernel struct i2c_msg.
+	struct Message
+	{
+		std::uint16_t address{}; //!< 7-bit device address.
+		bool read{}; //!< Whether this is a read (I2C_M_RD) message.
+		std::span< std::uint8_t > buffer{}; //!< Data to write or the destination of the read.
+		bool noStart{}; //!< Whether the (repeated) start condition is omitted (I2C_M_NOSTART).
+	};
+
+	Transaction() = default;
+
+	/// Queues a read of data.size() bytes starting at register reg, returns false if the transaction is full.
+	[[nodiscard]] bool read( const std::uint8_t deviceAddr, const std::uint8_t reg, std::span< std::uint8_t > data );
+
+	/// Queues a single byte register read, returns false if the transaction is full.
+	[[nodiscard]] bool read( const std::uint8_t deviceAddr, const std::uint8_t reg, std::uint8_t& value )
+	{
+		return read( deviceAddr, reg, std::span< std::uint8_t >{ &value, 1 } );
+	}
+
+	/// Queues a plain read of data.size() bytes without a register pointer, returns false if the transaction is full.
+	[[nodiscard]] bool read( const std::uint8_t deviceAddr, std::span< std::uint8_t > data );
+
+	/// Queues a write of data starting at register reg, returns false if the transaction is full.
+	[[nodiscard]] bool
+	write( const std::uint8_t deviceAddr, const std::uint8_t reg, std::span< const std::uint8_t > data );
+
+	/// Queues a single byte register write, returns false if the transaction is full.
+	[[nodiscard]] bool write( const std::uint8_t deviceAddr, const std::uint8_t reg, const std::uint8_t value )
+	{
+		return write( deviceAddr, reg, std::span< const std::uint8_t >{ &value, 1 } );
+	}
+
+	/// Returns the number of queued operations.
+	[[nodiscard]] std::size_t size() const noexcept { return m_operationCount; }
+
+	/// Returns true if no operations were queued.
+	[[nodiscard]] bool empty() const noexcept { return m_operationCount == 0; }
+
+	/// Returns the number of I2C messages the queued operations occupy.
+	[[nodiscard]] std::size_t messageCount() const noexcept { return m_messageCount; }
+
+	/// Returns the queued messages in submission order.
+	[[nodiscard]] std::span< const Message > messages() const noexcept { return { m_messages.data(), m_messageCount }; }
+
+	/**
+	 * @brief Returns the outcome of the operation at the given index (in the order queued).
+	 *
+	 * An operation that has not been submitted yet reports ErrorCode::BUS_BUSY, an out of range
+	 * index reports ErrorCode::INVALID_ARGUMENT.
+	 */
+	[[nodiscard]] Result< void > result( const std::size_t index ) const;
+
+	/// Returns true if every queued operation completed successfully.
+	[[nodiscard]] bool succeeded() const noexcept;
+
+	/// Drops all queued operations so the transaction can be reused.
+	void clear() noexcept;
+
+private:
+	friend class BusController;
+
+	enum class State : std::uint8_t
+	{
+		PENDING,
+		SUCCEEDED,
+		FAILED
+	};
+
+	struct Operation
+	{
+		std::uint8_t lastMessage{}; //!< Index of the last message belonging to this operation.
+		State state{ State::PENDING };
+		utils::ErrorCode error{ utils::ErrorCode::UNEXPECTED_ERROR };
+	};
+
+	/// Returns the queued messages in a mutable form, used by the bus controller to submit them.
+	[[nodiscard]] std::span< Message > mutableMessages() noexcept { return { m_messages.data(), m_messageCount }; }
+
+	/// Marks operations whose messages were all transferred as succeeded, remaining ones fail with error.
+	void complete( const std::size_t transferredMessages, const utils::ErrorCode error ) noexcept;
+
+	// Transactions hand out pointers into their own storage, they are non-copyable and non-movable
+	Transaction( const Transaction& ) = delete;
+	Transaction( Transaction&& ) = delete;
+	Transaction& operator=( const Transaction& ) = delete;
+	Transaction& operator=( Transaction&& ) = delete;
+
+private:
+	std::array< Message, kMaxMessages > m_messages{};
+	std::array< Operation, kMaxMessages > m_operations{};
+	std::array< std::uint8_t, kMaxWriteBytes > m_writeBuffer{};
+
+	std::size_t m_messageCount{};
+	std::size_t m_operationCount{};
+	std::size_t m_writeBufferUsed{};
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_TRANSACTION_HPP__
@@ -0,0 +1,68 @@
+/**
+ * @author MrAviator93
+ * @date 16 October 2026
+ * @brief Declaration of Transport interface, the backend used by BusController to move bytes on the bus.
+ *
+ * For license details, see the LICENSE file in the project root.
+ */
+
+#ifndef PBL_I2C_TRANSPORT_HPP__
+#define PBL_I2C_TRANSPORT_HPP__
+
+#include "Transaction.hpp"
+
+// C++
+#include <span>
+#include <chrono>
+#include <string>
+
+namespace pbl::i2c
+{
+
+inline namespace v1
+{
+
+/**
+ * @class Transport
+ * @brief Abstract I2C backend, performs combined transfers on behalf of a BusController.
+ *
+ * The BusController implements the register level protocol (pointer writes, repeated start reads,
+ * locking and error reporting) on top of a Transport, so every IC controller runs unchanged against
+ * any backend. Two implementations are provided:
+ *  - LinuxTransport, talks to a Linux i2c-dev character device (i.e. "/dev/i2c-1") using I2C_RDWR
+ *    or, for plain register accesses, the SMBus ioctls the adapter supports.
+ *  - SimulatedBus, an in-memory bus hosting register map models of the supported ICs, used to test
+ *    and benchmark drivers without hardware.
+ *
+ * Transports are not required to be thread-safe, the owning BusController serialises all calls
+ * to transfer.
+ */
+class Transport
+{
+public:
+	virtual ~Transport() = default;
+
+	/// Returns the name of the bus, i.e. "/dev/i2c-1".
+	[[nodiscard]] virtual const std::string& name() const noexcept = 0;
+
+	/// Returns whether the transport is ready to perform transfers.
+	[[nodiscard]] virtual bool isOpen() const noexcept = 0;
+
+	/**
+	 * @brief Performs the messages as one combined transfer (repeated start between the messages).
+	 *
+	 * Read messages are filled in place, the buffers must hold exactly the number of bytes to read.
+	 *
+	 * @param messages Messages to transfer in order, at most Transaction::kMaxMessages.
+	 * @return The number of messages transferred, or a negated errno value on failure
+	 *         (i.e. -ENXIO when the device did not acknowledge its address).
+	 */
+	[[nodiscard]] virtual int transfer( std::span< Transaction::Message > messages ) noexcept = 0;
+
+	/// Waits for the given time, i.e. for a conversion to complete. Simulated transports may skip the wait.
+	virtual void sleep( const std::chrono::microseconds sleepTime ) = 0;
+};
+
+} // namespace v1
+} // namespace pbl::i2c
+#endif // PBL_I2C_TRANSPORT_HPP__
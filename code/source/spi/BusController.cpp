@@ -4,7 +4,10 @@
 #include <array>
 #include <vector>
 #include <thread>
+#include <fstream>
 #include <sstream>
+#include <optional>
+#include <algorithm>
 
 // C
 extern "C" {
@@ -35,6 +38,61 @@ namespace
 	return SPI_MODE_0;
 }
 
+// Holds the size of the spidev bounce buffer
+constexpr const char* kBufsizParameter{ "/sys/module/spidev/parameters/bufsiz" };
+
+/// Returns the spidev bufsiz module parameter, std::nullopt if it can't be read.
+[[nodiscard]] std::optional< std::size_t > readBufsiz()
+{
+	std::ifstream file{ kBufsizParameter };
+	std::size_t value{};
+	if( !( file >> value ) || value == 0 )
+	{
+		return std::nullopt;
+	}
+
+	return value;
+}
+
+/// Returns the SPI_IOC_MESSAGE(count) request, the macro needs a constant count.
+[[nodiscard]] constexpr unsigned long messageRequest( const std::size_t count ) noexcept
+{
+	return _IOC( _IOC_WRITE, SPI_IOC_MAGIC, 0, SPI_MSGSIZE( count ) );
+}
+
+/// Fills the spidev descriptor of a segment, an empty buffer is passed as null.
+void toTransfer( const Segment& segment, ::spi_ioc_transfer& transfer ) noexcept
+{
+	transfer = ::spi_ioc_transfer{};
+	transfer.tx_buf = reinterpret_cast< __u64 >( segment.tx.empty() ? nullptr : segment.tx.data() );
+	transfer.rx_buf = reinterpret_cast< __u64 >( segment.rx.empty() ? nullptr : segment.rx.data() );
+	transfer.len = static_cast< __u32 >( std::max( segment.tx.size(), segment.rx.size() ) );
+	transfer.speed_hz = segment.config.speedHz;
+	transfer.delay_usecs = static_cast< __u16 >( segment.config.delay.count() );
+	transfer.bits_per_word = segment.config.bitsPerWord;
+	transfer.cs_change = segment.config.csChange ? 1 : 0;
+}
+
+/// A message converted to the spi_ioc_transfer array of its SPI_IOC_MESSAGE ioctl.
+class SpidevMessage final : public PreparedMessage
+{
+public:
+	SpidevMessage( const Transport& transport, std::span< const Segment > segments )
+		: PreparedMessage{ transport, segments }
+		, m_transfers( segments.size() )
+	{
+		for( std::size_t i{}; i < segments.size(); ++i )
+		{
+			toTransfer( segments[ i ], m_transfers[ i ] );
+		}
+	}
+
+	[[nodiscard]] std::span< const ::spi_ioc_transfer > transfers() const noexcept { return m_transfers; }
+
+private:
+	std::vector< ::spi_ioc_transfer > m_transfers;
+};
+
 } // namespace
 
 auto v1::BusController::open( const std::string& device, Mode mode, Speed speed, BitsPerWord bits )
@@ -52,6 +110,7 @@ auto v1::BusController::open( const std::string& device, Mode mode, Speed speed,
 		return utils::MakeError( rslt.error() );
 	}
 
+	bus.m_maxMessageSize = readBufsiz().value_or( kDefaultMaxMessageSize );
 	bus.m_open = true;
 	return Result< BusController >{ std::move( bus ) };
 }
@@ -82,7 +141,8 @@ void v1::BusController::sleep( const std::chrono::microseconds sleepTimeUs )
 
 auto v1::BusController::configure( Mode mode, Speed speed, BitsPerWord bitsPerWord ) -> Result< void >
 {
-	if( !m_open.load() ) [[unlikely]]
+	// Called by open before the device is marked open
+	if( m_fd < 0 ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "SPI Device is not open" );
 	}
@@ -119,30 +179,96 @@ std::string v1::BusController::getError()
 }
 
 auto v1::BusController::transfer( ConstByteSpan tx, ByteSpan rx ) -> Result< void >
+{
+	if( tx.size() != rx.size() ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "TX and RX buffer sizes must match" );
+	}
+
+	return stream( tx, rx, TransferConfig{} );
+}
+
+auto v1::BusController::write( ConstByteSpan tx ) -> Result< void >
+{
+	return stream( tx, {}, TransferConfig{} );
+}
+
+auto v1::BusController::write( ConstByteSpan tx, const TransferConfig& config ) -> Result< void >
+{
+	return stream( tx, {}, config );
+}
+
+auto v1::BusController::read( ByteSpan rx ) -> Result< void >
+{
+	return stream( {}, rx, TransferConfig{} );
+}
+
+auto v1::BusController::read( ByteSpan rx, const TransferConfig& config ) -> Result< void >
+{
+	return stream( {}, rx, config );
+}
+
+auto v1::BusController::transfer( std::span< const Segment > segments ) -> Result< void >
 {
 	if( !m_open ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "SPI device not open" );
 	}
 
-	if( tx.size() != rx.size() ) [[unlikely]]
+	std::scoped_lock _{ m_fdMtx };
+	return submit( segments );
+}
+
+auto v1::BusController::submit( std::span< const Segment > segments ) -> Result< void >
+{
+	if( auto rslt = validate( segments, m_maxMessageSize ); !rslt ) [[unlikely]]
 	{
-		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "TX and RX buffer sizes must match" );
+		return rslt;
 	}
 
-	std::scoped_lock _{ m_fdMtx };
+	// Converted on the stack, the longest message takes 16KB of descriptors
+	std::array< ::spi_ioc_transfer, kMaxSegments > transfers;
+	for( std::size_t i{}; i < segments.size(); ++i )
+	{
+		toTransfer( segments[ i ], transfers[ i ] );
+	}
+
+	if( ::ioctl( m_fd, messageRequest( segments.size() ), transfers.data() ) < 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE, getError() );
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto v1::BusController::prepare( std::span< const Segment > segments ) const
+	-> Result< std::unique_ptr< PreparedMessage > >
+{
+	if( auto rslt = validate( segments, m_maxMessageSize ); !rslt ) [[unlikely]]
+	{
+		return std::unexpected( rslt.error() );
+	}
 
-	spi_ioc_transfer tr{};
-	tr.tx_buf = reinterpret_cast< __u64 >( tx.data() );
-	tr.rx_buf = reinterpret_cast< __u64 >( rx.data() );
-	tr.len = static_cast< unsigned int >( tx.size() );
+	return std::make_unique< SpidevMessage >( *this, segments );
+}
+
+auto v1::BusController::transferPrepared( const PreparedMessage& message ) -> Result< void >
+{
+	// Only the messages prepared here carry a spi_ioc_transfer array
+	if( &message.transport() != this ) [[unlikely]]
+	{
+		return transfer( message.segments() );
+	}
+
+	if( !m_open ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "SPI device not open" );
+	}
 
-	// TODO: In the future consider introducing TransferConfig to be able to configure per transfer
-	tr.delay_usecs = 0;
-	tr.speed_hz = 0; // use default
-	tr.bits_per_word = 0; // use default
+	const auto transfers = static_cast< const SpidevMessage& >( message ).transfers();
 
-	if( ::ioctl( m_fd, SPI_IOC_MESSAGE( 1 ), &tr ) < 0 ) [[unlikely]]
+	std::scoped_lock _{ m_fdMtx };
+	if( ::ioctl( m_fd, messageRequest( transfers.size() ), transfers.data() ) < 0 ) [[unlikely]]
 	{
 		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE, getError() );
 	}
@@ -150,4 +276,39 @@ auto v1::BusController::transfer( ConstByteSpan tx, ByteSpan rx ) -> Result< voi
 	return utils::MakeSuccess();
 }
 
+auto v1::BusController::stream( ConstByteSpan tx, ByteSpan rx, const TransferConfig& config ) -> Result< void >
+{
+	if( !m_open ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "SPI device not open" );
+	}
+
+	const auto size = std::max( tx.size(), rx.size() );
+	if( size == 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "Empty SPI transfer" );
+	}
+
+	// Held across the chunks so other transfers on this device don't interleave
+	std::scoped_lock _{ m_fdMtx };
+
+	for( std::size_t offset{}; offset < size; offset += m_maxMessageSize )
+	{
+		const auto length = std::min( m_maxMessageSize, size - offset );
+		const Segment segment{ .tx = tx.empty() ? tx : tx.subspan( offset, length ),
+							   .rx = rx.empty() ? rx : rx.subspan( offset, length ),
+							   .config = config };
+
+		if( auto rslt = submit( std::span{ &segment, 1 } ); !rslt ) [[unlikely]]
+		{
+			return rslt;
+		}
+	}
+
+	return utils::MakeSuccess();
+}
+
+static_assert( SPI_MSGSIZE( v1::BusController::kMaxSegments ) != 0,
+			   "BusController::kMaxSegments exceeds the size limit of SPI_IOC_MESSAGE." );
+
 } // namespace pbl::spi
@@ -1,11 +1,14 @@
 #ifndef PBL_SPI_BUS_CONTROLLER_HPP__
 #define PBL_SPI_BUS_CONTROLLER_HPP__
 
+#include "Transport.hpp"
 #include <utils/Result.hpp>
 
 // C++
+#include <span>
 #include <mutex>
 #include <chrono>
+#include <memory>
 #include <atomic>
 #include <string>
 #include <cstdint>
@@ -19,7 +22,7 @@ inline namespace v1
 {
 
 /// TODO: Rename to Device, there is no concept of Bus in SPI.
-class BusController
+class BusController : public Transport
 {
 public:
 	template < typename T >
@@ -53,6 +56,12 @@ public:
 		BITS_16 = 16
 	};
 
+	using TransferConfig = spi::TransferConfig;
+	using Segment = spi::Segment;
+
+	/// Default of the spidev bufsiz module parameter, used if it can't be read.
+	static constexpr std::size_t kDefaultMaxMessageSize{ 4096 };
+
 	[[nodiscard]] static Result< BusController > open( const std::string& device,
 													   Mode mode = Mode::MODE_0,
 													   Speed speed = Speed::SPEED_1MHZ,
@@ -62,6 +71,7 @@ public:
 		: m_busName( std::move( other.m_busName ) )
 		, m_open( other.m_open.load() )
 		, m_fd( std::exchange( other.m_fd, -1 ) )
+		, m_maxMessageSize( other.m_maxMessageSize )
 	{ }
 
 	BusController& operator=( BusController&& other ) noexcept
@@ -70,12 +80,13 @@ public:
 		{
 			m_fd = std::exchange( other.m_fd, -1 );
 			m_open = other.m_open.load();
+			m_maxMessageSize = other.m_maxMessageSize;
 		}
 		return *this;
 	}
 
 	/// Default dtor, closes file m_fd file.
-	virtual ~BusController();
+	~BusController() override;
 
 	/// Returns the OS name of the physical bus name
 	[[nodiscard]] auto& bus() const { return m_busName; }
@@ -86,9 +97,59 @@ public:
 	/// Puts asleep calling thread for specified sleep time in microseconds
 	void sleep( const std::chrono::microseconds sleepTimeUs );
 
-	// Full-duplex: tx -> rx (must be same size)
+	/**
+	 * @brief Returns the largest number of bytes spidev moves in one message, its bufsiz module parameter.
+	 *
+	 * The limit applies to the transmitted and to the received bytes of a message separately.
+	 */
+	[[nodiscard]] std::size_t maxMessageSize() const noexcept override { return m_maxMessageSize; }
+
+	// Full-duplex: tx -> rx (must be same size), split into maxMessageSize() chunks if longer
 	[[nodiscard]] Result< void > transfer( ConstByteSpan tx, ByteSpan rx );
 
+	/**
+	 * @brief Transmits the data, the received bytes are discarded without a receive buffer.
+	 *
+	 * Data longer than maxMessageSize() is sent as consecutive messages of at most that size, the
+	 * device is deselected between them. The buffer is passed to spidev as it is, see TransferBuffer
+	 * for a page-aligned one.
+	 */
+	[[nodiscard]] Result< void > write( ConstByteSpan tx );
+
+	/// Transmits the data with the given segment configuration, applied to every chunk (see above).
+	[[nodiscard]] Result< void > write( ConstByteSpan tx, const TransferConfig& config );
+
+	/// Receives rx.size() bytes clocking out zeros, split into maxMessageSize() chunks (see write).
+	[[nodiscard]] Result< void > read( ByteSpan rx );
+
+	/// Receives rx.size() bytes with the given segment configuration, applied to every chunk.
+	[[nodiscard]] Result< void > read( ByteSpan rx, const TransferConfig& config );
+
+	/**
+	 * @brief Performs the segments as one message, a single SPI_IOC_MESSAGE(N) ioctl.
+	 *
+	 * The device stays selected from the first to the last segment unless a segment sets
+	 * TransferConfig::csChange, i.e. a command segment followed by a receive only response segment
+	 * is one chip select cycle. Setting csChange on the last segment keeps the device selected
+	 * until the next message, if the controller driver supports it.
+	 *
+	 * The buffers of a full-duplex segment must have the same size. spidev copies the data through
+	 * its bounce buffer, the transmitted and the received bytes of a message are limited to
+	 * maxMessageSize() each.
+	 *
+	 * @param segments The segments in order, at most kMaxSegments.
+	 * @return ErrorCode::INVALID_ARGUMENT for a malformed segment or a message exceeding maxMessageSize(),
+	 * ErrorCode::FAILED_TO_WRITE if the ioctl failed.
+	 */
+	[[nodiscard]] Result< void > transfer( std::span< const Segment > segments ) override;
+
+	/// Checks the segments and builds their spi_ioc_transfer array once, see transferPrepared.
+	[[nodiscard]] Result< std::unique_ptr< PreparedMessage > >
+	prepare( std::span< const Segment > segments ) const override;
+
+	/// Performs a prepared message with one SPI_IOC_MESSAGE(N) ioctl, the array is passed to spidev as it is.
+	[[nodiscard]] Result< void > transferPrepared( const PreparedMessage& message ) override;
+
 private:
 	explicit BusController( const std::string& busName );
 
@@ -99,6 +160,12 @@ private:
 	/// Configures the SPI bus
 	[[nodiscard]] Result< void > configure( Mode mode, Speed speed, BitsPerWord bitsPerWord );
 
+	/// Performs one message, the caller holds m_fdMtx.
+	[[nodiscard]] Result< void > submit( std::span< const Segment > segments );
+
+	/// Performs a transfer of any length as consecutive messages of at most maxMessageSize() bytes.
+	[[nodiscard]] Result< void > stream( ConstByteSpan tx, ByteSpan rx, const TransferConfig& config );
+
 	/// TBW
 	[[nodiscard]] static std::string getError();
 
@@ -108,6 +175,7 @@ private:
 
 	mutable std::mutex m_fdMtx; //!< Locks the read write operations
 	int m_fd{ -1 }; //!< File/device descriptor
+	std::size_t m_maxMessageSize{ kDefaultMaxMessageSize }; //!< The spidev bufsiz
 };
 
 } // namespace v1
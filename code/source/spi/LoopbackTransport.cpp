@@ -0,0 +1,63 @@
+#include "LoopbackTransport.hpp"
+
+// C++
+#include <thread>
+#include <algorithm>
+
+namespace pbl::spi
+{
+
+auto v1::LoopbackTransport::transfer( std::span< const Segment > segments ) -> Result< void >
+{
+	if( auto rslt = validate( segments, m_maxMessageSize ); !rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	std::scoped_lock _{ m_transferMtx };
+
+	if( m_failing.load( std::memory_order_relaxed ) ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE, "Loopback transfer failed" );
+	}
+
+	std::size_t bytes{};
+	std::uint64_t selects{ 1 };
+
+	for( std::size_t i{}; i < segments.size(); ++i )
+	{
+		const auto& segment = segments[ i ];
+		if( !segment.rx.empty() )
+		{
+			if( segment.tx.empty() )
+			{
+				std::ranges::fill( segment.rx, std::uint8_t{ 0 } );
+			}
+			else
+			{
+				std::ranges::copy( segment.tx, segment.rx.begin() );
+			}
+		}
+
+		bytes += std::max( segment.tx.size(), segment.rx.size() );
+
+		// On the last segment csChange keeps the device selected instead
+		if( segment.config.csChange && i + 1 < segments.size() )
+		{
+			++selects;
+		}
+	}
+
+	const auto latency = m_latencyPerMessage + m_latencyPerByte * static_cast< std::int64_t >( bytes );
+	if( latency > std::chrono::nanoseconds::zero() )
+	{
+		std::this_thread::sleep_for( latency );
+	}
+
+	m_messages.fetch_add( 1, std::memory_order_relaxed );
+	m_bytes.fetch_add( bytes, std::memory_order_relaxed );
+	m_selects.fetch_add( selects, std::memory_order_relaxed );
+	return utils::MakeSuccess();
+}
+
+} // namespace pbl::spi
@@ -0,0 +1,71 @@
+#ifndef PBL_SPI_LOOPBACK_TRANSPORT_HPP__
+#define PBL_SPI_LOOPBACK_TRANSPORT_HPP__
+
+#include "Transport.hpp"
+
+// C++
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace pbl::spi
+{
+
+inline namespace v1
+{
+
+/**
+ * @class LoopbackTransport
+ * @brief An in-memory SPI device with MOSI wired to MISO, every received byte is the byte sent.
+ *
+ * Receive only segments clock out zeros and receive them back. The transport applies the limits
+ * of spidev, so a message it accepts is accepted by BusController as well. A latency can be set
+ * to emulate the clock rate, the calling thread sleeps as it does in the spidev ioctl.
+ */
+class LoopbackTransport final : public Transport
+{
+public:
+	/// Creates a loopback device accepting messages of up to maxMessageSize bytes in each direction.
+	explicit LoopbackTransport( const std::size_t maxMessageSize = 4096 ) noexcept
+		: m_maxMessageSize{ maxMessageSize }
+	{ }
+
+	[[nodiscard]] Result< void > transfer( std::span< const Segment > segments ) override;
+
+	[[nodiscard]] std::size_t maxMessageSize() const noexcept override { return m_maxMessageSize; }
+
+	/// Sets the duration of a message, perMessage plus perByte for every byte clocked.
+	void setLatency( const std::chrono::nanoseconds perMessage, const std::chrono::nanoseconds perByte = {} ) noexcept
+	{
+		m_latencyPerMessage = perMessage;
+		m_latencyPerByte = perByte;
+	}
+
+	/// Makes the following messages fail with ErrorCode::FAILED_TO_WRITE, i.e. a removed device.
+	void setFailing( const bool failing ) noexcept { m_failing.store( failing, std::memory_order_relaxed ); }
+
+	/// Returns the number of messages performed.
+	[[nodiscard]] std::uint64_t messages() const noexcept { return m_messages.load( std::memory_order_relaxed ); }
+
+	/// Returns the number of bytes clocked.
+	[[nodiscard]] std::uint64_t bytes() const noexcept { return m_bytes.load( std::memory_order_relaxed ); }
+
+	/// Returns the number of times the device was selected, once per message plus once per csChange between segments.
+	[[nodiscard]] std::uint64_t selects() const noexcept { return m_selects.load( std::memory_order_relaxed ); }
+
+private:
+	const std::size_t m_maxMessageSize;
+	std::chrono::nanoseconds m_latencyPerMessage{};
+	std::chrono::nanoseconds m_latencyPerByte{};
+	std::atomic_bool m_failing{ false };
+
+	std::mutex m_transferMtx; //!< Serialises the messages, as the spidev device lock does
+	std::atomic< std::uint64_t > m_messages{};
+	std::atomic< std::uint64_t > m_bytes{};
+	std::atomic< std::uint64_t > m_selects{};
+};
+
+} // namespace v1
+} // namespace pbl::spi
+#endif // PBL_SPI_LOOPBACK_TRANSPORT_HPP__
@@ -0,0 +1,194 @@
+#include "MCP3008Controller.hpp"
+
+namespace pbl::spi
+{
+
+namespace
+{
+
+constexpr std::size_t kFrameSize{ 3 }; //!< Bytes per conversion
+constexpr std::uint8_t kStartBit{ 0x01 };
+constexpr std::uint8_t kSingleEnded{ 0x08 }; //!< SGL/DIFF bit of the input field
+
+/// Returns the conversion frame of the input selected by the SGL/DIFF, D2, D1, D0 field.
+[[nodiscard]] constexpr std::array< std::uint8_t, kFrameSize > makeFrame( const std::uint8_t input ) noexcept
+{
+	// The input field follows the start bit, the result is clocked out in the last 10 bits
+	return { kStartBit, static_cast< std::uint8_t >( input << 4 ), 0x00 };
+}
+
+/// The frames of a scan of all single-ended inputs, CH0 to CH7
+constexpr auto kScanFrames = []() {
+	std::array< std::array< std::uint8_t, kFrameSize >, MCP3008Controller::kChannels > frames{};
+	for( std::size_t channel{}; channel < frames.size(); ++channel )
+	{
+		frames[ channel ] = makeFrame( static_cast< std::uint8_t >( kSingleEnded | channel ) );
+	}
+	return frames;
+}();
+
+/// Returns the 10-bit result of a received frame, the null bit and the undriven bits are masked.
+[[nodiscard]] constexpr std::uint16_t decode( const std::uint8_t* pFrame ) noexcept
+{
+	return static_cast< std::uint16_t >( ( ( pFrame[ 1 ] & 0x03 ) << 8 ) | pFrame[ 2 ] );
+}
+
+/// Decodes the results of a received scan, frame after frame.
+void decodeScan( const std::uint8_t* pData, std::span< std::uint16_t, MCP3008Controller::kChannels > codes ) noexcept
+{
+	for( std::size_t channel{}; channel < codes.size(); ++channel, pData += kFrameSize )
+	{
+		codes[ channel ] = decode( pData );
+	}
+}
+
+} // namespace
+
+v1::MCP3008Controller::MCP3008Controller( Transport& transport, float referenceVoltage, std::uint32_t clockHz )
+	: m_transport{ transport }
+	, m_referenceVoltage{ referenceVoltage }
+	, m_clockHz{ clockHz }
+{
+	// Every conversion but the last deselects the device, the message end deselects it after the last
+	for( std::size_t channel{}; channel < kChannels; ++channel )
+	{
+		m_scanSteps[ channel ] = StreamingEngine::Step{
+			.tx = kScanFrames[ channel ],
+			.rxSize = kFrameSize,
+			.config = { .speedHz = m_clockHz, .csChange = channel + 1 < kChannels } };
+	}
+}
+
+v1::MCP3008Controller::~MCP3008Controller()
+{
+	stopContinuous();
+}
+
+auto v1::MCP3008Controller::readSingleEnded( Channel channel ) -> Result< std::uint16_t >
+{
+	const auto input = static_cast< std::uint8_t >( channel );
+	if( input >= kChannels ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	return convert( static_cast< std::uint8_t >( kSingleEnded | input ) );
+}
+
+auto v1::MCP3008Controller::readDifferential( DifferentialPair pair ) -> Result< std::uint16_t >
+{
+	const auto input = static_cast< std::uint8_t >( pair );
+	if( input >= kChannels ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	return convert( input );
+}
+
+auto v1::MCP3008Controller::scan( std::span< std::uint16_t, kChannels > codes ) -> Result< void >
+{
+	std::array< std::uint8_t, kChannels * kFrameSize > rx{};
+	std::array< Segment, kChannels > segments{};
+	for( std::size_t channel{}; channel < kChannels; ++channel )
+	{
+		const auto& step = m_scanSteps[ channel ];
+		segments[ channel ] = Segment{
+			.tx = step.tx, .rx = std::span{ rx }.subspan( channel * kFrameSize, kFrameSize ), .config = step.config };
+	}
+
+	if( auto rslt = m_transport.transfer( segments ); !rslt ) [[unlikely]]
+	{
+		return std::unexpected( rslt.error() );
+	}
+
+	decodeScan( rx.data(), codes );
+	return utils::MakeSuccess();
+}
+
+auto v1::MCP3008Controller::startContinuous( std::size_t scansPerBlock ) -> Result< void >
+{
+	if( continuousRunning() || scansPerBlock == 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	// A block is scansPerBlock messages, each a whole scan, so the message size limit applies per scan
+	stopContinuous();
+	m_engine = std::make_unique< StreamingEngine >(
+		m_transport, m_scanSteps, StreamingEngine::Options{ .messagesPerBlock = scansPerBlock } );
+	m_scansPerBlock = scansPerBlock;
+
+	if( auto rslt = m_engine->start(); !rslt ) [[unlikely]]
+	{
+		m_engine.reset();
+		return std::unexpected( rslt.error() );
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto v1::MCP3008Controller::readContinuous( utils::RingBuffer< Scan >& ring ) -> Result< std::size_t >
+{
+	if( !m_engine ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION, "Continuous mode is not running" );
+	}
+
+	auto block = m_engine->acquire();
+	if( !block ) [[unlikely]]
+	{
+		return m_engine->statistics().failures != 0
+				   ? utils::MakeError( utils::ErrorCode::FAILED_TO_READ, "Continuous scan failed" )
+				   : utils::MakeError( utils::ErrorCode::UNSUPPORTED_OPERATION, "Continuous mode is not running" );
+	}
+
+	std::size_t appended{};
+	const auto scansPerBlock = static_cast< std::int64_t >( m_scansPerBlock );
+	do
+	{
+		// The scans of a block are evenly spaced, each is stamped with its share of the block time
+		const auto elapsed = block->end - block->start;
+		for( std::int64_t i{}; i < scansPerBlock; ++i )
+		{
+			Scan scan{ .timestamp = block->start + elapsed * ( i + 1 ) / scansPerBlock };
+			decodeScan( block->data.data() + static_cast< std::size_t >( i ) * kChannels * kFrameSize, scan.codes );
+			ring.push( scan );
+		}
+
+		appended += m_scansPerBlock;
+		m_engine->release( *block );
+		block = m_engine->tryAcquire();
+	} while( block );
+
+	return appended;
+}
+
+void v1::MCP3008Controller::stopContinuous()
+{
+	if( m_engine )
+	{
+		m_engine->stop();
+	}
+}
+
+auto v1::MCP3008Controller::continuousStatistics() const noexcept -> StreamingEngine::Statistics
+{
+	return m_engine ? m_engine->statistics() : StreamingEngine::Statistics{};
+}
+
+auto v1::MCP3008Controller::convert( const std::uint8_t input ) -> Result< std::uint16_t >
+{
+	const auto tx = makeFrame( input );
+	std::array< std::uint8_t, kFrameSize > rx{};
+	const std::array segments{ Segment{ .tx = tx, .rx = rx, .config = { .speedHz = m_clockHz } } };
+
+	if( auto rslt = m_transport.transfer( segments ); !rslt ) [[unlikely]]
+	{
+		return std::unexpected( rslt.error() );
+	}
+
+	return decode( rx.data() );
+}
+
+} // namespace pbl::spi
@@ -0,0 +1,188 @@
+#ifndef PBL_SPI_MCP3008_CONTROLLER_HPP__
+#define PBL_SPI_MCP3008_CONTROLLER_HPP__
+
+#include "Transport.hpp"
+#include "StreamingEngine.hpp"
+#include <utils/Result.hpp>
+#include <utils/RingBuffer.hpp>
+
+// C++
+#include <span>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+
+namespace pbl::spi
+{
+
+inline namespace v1
+{
+
+/**
+ * @class MCP3008Controller
+ * @brief Controller for the MCP3008 10-bit ADC with SPI interface.
+ *
+ * The MCP3008 is an 8 channel 10-bit successive approximation ADC, every input can be sampled
+ * single-ended or as pseudo-differential pair with its neighbour. A conversion is one 3 byte
+ * frame, the start bit and the input in the first two bytes, the result clocked out in the last
+ * 10 bits. Each conversion needs its own chip select, the device ignores a second start bit
+ * while it stays selected.
+ *
+ * scan converts all 8 inputs in one message, 8 segments separated by a chip select toggle, i.e. a
+ * single SPI_IOC_MESSAGE(8) syscall on a BusController, and decodes the results in one pass.
+ * Continuous mode repeats the scan on a StreamingEngine and feeds the decoded scans into a ring
+ * buffer of the caller.
+ *
+ * Example usage:
+ * @code
+ * auto bus = spi::BusController::open( "/dev/spidev0.0" );
+ * MCP3008Controller adc{ *bus, 3.3f };
+ *
+ * std::array< std::uint16_t, MCP3008Controller::kChannels > codes{};
+ * if( auto rslt = adc.scan( codes ); rslt ) { ... }
+ * @endcode
+ *
+ * @note The controller does not lock, the transport serialises the messages.
+ */
+class MCP3008Controller final
+{
+public:
+	template < typename T >
+	using Result = utils::Result< T >;
+
+	using Clock = std::chrono::steady_clock;
+
+	/// Number of analog inputs
+	static constexpr std::size_t kChannels{ 8 };
+
+	/// Largest conversion result, the reference voltage minus one LSB
+	static constexpr std::uint16_t kMaxCode{ 1023 };
+
+	/// Maximum clock frequency at VDD = 5V
+	static constexpr std::uint32_t kMaxClockHz{ 3'600'000 };
+
+	/// Maximum clock frequency at VDD = 2.7V
+	static constexpr std::uint32_t kMaxClockHzLowVoltage{ 1'350'000 };
+
+	/// Input Channels for single-ended reading
+	enum class Channel : std::uint8_t
+	{
+		CH0 = 0,
+		CH1 = 1,
+		CH2 = 2,
+		CH3 = 3,
+		CH4 = 4,
+		CH5 = 5,
+		CH6 = 6,
+		CH7 = 7
+	};
+
+	/// Pseudo-differential input pairs, IN+ first
+	enum class DifferentialPair : std::uint8_t
+	{
+		CH0_CH1 = 0,
+		CH1_CH0 = 1,
+		CH2_CH3 = 2,
+		CH3_CH2 = 3,
+		CH4_CH5 = 4,
+		CH5_CH4 = 5,
+		CH6_CH7 = 6,
+		CH7_CH6 = 7
+	};
+
+	/// One conversion of every single-ended input
+	struct Scan
+	{
+		std::array< std::uint16_t, kChannels > codes{}; //!< Conversion results, indexed by channel.
+		Clock::time_point timestamp; //!< Approximate completion of the scan.
+	};
+
+	/**
+	 * @brief Creates a controller, the transport must outlive it.
+	 * @param referenceVoltage The voltage on VREF, used by toVolts.
+	 * @param clockHz The SPI clock of every conversion, at most kMaxClockHz for VDD = 5V and
+	 *				  kMaxClockHzLowVoltage for VDD = 2.7V.
+	 */
+	explicit MCP3008Controller( Transport& transport,
+								float referenceVoltage = 3.3f,
+								std::uint32_t clockHz = kMaxClockHz );
+
+	/// Stops continuous mode.
+	~MCP3008Controller();
+
+	/// Converts a single-ended input once, returns the 10-bit result.
+	[[nodiscard]] Result< std::uint16_t > readSingleEnded( Channel channel );
+
+	/// Converts a pseudo-differential pair once, returns the 10-bit result, 0 when IN- is above IN+.
+	[[nodiscard]] Result< std::uint16_t > readDifferential( DifferentialPair pair );
+
+	/**
+	 * @brief Converts all single-ended inputs in one message.
+	 * @param codes Receives the 10-bit results, indexed by channel.
+	 */
+	[[nodiscard]] Result< void > scan( std::span< std::uint16_t, kChannels > codes );
+
+	/**
+	 * @brief Starts scanning all inputs back to back on a StreamingEngine thread.
+	 *
+	 * @param scansPerBlock Scans handed over to readContinuous at once, more scans per block mean
+	 *		  fewer wake-ups of the consumer at the cost of latency.
+	 * @return ErrorCode::INVALID_ARGUMENT if continuous mode already runs, scansPerBlock is 0 or
+	 *		   a block exceeds Transport::maxMessageSize.
+	 */
+	[[nodiscard]] Result< void > startContinuous( std::size_t scansPerBlock = 32 );
+
+	/**
+	 * @brief Waits for the next completed block and appends its scans to the ring, with those of any other
+	 *		  completed block.
+	 *
+	 * A full ring overwrites its oldest scans, RingBuffer::dropped counts them. Scans the engine
+	 * dropped because the consumer fell behind are counted by continuousStatistics.
+	 *
+	 * @return The number of scans appended, ErrorCode::UNSUPPORTED_OPERATION if continuous mode is
+	 *		   not running, ErrorCode::FAILED_TO_READ if a transfer failed and stopped it.
+	 * @note Call from one consumer thread, the ring is not synchronised.
+	 */
+	[[nodiscard]] Result< std::size_t > readContinuous( utils::RingBuffer< Scan >& ring );
+
+	/// Stops continuous mode after the scan in flight, the completed scans can still be read.
+	void stopContinuous();
+
+	/// Returns whether continuous mode runs, false after stopContinuous or a failed transfer.
+	[[nodiscard]] bool continuousRunning() const noexcept { return m_engine && m_engine->running(); }
+
+	/// Returns the engine statistics of continuous mode, a block is scansPerBlock scans.
+	[[nodiscard]] StreamingEngine::Statistics continuousStatistics() const noexcept;
+
+	/// Converts a conversion result to volts.
+	[[nodiscard]] float toVolts( const std::uint16_t code ) const noexcept
+	{
+		return static_cast< float >( code ) * m_referenceVoltage / static_cast< float >( kMaxCode + 1 );
+	}
+
+	/// Returns the SPI clock of the conversions.
+	[[nodiscard]] std::uint32_t clockHz() const noexcept { return m_clockHz; }
+
+private:
+	/// Converts the input selected by the 4 bit SGL/DIFF, D2, D1, D0 field.
+	[[nodiscard]] Result< std::uint16_t > convert( const std::uint8_t input );
+
+	// This class is non-copyable and non-movable
+	MCP3008Controller( const MCP3008Controller& ) = delete;
+	MCP3008Controller( MCP3008Controller&& ) = delete;
+	MCP3008Controller& operator=( const MCP3008Controller& ) = delete;
+	MCP3008Controller& operator=( MCP3008Controller&& ) = delete;
+
+private:
+	Transport& m_transport;
+	const float m_referenceVoltage;
+	const std::uint32_t m_clockHz;
+	std::array< StreamingEngine::Step, kChannels > m_scanSteps; //!< Frames of a scan, also repeated by continuous mode
+	std::unique_ptr< StreamingEngine > m_engine;
+	std::size_t m_scansPerBlock{};
+};
+
+} // namespace v1
+} // namespace pbl::spi
+#endif // PBL_SPI_MCP3008_CONTROLLER_HPP__
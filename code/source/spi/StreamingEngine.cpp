@@ -0,0 +1,237 @@
+#include "StreamingEngine.hpp"
+
+// C++
+#include <numeric>
+
+namespace pbl::spi
+{
+
+namespace
+{
+
+/// Returns the number of bytes a message of the steps receives.
+[[nodiscard]] std::size_t receivedBytes( std::span< const StreamingEngine::Step > steps ) noexcept
+{
+	return std::accumulate( steps.begin(), steps.end(), std::size_t{}, []( auto sum, const auto& step ) {
+		return sum + step.rxSize;
+	} );
+}
+
+} // namespace
+
+v1::StreamingEngine::StreamingEngine( Transport& transport, std::span< const Step > message )
+	: StreamingEngine{ transport, message, Options{} }
+{ }
+
+v1::StreamingEngine::StreamingEngine( Transport& transport, std::span< const Step > message, Options options )
+	: m_transport{ transport }
+	, m_options{ options }
+	, m_steps{ message.begin(), message.end() }
+	, m_messageSize{ receivedBytes( message ) }
+	, m_blockSize{ m_messageSize * options.messagesPerBlock }
+	, m_storage( m_blockSize * ( kBuffers + 1 ) )
+{
+	// Point the received data of every message into its buffer once, start only validates
+	m_segments.reserve( ( kBuffers + 1 ) * options.messagesPerBlock * m_steps.size() );
+	for( std::size_t buffer{}; buffer <= kBuffers; ++buffer )
+	{
+		auto* pData = m_storage.data() + buffer * m_blockSize;
+		for( std::size_t i{}; i < options.messagesPerBlock; ++i )
+		{
+			for( const auto& step : m_steps )
+			{
+				const std::span< std::uint8_t > rx{ pData, step.rxSize };
+				m_segments.push_back( Segment{ .tx = step.tx, .rx = rx, .config = step.config } );
+				pData += step.rxSize;
+			}
+		}
+	}
+}
+
+v1::StreamingEngine::~StreamingEngine()
+{
+	stop();
+}
+
+auto v1::StreamingEngine::start() -> Result< void >
+{
+	if( running() || m_steps.empty() || m_steps.size() > Transport::kMaxSegments ||
+		m_options.messagesPerBlock == 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	std::size_t txTotal{};
+	for( const auto& step : m_steps )
+	{
+		const bool fullDuplex = !step.tx.empty() && step.rxSize != 0;
+		if( ( step.tx.empty() && step.rxSize == 0 ) || ( fullDuplex && step.tx.size() != step.rxSize ) ) [[unlikely]]
+		{
+			return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "Malformed streaming step" );
+		}
+
+		txTotal += step.tx.size();
+	}
+
+	if( txTotal > m_transport.maxMessageSize() || m_messageSize > m_transport.maxMessageSize() ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "Streaming message exceeds the transport limit" );
+	}
+
+	// Joins a thread stopped by a failed message, afterwards no other thread touches the queues
+	if( m_thread.joinable() )
+	{
+		m_thread.join();
+	}
+
+	if( auto rslt = prepare(); !rslt ) [[unlikely]]
+	{
+		return rslt;
+	}
+
+	while( m_ready.pop() ) { }
+	while( m_free.pop() ) { }
+	for( std::size_t buffer{}; buffer < kBuffers; ++buffer )
+	{
+		[[maybe_unused]] const bool pushed = m_free.push( buffer );
+	}
+
+	m_active.store( true, std::memory_order_release );
+	m_thread = std::jthread{ [ this ]( std::stop_token stopToken ) { run( std::move( stopToken ) ); } };
+	return utils::MakeSuccess();
+}
+
+void v1::StreamingEngine::stop()
+{
+	if( !m_thread.joinable() )
+	{
+		return;
+	}
+
+	m_thread.request_stop();
+	m_thread.join();
+}
+
+auto v1::StreamingEngine::tryAcquire() -> std::optional< Block >
+{
+	return m_ready.pop();
+}
+
+auto v1::StreamingEngine::acquire() -> std::optional< Block >
+{
+	while( true )
+	{
+		// Read before checking, a hand-over after the check changes it and the wait returns at once
+		const auto published = m_published.load( std::memory_order_acquire );
+
+		if( auto block = m_ready.pop() )
+		{
+			return block;
+		}
+
+		if( !running() )
+		{
+			// The thread may have published a last block before it stopped
+			return m_ready.pop();
+		}
+
+		m_published.wait( published, std::memory_order_acquire );
+	}
+}
+
+void v1::StreamingEngine::release( const Block& block )
+{
+	if( block.buffer < kBuffers ) [[likely]]
+	{
+		[[maybe_unused]] const bool pushed = m_free.push( block.buffer );
+	}
+}
+
+auto v1::StreamingEngine::statistics() const noexcept -> Statistics
+{
+	return Statistics{ .blocks = m_blocks.load( std::memory_order_relaxed ),
+					   .overruns = m_overruns.load( std::memory_order_relaxed ),
+					   .failures = m_failures.load( std::memory_order_relaxed ) };
+}
+
+auto v1::StreamingEngine::message( const std::size_t buffer, const std::size_t index ) const noexcept
+	-> std::span< const Segment >
+{
+	const auto first = ( buffer * m_options.messagesPerBlock + index ) * m_steps.size();
+	return std::span{ m_segments }.subspan( first, m_steps.size() );
+}
+
+auto v1::StreamingEngine::prepare() -> Result< void >
+{
+	if( !m_prepared.empty() )
+	{
+		return utils::MakeSuccess();
+	}
+
+	const auto messages = ( kBuffers + 1 ) * m_options.messagesPerBlock;
+	m_prepared.reserve( messages );
+
+	for( std::size_t i{}; i < messages; ++i )
+	{
+		auto prepared = m_transport.prepare( message( i / m_options.messagesPerBlock, i % m_options.messagesPerBlock ) );
+		if( !prepared ) [[unlikely]]
+		{
+			m_prepared.clear();
+			return std::unexpected( prepared.error() );
+		}
+
+		m_prepared.push_back( std::move( *prepared ) );
+	}
+
+	return utils::MakeSuccess();
+}
+
+void v1::StreamingEngine::deactivate() noexcept
+{
+	m_active.store( false, std::memory_order_release );
+	m_published.fetch_add( 1, std::memory_order_release );
+	m_published.notify_all();
+}
+
+void v1::StreamingEngine::run( std::stop_token stopToken )
+{
+	std::uint64_t sequence{};
+
+	while( !stopToken.stop_requested() )
+	{
+		// Without a free buffer the block is received into the scratch buffer and dropped
+		const auto buffer = m_free.pop().value_or( kScratchBuffer );
+		const auto start = Clock::now();
+
+		for( std::size_t i{}; i < m_options.messagesPerBlock; ++i )
+		{
+			if( !m_transport.transferPrepared( *m_prepared[ buffer * m_options.messagesPerBlock + i ] ) ) [[unlikely]]
+			{
+				m_failures.fetch_add( 1, std::memory_order_relaxed );
+				deactivate();
+				return;
+			}
+		}
+
+		const auto end = Clock::now();
+
+		if( buffer == kScratchBuffer ) [[unlikely]]
+		{
+			m_overruns.fetch_add( 1, std::memory_order_relaxed );
+			++sequence;
+			continue;
+		}
+
+		const std::span< const std::uint8_t > data{ m_storage.data() + buffer * m_blockSize, m_blockSize };
+		[[maybe_unused]] const bool pushed =
+			m_ready.push( Block{ .data = data, .sequence = sequence++, .start = start, .end = end, .buffer = buffer } );
+
+		m_blocks.fetch_add( 1, std::memory_order_relaxed );
+		m_published.fetch_add( 1, std::memory_order_release );
+		m_published.notify_one();
+	}
+
+	deactivate();
+}
+
+} // namespace pbl::spi
@@ -0,0 +1,185 @@
+#ifndef PBL_SPI_STREAMING_ENGINE_HPP__
+#define PBL_SPI_STREAMING_ENGINE_HPP__
+
+#include "Transport.hpp"
+#include <utils/Result.hpp>
+#include <threading/SpscQueue.hpp>
+
+// C++
+#include <span>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+namespace pbl::spi
+{
+
+inline namespace v1
+{
+
+/**
+ * @class StreamingEngine
+ * @brief Repeats a prebuilt SPI message on a dedicated thread and double buffers the received data.
+ *
+ * Continuous acquisition, i.e. an SPI ADC sampled at 100+ kS/s, can't afford to build, check and
+ * allocate a message for every conversion. The engine prepares every message of its two block buffers
+ * once on start (Transport::prepare, on a BusController the spi_ioc_transfer array of the ioctl), its
+ * thread then submits them back to back into one buffer while the consumer processes the other. What
+ * remains per message is the uncontended device lock and the ioctl. A block is messagesPerBlock
+ * messages, every completed block is handed over through a lock-free single producer single consumer
+ * queue together with its sequence number and the time the first message was submitted and the last
+ * one completed.
+ *
+ * When the consumer still holds both buffers the thread keeps the transfers going into a scratch
+ * buffer and drops that block, counted as an overrun. The sampling cadence is kept, the consumer
+ * sees the gap in the sequence numbers.
+ *
+ * Example usage:
+ * @code
+ * const std::array< std::uint8_t, 3 > command{ 0x01, 0x80, 0x00 }; // MCP3008 CH0
+ * std::vector< StreamingEngine::Step > message( 64, { .tx = command, .rxSize = 3, .config = { .csChange = true } } );
+ *
+ * StreamingEngine engine{ busController, message };
+ * if( auto rslt = engine.start(); !rslt ) { ... }
+ *
+ * while( auto block = engine.acquire() )
+ * {
+ *     process( block->data );
+ *     engine.release( *block );
+ * }
+ * @endcode
+ *
+ * @note acquire, tryAcquire and release must be called from one consumer thread.
+ */
+class StreamingEngine final
+{
+public:
+	template < typename T >
+	using Result = utils::Result< T >;
+
+	using Clock = std::chrono::steady_clock;
+
+	/// One segment of the repeated message, the received bytes are stored in the block buffer.
+	struct Step
+	{
+		std::span< const std::uint8_t > tx{}; //!< Sent by every repetition, must outlive the engine, empty if none.
+		std::size_t rxSize{}; //!< Bytes received, tx.size() for full-duplex, 0 to transmit only.
+		TransferConfig config{};
+	};
+
+	struct Options
+	{
+		/// Messages making up one block, more messages per block means fewer hand-overs to the consumer.
+		std::size_t messagesPerBlock{ 1 };
+	};
+
+	/// A completed block, the data stays valid until the block is released.
+	struct Block
+	{
+		std::span< const std::uint8_t > data; //!< Received bytes, the steps of every message in order.
+		std::uint64_t sequence{}; //!< Number of the block since start, a gap means blocks were dropped.
+		Clock::time_point start; //!< Submission of the first message.
+		Clock::time_point end; //!< Completion of the last message.
+		std::size_t buffer{}; //!< The buffer holding the data, returned by release.
+	};
+
+	struct Statistics
+	{
+		std::uint64_t blocks{}; //!< Blocks handed to the consumer.
+		std::uint64_t overruns{}; //!< Blocks dropped because the consumer held both buffers.
+		std::uint64_t failures{}; //!< Failed messages, the engine stops on a failure.
+	};
+
+	/// Creates a stopped engine with the default options, the transport must outlive it.
+	StreamingEngine( Transport& transport, std::span< const Step > message );
+
+	/// Creates a stopped engine, the transport must outlive it.
+	StreamingEngine( Transport& transport, std::span< const Step > message, Options options );
+
+	/// Stops the engine thread.
+	~StreamingEngine();
+
+	/**
+	 * @brief Starts the engine thread, both buffers are free.
+	 *
+	 * Blocks acquired before a restart must not be released afterwards.
+	 *
+	 * @return ErrorCode::INVALID_ARGUMENT if the engine runs, the message is empty, has more than
+	 * Transport::kMaxSegments steps, a malformed step or exceeds Transport::maxMessageSize.
+	 */
+	[[nodiscard]] Result< void > start();
+
+	/// Stops the engine thread after the message in flight, the completed blocks can still be acquired.
+	void stop();
+
+	/// Returns whether the engine thread runs, false after stop or a failed message.
+	[[nodiscard]] bool running() const noexcept { return m_active.load( std::memory_order_acquire ); }
+
+	/// Returns the oldest completed block, std::nullopt if there is none. Never blocks.
+	[[nodiscard]] std::optional< Block > tryAcquire();
+
+	/// Returns the oldest completed block, waits for one while the engine runs, std::nullopt once stopped.
+	[[nodiscard]] std::optional< Block > acquire();
+
+	/// Hands the buffer of the block back to the engine.
+	void release( const Block& block );
+
+	/// Returns the number of bytes received per block.
+	[[nodiscard]] std::size_t blockSize() const noexcept { return m_blockSize; }
+
+	/// Returns the statistics since the engine was created.
+	[[nodiscard]] Statistics statistics() const noexcept;
+
+private:
+	/// Returns the prebuilt segments of a message of a buffer.
+	[[nodiscard]] std::span< const Segment > message( const std::size_t buffer,
+													  const std::size_t index ) const noexcept;
+
+	/// Prepares every message of the buffers with the transport, once.
+	[[nodiscard]] Result< void > prepare();
+
+	/// Marks the engine stopped and wakes the consumer.
+	void deactivate() noexcept;
+
+	/// The engine thread loop.
+	void run( std::stop_token stopToken );
+
+	// This class is non-copyable and non-movable
+	StreamingEngine( const StreamingEngine& ) = delete;
+	StreamingEngine( StreamingEngine&& ) = delete;
+	StreamingEngine& operator=( const StreamingEngine& ) = delete;
+	StreamingEngine& operator=( StreamingEngine&& ) = delete;
+
+private:
+	static constexpr std::size_t kBuffers{ 2 };
+	static constexpr std::size_t kScratchBuffer{ kBuffers }; //!< Receives the dropped blocks
+
+	Transport& m_transport;
+	const Options m_options;
+	const std::vector< Step > m_steps;
+	const std::size_t m_messageSize; //!< Bytes received per message
+	const std::size_t m_blockSize;
+
+	std::vector< std::uint8_t > m_storage; //!< The block buffers followed by the scratch buffer
+	std::vector< Segment > m_segments; //!< Prebuilt messages, per buffer per message
+	std::vector< std::unique_ptr< PreparedMessage > > m_prepared; //!< m_segments prepared by the transport on start
+
+	threading::SpscQueue< std::size_t > m_free{ kBuffers }; //!< Consumer to engine thread
+	threading::SpscQueue< Block > m_ready{ kBuffers }; //!< Engine thread to consumer
+	std::atomic< std::uint64_t > m_published{}; //!< Bumped on every hand-over, waited on by acquire
+	std::atomic_bool m_active{ false };
+
+	std::atomic< std::uint64_t > m_blocks{};
+	std::atomic< std::uint64_t > m_overruns{};
+	std::atomic< std::uint64_t > m_failures{};
+
+	std::jthread m_thread;
+};
+
+} // namespace v1
+} // namespace pbl::spi
+#endif // PBL_SPI_STREAMING_ENGINE_HPP__
@@ -0,0 +1,53 @@
+#include "TransferBuffer.hpp"
+
+// C++
+#include <cstring>
+
+// C
+extern "C" {
+#include <unistd.h>
+}
+
+namespace pbl::spi
+{
+
+namespace
+{
+
+// Used if the page size can't be queried
+constexpr std::size_t kDefaultPageSize{ 4096 };
+
+} // namespace
+
+auto v1::TransferBuffer::allocate( const std::size_t size ) -> Result< TransferBuffer >
+{
+	if( size == 0 ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "Empty transfer buffer" );
+	}
+
+	// std::aligned_alloc requires a multiple of the alignment
+	const auto alignment = pageSize();
+	const auto capacity = ( size + alignment - 1 ) / alignment * alignment;
+
+	auto* pData = static_cast< std::uint8_t* >( std::aligned_alloc( alignment, capacity ) );
+	if( pData == nullptr ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::UNEXPECTED_ERROR, "Failed to allocate the transfer buffer" );
+	}
+
+	std::memset( pData, 0, capacity );
+	return Result< TransferBuffer >{ TransferBuffer{ pData, size } };
+}
+
+std::size_t v1::TransferBuffer::pageSize() noexcept
+{
+	static const std::size_t size = [] {
+		const auto value = ::sysconf( _SC_PAGESIZE );
+		return value > 0 ? static_cast< std::size_t >( value ) : kDefaultPageSize;
+	}();
+
+	return size;
+}
+
+} // namespace pbl::spi
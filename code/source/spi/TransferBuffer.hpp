@@ -0,0 +1,78 @@
+#ifndef PBL_SPI_TRANSFER_BUFFER_HPP__
+#define PBL_SPI_TRANSFER_BUFFER_HPP__
+
+#include <utils/Result.hpp>
+
+// C++
+#include <span>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>
+
+namespace pbl::spi
+{
+
+inline namespace v1
+{
+
+/**
+ * @class TransferBuffer
+ * @brief A page-aligned byte buffer for large transfers, i.e. display frames or LED strip data.
+ *
+ * BusController passes caller buffers to spidev as they are, any buffer works. A page-aligned one
+ * starts every bufsiz chunk of a long transfer on a page boundary, which keeps the copy into the
+ * spidev bounce buffer aligned and lets drivers that map user pages for DMA do so without a split page.
+ *
+ * Example usage:
+ * @code
+ * auto frame = TransferBuffer::allocate( 320 * 240 * 2 );
+ * if( frame ) { render( frame->span() ); bus.write( frame->span() ); }
+ * @endcode
+ */
+class TransferBuffer final
+{
+public:
+	template < typename T >
+	using Result = utils::Result< T >;
+
+	/// Allocates a zero filled buffer of size bytes aligned to the page size, fails for size 0 or out of memory.
+	[[nodiscard]] static Result< TransferBuffer > allocate( const std::size_t size );
+
+	TransferBuffer( TransferBuffer&& ) noexcept = default;
+	TransferBuffer& operator=( TransferBuffer&& ) noexcept = default;
+
+	[[nodiscard]] std::uint8_t* data() noexcept { return m_data.get(); }
+	[[nodiscard]] const std::uint8_t* data() const noexcept { return m_data.get(); }
+
+	/// Returns the requested size, the allocation is rounded up to whole pages.
+	[[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+	[[nodiscard]] std::span< std::uint8_t > span() noexcept { return { m_data.get(), m_size }; }
+	[[nodiscard]] std::span< const std::uint8_t > span() const noexcept { return { m_data.get(), m_size }; }
+
+	/// Returns the page size the buffers are aligned to.
+	[[nodiscard]] static std::size_t pageSize() noexcept;
+
+private:
+	struct Deleter
+	{
+		void operator()( std::uint8_t* pData ) const noexcept { std::free( pData ); }
+	};
+
+	TransferBuffer( std::uint8_t* pData, const std::size_t size ) noexcept
+		: m_data{ pData }
+		, m_size{ size }
+	{ }
+
+	// This class is non-copyable
+	TransferBuffer( const TransferBuffer& ) = delete;
+	TransferBuffer& operator=( const TransferBuffer& ) = delete;
+
+private:
+	std::unique_ptr< std::uint8_t[], Deleter > m_data;
+	std::size_t m_size{};
+};
+
+} // namespace v1
+} // namespace pbl::spi
+#endif // PBL_SPI_TRANSFER_BUFFER_HPP__
@@ -0,0 +1,79 @@
+#include "Transport.hpp"
+
+// C++
+#include <limits>
+#include <algorithm>
+
+namespace pbl::spi
+{
+
+namespace
+{
+
+// spi_ioc_transfer::delay_usecs is 16-bit
+constexpr std::chrono::microseconds kMaxDelay{ std::numeric_limits< std::uint16_t >::max() };
+
+/// Returns whether the segment can be passed to spidev.
+[[nodiscard]] bool isValid( const Segment& segment ) noexcept
+{
+	const bool fullDuplex = !segment.tx.empty() && !segment.rx.empty();
+	if( ( segment.tx.empty() && segment.rx.empty() ) || ( fullDuplex && segment.tx.size() != segment.rx.size() ) )
+	{
+		return false;
+	}
+
+	const auto delay = segment.config.delay;
+	return delay >= std::chrono::microseconds::zero() && delay <= kMaxDelay &&
+		   std::max( segment.tx.size(), segment.rx.size() ) <= std::numeric_limits< std::uint32_t >::max();
+}
+
+} // namespace
+
+auto v1::Transport::validate( std::span< const Segment > segments, const std::size_t maxMessageSize )
+	-> Result< void >
+{
+	if( segments.empty() || segments.size() > kMaxSegments ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "Invalid number of segments" );
+	}
+
+	// spidev limits the transmitted and the received bytes separately
+	std::size_t txTotal{};
+	std::size_t rxTotal{};
+
+	for( const auto& segment : segments )
+	{
+		if( !isValid( segment ) ) [[unlikely]]
+		{
+			return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "Malformed SPI segment" );
+		}
+
+		txTotal += segment.tx.size();
+		rxTotal += segment.rx.size();
+	}
+
+	if( txTotal > maxMessageSize || rxTotal > maxMessageSize ) [[unlikely]]
+	{
+		return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT, "SPI message exceeds the spidev bufsiz" );
+	}
+
+	return utils::MakeSuccess();
+}
+
+auto v1::Transport::prepare( std::span< const Segment > segments ) const
+	-> Result< std::unique_ptr< PreparedMessage > >
+{
+	if( auto rslt = validate( segments, maxMessageSize() ); !rslt ) [[unlikely]]
+	{
+		return std::unexpected( rslt.error() );
+	}
+
+	return std::unique_ptr< PreparedMessage >{ new PreparedMessage{ *this, segments } };
+}
+
+auto v1::Transport::transferPrepared( const PreparedMessage& message ) -> Result< void >
+{
+	return transfer( message.segments() );
+}
+
+} // namespace pbl::spi
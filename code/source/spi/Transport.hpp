@@ -0,0 +1,134 @@
+#ifndef PBL_SPI_TRANSPORT_HPP__
+#define PBL_SPI_TRANSPORT_HPP__
+
+#include <utils/Result.hpp>
+
+// C++
+#include <span>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+
+namespace pbl::spi
+{
+
+inline namespace v1
+{
+
+/// Per segment overrides of the device configuration, zero keeps the value set when the device was opened.
+struct TransferConfig
+{
+	std::uint32_t speedHz{}; //!< Clock rate of the segment, 0 uses the device speed.
+	std::uint8_t bitsPerWord{}; //!< Word size of the segment, 0 uses the device word size.
+	std::chrono::microseconds delay{}; //!< Delay after the segment, before chip select changes, up to 65535µs.
+	bool csChange{}; //!< Deselects the device between this and the next segment.
+};
+
+/// One transfer of a multi-segment message, either buffer may be empty for a transmit or receive only segment.
+struct Segment
+{
+	std::span< const std::uint8_t > tx{}; //!< Data to send, zeros are clocked out if empty.
+	std::span< std::uint8_t > rx{}; //!< Destination of the received data, discarded if empty.
+	TransferConfig config{};
+};
+
+class Transport;
+
+/**
+ * @class PreparedMessage
+ * @brief A message checked and converted once by Transport::prepare, performed by Transport::transferPrepared.
+ *
+ * Transports that hand messages to the kernel in a native form keep the converted form in a derived
+ * message, i.e. BusController the spi_ioc_transfer array of the SPI_IOC_MESSAGE ioctl.
+ */
+class PreparedMessage
+{
+public:
+	virtual ~PreparedMessage() = default;
+
+	/// Returns the transport that prepared the message.
+	[[nodiscard]] const Transport& transport() const noexcept { return m_transport; }
+
+	/// Returns the segments of the message.
+	[[nodiscard]] std::span< const Segment > segments() const noexcept { return m_segments; }
+
+protected:
+	friend class Transport;
+
+	PreparedMessage( const Transport& transport, std::span< const Segment > segments ) noexcept
+		: m_transport{ transport }
+		, m_segments{ segments }
+	{ }
+
+	// This class is non-copyable and non-movable
+	PreparedMessage( const PreparedMessage& ) = delete;
+	PreparedMessage( PreparedMessage&& ) = delete;
+	PreparedMessage& operator=( const PreparedMessage& ) = delete;
+	PreparedMessage& operator=( PreparedMessage&& ) = delete;
+
+private:
+	const Transport& m_transport;
+	const std::span< const Segment > m_segments;
+};
+
+/**
+ * @class Transport
+ * @brief Performs SPI messages on one device (chip select).
+ *
+ * Drivers and the StreamingEngine are written against this interface, so they run unchanged against:
+ *  - BusController, a Linux spidev device (i.e. "/dev/spidev0.0"),
+ *  - LoopbackTransport, an in-memory stand-in with MOSI wired to MISO, used to test and benchmark
+ *    without hardware.
+ *
+ * Implementations are thread-safe, concurrent messages are serialised.
+ */
+class Transport
+{
+public:
+	template < typename T >
+	using Result = utils::Result< T >;
+
+	/// Maximum number of segments in one message, bounded by the size field of the SPI_IOC_MESSAGE ioctl.
+	static constexpr std::size_t kMaxSegments{ 511 };
+
+	virtual ~Transport() = default;
+
+	/**
+	 * @brief Performs the segments as one message, the device stays selected unless a segment sets csChange.
+	 *
+	 * The buffers of a full-duplex segment must have the same size, the transmitted and the received
+	 * bytes of the message are limited to maxMessageSize() each.
+	 *
+	 * @param segments The segments in order, at most kMaxSegments.
+	 * @return ErrorCode::INVALID_ARGUMENT for a malformed message, ErrorCode::FAILED_TO_WRITE if the transfer failed.
+	 */
+	[[nodiscard]] virtual Result< void > transfer( std::span< const Segment > segments ) = 0;
+
+	/**
+	 * @brief Checks a message once and converts it for repeated use by transferPrepared.
+	 *
+	 * @param segments The segments in order, they and their buffers must outlive the returned message.
+	 * @return ErrorCode::INVALID_ARGUMENT for a malformed message, see transfer.
+	 */
+	[[nodiscard]] virtual Result< std::unique_ptr< PreparedMessage > >
+	prepare( std::span< const Segment > segments ) const;
+
+	/**
+	 * @brief Performs a message returned by prepare, without checking or converting it again.
+	 *
+	 * The default performs the segments through transfer, transports with a native message form override it.
+	 */
+	[[nodiscard]] virtual Result< void > transferPrepared( const PreparedMessage& message );
+
+	/// Returns the largest number of bytes moved in each direction by one message.
+	[[nodiscard]] virtual std::size_t maxMessageSize() const noexcept = 0;
+
+protected:
+	/// Checks the message against the limits of transfer, returns ErrorCode::INVALID_ARGUMENT if it violates them.
+	[[nodiscard]] static Result< void > validate( std::span< const Segment > segments,
+												  const std::size_t maxMessageSize );
+};
+
+} // namespace v1
+} // namespace pbl::spi
+#endif // PBL_SPI_TRANSPORT_HPP__
@@ -0,0 +1,114 @@
+#ifndef PBL_THREADING_SPSC_QUEUE_HPP__
+#define PBL_THREADING_SPSC_QUEUE_HPP__
+
+// C++
+#include <bit>
+#include <atomic>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <optional>
+
+namespace pbl::threading
+{
+
+/**
+ * @class SpscQueue
+ * @brief A bounded lock-free queue for exactly one producer and one consumer thread.
+ *
+ * The storage is allocated once when constructed, pushing and popping never allocate nor block.
+ * A push into a full queue fails, the element is not stored. The producer and the consumer index
+ * live on separate cache lines, each side keeps a copy of the other index and only reloads it when
+ * the queue looks full or empty.
+ *
+ * Example usage:
+ * @code
+ * SpscQueue< Event > queue{ 256 };
+ * // Producer thread
+ * queue.push( event );
+ * // Consumer thread
+ * while( auto event = queue.pop() ) { ... }
+ * @endcode
+ *
+ * @tparam T The element type, must be default constructible and move assignable.
+ */
+template < typename T >
+class SpscQueue final
+{
+	static constexpr std::size_t kCacheLine{ 64 };
+
+public:
+	/// Constructs an empty queue, the capacity is rounded up to a power of two.
+	explicit SpscQueue( const std::size_t capacity )
+		: m_storage( std::bit_ceil( capacity < 1 ? std::size_t{ 1 } : capacity ) )
+		, m_mask{ m_storage.size() - 1 }
+	{ }
+
+	/// Returns the maximum number of elements.
+	[[nodiscard]] std::size_t capacity() const noexcept { return m_storage.size(); }
+
+	/// Returns the number of elements, exact only when called by the producer or the consumer while the other is idle.
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return m_tail.load( std::memory_order::acquire ) - m_head.load( std::memory_order::acquire );
+	}
+
+	/// Returns true if the queue holds no element, see size.
+	[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+	/// Appends an element, returns false if the queue is full. Producer thread only.
+	template < typename U >
+	[[nodiscard]] bool push( U&& value )
+	{
+		const auto tail = m_tail.load( std::memory_order::relaxed );
+		if( tail - m_headCache == capacity() )
+		{
+			m_headCache = m_head.load( std::memory_order::acquire );
+			if( tail - m_headCache == capacity() )
+			{
+				return false;
+			}
+		}
+
+		m_storage[ tail & m_mask ] = std::forward< U >( value );
+		m_tail.store( tail + 1, std::memory_order::release );
+		return true;
+	}
+
+	/// Removes and returns the oldest element, std::nullopt if empty. Consumer thread only.
+	[[nodiscard]] std::optional< T > pop()
+	{
+		const auto head = m_head.load( std::memory_order::relaxed );
+		if( head == m_tailCache )
+		{
+			m_tailCache = m_tail.load( std::memory_order::acquire );
+			if( head == m_tailCache )
+			{
+				return std::nullopt;
+			}
+		}
+
+		std::optional< T > value{ std::move( m_storage[ head & m_mask ] ) };
+		m_head.store( head + 1, std::memory_order::release );
+		return value;
+	}
+
+private:
+	SpscQueue( const SpscQueue& ) = delete;
+	SpscQueue& operator=( const SpscQueue& ) = delete;
+	SpscQueue( SpscQueue&& ) = delete;
+	SpscQueue& operator=( SpscQueue&& ) = delete;
+
+private:
+	std::vector< T > m_storage;
+	std::size_t m_mask;
+
+	alignas( kCacheLine ) std::atomic< std::size_t > m_head{}; //!< Next element to pop, written by the consumer
+	std::size_t m_tailCache{}; //!< Consumer copy of m_tail
+
+	alignas( kCacheLine ) std::atomic< std::size_t > m_tail{}; //!< Next free slot, written by the producer
+	std::size_t m_headCache{}; //!< Producer copy of m_head
+};
+
+} // namespace pbl::threading
+#endif // PBL_THREADING_SPSC_QUEUE_HPP__
@@ -0,0 +1,123 @@
+#ifndef PBL_UTILS_RING_BUFFER_HPP__
+#define PBL_UTILS_RING_BUFFER_HPP__
+
+// C++
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace pbl::utils
+{
+
+/**
+ * @brief A fixed capacity FIFO ring, the storage is allocated once when constructed.
+ *
+ * Meant for sample streams produced faster than they are consumed occasionally, pushing into a
+ * full ring overwrites the oldest element (the newest data is kept) and counts it as dropped.
+ * Pushing and popping never allocate.
+ *
+ * Example usage:
+ * @code
+ * RingBuffer< Sample > ring{ 1024 };
+ * ring.push( sample );
+ * while( auto s = ring.pop() ) { ... }
+ * @endcode
+ *
+ * @note The ring is not synchronised, produce and consume from the same thread or guard it.
+ *
+ * @tparam T The element type, must be default constructible and copy or move assignable.
+ */
+template < typename T >
+class RingBuffer final
+{
+public:
+	/// Constructs an empty ring that can't hold any element.
+	RingBuffer() = default;
+
+	/// Constructs an empty ring holding at most capacity elements.
+	explicit RingBuffer( const std::size_t capacity )
+		: m_storage( capacity )
+	{ }
+
+	/// Returns the maximum number of elements.
+	[[nodiscard]] std::size_t capacity() const noexcept { return m_storage.size(); }
+
+	/// Returns the number of elements.
+	[[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+	/// Returns true if the ring holds no element.
+	[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+	/// Returns true if the next push overwrites the oldest element.
+	[[nodiscard]] bool full() const noexcept { return m_size == capacity(); }
+
+	/// Returns the number of elements overwritten before they were popped.
+	[[nodiscard]] std::uint64_t dropped() const noexcept { return m_dropped; }
+
+	/// Appends an element, overwrites the oldest one if the ring is full. Returns false if one was overwritten.
+	template < typename U >
+	bool push( U&& value )
+	{
+		if( m_storage.empty() ) [[unlikely]]
+		{
+			++m_dropped;
+			return false;
+		}
+
+		m_storage[ ( m_head + m_size ) % capacity() ] = std::forward< U >( value );
+
+		if( full() )
+		{
+			m_head = ( m_head + 1 ) % capacity();
+			++m_dropped;
+			return false;
+		}
+
+		++m_size;
+		return true;
+	}
+
+	/// Removes and returns the oldest element, std::nullopt if empty.
+	[[nodiscard]] std::optional< T > pop()
+	{
+		if( empty() )
+		{
+			return std::nullopt;
+		}
+
+		std::optional< T > value{ std::move( m_storage[ m_head ] ) };
+		m_head = ( m_head + 1 ) % capacity();
+		--m_size;
+		return value;
+	}
+
+	/// Returns the element at the index, 0 is the oldest. The index must be less than size().
+	[[nodiscard]] const T& operator[]( const std::size_t index ) const noexcept
+	{
+		return m_storage[ ( m_head + index ) % capacity() ];
+	}
+
+	/// Returns the oldest element, the ring must not be empty.
+	[[nodiscard]] const T& front() const noexcept { return m_storage[ m_head ]; }
+
+	/// Returns the newest element, the ring must not be empty.
+	[[nodiscard]] const T& back() const noexcept { return ( *this )[ m_size - 1 ]; }
+
+	/// Removes all elements, keeps the storage and the dropped count.
+	void clear() noexcept
+	{
+		m_head = 0;
+		m_size = 0;
+	}
+
+private:
+	std::vector< T > m_storage;
+	std::size_t m_head{}; //!< Index of the oldest element
+	std::size_t m_size{};
+	std::uint64_t m_dropped{};
+};
+
+} // namespace pbl::utils
+#endif // PBL_UTILS_RING_BUFFER_HPP__
@@ -0,0 +1,151 @@
+// PBL
+#include <i2c/BusController.hpp>
+#include <i2c/EdgeEventLoop.hpp>
+#include <i2c/ADS1015Controller.hpp>
+#include <i2c/SimulatedDevices.hpp>
+#include "EdgeEventSourceStub.hpp"
+
+// C++
+#include <array>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/// Returns a bus with an ADS1015 at 0x48, 0.25V, 0.5V, 0.75V and 1V on the inputs.
+[[nodiscard]] std::unique_ptr< SimulatedBus > makeBus( SimulatedADS1015*& device )
+{
+	auto bus = std::make_unique< SimulatedBus >();
+	device = &bus->attach< SimulatedADS1015 >( 0x48 );
+	device->setInputVoltage( 0, 0.25f );
+	device->setInputVoltage( 1, 0.5f );
+	device->setInputVoltage( 2, 0.75f );
+	device->setInputVoltage( 3, 1.0f );
+	return bus;
+}
+
+} // namespace
+
+TEST( ADS1015ControllerTests, SingleEndedReadWaitsForTheConversion )
+{
+	// Arrange
+	SimulatedADS1015* device{};
+	auto bus = makeBus( device );
+	auto* pBus = bus.get();
+	BusController busController{ std::move( bus ) };
+	ADS1015Controller::SingleShotReader reader{ ADS1015Controller{ busController } };
+
+	// Act
+	const auto code = reader.read( ADS1015Controller::Channel::CH2 );
+
+	// Assert, 2.048V full-scale range at 1600 SPS
+	ASSERT_TRUE( code.has_value() );
+	EXPECT_EQ( *code, 750 );
+	EXPECT_NEAR( ADS1015Controller::toVolts( *code, ADS1015Controller::Gain::FS_2_048V ), 0.75f, 0.001f );
+	EXPECT_GE( pBus->sleptFor(), 625us );
+	EXPECT_EQ( device->registerValue( 0x01 ) & 0x7000, 0x6000 );
+}
+
+TEST( ADS1015ControllerTests, DifferentialReadChecksThePair )
+{
+	// Arrange
+	SimulatedADS1015* device{};
+	BusController busController{ makeBus( device ) };
+	ADS1015Controller::DifferentialReader reader{ ADS1015Controller{ busController } };
+
+	// Act
+	const auto difference = reader.read( ADS1015Controller::Channel::CH0, ADS1015Controller::Channel::CH3 );
+	const auto unsupported = reader.read( ADS1015Controller::Channel::CH1, ADS1015Controller::Channel::CH2 );
+
+	// Assert
+	ASSERT_TRUE( difference.has_value() );
+	EXPECT_EQ( *difference, -750 );
+	ASSERT_FALSE( unsupported.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( unsupported.error() ), utils::ErrorCode::INVALID_ARGUMENT );
+}
+
+TEST( ADS1015ControllerTests, ContinuousReaderFollowsTheInput )
+{
+	// Arrange
+	SimulatedADS1015* device{};
+	BusController busController{ makeBus( device ) };
+	ADS1015Controller::ContinuousReader reader{ ADS1015Controller{ busController },
+												ADS1015Controller::Channel::CH1 };
+
+	// Act
+	const auto first = reader.read();
+	device->setInputVoltage( 1, 1.5f );
+	const auto second = reader.read();
+	const auto continuousConfig = device->registerValue( 0x01 );
+	auto controller = reader.release();
+
+	// Assert, ALERT/RDY signals conversion ready while running, the comparator is disabled after
+	ASSERT_TRUE( first.has_value() );
+	EXPECT_EQ( *first, 500 );
+	ASSERT_TRUE( second.has_value() );
+	EXPECT_EQ( *second, 1500 );
+	EXPECT_EQ( continuousConfig & 0x0103, 0x0000 );
+	EXPECT_EQ( device->registerValue( 0x03 ), 0x8000 );
+	EXPECT_FALSE( controller.continuous() );
+	EXPECT_EQ( device->registerValue( 0x01 ) & 0x0103, 0x0103 );
+	EXPECT_FALSE( controller.readContinuous().has_value() );
+}
+
+TEST( ADS1015ControllerTests, ScanRotatesChannelsOnConversionReady )
+{
+	// Arrange
+	SimulatedADS1015* device{};
+	auto bus = makeBus( device );
+	auto* pBus = bus.get();
+	BusController busController{ std::move( bus ) };
+	ADS1015Controller ads1015{ busController };
+	EdgeEventSourceStub alert;
+	EdgeEventLoop loop{ alert };
+	alert.fire(); // Conversion of the first channel
+
+	using enum ADS1015Controller::Channel;
+	const std::array channels{ CH0, CH2, CH3 };
+	std::vector< ADS1015Controller::ScanSample > samples;
+	std::vector< std::uint64_t > transfers;
+
+	// Act
+	const auto scanned = ads1015.scan( loop, channels, [ & ]( const ADS1015Controller::ScanSample& sample ) {
+		samples.push_back( sample );
+		transfers.push_back( pBus->transferCount() );
+		alert.fire();
+		return samples.size() < 5;
+	} );
+
+	// Assert, one transfer per sample
+	ASSERT_TRUE( scanned.has_value() );
+	ASSERT_EQ( samples.size(), 5u );
+	EXPECT_EQ( samples[ 0 ].channel, CH0 );
+	EXPECT_EQ( samples[ 0 ].code, 250 );
+	EXPECT_EQ( samples[ 1 ].channel, CH2 );
+	EXPECT_NEAR( samples[ 1 ].volts, 0.75f, 0.001f );
+	EXPECT_EQ( samples[ 2 ].channel, CH3 );
+	EXPECT_EQ( samples[ 2 ].code, 1000 );
+	EXPECT_EQ( samples[ 3 ].channel, CH0 );
+	EXPECT_EQ( samples[ 4 ].channel, CH2 );
+	EXPECT_EQ( samples[ 4 ].code, 750 );
+	for( std::size_t i = 1; i < transfers.size(); ++i )
+	{
+		EXPECT_EQ( transfers[ i ] - transfers[ i - 1 ], 1u );
+	}
+
+	EXPECT_EQ( device->registerValue( 0x01 ) & 0x0003, 0x0003 );
+	EXPECT_EQ( pBus->sleptFor(), 0us );
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,278 @@
+// PBL
+#include <i2c/Controllers.hpp>
+#include <i2c/TMP102Controller.hpp>
+#include <i2c/SHT31Controller.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <new>
+#include <atomic>
+#include <memory>
+#include <cstdlib>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::atomic< std::size_t > g_allocations{};
+
+} // namespace
+
+// Every heap allocation made by this test binary goes through the counting operators below, they replace the
+// global ones for the whole executable, which is why these tests are built as test_i2c_allocations of their own
+void* operator new( std::size_t size )
+{
+	g_allocations.fetch_add( 1, std::memory_order_relaxed );
+
+	if( void* ptr = std::malloc( size == 0 ? 1 : size ) )
+	{
+		return ptr;
+	}
+
+	throw std::bad_alloc{};
+}
+
+// GCC flags free() on memory from operator new once the replacements are inlined, they pair up here
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete( void* ptr ) noexcept
+{
+	std::free( ptr );
+}
+
+void operator delete( void* ptr, std::size_t ) noexcept
+{
+	std::free( ptr );
+}
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+constexpr int kSamples{ 100 };
+
+/// Runs one warm-up sample, then returns the number of allocations made by kSamples further samples.
+template < typename Sample >
+[[nodiscard]] std::size_t allocationsPerSamples( Sample&& sample )
+{
+	sample();
+
+	const auto before = g_allocations.load( std::memory_order_relaxed );
+	for( int i = 0; i < kSamples; ++i )
+	{
+		sample();
+	}
+
+	return g_allocations.load( std::memory_order_relaxed ) - before;
+}
+
+} // namespace
+
+TEST( AllocationTests, CountingOperatorNewIsActive )
+{
+	// Arrange
+	const auto before = g_allocations.load( std::memory_order_relaxed );
+
+	// Act
+	auto value = std::make_unique< int >( 42 );
+
+	// Assert
+	EXPECT_EQ( g_allocations.load( std::memory_order_relaxed ) - before, 1u );
+}
+
+TEST( AllocationTests, LM75SampleDoesNotAllocate )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedLM75 >( 0x48 ).setTemperature( 21.5f );
+	BusController busController{ std::move( bus ) };
+	LM75Controller lm75{ busController };
+	bool ok{ true };
+
+	// Act
+	const auto allocations = allocationsPerSamples( [ & ] {
+		ok &= lm75.getTemperatureC().has_value();
+		ok &= lm75.setPowerMode( LM75Controller::NORMAL ).has_value();
+	} );
+
+	// Assert
+	EXPECT_TRUE( ok );
+	EXPECT_EQ( allocations, 0u );
+}
+
+TEST( AllocationTests, TMP102SampleDoesNotAllocate )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedTMP102 >( 0x48 ).setTemperature( 21.5f );
+	BusController busController{ std::move( bus ) };
+	TMP102Controller tmp102{ busController };
+	bool ok{ true };
+
+	// Act
+	const auto allocations = allocationsPerSamples( [ & ] {
+		ok &= tmp102.getTemperatureC().has_value();
+		ok &= tmp102.triggerOneShot();
+	} );
+
+	// Assert
+	EXPECT_TRUE( ok );
+	EXPECT_EQ( allocations, 0u );
+}
+
+TEST( AllocationTests, SHT31SampleDoesNotAllocate )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedSHT31 >( 0x44 );
+	BusController busController{ std::move( bus ) };
+	SHT31Controller sht31{ busController };
+	bool ok{ true };
+
+	// Act
+	const auto allocations = allocationsPerSamples( [ & ] {
+		ok &= sht31.triggerMeasurement().has_value();
+		ok &= sht31.getTemperatureC().has_value();
+		ok &= sht31.triggerMeasurement().has_value();
+		ok &= sht31.getHumidity().has_value();
+	} );
+
+	// Assert
+	EXPECT_TRUE( ok );
+	EXPECT_EQ( allocations, 0u );
+}
+
+TEST( AllocationTests, BMP180SampleDoesNotAllocate )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedBMP180 >( 0x77 );
+	BusController busController{ std::move( bus ) };
+	BMP180Controller bmp180{ busController };
+	bool ok{ true };
+
+	// Act
+	const auto allocations = allocationsPerSamples( [ & ] {
+		ok &= bmp180.getTrueTemperatureC().has_value();
+		ok &= bmp180.getTruePressurePa().has_value();
+	} );
+
+	// Assert
+	EXPECT_TRUE( ok );
+	EXPECT_EQ( allocations, 0u );
+}
+
+TEST( AllocationTests, MPU6050SampleDoesNotAllocate )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedMPU6050 >( 0x68 ).setAccelerometer( 0, 0, 16384 );
+	BusController busController{ std::move( bus ) };
+	MPU6050Controller mpu6050{ busController };
+	bool ok{ true };
+
+	// Act
+	const auto allocations = allocationsPerSamples( [ & ] { ok &= mpu6050.angles().has_value(); } );
+
+	// Assert
+	EXPECT_TRUE( ok );
+	EXPECT_EQ( allocations, 0u );
+}
+
+TEST( AllocationTests, ADS1015SampleDoesNotAllocate )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedADS1015 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	ADS1015Controller ads1015{ busController };
+	ASSERT_TRUE( ads1015.setGain( ADS1015Controller::Gain::FS_1_024V ).has_value() );
+	bool ok{ true };
+
+	// Act, single-shot conversions and continuous mode both read the conversion register
+	const auto singleShotAllocations = allocationsPerSamples( [ & ] {
+		ok &= ads1015.readSingleEnded( ADS1015Controller::Channel::CH1 ).has_value();
+		ok &= ads1015.readDifferential( ADS1015Controller::Channel::CH0, ADS1015Controller::Channel::CH1 ).has_value();
+	} );
+
+	ASSERT_TRUE( ads1015.startContinuous( ADS1015Controller::Channel::CH2 ).has_value() );
+	const auto continuousAllocations =
+		allocationsPerSamples( [ & ] { ok &= ads1015.readContinuous().has_value(); } );
+
+	// Assert
+	EXPECT_TRUE( ok );
+	EXPECT_EQ( singleShotAllocations, 0u );
+	EXPECT_EQ( continuousAllocations, 0u );
+}
+
+TEST( AllocationTests, PCA9685SampleDoesNotAllocate )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedPCA9685 >( 0x40 );
+	BusController busController{ std::move( bus ) };
+	PCA9685Controller pca9685{ busController };
+	bool ok{ true };
+
+	// Act
+	const auto allocations = allocationsPerSamples( [ & ] {
+		ok &= pca9685.setPWMPercentage( PCA9685Controller::CH3, 50.0f ).has_value();
+		ok &= pca9685.setFullOff( PCA9685Controller::CH4, true ).has_value();
+	} );
+
+	// Assert
+	EXPECT_TRUE( ok );
+	EXPECT_EQ( allocations, 0u );
+}
+
+TEST( AllocationTests, MCP23017SampleDoesNotAllocate )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedMCP23017 >( 0x20 );
+	BusController busController{ std::move( bus ) };
+	MCP23017Controller mcp23017{ busController };
+	auto pin = mcp23017.portA().pin( MCP23017Controller::Port::Pins::PIN_1 );
+	ASSERT_TRUE( pin.setMode( MCP23017Controller::Port::PinMode::OUTPUT ).has_value() );
+	bool ok{ true };
+
+	// Act
+	const auto allocations = allocationsPerSamples( [ & ] {
+		ok &= pin.switchPinState().has_value();
+		ok &= mcp23017.portB().pinStates().has_value();
+	} );
+
+	// Assert
+	EXPECT_TRUE( ok );
+	EXPECT_EQ( allocations, 0u );
+}
+
+TEST( AllocationTests, FailedTransferDoesNotAllocate )
+{
+	// Arrange
+	BusController busController{ std::make_unique< SimulatedBus >() };
+	LM75Controller lm75{ busController };
+	bool failed{ true };
+
+	// Act
+	const auto allocations = allocationsPerSamples( [ & ] { failed &= !lm75.getTemperatureC().has_value(); } );
+
+	// Assert
+	EXPECT_TRUE( failed );
+	EXPECT_EQ( allocations, 0u );
+	EXPECT_EQ( busController.lastErrorCode(), utils::ErrorCode::NACK_RECEIVED );
+	EXPECT_FALSE( busController.lastError().empty() );
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,249 @@
+// PBL
+#include <i2c/AsyncExecutor.hpp>
+#include <i2c/BusController.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <array>
+#include <future>
+#include <memory>
+#include <vector>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+/// Keeps the bus thread busy until released, so that the following requests end up in one batch.
+class BusBlocker
+{
+public:
+	explicit BusBlocker( AsyncExecutor& executor )
+	{
+		executor.write( 0x48, 0x01, 0x00, [ this ]( auto ) {
+			m_started.set_value();
+			m_release.get_future().wait();
+		} );
+
+		m_started.get_future().wait();
+	}
+
+	void release() { m_release.set_value(); }
+
+private:
+	std::promise< void > m_started;
+	std::promise< void > m_release;
+};
+
+} // namespace
+
+TEST( AsyncExecutorTests, ReadCompletesThroughFuture )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedLM75 >( 0x48 ).setTemperature( 21.5f );
+	BusController busController{ std::move( bus ) };
+	AsyncExecutor executor{ busController };
+
+	// Act
+	auto rslt = executor.read( 0x48, 0x00, 2 ).get();
+
+	// Assert
+	ASSERT_TRUE( rslt.has_value() );
+	EXPECT_EQ( rslt.value(), ( std::vector< std::uint8_t >{ 0x15, 0x80 } ) );
+}
+
+TEST( AsyncExecutorTests, WriteCallbackReportsOutcome )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& expander = bus->attach< SimulatedMCP23017 >( 0x20 );
+	BusController busController{ std::move( bus ) };
+	AsyncExecutor executor{ busController };
+	std::promise< bool > outcome;
+
+	// Act
+	executor.write( 0x20, 0x00, 0x0F, [ & ]( auto rslt ) { outcome.set_value( rslt.has_value() ); } );
+
+	// Assert
+	EXPECT_TRUE( outcome.get_future().get() );
+	EXPECT_EQ( expander.registerValue( 0x00 ), 0x0F );
+}
+
+TEST( AsyncExecutorTests, MissingDeviceFailsRequest )
+{
+	// Arrange
+	BusController busController{ std::make_unique< SimulatedBus >() };
+	AsyncExecutor executor{ busController };
+
+	// Act
+	auto rslt = executor.read( 0x48, 0x00, 2 ).get();
+
+	// Assert
+	EXPECT_FALSE( rslt.has_value() );
+	EXPECT_EQ( executor.statistics().failed, 1u );
+}
+
+TEST( AsyncExecutorTests, MissingDeviceFailsOnlyItsOwnRequests )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedLM75 >( 0x48 ).setTemperature( 20.0f );
+	BusController busController{ std::move( bus ) };
+	AsyncExecutor executor{ busController };
+
+	BusBlocker blocker{ executor };
+	const auto transfersBefore = pBus->transferCount();
+
+	// Act
+	auto temperature = executor.read( 0x48, 0x00, 2 );
+	auto missing = executor.read( 0x77, 0xAA, 2 );
+	blocker.release();
+	executor.waitIdle();
+
+	// Assert, the shared transfer failed and both reads were retried alone
+	const auto temperatureRslt = temperature.get();
+	const auto missingRslt = missing.get();
+	ASSERT_TRUE( temperatureRslt.has_value() );
+	EXPECT_EQ( temperatureRslt.value()[ 0 ], 20 );
+	ASSERT_FALSE( missingRslt.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( missingRslt.error() ), utils::ErrorCode::NACK_RECEIVED );
+	EXPECT_EQ( pBus->transferCount() - transfersBefore, 3u );
+	EXPECT_EQ( executor.statistics().failed, 1u );
+}
+
+TEST( AsyncExecutorTests, NonIdempotentReadIsNotRepeated )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedLM75 >( 0x48 );
+	bus->attach< SimulatedMPU6050 >( 0x68 );
+	BusController busController{ std::move( bus ) };
+	AsyncExecutor executor{ busController };
+
+	BusBlocker blocker{ executor };
+	const auto transfersBefore = pBus->transferCount();
+
+	// Act, INT_STATUS clears on read, the shared transfer may have read it already
+	auto status = executor.read( 0x68, 0x3A, 1, Idempotency::NON_IDEMPOTENT );
+	auto missing = executor.read( 0x77, 0xAA, 2 );
+	blocker.release();
+	executor.waitIdle();
+
+	// Assert, only the read of the missing device was retried
+	const auto statusRslt = status.get();
+	ASSERT_FALSE( statusRslt.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( statusRslt.error() ), utils::ErrorCode::NACK_RECEIVED );
+	EXPECT_FALSE( missing.get().has_value() );
+	EXPECT_EQ( pBus->transferCount() - transfersBefore, 2u );
+	EXPECT_EQ( executor.statistics().failed, 2u );
+}
+
+TEST( AsyncExecutorTests, EmptyReadIsRejected )
+{
+	// Arrange
+	BusController busController{ std::make_unique< SimulatedBus >() };
+	AsyncExecutor executor{ busController };
+
+	// Act
+	auto rslt = executor.read( 0x48, 0x00, 0 ).get();
+
+	// Assert
+	ASSERT_FALSE( rslt.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( rslt.error() ), utils::ErrorCode::INVALID_ARGUMENT );
+}
+
+TEST( AsyncExecutorTests, QueuedRequestsShareOneTransfer )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedLM75 >( 0x48 ).setTemperature( 20.0f );
+	bus->attach< SimulatedMPU6050 >( 0x68 ).setAccelerometer( 1, 2, 3 );
+	BusController busController{ std::move( bus ) };
+	AsyncExecutor executor{ busController, { .coalesce = false } };
+
+	BusBlocker blocker{ executor };
+	const auto transfersBefore = pBus->transferCount();
+
+	// Act
+	auto temperature = executor.read( 0x48, 0x00, 2 );
+	auto accel = executor.read( 0x68, 0x3B, 6 );
+	blocker.release();
+	executor.waitIdle();
+
+	// Assert
+	EXPECT_EQ( pBus->transferCount() - transfersBefore, 1u );
+	EXPECT_EQ( temperature.get().value()[ 0 ], 20 );
+	EXPECT_EQ( accel.get().value()[ 5 ], 3 );
+	EXPECT_EQ( executor.statistics().coalesced, 0u );
+}
+
+TEST( AsyncExecutorTests, AdjacentReadsAreCoalesced )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedLM75 >( 0x48 );
+	auto& imu = bus->attach< SimulatedMPU6050 >( 0x68 );
+	imu.setAccelerometer( 1, 2, 3 );
+	imu.setTemperature( 4 );
+	imu.setGyroscope( 5, 6, 7 );
+	BusController busController{ std::move( bus ) };
+	AsyncExecutor executor{ busController };
+
+	BusBlocker blocker{ executor };
+	const auto messagesBefore = pBus->messageCount();
+
+	// Act, accelerometer, temperature and gyroscope registers are contiguous
+	auto accel = executor.read( 0x68, 0x3B, 6 );
+	auto temperature = executor.read( 0x68, 0x41, 2 );
+	auto gyro = executor.read( 0x68, 0x43, 6 );
+	blocker.release();
+	executor.waitIdle();
+
+	// Assert
+	EXPECT_EQ( pBus->messageCount() - messagesBefore, 2u ); // One register pointer write + one read
+	EXPECT_EQ( accel.get().value(), ( std::vector< std::uint8_t >{ 0, 1, 0, 2, 0, 3 } ) );
+	EXPECT_EQ( temperature.get().value(), ( std::vector< std::uint8_t >{ 0, 4 } ) );
+	EXPECT_EQ( gyro.get().value(), ( std::vector< std::uint8_t >{ 0, 5, 0, 6, 0, 7 } ) );
+
+	const auto stats = executor.statistics();
+	EXPECT_EQ( stats.coalesced, 2u );
+	EXPECT_EQ( stats.completed, 4u );
+	EXPECT_GE( stats.peakQueueDepth, 3u );
+	EXPECT_EQ( stats.queueDepth, 0u );
+	EXPECT_GE( stats.maxLatency, stats.meanLatency );
+}
+
+TEST( AsyncExecutorTests, DestructorCompletesQueuedRequests )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedLM75 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	std::vector< std::future< utils::Result< std::vector< std::uint8_t > > > > reads;
+
+	// Act
+	{
+		AsyncExecutor executor{ busController };
+		for( int i = 0; i < 100; ++i )
+		{
+			reads.push_back( executor.read( 0x48, 0x00, 2 ) );
+		}
+	}
+
+	// Assert
+	for( auto& read : reads )
+	{
+		EXPECT_TRUE( read.get().has_value() );
+	}
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,271 @@
+// PBL
+#include <i2c/BusController.hpp>
+#include <i2c/BMP180Controller.hpp>
+#include <i2c/CalibrationCache.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <array>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+using namespace std::chrono_literals;
+
+TEST( BMP180ControllerTests, SampleMatchesBlockingReadings )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedBMP180 >( 0x77 );
+	BusController busController{ std::move( bus ) };
+	BMP180Controller bmp180{ busController, BMP180Controller::DEFAULT, BMP180Controller::ULTRA_LOW_POWER };
+	bmp180.setCompletion( BMP180Controller::Completion::EOC );
+
+	// Act
+	ASSERT_TRUE( bmp180.startSample().has_value() );
+	const auto temperatureDone = bmp180.pollSample(); // Starts the pressure conversion
+	const auto pressureDone = bmp180.pollSample();
+
+	// Assert
+	ASSERT_TRUE( temperatureDone.has_value() );
+	EXPECT_FALSE( temperatureDone->has_value() );
+	ASSERT_TRUE( pressureDone.has_value() );
+	ASSERT_TRUE( pressureDone->has_value() );
+	EXPECT_NEAR( ( *pressureDone )->temperatureC, 15.0f, 1e-4f );
+	EXPECT_NEAR( ( *pressureDone )->pressurePa, 69964.0f, 1.0f );
+	EXPECT_FALSE( bmp180.conversionDeadline().has_value() );
+}
+
+TEST( BMP180ControllerTests, DeadlineCompletionWaitsWithoutBusTraffic )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedBMP180 >( 0x77 );
+	BusController busController{ std::move( bus ) };
+	BMP180Controller bmp180{ busController, BMP180Controller::DEFAULT, BMP180Controller::ULTRA_HIGH_RESOLUTION };
+	ASSERT_TRUE( bmp180.startSample().has_value() );
+	const auto transfers = pBus->transferCount();
+
+	// Act
+	const auto early = bmp180.pollSample();
+	const auto afterEarlyPoll = pBus->transferCount();
+
+	std::optional< BMP180Controller::Sample > sample;
+	while( !sample )
+	{
+		const auto deadline = bmp180.conversionDeadline();
+		ASSERT_TRUE( deadline.has_value() );
+		std::this_thread::sleep_until( *deadline );
+
+		auto rslt = bmp180.pollSample();
+		ASSERT_TRUE( rslt.has_value() );
+		sample = *rslt;
+	}
+
+	// Assert
+	ASSERT_TRUE( early.has_value() );
+	EXPECT_FALSE( early->has_value() );
+	EXPECT_EQ( afterEarlyPoll, transfers );
+	EXPECT_NEAR( sample->temperatureC, 15.0f, 1e-4f );
+	EXPECT_EQ( pBus->sleptFor(), 0us );
+}
+
+TEST( BMP180ControllerTests, RecentTemperatureIsReused )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedBMP180 >( 0x77 );
+	BusController busController{ std::move( bus ) };
+	BMP180Controller bmp180{ busController, BMP180Controller::DEFAULT, BMP180Controller::ULTRA_LOW_POWER };
+	bmp180.setCompletion( BMP180Controller::Completion::EOC );
+	bmp180.setTemperatureInterval( 1h );
+
+	ASSERT_TRUE( bmp180.startSample().has_value() );
+	ASSERT_TRUE( bmp180.pollSample().has_value() );
+	ASSERT_TRUE( bmp180.pollSample().has_value() );
+	const auto transfers = pBus->transferCount();
+
+	// Act
+	ASSERT_TRUE( bmp180.startSample().has_value() );
+	const auto sample = bmp180.pollSample();
+
+	// Assert, one pressure conversion: the command write and the output read
+	ASSERT_TRUE( sample.has_value() );
+	ASSERT_TRUE( sample->has_value() );
+	EXPECT_NEAR( ( *sample )->pressurePa, 69964.0f, 1.0f );
+	EXPECT_EQ( pBus->transferCount() - transfers, 2u );
+}
+
+TEST( BMP180ControllerTests, OneThreadInterleavesSensors )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedBMP180 >( 0x77 );
+	bus->attach< SimulatedBMP180 >( 0x76 ).setUncompensatedPressure( 24000 );
+	BusController busController{ std::move( bus ) };
+	std::array< BMP180Controller, 2 > sensors{ BMP180Controller{ busController, BMP180Controller::DEFAULT },
+											   BMP180Controller{ busController, BMP180Controller::ALTERNATIVE } };
+	std::array< int, 2 > samples{};
+
+	for( auto& sensor : sensors )
+	{
+		ASSERT_TRUE( sensor.startSample( true ).has_value() );
+	}
+
+	// Act
+	while( std::ranges::min( samples ) < 3 )
+	{
+		const auto deadline = std::min( *sensors[ 0 ].conversionDeadline(), *sensors[ 1 ].conversionDeadline() );
+		std::this_thread::sleep_until( deadline );
+
+		for( std::size_t i = 0; i < sensors.size(); ++i )
+		{
+			const auto rslt = sensors[ i ].pollSample();
+			ASSERT_TRUE( rslt.has_value() );
+			samples[ i ] += rslt->has_value() ? 1 : 0;
+		}
+	}
+
+	// Assert, continuous sampling keeps both sensors converting
+	EXPECT_TRUE( sensors[ 0 ].conversionDeadline().has_value() );
+	EXPECT_TRUE( sensors[ 1 ].conversionDeadline().has_value() );
+}
+
+TEST( BMP180ControllerTests, SampleStateIsChecked )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedBMP180 >( 0x77 );
+	BusController busController{ std::move( bus ) };
+	BMP180Controller bmp180{ busController };
+
+	// Act
+	const auto notStarted = bmp180.pollSample();
+	ASSERT_TRUE( bmp180.startSample().has_value() );
+	const auto started = bmp180.startSample();
+	const auto blocking = bmp180.getTruePressurePa();
+	bmp180.cancelSample();
+
+	// Assert
+	ASSERT_FALSE( notStarted.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( notStarted.error() ), utils::ErrorCode::UNSUPPORTED_OPERATION );
+	ASSERT_FALSE( started.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( started.error() ), utils::ErrorCode::BUS_BUSY );
+	EXPECT_FALSE( blocking.has_value() );
+	EXPECT_TRUE( bmp180.getTruePressurePa().has_value() );
+}
+
+TEST( BMP180ControllerTests, CalibrationIsReadInOneBurst )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedBMP180 >( 0x77 );
+	BusController busController{ std::move( bus ) };
+
+	// Act
+	BMP180Controller bmp180{ busController };
+
+	// Assert
+	EXPECT_TRUE( bmp180.calibrated() );
+	EXPECT_EQ( pBus->transferCount(), 1u );
+}
+
+TEST( BMP180ControllerTests, InvalidCalibrationIsReloaded )
+{
+	// Arrange, the datasheet example coefficients
+	constexpr std::array< std::uint8_t, 22 > kCalibration{ 0x01, 0x98, 0xFF, 0xB8, 0xC7, 0xD1, 0x7F, 0xE5,
+														   0x7F, 0xF5, 0x5A, 0x71, 0x18, 0x2E, 0x00, 0x04,
+														   0x80, 0x00, 0xDD, 0xF9, 0x0B, 0x34 };
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& device = bus->attach< SimulatedBMP180 >( 0x77 );
+	device.setCalibration( std::array< std::uint8_t, 22 >{} );
+	BusController busController{ std::move( bus ) };
+	BMP180Controller bmp180{ busController };
+
+	// Act
+	const auto uncalibrated = bmp180.getTrueTemperatureC();
+	device.setCalibration( kCalibration );
+	const auto calibrated = bmp180.getTrueTemperatureC();
+
+	// Assert
+	ASSERT_FALSE( uncalibrated.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( uncalibrated.error() ), utils::ErrorCode::FAILED_TO_READ );
+	ASSERT_TRUE( calibrated.has_value() );
+	EXPECT_NEAR( *calibrated, 15.0f, 1e-4f );
+	EXPECT_TRUE( bmp180.calibrated() );
+}
+
+TEST( BMP180ControllerTests, CachedCalibrationSkipsTheBurstRead )
+{
+	// Arrange
+	const auto directory = std::filesystem::temp_directory_path() / "pbl-bmp180-calibration";
+	std::filesystem::remove_all( directory );
+	CalibrationCache cache{ directory };
+
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedBMP180 >( 0x77 );
+	BusController busController{ std::move( bus ) };
+
+	// Act
+	const BMP180Controller first{ busController, cache };
+	const auto firstTransfers = pBus->transferCount();
+	BMP180Controller second{ busController, cache };
+	const auto secondTransfers = pBus->transferCount() - firstTransfers;
+
+	// Assert, the chip id and the calibration block, then only the chip id
+	EXPECT_TRUE( first.calibrated() );
+	EXPECT_EQ( firstTransfers, 2u );
+	EXPECT_EQ( secondTransfers, 1u );
+	EXPECT_TRUE( std::filesystem::exists( cache.path( { "BMP180", "sim-i2c", 0x77 } ) ) );
+
+	const auto temperature = second.getTrueTemperatureC();
+	ASSERT_TRUE( temperature.has_value() );
+	EXPECT_NEAR( *temperature, 15.0f, 1e-4f );
+}
+
+TEST( BMP180ControllerTests, ReplacedSensorIgnoresTheCachedCalibration )
+{
+	// Arrange, the datasheet example coefficients with AC1 = 408 changed to 409
+	constexpr std::array< std::uint8_t, 22 > kOtherCalibration{ 0x01, 0x99, 0xFF, 0xB8, 0xC7, 0xD1, 0x7F, 0xE5,
+																 0x7F, 0xF5, 0x5A, 0x71, 0x18, 0x2E, 0x00, 0x04,
+																 0x80, 0x00, 0xDD, 0xF9, 0x0B, 0x34 };
+	const auto directory = std::filesystem::temp_directory_path() / "pbl-bmp180-replaced";
+	std::filesystem::remove_all( directory );
+	CalibrationCache cache{ directory };
+
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	auto& device = bus->attach< SimulatedBMP180 >( 0x77 );
+	BusController busController{ std::move( bus ) };
+	const BMP180Controller original{ busController, cache };
+
+	// Act, the same part at the same address, with its own calibration
+	device.setCalibration( kOtherCalibration );
+	const auto transfersBefore = pBus->transferCount();
+	const BMP180Controller replacement{ busController, cache };
+	const auto replacementTransfers = pBus->transferCount() - transfersBefore;
+
+	std::array< std::uint8_t, 22 > stored{};
+	const bool loaded = cache.load( { "BMP180", "sim-i2c", 0x77 }, 0x55, stored );
+
+	// Assert, the fingerprint mismatched, the block was read and replaced the entry
+	EXPECT_TRUE( original.calibrated() );
+	EXPECT_TRUE( replacement.calibrated() );
+	EXPECT_EQ( replacementTransfers, 2u );
+	ASSERT_TRUE( loaded );
+	EXPECT_EQ( stored, kOtherCalibration );
+}
+
+} // namespace pbl::i2c
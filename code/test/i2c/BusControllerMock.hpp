@@ -1,8 +1,28 @@
 #ifndef PBL_TEST_I2C_BUS_CONTROLLER_MOCK_HPP__
 #define PBL_TEST_I2C_BUS_CONTROLLER_MOCK_HPP__
 
+// PBL
+#include <i2c/Transport.hpp>
+
+// C++
+#include <span>
+#include <chrono>
+#include <string>
+
+// Third Party
+#include <gmock/gmock.h>
+
 namespace pbl::i2c
 {
 
+class TransportMock : public Transport
+{
+public:
+	MOCK_METHOD( const std::string&, name, (), ( const, noexcept, override ) );
+	MOCK_METHOD( bool, isOpen, (), ( const, noexcept, override ) );
+	MOCK_METHOD( int, transfer, ( std::span< Transaction::Message > messages ), ( noexcept, override ) );
+	MOCK_METHOD( void, sleep, ( const std::chrono::microseconds sleepTime ), ( override ) );
+};
+
 } // namespace pbl::i2c
 #endif // PBL_TEST_I2C_BUS_CONTROLLER_MOCK_HPP__
@@ -1,7 +1,159 @@
+// PBL
+#include "BusControllerMock.hpp"
 #include <i2c/BusController.hpp>
 
+// C++
+#include <array>
+#include <memory>
+#include <string>
+#include <cstring>
+
+// C
+extern "C" {
+#include <errno.h>
+}
+
+// Third Party
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
 namespace pbl::i2c
 {
 
-} // namespace pbl::i2c
+using ::testing::_;
+using ::testing::Return;
+using ::testing::ReturnRef;
+using ::testing::NiceMock;
+
+namespace
+{
+
+/// Creates a bus controller on top of a mock transport, the mock stays owned by the controller.
+std::unique_ptr< BusController > makeController( NiceMock< TransportMock >*& pTransport, const bool open = true )
+{
+	static const std::string kName{ "mock-i2c" };
+
+	auto transport = std::make_unique< NiceMock< TransportMock > >();
+	ON_CALL( *transport, name() ).WillByDefault( ReturnRef( kName ) );
+	ON_CALL( *transport, isOpen() ).WillByDefault( Return( open ) );
+
+	pTransport = transport.get();
+	return std::make_unique< BusController >( std::move( transport ) );
+}
+
+} // namespace
+
+TEST( BusControllerTests, ClosedTransportRejectsTransfers )
+{
+	// Arrange
+	NiceMock< TransportMock >* pTransport{};
+	auto busController = makeController( pTransport, false );
+	std::uint8_t value{};
+
+	// Assert
+	EXPECT_CALL( *pTransport, transfer( _ ) ).Times( 0 );
+	EXPECT_FALSE( busController->isOpen() );
+	EXPECT_EQ( busController->bus(), "mock-i2c" );
+	EXPECT_FALSE( busController->read( 0x48, 0x00, value ) );
+}
+
+TEST( BusControllerTests, RegisterReadIsPointerWriteFollowedByRead )
+{
+	// Arrange
+	NiceMock< TransportMock >* pTransport{};
+	auto busController = makeController( pTransport );
+	std::array< std::uint8_t, 2 > result{};
+
+	EXPECT_CALL( *pTransport, transfer( _ ) ).WillOnce( []( std::span< Transaction::Message > messages ) {
+		EXPECT_EQ( messages.size(), 2u );
+		EXPECT_EQ( messages[ 0 ].address, 0x48 );
+		EXPECT_FALSE( messages[ 0 ].read );
+		EXPECT_EQ( messages[ 0 ].buffer[ 0 ], 0x05 );
+		EXPECT_TRUE( messages[ 1 ].read );
+		EXPECT_EQ( messages[ 1 ].buffer.size(), 2u );
+
+		messages[ 1 ].buffer[ 0 ] = 0x12;
+		messages[ 1 ].buffer[ 1 ] = 0x34;
+		return 2;
+	} );
+
+	// Act
+	const bool rslt = busController->read( 0x48, 0x05, result );
+
+	// Assert
+	EXPECT_TRUE( rslt );
+	EXPECT_EQ( result[ 0 ], 0x12 );
+	EXPECT_EQ( result[ 1 ], 0x34 );
+}
 
+TEST( BusControllerTests, FailedTransferReportsError )
+{
+	// Arrange
+	NiceMock< TransportMock >* pTransport{};
+	auto busController = makeController( pTransport );
+	EXPECT_CALL( *pTransport, transfer( _ ) ).WillOnce( Return( -ENXIO ) );
+
+	// Act
+	const bool rslt = busController->write( 0x48, 0x01, 0x00 );
+
+	// Assert
+	EXPECT_FALSE( rslt );
+	EXPECT_EQ( busController->lastError(), std::string{ ::strerror( ENXIO ) } );
+}
+
+TEST( BusControllerTests, SubmitMapsErrnoToErrorCode )
+{
+	// Arrange
+	NiceMock< TransportMock >* pTransport{};
+	auto busController = makeController( pTransport );
+	EXPECT_CALL( *pTransport, transfer( _ ) ).WillOnce( Return( -ETIMEDOUT ) );
+
+	Transaction tx;
+	ASSERT_TRUE( tx.write( 0x48, 0x01, 0x00 ) );
+
+	// Act
+	const bool rslt = busController->submit( tx );
+
+	// Assert
+	EXPECT_FALSE( rslt );
+	const auto outcome = tx.result( 0 );
+	ASSERT_FALSE( outcome.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( outcome.error() ), utils::ErrorCode::TIMEOUT );
+}
+
+TEST( BusControllerTests, SubmitReportsOperationsNotTransferred )
+{
+	// Arrange
+	NiceMock< TransportMock >* pTransport{};
+	auto busController = makeController( pTransport );
+	EXPECT_CALL( *pTransport, transfer( _ ) ).WillOnce( Return( 2 ) );
+
+	Transaction tx;
+	std::uint8_t value{};
+	ASSERT_TRUE( tx.read( 0x48, 0x00, value ) );
+	ASSERT_TRUE( tx.write( 0x20, 0x12, 0xFF ) );
+
+	// Act
+	const bool rslt = busController->submit( tx );
+
+	// Assert
+	EXPECT_FALSE( rslt );
+	EXPECT_TRUE( tx.result( 0 ).has_value() );
+	ASSERT_FALSE( tx.result( 1 ).has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( tx.result( 1 ).error() ), utils::ErrorCode::DEVICE_NOT_RESPONDING );
+}
+
+TEST( BusControllerTests, SleepIsDelegatedToTransport )
+{
+	// Arrange
+	NiceMock< TransportMock >* pTransport{};
+	auto busController = makeController( pTransport );
+
+	// Assert
+	EXPECT_CALL( *pTransport, sleep( std::chrono::microseconds{ 2000 } ) ).Times( 1 );
+
+	// Act
+	busController->sleep( std::chrono::milliseconds{ 2 } );
+}
+
+} // namespace pbl::i2c
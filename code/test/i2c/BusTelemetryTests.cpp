@@ -0,0 +1,170 @@
+// PBL
+#include <i2c/Controllers.hpp>
+#include <i2c/BusTelemetry.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <chrono>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+using namespace std::chrono_literals;
+
+TEST( BusTelemetryTests, LatencyBucketsAreLog2 )
+{
+	// Assert
+	EXPECT_EQ( BusTelemetry::bucket( 0ns ), 0u );
+	EXPECT_EQ( BusTelemetry::bucket( 1ns ), 1u );
+	EXPECT_EQ( BusTelemetry::bucket( 1023ns ), 10u );
+	EXPECT_EQ( BusTelemetry::bucket( 1024ns ), 11u );
+	EXPECT_EQ( BusTelemetry::bucket( 1h ), BusTelemetry::kLatencyBuckets - 1 );
+	EXPECT_EQ( BusTelemetry::bucket( -5ns ), 0u );
+}
+
+TEST( BusTelemetryTests, HistogramQuantileReturnsBucketUpperBound )
+{
+	// Arrange
+	BusTelemetry::Histogram histogram;
+	histogram.buckets[ 4 ] = 90; // [8, 16) ns
+	histogram.buckets[ 10 ] = 10; // [512, 1024) ns
+
+	// Assert
+	EXPECT_EQ( histogram.count(), 100u );
+	EXPECT_EQ( histogram.quantile( 0.5 ), 16ns );
+	EXPECT_EQ( histogram.quantile( 0.99 ), 1024ns );
+	EXPECT_EQ( BusTelemetry::Histogram{}.quantile( 0.5 ), 0ns );
+}
+
+TEST( BusTelemetryTests, RecordAccountsEveryAddressedDevice )
+{
+	// Arrange
+	BusTelemetry telemetry;
+	std::array< std::uint8_t, 1 > pointer{ 0x00 };
+	std::array< std::uint8_t, 2 > temperature{};
+	std::array< std::uint8_t, 6 > accel{};
+	std::array messages{ Transaction::Message{ 0x48, false, pointer },
+						 Transaction::Message{ 0x48, true, temperature },
+						 Transaction::Message{ 0x68, false, pointer },
+						 Transaction::Message{ 0x68, true, accel } };
+
+	// Act, the adapter stopped after the second message
+	telemetry.record( messages, 2, utils::ErrorCode::DEVICE_NOT_RESPONDING, 100ns, 300us );
+
+	// Assert
+	const auto lm75 = telemetry.snapshot( 0x48 );
+	const auto imu = telemetry.snapshot( 0x68 );
+	ASSERT_TRUE( lm75.has_value() );
+	ASSERT_TRUE( imu.has_value() );
+	EXPECT_EQ( telemetry.snapshot().size(), 2u );
+
+	EXPECT_EQ( lm75->transfers, 1u );
+	EXPECT_EQ( lm75->bytesWritten, 1u );
+	EXPECT_EQ( lm75->bytesRead, 2u );
+	EXPECT_EQ( imu->bytesWritten, 0u );
+	EXPECT_EQ( imu->bytesRead, 0u );
+	EXPECT_EQ( imu->failures, 1u );
+	EXPECT_EQ( imu->failuresWith( utils::ErrorCode::DEVICE_NOT_RESPONDING ), 1u );
+	EXPECT_EQ( imu->transferLatency.buckets[ BusTelemetry::bucket( 300us ) ], 1u );
+	EXPECT_EQ( imu->lockWait.buckets[ BusTelemetry::bucket( 100ns ) ], 1u );
+	EXPECT_FALSE( telemetry.snapshot( 0x20 ).has_value() );
+}
+
+TEST( BusTelemetryTests, ResetClearsCounters )
+{
+	// Arrange
+	BusTelemetry telemetry;
+	std::array< std::uint8_t, 2 > data{};
+	std::array messages{ Transaction::Message{ 0x40, false, data } };
+	telemetry.record( messages, 1, std::nullopt, 0ns, 1us );
+
+	// Act
+	telemetry.reset();
+
+	// Assert
+	EXPECT_TRUE( telemetry.snapshot().empty() );
+}
+
+TEST( BusTelemetryTests, BusControllerRecordsTransfers )
+{
+	if constexpr( !BusTelemetry::kEnabled )
+	{
+		GTEST_SKIP() << "Built without PBL_I2C_TELEMETRY";
+	}
+
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedLM75 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	LM75Controller lm75{ busController };
+
+	// Act
+	ASSERT_TRUE( lm75.getTemperatureC().has_value() );
+	ASSERT_TRUE( lm75.getTemperatureC().has_value() );
+	std::uint8_t value{};
+	ASSERT_FALSE( busController.read( 0x49, 0x00, value ) );
+
+	// Assert
+	const auto lm75Stats = busController.telemetry( 0x48 );
+	const auto missing = busController.telemetry( 0x49 );
+	ASSERT_TRUE( lm75Stats.has_value() );
+	ASSERT_TRUE( missing.has_value() );
+	EXPECT_EQ( lm75Stats->transfers, 2u );
+	EXPECT_EQ( lm75Stats->bytesWritten, 2u ); // Register pointers
+	EXPECT_EQ( lm75Stats->bytesRead, 4u );
+	EXPECT_EQ( lm75Stats->failures, 0u );
+	EXPECT_EQ( lm75Stats->transferLatency.count(), 2u );
+	EXPECT_EQ( lm75Stats->lockWait.count(), 2u );
+	EXPECT_EQ( missing->failuresWith( utils::ErrorCode::NACK_RECEIVED ), 1u );
+}
+
+TEST( BusTelemetryTests, SnapshotWhileTransferring )
+{
+	if constexpr( !BusTelemetry::kEnabled )
+	{
+		GTEST_SKIP() << "Built without PBL_I2C_TELEMETRY";
+	}
+
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedLM75 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	constexpr std::uint64_t kReads{ 2000 };
+	std::atomic_bool done{};
+
+	// Act
+	std::thread sampler{ [ & ] {
+		std::uint8_t value{};
+		for( std::uint64_t i = 0; i < kReads; ++i )
+		{
+			[[maybe_unused]] const bool rslt = busController.read( 0x48, 0x01, value );
+		}
+		done = true;
+	} };
+
+	std::uint64_t previous{};
+	bool monotonic{ true };
+	while( !done )
+	{
+		const auto stats = busController.telemetry( 0x48 );
+		const auto transfers = stats ? stats->transfers : 0;
+		monotonic &= transfers >= previous;
+		previous = transfers;
+	}
+
+	sampler.join();
+
+	// Assert
+	EXPECT_TRUE( monotonic );
+	ASSERT_TRUE( busController.telemetry( 0x48 ).has_value() );
+	EXPECT_EQ( busController.telemetry( 0x48 )->transfers, kReads );
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,100 @@
+// PBL
+#include <i2c/CalibrationCache.hpp>
+
+// C++
+#include <array>
+#include <string>
+#include <cstdint>
+#include <fstream>
+#include <filesystem>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+/// Returns an empty directory unique to the running test.
+[[nodiscard]] std::filesystem::path makeDirectory()
+{
+	const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+	auto directory = std::filesystem::temp_directory_path() / "pbl-calibration-cache" / info->name();
+	std::filesystem::remove_all( directory );
+	return directory;
+}
+
+constexpr std::array< std::uint8_t, 4 > kData{ 0x01, 0x98, 0xFF, 0xB8 };
+constexpr CalibrationCache::Key kKey{ "BMP180", "/dev/i2c-1", 0x77 };
+
+} // namespace
+
+TEST( CalibrationCacheTests, StoredEntryIsLoaded )
+{
+	// Arrange
+	CalibrationCache cache{ makeDirectory() };
+	std::array< std::uint8_t, 4 > data{};
+
+	// Act
+	const bool missing = cache.load( kKey, 0x55, data );
+	const bool stored = cache.store( kKey, 0x55, kData );
+	const bool loaded = cache.load( kKey, 0x55, data );
+
+	// Assert
+	EXPECT_FALSE( missing );
+	EXPECT_TRUE( stored );
+	EXPECT_TRUE( loaded );
+	EXPECT_EQ( data, kData );
+	EXPECT_TRUE( cache.erase( kKey ) );
+	EXPECT_FALSE( cache.load( kKey, 0x55, data ) );
+}
+
+TEST( CalibrationCacheTests, EntriesAreKeyedByPartBusAndAddress )
+{
+	// Arrange
+	CalibrationCache cache{ makeDirectory() };
+	ASSERT_TRUE( cache.store( kKey, 0x55, kData ) );
+	std::array< std::uint8_t, 4 > data{};
+
+	// Act
+	const bool otherBus = cache.load( { "BMP180", "/dev/i2c-2", 0x77 }, 0x55, data );
+	const bool otherAddress = cache.load( { "BMP180", "/dev/i2c-1", 0x76 }, 0x55, data );
+	const bool otherPart = cache.load( { "BMP085", "/dev/i2c-1", 0x77 }, 0x55, data );
+
+	// Assert
+	EXPECT_FALSE( otherBus );
+	EXPECT_FALSE( otherAddress );
+	EXPECT_FALSE( otherPart );
+	EXPECT_EQ( cache.path( kKey ).filename(), "BMP180-dev_i2c-1-0x77.cal" );
+}
+
+TEST( CalibrationCacheTests, MismatchedEntriesAreRejected )
+{
+	// Arrange
+	CalibrationCache cache{ makeDirectory() };
+	ASSERT_TRUE( cache.store( kKey, 0x55, kData ) );
+	std::array< std::uint8_t, 4 > data{};
+	std::array< std::uint8_t, 6 > larger{};
+
+	// Act
+	const bool otherChip = cache.load( kKey, 0x58, data );
+	const bool otherSize = cache.load( kKey, 0x55, larger );
+
+	// Corrupt the last data byte
+	{
+		std::fstream file{ cache.path( kKey ), std::ios::binary | std::ios::in | std::ios::out };
+		file.seekp( -1, std::ios::end );
+		file.put( 0x00 );
+	}
+	const bool corrupted = cache.load( kKey, 0x55, data );
+
+	// Assert
+	EXPECT_FALSE( otherChip );
+	EXPECT_FALSE( otherSize );
+	EXPECT_FALSE( corrupted );
+	EXPECT_EQ( data, ( std::array< std::uint8_t, 4 >{} ) ); // Untouched
+}
+
+} // namespace pbl::i2c
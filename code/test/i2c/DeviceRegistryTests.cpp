@@ -0,0 +1,151 @@
+// PBL
+#include <i2c/DeviceRegistry.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <memory>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+/// Returns a bus with an MPU6050, a BMP180, an LM75 and an MCP23017 attached.
+[[nodiscard]] std::unique_ptr< BusController > makeSensorBus()
+{
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedMPU6050 >( 0x68 );
+	bus->attach< SimulatedBMP180 >( 0x77 );
+	bus->attach< SimulatedLM75 >( 0x48 );
+	bus->attach< SimulatedMCP23017 >( 0x20 );
+	return std::make_unique< BusController >( std::move( bus ) );
+}
+
+} // namespace
+
+TEST( DeviceRegistryTests, ScanFindsAttachedDevices )
+{
+	// Arrange
+	auto busController = makeSensorBus();
+
+	// Act
+	const auto devices = DeviceRegistry::scan( *busController );
+
+	// Assert
+	ASSERT_EQ( devices.size(), 4u );
+	EXPECT_EQ( devices[ 0 ].address, 0x20 );
+	EXPECT_EQ( devices[ 0 ].part, Part::MCP23017 );
+	EXPECT_EQ( devices[ 1 ].address, 0x48 );
+	EXPECT_EQ( devices[ 1 ].part, Part::UNKNOWN ); // LM75, TMP102 or ADS1015
+	EXPECT_EQ( devices[ 1 ].candidates.size(), 3u );
+	EXPECT_EQ( devices[ 2 ].address, 0x68 );
+	EXPECT_EQ( devices[ 2 ].part, Part::MPU6050 );
+	EXPECT_EQ( devices[ 3 ].address, 0x77 );
+	EXPECT_EQ( devices[ 3 ].part, Part::BMP180 );
+}
+
+TEST( DeviceRegistryTests, ScanWithoutFingerprintKeepsSharedAddressesUnknown )
+{
+	// Arrange
+	auto busController = makeSensorBus();
+
+	// Act
+	const auto devices =
+		DeviceRegistry::scan( *busController, DiscoveryOptions{ .probe = ProbeMode::READ_BYTE, .fingerprint = false } );
+
+	// Assert
+	ASSERT_EQ( devices.size(), 4u );
+	EXPECT_EQ( devices[ 2 ].part, Part::UNKNOWN ); // MPU6050 or MPU9250
+	EXPECT_EQ( devices[ 3 ].part, Part::BMP180 );
+}
+
+TEST( DeviceRegistryTests, BMP180HasAFixedAddress )
+{
+	// Act
+	const auto alternative = DeviceRegistry::candidates( 0x76 );
+	const auto fixed = DeviceRegistry::candidates( 0x77 );
+
+	// Assert
+	EXPECT_TRUE( alternative.empty() );
+	EXPECT_EQ( fixed, std::vector< Part >{ Part::BMP180 } );
+}
+
+TEST( DeviceRegistryTests, DiscoverScansAllBuses )
+{
+	// Arrange
+	std::vector< std::unique_ptr< BusController > > buses;
+	buses.push_back( makeSensorBus() );
+	auto imuBus = std::make_unique< SimulatedBus >();
+	imuBus->attach< SimulatedMPU6050 >( 0x69 );
+	buses.push_back( std::make_unique< BusController >( std::move( imuBus ) ) );
+	buses.push_back( std::make_unique< BusController >( std::make_unique< SimulatedBus >() ) );
+
+	// Act
+	const auto registry = DeviceRegistry::discover( std::move( buses ) );
+
+	// Assert
+	ASSERT_EQ( registry.buses().size(), 3u );
+	EXPECT_EQ( registry.buses()[ 0 ].devices.size(), 4u );
+	EXPECT_EQ( registry.buses()[ 1 ].devices.size(), 1u );
+	EXPECT_TRUE( registry.buses()[ 2 ].devices.empty() );
+
+	const auto second = registry.find( Part::MPU6050, 1 );
+	ASSERT_TRUE( second.has_value() );
+	EXPECT_EQ( second->first, registry.buses()[ 1 ].controller.get() );
+	EXPECT_EQ( second->second, 0x69 );
+	EXPECT_FALSE( registry.find( Part::MPU6050, 2 ).has_value() );
+}
+
+TEST( DeviceRegistryTests, CreateConstructsDiscoveredControllers )
+{
+	// Arrange
+	std::vector< std::unique_ptr< BusController > > buses;
+	buses.push_back( makeSensorBus() );
+	const auto registry = DeviceRegistry::discover( std::move( buses ) );
+
+	// Act
+	auto mpu6050 = registry.create< MPU6050Controller >();
+	auto bmp180 = registry.create< BMP180Controller >();
+	auto lm75 = DeviceRegistry::create( *registry.buses()[ 0 ].controller, 0x48, Part::LM75 );
+
+	// Assert
+	ASSERT_NE( mpu6050, nullptr );
+	ASSERT_NE( bmp180, nullptr );
+	ASSERT_NE( lm75, nullptr );
+	EXPECT_EQ( mpu6050->address(), 0x68 );
+	EXPECT_TRUE( bmp180->getTrueTemperatureC().has_value() );
+	EXPECT_EQ( registry.create< PCA9685Controller >(), nullptr );
+	EXPECT_EQ( DeviceRegistry::create( *registry.buses()[ 0 ].controller, 0x48, Part::MPU6050 ), nullptr );
+}
+
+TEST( DeviceRegistryTests, EnumerateOrdersAdaptersByBusNumber )
+{
+	// Arrange
+	const auto directory = std::filesystem::temp_directory_path() / "pbl_device_registry_tests";
+	std::filesystem::remove_all( directory );
+	std::filesystem::create_directories( directory );
+	for( const auto* name : { "i2c-10", "i2c-2", "i2c-0", "i2c-dev", "spidev0.0" } )
+	{
+		std::ofstream{ directory / name };
+	}
+
+	// Act
+	const auto adapters = DeviceRegistry::enumerate( directory );
+	std::filesystem::remove_all( directory );
+
+	// Assert
+	ASSERT_EQ( adapters.size(), 3u );
+	EXPECT_EQ( adapters[ 0 ], ( directory / "i2c-0" ).string() );
+	EXPECT_EQ( adapters[ 1 ], ( directory / "i2c-2" ).string() );
+	EXPECT_EQ( adapters[ 2 ], ( directory / "i2c-10" ).string() );
+	EXPECT_TRUE( DeviceRegistry::enumerate( directory ).empty() );
+}
+
+} // namespace pbl::i2c
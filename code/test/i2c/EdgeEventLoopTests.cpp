@@ -0,0 +1,81 @@
+// PBL
+#include <i2c/EdgeEventLoop.hpp>
+#include "EdgeEventSourceStub.hpp"
+
+// C++
+#include <array>
+#include <chrono>
+#include <thread>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+using namespace std::chrono_literals;
+
+TEST( EdgeEventLoopTests, PendingEdgesAreReadInOrder )
+{
+	// Arrange
+	EdgeEventSourceStub line;
+	EdgeEventLoop loop{ line };
+	const auto now = std::chrono::steady_clock::now();
+	line.fire( gpio::Edge::RISING, now );
+	line.fire( gpio::Edge::FALLING, now + 1ms );
+
+	// Act
+	std::array< gpio::EdgeEvent, 4 > events{};
+	const auto count = loop.wait( events, 100ms );
+
+	// Assert
+	ASSERT_TRUE( loop.isOpen() );
+	ASSERT_TRUE( count.has_value() );
+	ASSERT_EQ( *count, 2u );
+	EXPECT_EQ( events[ 0 ].edge, gpio::Edge::RISING );
+	EXPECT_EQ( events[ 0 ].timestamp, now );
+	EXPECT_EQ( events[ 1 ].edge, gpio::Edge::FALLING );
+}
+
+TEST( EdgeEventLoopTests, WaitTimesOut )
+{
+	// Arrange
+	EdgeEventSourceStub line;
+	EdgeEventLoop loop{ line };
+	std::array< gpio::EdgeEvent, 1 > events{};
+
+	// Act
+	const auto count = loop.wait( events, 5ms );
+
+	// Assert
+	ASSERT_FALSE( count.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( count.error() ), utils::ErrorCode::TIMEOUT );
+}
+
+TEST( EdgeEventLoopTests, StopWakesTheWaitingThread )
+{
+	// Arrange
+	EdgeEventSourceStub line;
+	EdgeEventLoop loop{ line };
+	std::array< gpio::EdgeEvent, 1 > events{};
+
+	// Act
+	std::jthread stopper{ [ &loop ] {
+		std::this_thread::sleep_for( 10ms );
+		loop.stop();
+	} };
+	const auto stopped = loop.wait( events );
+	stopper.join();
+
+	loop.reset();
+	line.fire();
+	const auto rearmed = loop.wait( events, 100ms );
+
+	// Assert
+	ASSERT_TRUE( stopped.has_value() );
+	EXPECT_EQ( *stopped, 0u );
+	ASSERT_TRUE( rearmed.has_value() );
+	EXPECT_EQ( *rearmed, 1u );
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,59 @@
+#ifndef PBL_TEST_I2C_EDGE_EVENT_SOURCE_STUB_HPP__
+#define PBL_TEST_I2C_EDGE_EVENT_SOURCE_STUB_HPP__
+
+// PBL
+#include <gpio/EdgeEvent.hpp>
+
+// C++
+#include <span>
+#include <chrono>
+#include <cstddef>
+
+// C
+extern "C" {
+#include <fcntl.h>
+#include <unistd.h>
+}
+
+namespace pbl::i2c
+{
+
+/// An interrupt line backed by a pipe, fire queues an edge as the kernel would on a GPIO interrupt.
+class EdgeEventSourceStub final : public gpio::EdgeEventSource
+{
+public:
+	EdgeEventSourceStub() { [[maybe_unused]] const auto rslt = ::pipe2( m_pipe, O_CLOEXEC | O_NONBLOCK ); }
+
+	~EdgeEventSourceStub() override
+	{
+		::close( m_pipe[ 0 ] );
+		::close( m_pipe[ 1 ] );
+	}
+
+	[[nodiscard]] int fd() const noexcept override { return m_pipe[ 0 ]; }
+
+	[[nodiscard]] Result< std::size_t > readEvents( std::span< gpio::EdgeEvent > events ) override
+	{
+		const auto size = ::read( m_pipe[ 0 ], events.data(), events.size_bytes() );
+		if( size < 0 )
+		{
+			return utils::MakeError( utils::ErrorCode::FAILED_TO_READ );
+		}
+
+		return utils::MakeSuccess( static_cast< std::size_t >( size ) / sizeof( gpio::EdgeEvent ) );
+	}
+
+	/// Queues an edge, thread-safe.
+	void fire( const gpio::Edge edge = gpio::Edge::RISING,
+			   const std::chrono::steady_clock::time_point timestamp = std::chrono::steady_clock::now() ) const
+	{
+		const gpio::EdgeEvent event{ .edge = edge, .timestamp = timestamp };
+		[[maybe_unused]] const auto rslt = ::write( m_pipe[ 1 ], &event, sizeof( event ) );
+	}
+
+private:
+	int m_pipe[ 2 ]{ -1, -1 };
+};
+
+} // namespace pbl::i2c
+#endif // PBL_TEST_I2C_EDGE_EVENT_SOURCE_STUB_HPP__
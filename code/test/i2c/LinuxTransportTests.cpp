@@ -0,0 +1,195 @@
+// PBL
+#include <i2c/LinuxTransport.hpp>
+#include <i2c/BusController.hpp>
+
+// C++
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Third Party
+#include <gtest/gtest.h>
+
+// C
+extern "C" {
+#include <linux/i2c.h>
+}
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+using Message = Transaction::Message;
+using Path = LinuxTransport::Path;
+
+constexpr std::uint64_t kSmbusFuncs{ I2C_FUNC_I2C | I2C_FUNC_SMBUS_BYTE_DATA | I2C_FUNC_SMBUS_WORD_DATA |
+									 I2C_FUNC_SMBUS_I2C_BLOCK };
+
+/// Records the path LinuxTransport would select for every transfer of a BusController, nothing reaches a bus.
+class PathRecorder final : public Transport
+{
+public:
+	explicit PathRecorder( std::vector< Path >& paths )
+		: m_paths{ paths }
+	{ }
+
+	[[nodiscard]] const std::string& name() const noexcept override { return m_name; }
+	[[nodiscard]] bool isOpen() const noexcept override { return true; }
+
+	[[nodiscard]] int transfer( std::span< Transaction::Message > messages ) noexcept override
+	{
+		m_paths.push_back( LinuxTransport::selectPath( kSmbusFuncs, messages ) );
+		return static_cast< int >( messages.size() );
+	}
+
+	void sleep( const std::chrono::microseconds ) override { }
+
+private:
+	const std::string m_name{ "recorder" };
+	std::vector< Path >& m_paths;
+};
+
+} // namespace
+
+TEST( LinuxTransportTests, RegisterReadsUseSmbusBySize )
+{
+	// Arrange
+	std::array< std::uint8_t, 1 > pointer{ 0x3B };
+	std::array< std::uint8_t, 32 > data{};
+	const auto registerRead = [ & ]( const std::size_t size ) {
+		return std::array{ Message{ 0x68, false, pointer }, Message{ 0x68, true, std::span{ data }.first( size ) } };
+	};
+
+	// Assert
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, registerRead( 1 ) ), Path::SMBUS_BYTE_DATA );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, registerRead( 2 ) ), Path::SMBUS_WORD_DATA );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, registerRead( 6 ) ), Path::SMBUS_I2C_BLOCK_DATA );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, registerRead( 32 ) ), Path::SMBUS_I2C_BLOCK_DATA );
+}
+
+TEST( LinuxTransportTests, RegisterWritesUseSmbusBySize )
+{
+	// Arrange
+	std::array< std::uint8_t, 34 > data{};
+	const auto registerWrite = [ & ]( const std::size_t size ) {
+		return std::array{ Message{ 0x40, false, std::span{ data }.first( size + 1 ) } };
+	};
+
+	// Assert
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, registerWrite( 1 ) ), Path::SMBUS_BYTE_DATA );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, registerWrite( 2 ) ), Path::SMBUS_WORD_DATA );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, registerWrite( 4 ) ), Path::SMBUS_I2C_BLOCK_DATA );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, registerWrite( 33 ) ), Path::RDWR );
+}
+
+TEST( LinuxTransportTests, MissingFunctionalityFallsBackToRdwr )
+{
+	// Arrange
+	std::array< std::uint8_t, 1 > pointer{ 0x00 };
+	std::array< std::uint8_t, 2 > word{};
+	std::array< std::uint8_t, 4 > block{};
+	std::array wordRead{ Message{ 0x48, false, pointer }, Message{ 0x48, true, word } };
+	std::array blockRead{ Message{ 0x48, false, pointer }, Message{ 0x48, true, block } };
+
+	// Assert, word reads degrade to a block read before falling back to I2C_RDWR
+	EXPECT_EQ( LinuxTransport::selectPath( I2C_FUNC_I2C | I2C_FUNC_SMBUS_READ_I2C_BLOCK, wordRead ),
+			   Path::SMBUS_I2C_BLOCK_DATA );
+	EXPECT_EQ( LinuxTransport::selectPath( I2C_FUNC_I2C, wordRead ), Path::RDWR );
+	EXPECT_EQ( LinuxTransport::selectPath( I2C_FUNC_I2C | I2C_FUNC_SMBUS_WORD_DATA, blockRead ), Path::RDWR );
+}
+
+TEST( LinuxTransportTests, OtherTransfersUseRdwr )
+{
+	// Arrange
+	std::array< std::uint8_t, 1 > pointer{ 0x00 };
+	std::array< std::uint8_t, 2 > data{};
+	std::array< std::uint8_t, 64 > large{};
+
+	std::array rawRead{ Message{ 0x44, true, data } };
+	std::array command{ Message{ 0x44, false, std::span{ data }.first( 1 ) } };
+	std::array otherDevice{ Message{ 0x48, false, pointer }, Message{ 0x49, true, data } };
+	std::array noStartRead{ Message{ 0x48, false, pointer }, Message{ 0x48, true, data, true } };
+	std::array noStartWrite{ Message{ 0x48, false, pointer }, Message{ 0x48, false, data, true } };
+	std::array largeRead{ Message{ 0x48, false, pointer }, Message{ 0x48, true, large } };
+	std::array transaction{ Message{ 0x48, false, pointer },
+							Message{ 0x48, true, data },
+							Message{ 0x68, false, pointer },
+							Message{ 0x68, true, data } };
+
+	// Assert
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, rawRead ), Path::RDWR );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, command ), Path::RDWR );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, otherDevice ), Path::RDWR );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, noStartRead ), Path::RDWR );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, noStartWrite ), Path::RDWR );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, largeRead ), Path::RDWR );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, transaction ), Path::RDWR );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, std::span< const Message >{} ), Path::RDWR );
+}
+
+TEST( LinuxTransportTests, BusControllerRegisterAccessesUseSmbus )
+{
+	// Arrange
+	std::vector< Path > paths;
+	BusController busController{ std::make_unique< PathRecorder >( paths ) };
+	std::uint8_t byte{};
+	std::array< std::uint8_t, 2 > word{};
+	std::array< std::uint8_t, 6 > block{};
+	const std::array< std::uint8_t, 2 > payload{ 0x12, 0x34 };
+
+	// Act
+	const bool byteRead = busController.read( 0x48, 0x01, byte );
+	const bool wordRead = busController.read( 0x48, 0x00, word );
+	const auto blockRead = busController.read( 0x68, 0x3B, block.data(), static_cast< std::uint16_t >( block.size() ) );
+	const bool byteWrite = busController.write( 0x40, 0x00, std::uint8_t{ 0x20 } );
+	const bool wordWrite = busController.write( 0x48, 0x02, payload );
+
+	// Assert
+	EXPECT_TRUE( byteRead && wordRead && byteWrite && wordWrite );
+	EXPECT_EQ( blockRead, 6 );
+	EXPECT_EQ( paths,
+			   ( std::vector< Path >{ Path::SMBUS_BYTE_DATA,
+									  Path::SMBUS_WORD_DATA,
+									  Path::SMBUS_I2C_BLOCK_DATA,
+									  Path::SMBUS_BYTE_DATA,
+									  Path::SMBUS_WORD_DATA } ) );
+}
+
+TEST( LinuxTransportTests, ProbesAndSingleBytesUseQuickAndByte )
+{
+	// Arrange
+	constexpr std::uint64_t kFuncs{ kSmbusFuncs | I2C_FUNC_SMBUS_QUICK | I2C_FUNC_SMBUS_BYTE };
+	std::array< std::uint8_t, 1 > data{};
+	std::array probe{ Message{ 0x50, false, {} } };
+	std::array readByte{ Message{ 0x50, true, data } };
+	std::array writeByte{ Message{ 0x44, false, data } };
+
+	// Assert
+	EXPECT_EQ( LinuxTransport::selectPath( kFuncs, probe ), Path::SMBUS_QUICK );
+	EXPECT_EQ( LinuxTransport::selectPath( kFuncs, readByte ), Path::SMBUS_BYTE );
+	EXPECT_EQ( LinuxTransport::selectPath( kFuncs, writeByte ), Path::SMBUS_BYTE );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, probe ), Path::RDWR );
+	EXPECT_EQ( LinuxTransport::selectPath( kSmbusFuncs, readByte ), Path::RDWR );
+}
+
+TEST( LinuxTransportTests, MissingDeviceHasNoFunctionality )
+{
+	// Arrange
+	LinuxTransport transport{ "/dev/i2c-does-not-exist" };
+	std::array< std::uint8_t, 2 > data{};
+	std::array messages{ Message{ 0x48, false, data } };
+
+	// Assert
+	EXPECT_FALSE( transport.isOpen() );
+	EXPECT_EQ( transport.functionality(), 0u );
+	EXPECT_EQ( transport.path( messages ), Path::RDWR );
+	EXPECT_FALSE( transport.setPec( 0x48, true ) );
+	EXPECT_TRUE( transport.setPec( 0x48, false ) );
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,243 @@
+// PBL
+#include <i2c/BusController.hpp>
+#include <i2c/EdgeEventLoop.hpp>
+#include <i2c/MCP23017Controller.hpp>
+#include <i2c/SimulatedDevices.hpp>
+#include "EdgeEventSourceStub.hpp"
+
+// C++
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+using Batch = MCP23017Controller::Batch;
+using PinMode = Batch::PinMode;
+using PinState = Batch::PinState;
+
+namespace
+{
+
+/// An INT line delivering one edge per read, the step models the input change that raised it.
+class ScriptedInterruptLine final : public gpio::EdgeEventSource
+{
+public:
+	explicit ScriptedInterruptLine( std::vector< std::function< void() > > steps )
+		: m_steps{ std::move( steps ) }
+	{
+		for( std::size_t i = 0; i < m_steps.size(); ++i )
+		{
+			m_line.fire( gpio::Edge::FALLING );
+		}
+	}
+
+	[[nodiscard]] int fd() const noexcept override { return m_line.fd(); }
+
+	[[nodiscard]] Result< std::size_t > readEvents( std::span< gpio::EdgeEvent > events ) override
+	{
+		const auto count = m_line.readEvents( events.first( 1 ) );
+		if( count && *count == 1 && m_next < m_steps.size() )
+		{
+			m_steps[ m_next++ ]();
+		}
+
+		return count;
+	}
+
+private:
+	EdgeEventSourceStub m_line;
+	std::vector< std::function< void() > > m_steps;
+	std::size_t m_next{};
+};
+
+} // namespace
+
+TEST( MCP23017ControllerTests, BatchUpdatesBothPortsInConstantTransfers )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	auto& expander = bus->attach< SimulatedMCP23017 >( 0x20 );
+	BusController busController{ std::move( bus ) };
+	MCP23017Controller mcp23017{ busController };
+
+	// Act, port A and the upper half of port B drive LEDs, the rest are inputs with pull-ups
+	auto transfers = pBus->transferCount();
+	const auto configured = mcp23017.apply( Batch{}
+												.setState( 0x5555, PinState::HIGH )
+												.setMode( 0xF0FF, PinMode::OUTPUT )
+												.setPullUp( 0x0F00, true ) );
+	const auto configureCost = pBus->transferCount() - transfers;
+
+	transfers = pBus->transferCount();
+	const auto toggled = mcp23017.apply( Batch{}.toggle( 0xFFFF ).toggle( 0x0001 ) );
+	const auto toggleCost = pBus->transferCount() - transfers;
+
+	// Assert, one read of the unknown registers and one write
+	ASSERT_TRUE( configured.has_value() );
+	EXPECT_EQ( configureCost, 2u );
+	ASSERT_TRUE( toggled.has_value() );
+	EXPECT_EQ( toggleCost, 1u );
+	EXPECT_EQ( expander.registerValue( 0x00 ), 0x00 ); // IODIRA
+	EXPECT_EQ( expander.registerValue( 0x01 ), 0x0F ); // IODIRB
+	EXPECT_EQ( expander.registerValue( 0x0D ), 0x0F ); // GPPUB
+	EXPECT_EQ( expander.outputs( SimulatedMCP23017::Port::A ), 0xAB );
+	EXPECT_EQ( expander.outputs( SimulatedMCP23017::Port::B ), 0xA0 );
+}
+
+TEST( MCP23017ControllerTests, UnchangedRegistersAreNotWritten )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedMCP23017 >( 0x20 );
+	BusController busController{ std::move( bus ) };
+	MCP23017Controller mcp23017{ busController };
+	const auto batch = Batch{}.setMode( 0x00FF, PinMode::OUTPUT );
+	ASSERT_TRUE( mcp23017.apply( batch ).has_value() );
+
+	// Act
+	const auto transfers = pBus->transferCount();
+	const auto rslt = mcp23017.apply( batch );
+
+	// Assert
+	ASSERT_TRUE( rslt.has_value() );
+	EXPECT_TRUE( Batch{}.empty() );
+	EXPECT_FALSE( batch.empty() );
+	EXPECT_EQ( pBus->transferCount() - transfers, 0u );
+}
+
+TEST( MCP23017ControllerTests, InterruptsAreConfiguredAndReadTogether )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	auto& expander = bus->attach< SimulatedMCP23017 >( 0x20 );
+	BusController busController{ std::move( bus ) };
+	MCP23017Controller mcp23017{ busController };
+	using Pins = MCP23017Controller::Port::Pins;
+	using InterruptControl = Batch::InterruptControl;
+	ASSERT_TRUE( mcp23017.portA().pin( Pins::PIN_1 ).enableInterrupt( true ).has_value() );
+
+	// Act, pin 3 of port B interrupts when pulled low
+	const auto transfers = pBus->transferCount();
+	const auto enabled =
+		mcp23017.portB().pin( Pins::PIN_3 ).setInterruptTrigger( InterruptControl::COMPARE, PinState::HIGH );
+	const auto enableCost = pBus->transferCount() - transfers;
+
+	expander.setInputs( SimulatedMCP23017::Port::B, 0xFB );
+	expander.setInputs( SimulatedMCP23017::Port::A, 0x01 );
+	const auto interrupts = mcp23017.readInterrupts();
+	const auto cleared = mcp23017.readInterrupts();
+	const auto pins = mcp23017.readPins();
+
+	// Assert, INTCON, DEFVAL and GPINTEN in one transfer
+	ASSERT_TRUE( enabled.has_value() );
+	EXPECT_EQ( enableCost, 1u );
+	EXPECT_EQ( expander.registerValue( 0x05 ), 0x04 ); // GPINTENB
+	EXPECT_EQ( expander.registerValue( 0x07 ), 0x04 ); // DEFVALB
+	EXPECT_EQ( expander.registerValue( 0x09 ), 0x04 ); // INTCONB
+	ASSERT_TRUE( pins.has_value() );
+	EXPECT_EQ( *pins, 0xFB01 );
+	ASSERT_TRUE( interrupts.has_value() );
+	EXPECT_EQ( interrupts->flags, 0x0401 );
+	EXPECT_EQ( interrupts->capture, 0xFB01 );
+	ASSERT_TRUE( cleared.has_value() );
+	EXPECT_EQ( cleared->flags, 0x0000 );
+}
+
+TEST( MCP23017ControllerTests, ListenQueuesPinChanges )
+{
+	// Arrange, two buttons on port A with pull-ups
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& expander = bus->attach< SimulatedMCP23017 >( 0x20 );
+	BusController busController{ std::move( bus ) };
+	MCP23017Controller mcp23017{ busController };
+	expander.setInputs( SimulatedMCP23017::Port::A, 0xFF );
+	ASSERT_TRUE( mcp23017.configureInterruptOutput( true ).has_value() );
+	ASSERT_TRUE( mcp23017.apply( Batch{}.setPullUp( 0x0003, true ).enableInterrupt( 0x0003, true ) ).has_value() );
+
+	EdgeEventLoop* pLoop{};
+	ScriptedInterruptLine line{ {
+		[ & ] { expander.setInputs( SimulatedMCP23017::Port::A, 0xFE ); }, // Button 1 pressed
+		[ & ] {
+			// Button 2 pressed and released before the interrupt is read
+			expander.setInputs( SimulatedMCP23017::Port::A, 0xFC );
+			expander.setInputs( SimulatedMCP23017::Port::A, 0xFE );
+		},
+		[ & ] {
+			expander.setInputs( SimulatedMCP23017::Port::A, 0xFF ); // Button 1 released
+			pLoop->stop();
+		},
+	} };
+	EdgeEventLoop loop{ line };
+	pLoop = &loop;
+	MCP23017Controller::PinChangeQueue queue{ 8 };
+
+	// Act
+	const auto listened = mcp23017.listen( loop, queue );
+
+	std::vector< MCP23017Controller::PinChange > changes;
+	while( auto change = queue.pop() )
+	{
+		changes.push_back( *change );
+	}
+
+	// Assert
+	ASSERT_TRUE( listened.has_value() );
+	EXPECT_EQ( expander.registerValue( 0x0A ) & 0x46, 0x40 ); // Mirrored, active low, push-pull
+	ASSERT_EQ( changes.size(), 4u );
+	EXPECT_EQ( changes[ 0 ].pin, 0x0001 );
+	EXPECT_EQ( changes[ 0 ].state, PinState::LOW );
+	EXPECT_EQ( changes[ 1 ].pin, 0x0002 );
+	EXPECT_EQ( changes[ 1 ].state, PinState::LOW );
+	EXPECT_EQ( changes[ 2 ].pin, 0x0002 );
+	EXPECT_EQ( changes[ 2 ].state, PinState::HIGH );
+	EXPECT_GE( changes[ 2 ].timestamp, changes[ 1 ].timestamp );
+	EXPECT_EQ( changes[ 3 ].pin, 0x0001 );
+	EXPECT_EQ( changes[ 3 ].state, PinState::HIGH );
+
+	const auto& statistics = mcp23017.interruptStatistics();
+	EXPECT_EQ( statistics.edges, 3u );
+	EXPECT_EQ( statistics.reads, 3u );
+	EXPECT_EQ( statistics.changes, 4u );
+	EXPECT_EQ( statistics.dropped, 0u );
+}
+
+TEST( MCP23017ControllerTests, ListenCountsChangesLostToAFullQueue )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& expander = bus->attach< SimulatedMCP23017 >( 0x20 );
+	BusController busController{ std::move( bus ) };
+	MCP23017Controller mcp23017{ busController };
+	ASSERT_TRUE( mcp23017.apply( Batch{}.enableInterrupt( 0xFF00, true ) ).has_value() );
+
+	EdgeEventLoop* pLoop{};
+	ScriptedInterruptLine line{ { [ & ] {
+		expander.setInputs( SimulatedMCP23017::Port::B, 0x0F );
+		pLoop->stop();
+	} } };
+	EdgeEventLoop loop{ line };
+	pLoop = &loop;
+	MCP23017Controller::PinChangeQueue queue{ 2 };
+
+	// Act
+	const auto listened = mcp23017.listen( loop, queue );
+
+	// Assert
+	ASSERT_TRUE( listened.has_value() );
+	EXPECT_EQ( mcp23017.interruptStatistics().changes, 2u );
+	EXPECT_EQ( mcp23017.interruptStatistics().dropped, 2u );
+	const auto first = queue.pop();
+	ASSERT_TRUE( first.has_value() );
+	EXPECT_EQ( first->pin, 0x0100 );
+}
+
+} // namespace pbl::i2c
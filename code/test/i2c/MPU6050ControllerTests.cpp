@@ -0,0 +1,367 @@
+// PBL
+#include <i2c/BusController.hpp>
+#include <i2c/EdgeEventLoop.hpp>
+#include <i2c/MPU6050Controller.hpp>
+#include <i2c/SimulatedDevices.hpp>
+#include "EdgeEventSourceStub.hpp"
+
+// C++
+#include <array>
+#include <memory>
+#include <chrono>
+#include <vector>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <cstdint>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/// Returns a bus with an MPU6050 at 0x68 reporting 1g and 1°/s on every axis.
+[[nodiscard]] std::unique_ptr< SimulatedBus > makeBus( SimulatedMPU6050*& device )
+{
+	auto bus = std::make_unique< SimulatedBus >();
+	device = &bus->attach< SimulatedMPU6050 >( 0x68 );
+	device->setAccelerometer( 16384, -16384, 8192 );
+	device->setTemperature( 340 );
+	device->setGyroscope( 131, -131, 262 );
+	return bus;
+}
+
+constexpr float kGravity{ 9.80665f };
+constexpr float kDegreesToRadians{ std::numbers::pi_v< float > / 180.0f };
+
+} // namespace
+
+TEST( MPU6050ControllerTests, AllOutputsAreReadInOneTransfer )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	auto bus = makeBus( device );
+	auto* pBus = bus.get();
+	BusController busController{ std::move( bus ) };
+	MPU6050Controller mpu6050{ busController };
+	ASSERT_TRUE(
+		mpu6050.configureScales( MPU6050Controller::ACCEL_4G, MPU6050Controller::GYRO_500DPS ).has_value() );
+	const auto transfers = pBus->transferCount();
+
+	// Act
+	const auto measurement = mpu6050.readAll();
+
+	// Assert, 8192 LSB/g and 65.5 LSB/°/s
+	ASSERT_TRUE( measurement.has_value() );
+	EXPECT_EQ( pBus->transferCount() - transfers, 1u );
+	EXPECT_FLOAT_EQ( measurement->acceleration.x(), 2.0f * kGravity );
+	EXPECT_FLOAT_EQ( measurement->acceleration.y(), -2.0f * kGravity );
+	EXPECT_FLOAT_EQ( measurement->acceleration.z(), kGravity );
+	EXPECT_NEAR( measurement->temperatureC, 37.53f, 1e-4f );
+	EXPECT_FLOAT_EQ( measurement->angularRate.x(), 2.0f * kDegreesToRadians );
+	EXPECT_FLOAT_EQ( measurement->angularRate.y(), -2.0f * kDegreesToRadians );
+	EXPECT_FLOAT_EQ( measurement->angularRate.z(), 4.0f * kDegreesToRadians );
+}
+
+TEST( MPU6050ControllerTests, BatchConversionMatchesSingleFrames )
+{
+	// Arrange, frames of increasing outputs, more than a conversion block
+	std::vector< MPU6050Controller::RawFrame > frames( 100 );
+	for( std::size_t n = 0; n < frames.size(); ++n )
+	{
+		for( std::size_t word = 0; word < 7; ++word )
+		{
+			const auto value = static_cast< std::int16_t >( ( n + 1 ) * ( word + 1 ) * 37 * ( word % 2 ? -1 : 1 ) );
+			frames[ n ][ 2 * word ] = static_cast< std::uint8_t >( static_cast< std::uint16_t >( value ) >> 8 );
+			frames[ n ][ 2 * word + 1 ] = static_cast< std::uint8_t >( value & 0xFF );
+		}
+	}
+	std::vector< MPU6050Controller::Measurement > measurements( 80 );
+
+	// Act
+	const auto converted = MPU6050Controller::convert(
+		frames, measurements, MPU6050Controller::ACCEL_16G, MPU6050Controller::GYRO_2000DPS );
+
+	// Assert
+	ASSERT_EQ( converted, 80u );
+	for( std::size_t n = 0; n < converted; ++n )
+	{
+		std::array< MPU6050Controller::Measurement, 1 > single{};
+		ASSERT_EQ( MPU6050Controller::convert( std::span{ frames }.subspan( n, 1 ),
+											   single,
+											   MPU6050Controller::ACCEL_16G,
+											   MPU6050Controller::GYRO_2000DPS ),
+				   1u );
+		EXPECT_FLOAT_EQ( measurements[ n ].acceleration.y(), single[ 0 ].acceleration.y() );
+		EXPECT_FLOAT_EQ( measurements[ n ].temperatureC, single[ 0 ].temperatureC );
+		EXPECT_FLOAT_EQ( measurements[ n ].angularRate.z(), single[ 0 ].angularRate.z() );
+	}
+
+	const auto first = static_cast< float >( 37 );
+	EXPECT_FLOAT_EQ( measurements[ 0 ].acceleration.x(), first / 2048.0f * kGravity );
+	EXPECT_FLOAT_EQ( measurements[ 0 ].angularRate.x(), 5.0f * first / 16.4f * kDegreesToRadians );
+}
+
+TEST( MPU6050ControllerTests, AnglesUseOneTransfer )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	auto bus = makeBus( device );
+	auto* pBus = bus.get();
+	BusController busController{ std::move( bus ) };
+	MPU6050Controller mpu6050{ busController };
+	device->setAccelerometer( 0, 0, 16384 );
+	const auto transfers = pBus->transferCount();
+
+	// Act
+	const auto angles = mpu6050.angles();
+
+	// Assert, level with the yaw rate in °/s
+	ASSERT_TRUE( angles.has_value() );
+	EXPECT_EQ( pBus->transferCount() - transfers, 1u );
+	EXPECT_NEAR( angles->x(), 0.0f, 1e-4f );
+	EXPECT_NEAR( angles->y(), 0.0f, 1e-4f );
+	EXPECT_FLOAT_EQ( angles->z(), 2.0f );
+}
+
+TEST( MPU6050ControllerTests, EveryDataReadyEdgeIsReadOnce )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	auto bus = makeBus( device );
+	auto* pBus = bus.get();
+	BusController busController{ std::move( bus ) };
+	MPU6050Controller mpu6050{ busController };
+	EdgeEventSourceStub intLine;
+	EdgeEventLoop loop{ intLine };
+
+	const auto start = MPU6050Controller::Clock::now();
+	intLine.fire( gpio::Edge::RISING, start );
+	std::vector< MPU6050Controller::DataReadySample > samples;
+
+	// Act, the next edge arrives while the current sample is handled
+	const auto transfers = pBus->transferCount();
+	const auto acquired = mpu6050.acquire( loop, [ & ]( const MPU6050Controller::DataReadySample& sample ) {
+		samples.push_back( sample );
+		intLine.fire( gpio::Edge::FALLING, sample.timestamp + 50us );
+		intLine.fire( gpio::Edge::RISING, sample.timestamp + 1ms );
+		return samples.size() < 3;
+	} );
+
+	// Assert, enabling DATA_RDY_INT then one burst per edge
+	ASSERT_TRUE( acquired.has_value() );
+	ASSERT_EQ( samples.size(), 3u );
+	EXPECT_EQ( pBus->transferCount() - transfers, 2u + 3u );
+	EXPECT_EQ( device->registerValue( 0x38 ) & 0x01, 0x01 );
+	EXPECT_EQ( samples[ 0 ].timestamp, start );
+	EXPECT_EQ( samples[ 2 ].timestamp, start + 2ms );
+	EXPECT_FLOAT_EQ( samples[ 2 ].measurement.acceleration.x(), kGravity );
+	EXPECT_EQ( mpu6050.dataReadyStatistics().samples, 3u );
+	EXPECT_EQ( mpu6050.dataReadyStatistics().missed, 0u );
+}
+
+TEST( MPU6050ControllerTests, QueuedDataReadyEdgesAreNotDuplicated )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	BusController busController{ makeBus( device ) };
+	MPU6050Controller mpu6050{ busController };
+	EdgeEventSourceStub intLine;
+	EdgeEventLoop loop{ intLine };
+
+	const auto start = MPU6050Controller::Clock::now();
+	for( int i = 0; i < 3; ++i )
+	{
+		intLine.fire( gpio::Edge::RISING, start + i * 1ms );
+	}
+
+	// Act
+	std::optional< MPU6050Controller::DataReadySample > last;
+	const auto acquired = mpu6050.acquire( loop, [ & ]( const MPU6050Controller::DataReadySample& sample ) {
+		last = sample;
+		return false;
+	} );
+
+	// Assert, the newest edge is read
+	ASSERT_TRUE( acquired.has_value() );
+	ASSERT_TRUE( last.has_value() );
+	EXPECT_EQ( last->timestamp, start + 2ms );
+	EXPECT_EQ( mpu6050.dataReadyStatistics().edges, 3u );
+	EXPECT_EQ( mpu6050.dataReadyStatistics().samples, 1u );
+	EXPECT_EQ( mpu6050.dataReadyStatistics().missed, 2u );
+}
+
+TEST( MPU6050ControllerTests, MissingDataReadyEdgesTimeOut )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	BusController busController{ makeBus( device ) };
+	MPU6050Controller mpu6050{ busController };
+	EdgeEventSourceStub intLine;
+	EdgeEventLoop loop{ intLine };
+
+	// Act
+	const auto acquired = mpu6050.acquire( loop, []( const auto& ) { return true; }, 5ms );
+
+	// Assert
+	ASSERT_FALSE( acquired.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( acquired.error() ), utils::ErrorCode::TIMEOUT );
+}
+
+TEST( MPU6050ControllerTests, FifoIsDrainedInOneBurst )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	auto bus = makeBus( device );
+	auto* pBus = bus.get();
+	BusController busController{ std::move( bus ) };
+	MPU6050Controller mpu6050{ busController };
+	ASSERT_TRUE( mpu6050.startFifo().has_value() );
+	device->sample( 50 );
+	const auto transfers = pBus->transferCount();
+
+	// Act
+	const auto drained = mpu6050.drainFifo();
+
+	// Assert, the status and count read then the FIFO burst
+	ASSERT_TRUE( drained.has_value() );
+	EXPECT_EQ( *drained, 50u );
+	EXPECT_EQ( pBus->transferCount() - transfers, 2u );
+	EXPECT_EQ( device->fifoCount(), 0u );
+
+	const auto& samples = mpu6050.fifoSamples();
+	ASSERT_EQ( samples.size(), 50u );
+	EXPECT_FLOAT_EQ( samples[ 0 ].acceleration.x(), 1.0f );
+	EXPECT_FLOAT_EQ( samples[ 0 ].acceleration.y(), -1.0f );
+	EXPECT_FLOAT_EQ( samples[ 0 ].acceleration.z(), 0.5f );
+	EXPECT_FLOAT_EQ( samples[ 0 ].angularRate.x(), 1.0f );
+	EXPECT_FLOAT_EQ( samples[ 0 ].angularRate.y(), -1.0f );
+	EXPECT_FLOAT_EQ( samples[ 0 ].angularRate.z(), 2.0f );
+
+	// The low pass filter is disabled after power up, the sample rate is 8kHz
+	EXPECT_EQ( samples[ 1 ].timestamp - samples[ 0 ].timestamp, 125us );
+	EXPECT_LE( samples.back().timestamp, MPU6050Controller::Clock::now() );
+	EXPECT_EQ( mpu6050.fifoStatistics().bursts, 1u );
+}
+
+TEST( MPU6050ControllerTests, TemperatureIsStreamedOnRequest )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	BusController busController{ makeBus( device ) };
+	MPU6050Controller mpu6050{ busController };
+	ASSERT_TRUE( mpu6050.startFifo( { .temperature = true } ).has_value() );
+	device->sample( 2 );
+
+	// Act
+	const auto drained = mpu6050.drainFifo();
+
+	// Assert
+	EXPECT_EQ( device->fifoCount(), 0u ); // 14 bytes per sample
+	ASSERT_TRUE( drained.has_value() );
+	ASSERT_EQ( *drained, 2u );
+	const auto sample = mpu6050.fifoSamples().pop();
+	ASSERT_TRUE( sample.has_value() );
+	EXPECT_NEAR( sample->temperatureC, 37.53f, 1e-4f );
+	EXPECT_FLOAT_EQ( sample->angularRate.z(), 2.0f );
+}
+
+TEST( MPU6050ControllerTests, OverflowResetsTheFifo )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	BusController busController{ makeBus( device ) };
+	MPU6050Controller mpu6050{ busController };
+	ASSERT_TRUE( mpu6050.startFifo().has_value() );
+	device->sample( 100 ); // 1200 bytes
+
+	// Act
+	const auto overflowed = mpu6050.drainFifo();
+	const auto afterReset = device->fifoCount();
+	device->sample( 3 );
+	const auto recovered = mpu6050.drainFifo();
+
+	// Assert
+	ASSERT_TRUE( overflowed.has_value() );
+	EXPECT_EQ( *overflowed, 0u );
+	EXPECT_EQ( afterReset, 0u );
+	ASSERT_TRUE( recovered.has_value() );
+	EXPECT_EQ( *recovered, 3u );
+	EXPECT_EQ( mpu6050.fifoStatistics().overflows, 1u );
+	EXPECT_EQ( mpu6050.fifoStatistics().samples, 3u );
+	EXPECT_FLOAT_EQ( mpu6050.fifoSamples().front().acceleration.x(), 1.0f ); // Frame aligned again
+}
+
+TEST( MPU6050ControllerTests, RestartClearsStaleSamples )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	BusController busController{ makeBus( device ) };
+	MPU6050Controller mpu6050{ busController };
+	ASSERT_TRUE( mpu6050.startFifo().has_value() );
+	device->sample( 5 );
+
+	// Act, FIFO_EN is still set when the restart resets the FIFO
+	const auto restarted = mpu6050.startFifo();
+	const auto stale = device->fifoCount();
+	device->sample( 2 );
+	const auto drained = mpu6050.drainFifo();
+
+	// Assert
+	ASSERT_TRUE( restarted.has_value() );
+	EXPECT_EQ( stale, 0u );
+	ASSERT_TRUE( drained.has_value() );
+	EXPECT_EQ( *drained, 2u );
+}
+
+TEST( MPU6050ControllerTests, TimestampsIncreaseAcrossDrains )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	BusController busController{ makeBus( device ) };
+	MPU6050Controller mpu6050{ busController };
+	ASSERT_TRUE( mpu6050.startFifo( { .capacity = 8 } ).has_value() );
+
+	// Act
+	device->sample( 4 );
+	ASSERT_TRUE( mpu6050.drainFifo().has_value() );
+	device->sample( 6 );
+	ASSERT_TRUE( mpu6050.drainFifo().has_value() );
+
+	// Assert, the ring keeps the newest samples
+	const auto& samples = mpu6050.fifoSamples();
+	ASSERT_EQ( samples.size(), 8u );
+	EXPECT_EQ( samples.dropped(), 2u );
+	for( std::size_t i = 1; i < samples.size(); ++i )
+	{
+		EXPECT_GT( samples[ i ].timestamp, samples[ i - 1 ].timestamp );
+	}
+}
+
+TEST( MPU6050ControllerTests, FifoMustBeStarted )
+{
+	// Arrange
+	SimulatedMPU6050* device{};
+	BusController busController{ makeBus( device ) };
+	MPU6050Controller mpu6050{ busController };
+
+	// Act
+	const auto notStarted = mpu6050.drainFifo();
+	ASSERT_TRUE( mpu6050.startFifo().has_value() );
+	ASSERT_TRUE( mpu6050.stopFifo().has_value() );
+	device->sample( 1 );
+
+	// Assert
+	ASSERT_FALSE( notStarted.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( notStarted.error() ), utils::ErrorCode::UNSUPPORTED_OPERATION );
+	EXPECT_FALSE( mpu6050.fifoRunning() );
+	EXPECT_EQ( device->fifoCount(), 0u );
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,189 @@
+// PBL
+#include <i2c/BusController.hpp>
+#include <i2c/MPU9250Controller.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <array>
+#include <memory>
+#include <cstdint>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+namespace
+{
+
+/// Returns a bus with an MPU9250 at 0x68 reporting 1g, 1°/s and 22°C, the magnetometer 15, 30 and 45µT.
+[[nodiscard]] std::unique_ptr< SimulatedBus > makeBus( SimulatedMPU9250*& device )
+{
+	auto bus = std::make_unique< SimulatedBus >();
+	device = &bus->attach< SimulatedMPU9250 >( 0x68 );
+	device->setAccelerometer( 16384, -16384, 8192 );
+	device->setTemperature( 334 );
+	device->setGyroscope( 131, -131, 262 );
+	device->setMagnetometer( 100, 200, -300 );
+	return bus;
+}
+
+} // namespace
+
+TEST( MPU9250ControllerTests, InitializeStartsTheMagnetometer )
+{
+	// Arrange
+	SimulatedMPU9250* device{};
+	BusController busController{ makeBus( device ) };
+	MPU9250Controller mpu9250{ busController };
+
+	// Act
+	const auto initialized = mpu9250.initialize();
+
+	// Assert, continuous 100Hz measurement with 16-bit output
+	ASSERT_TRUE( initialized.has_value() );
+	EXPECT_TRUE( mpu9250.initialized() );
+	EXPECT_EQ( device->magnetometerRegister( 0x0A ), 0x16 );
+	EXPECT_EQ( device->registerValue( 0x25 ), 0x8C ); // Slave 0 reads the AK8963
+	EXPECT_EQ( device->registerValue( 0x26 ), 0x03 ); // from HXL
+	EXPECT_EQ( device->registerValue( 0x27 ), 0x87 ); // 7 bytes, up to ST2
+}
+
+TEST( MPU9250ControllerTests, AllAxesAreReadInOneBurst )
+{
+	// Arrange
+	SimulatedMPU9250* device{};
+	auto bus = makeBus( device );
+	auto* pBus = bus.get();
+	BusController busController{ std::move( bus ) };
+	device->setMagnetometerAdjustment( { 176, 128, 128 } ); // X sensitivity 1.1875
+	MPU9250Controller mpu9250{ busController };
+	ASSERT_TRUE( mpu9250.initialize().has_value() );
+	device->sample();
+	const auto transfers = pBus->transferCount();
+
+	// Act
+	const auto sample = mpu9250.readSample();
+
+	// Assert, the magnetometer in the accelerometer axes
+	ASSERT_TRUE( sample.has_value() );
+	EXPECT_EQ( pBus->transferCount() - transfers, 1u );
+	EXPECT_FLOAT_EQ( sample->acceleration.x(), 1.0f );
+	EXPECT_FLOAT_EQ( sample->acceleration.y(), -1.0f );
+	EXPECT_FLOAT_EQ( sample->acceleration.z(), 0.5f );
+	EXPECT_NEAR( sample->temperatureC, 22.0f, 0.01f );
+	EXPECT_FLOAT_EQ( sample->angularRate.z(), 2.0f );
+	EXPECT_FLOAT_EQ( sample->magneticField.x(), 30.0f );
+	EXPECT_FLOAT_EQ( sample->magneticField.y(), 100.0f * 1.1875f * 0.15f );
+	EXPECT_FLOAT_EQ( sample->magneticField.z(), 45.0f );
+	EXPECT_FALSE( sample->magneticOverflow );
+
+	const auto magnetometer = mpu9250.getMagnetometer();
+	ASSERT_TRUE( magnetometer.has_value() );
+	EXPECT_FLOAT_EQ( magnetometer->x(), 30.0f );
+}
+
+TEST( MPU9250ControllerTests, MagnetometerOverflowIsReported )
+{
+	// Arrange
+	SimulatedMPU9250* device{};
+	BusController busController{ makeBus( device ) };
+	MPU9250Controller mpu9250{ busController };
+	const auto notInitialized = mpu9250.getMagnetometer();
+	ASSERT_TRUE( mpu9250.initialize().has_value() );
+	device->setMagnetometer( 0, 0, 0, true );
+	device->sample();
+
+	// Act
+	const auto magnetometer = mpu9250.getMagnetometer();
+	const auto sample = mpu9250.readSample();
+
+	// Assert
+	ASSERT_FALSE( notInitialized.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( notInitialized.error() ), utils::ErrorCode::UNSUPPORTED_OPERATION );
+	ASSERT_FALSE( magnetometer.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( magnetometer.error() ), utils::ErrorCode::DATA_OVERRUN );
+	ASSERT_TRUE( sample.has_value() );
+	EXPECT_TRUE( sample->magneticOverflow );
+}
+
+TEST( MPU9250ControllerTests, FifoStreamsAllAxes )
+{
+	// Arrange
+	SimulatedMPU9250* device{};
+	BusController busController{ makeBus( device ) };
+	MPU9250Controller mpu9250{ busController };
+	ASSERT_TRUE( mpu9250.initialize().has_value() );
+	ASSERT_TRUE( mpu9250.setSampleRate( 4 ).has_value() );
+	ASSERT_TRUE( mpu9250.startFifo().has_value() );
+	device->sample( 5 );
+
+	// Act
+	std::array< MPU9250Controller::Sample, 3 > samples{};
+	const auto first = mpu9250.readFifo( samples );
+	const auto rest = mpu9250.readFifo( samples );
+
+	// Assert
+	EXPECT_EQ( device->registerValue( 0x19 ), 4u );
+	ASSERT_TRUE( first.has_value() );
+	EXPECT_EQ( *first, 3u );
+	ASSERT_TRUE( rest.has_value() );
+	EXPECT_EQ( *rest, 2u );
+	EXPECT_EQ( device->fifoCount(), 0u );
+	EXPECT_FLOAT_EQ( samples[ 1 ].acceleration.x(), 1.0f );
+	EXPECT_FLOAT_EQ( samples[ 1 ].angularRate.y(), -1.0f );
+	EXPECT_FLOAT_EQ( samples[ 1 ].magneticField.z(), 45.0f );
+}
+
+TEST( MPU9250ControllerTests, FifoOverflowResetsTheFifo )
+{
+	// Arrange
+	SimulatedMPU9250* device{};
+	BusController busController{ makeBus( device ) };
+	MPU9250Controller mpu9250{ busController };
+	ASSERT_TRUE( mpu9250.initialize().has_value() );
+	ASSERT_TRUE( mpu9250.startFifo().has_value() );
+	device->sample( 30 ); // 630 bytes
+
+	// Act
+	std::array< MPU9250Controller::Sample, 24 > samples{};
+	const auto overflowed = mpu9250.readFifo( samples );
+	const auto afterReset = device->fifoCount();
+	device->sample( 2 );
+	const auto recovered = mpu9250.readFifo( samples );
+
+	// Assert
+	ASSERT_FALSE( overflowed.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( overflowed.error() ), utils::ErrorCode::DATA_OVERRUN );
+	EXPECT_EQ( afterReset, 0u );
+	ASSERT_TRUE( recovered.has_value() );
+	EXPECT_EQ( *recovered, 2u );
+	EXPECT_FLOAT_EQ( samples[ 0 ].acceleration.x(), 1.0f ); // Frame aligned again
+}
+
+TEST( MPU9250ControllerTests, RestartClearsStaleSamples )
+{
+	// Arrange
+	SimulatedMPU9250* device{};
+	BusController busController{ makeBus( device ) };
+	MPU9250Controller mpu9250{ busController };
+	ASSERT_TRUE( mpu9250.initialize().has_value() );
+	ASSERT_TRUE( mpu9250.startFifo().has_value() );
+	device->sample( 5 );
+
+	// Act, FIFO_EN is still set when the restart resets the FIFO
+	const auto restarted = mpu9250.startFifo();
+	const auto stale = device->fifoCount();
+	device->sample( 2 );
+	std::array< MPU9250Controller::Sample, 8 > samples{};
+	const auto read = mpu9250.readFifo( samples );
+
+	// Assert
+	ASSERT_TRUE( restarted.has_value() );
+	EXPECT_EQ( stale, 0u );
+	ASSERT_TRUE( read.has_value() );
+	EXPECT_EQ( *read, 2u );
+}
+
+} // namespace pbl::i2c
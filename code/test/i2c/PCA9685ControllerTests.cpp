@@ -0,0 +1,125 @@
+// PBL
+#include <i2c/BusController.hpp>
+#include <i2c/PCA9685Controller.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <memory>
+#include <cstdint>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+TEST( PCA9685ControllerTests, FrameIsFlushedInOneWrite )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	auto& pwm = bus->attach< SimulatedPCA9685 >( 0x40 );
+	BusController busController{ std::move( bus ) };
+	PCA9685Controller pca9685{ busController };
+	ASSERT_TRUE( pca9685.setPWMFrequency( 50 ).has_value() );
+
+	PCA9685Controller::Frame frame;
+	for( std::uint8_t channel = 0; channel < 16; ++channel )
+	{
+		frame.set( static_cast< PCA9685Controller::Channel >( channel ),
+				   PCA9685Controller::PWMState{ static_cast< std::uint16_t >( 10 * channel ) },
+				   PCA9685Controller::PWMState{ static_cast< std::uint16_t >( 300 + channel ) } );
+	}
+	frame.setFullOn( PCA9685Controller::CH15 );
+
+	// Act
+	const auto transfers = pBus->transferCount();
+	const auto flushed = pca9685.flush( frame );
+
+	// Assert
+	ASSERT_TRUE( flushed.has_value() );
+	EXPECT_EQ( pBus->transferCount() - transfers, 1u );
+	EXPECT_EQ( pwm.onCount( 0 ), 0u );
+	EXPECT_EQ( pwm.offCount( 0 ), 300u );
+	EXPECT_EQ( pwm.onCount( 7 ), 70u );
+	EXPECT_EQ( pwm.offCount( 14 ), 314u );
+	EXPECT_EQ( pwm.onCount( 15 ), 0x1000u );
+	EXPECT_EQ( pwm.offCount( 15 ), 0u );
+}
+
+TEST( PCA9685ControllerTests, OnlyChangedChannelsAreWritten )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	auto& pwm = bus->attach< SimulatedPCA9685 >( 0x40 );
+	BusController busController{ std::move( bus ) };
+	PCA9685Controller pca9685{ busController };
+
+	PCA9685Controller::Frame frame;
+	frame.set( PCA9685Controller::CH0, PCA9685Controller::PWMState{ 307 } );
+	ASSERT_TRUE( pca9685.flush( frame ).has_value() );
+
+	// Act
+	const auto unchangedTransfers = pBus->transferCount();
+	const auto unchanged = pca9685.flush( frame );
+	const auto unchangedCost = pBus->transferCount() - unchangedTransfers;
+
+	frame.set( PCA9685Controller::CH3, PCA9685Controller::PWMState{ 205 } )
+		.set( PCA9685Controller::CH5, PCA9685Controller::PWMState{ 409 } );
+	pwm.setRegisterValue( 0x06, 0xAA ); // Channel 0 changed behind the controller's back
+	const auto transfers = pBus->transferCount();
+	const auto partial = pca9685.flush( frame );
+
+	// Assert, only channels 3 to 5 are rewritten
+	ASSERT_TRUE( unchanged.has_value() );
+	EXPECT_EQ( unchangedCost, 0u );
+	ASSERT_TRUE( partial.has_value() );
+	EXPECT_EQ( pBus->transferCount() - transfers, 1u );
+	EXPECT_EQ( pwm.onCount( 0 ), 0xAAu );
+	EXPECT_EQ( pwm.offCount( 3 ), 205u );
+	EXPECT_EQ( pwm.offCount( 4 ), 0x1000u );
+	EXPECT_EQ( pwm.offCount( 5 ), 409u );
+}
+
+TEST( PCA9685ControllerTests, AllLedRegistersUpdateEveryChannel )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	auto& pwm = bus->attach< SimulatedPCA9685 >( 0x40 );
+	BusController busController{ std::move( bus ) };
+	PCA9685Controller pca9685{ busController };
+	ASSERT_TRUE( pca9685.setAllFullOff().has_value() );
+
+	// Act
+	auto transfers = pBus->transferCount();
+	const auto all = pca9685.setAllPWM( PCA9685Controller::PWMState{ 0 }, PCA9685Controller::PWMState{ 1024 } );
+	const auto allCost = pBus->transferCount() - transfers;
+
+	PCA9685Controller::Frame frame;
+	for( std::uint8_t channel = 0; channel < 16; ++channel )
+	{
+		frame.set( static_cast< PCA9685Controller::Channel >( channel ), PCA9685Controller::PWMState{ 1024 } );
+	}
+	transfers = pBus->transferCount();
+	const auto flushed = pca9685.flush( frame );
+	const auto flushCost = pBus->transferCount() - transfers;
+
+	// Assert, the frame matches what the broadcast wrote
+	ASSERT_TRUE( all.has_value() );
+	EXPECT_EQ( allCost, 1u );
+	ASSERT_TRUE( flushed.has_value() );
+	EXPECT_EQ( flushCost, 0u );
+	for( std::size_t channel = 0; channel < 16; ++channel )
+	{
+		EXPECT_EQ( pwm.onCount( channel ), 0u );
+		EXPECT_EQ( pwm.offCount( channel ), 1024u );
+	}
+
+	ASSERT_TRUE( pca9685.setAllFullOn().has_value() );
+	EXPECT_EQ( pwm.onCount( 9 ), 0x1000u );
+	EXPECT_EQ( pwm.offCount( 9 ), 0u );
+}
+
+} // namespace pbl::i2c
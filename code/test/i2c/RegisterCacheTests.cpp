@@ -0,0 +1,170 @@
+// PBL
+#include <i2c/Controllers.hpp>
+#include <i2c/TMP102Controller.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <array>
+#include <memory>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+TEST( RegisterCacheTests, UnknownRegisterIsReadOnce )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedLM75 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	LM75Controller lm75{ busController };
+
+	// Act
+	ASSERT_TRUE( lm75.setPowerMode( LM75Controller::LOW_POWER ).has_value() );
+	const auto firstUpdate = pBus->transferCount();
+	ASSERT_TRUE( lm75.setThermostatMode( LM75Controller::ThermostatMode::INTERRUPT ).has_value() );
+	const auto secondUpdate = pBus->transferCount() - firstUpdate;
+	const auto mode = lm75.getPowerMode();
+
+	// Assert
+	EXPECT_EQ( firstUpdate, 2u ); // Read + write
+	EXPECT_EQ( secondUpdate, 1u ); // Write only
+	ASSERT_TRUE( mode.has_value() );
+	EXPECT_EQ( mode.value(), LM75Controller::LOW_POWER );
+	EXPECT_EQ( pBus->transferCount(), 3u );
+}
+
+TEST( RegisterCacheTests, FailedWriteInvalidatesRegister )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedLM75 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	LM75Controller lm75{ busController };
+	ASSERT_TRUE( lm75.setPowerMode( LM75Controller::LOW_POWER ).has_value() );
+
+	// Act, the sensor was power cycled while the write failed
+	pBus->detach( 0x48 );
+	const auto failed = lm75.setPowerMode( LM75Controller::LOW_POWER );
+	pBus->attach< SimulatedLM75 >( 0x48 );
+	const auto mode = lm75.getPowerMode();
+
+	// Assert
+	EXPECT_FALSE( failed.has_value() );
+	ASSERT_TRUE( mode.has_value() );
+	EXPECT_EQ( mode.value(), LM75Controller::NORMAL );
+}
+
+TEST( RegisterCacheTests, TMP102OneShotBitIsNotCached )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	auto& sensor = bus->attach< SimulatedTMP102 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	TMP102Controller tmp102{ busController };
+
+	// Act
+	ASSERT_TRUE( tmp102.setShutdownMode( true ) );
+	ASSERT_TRUE( tmp102.triggerOneShot() );
+	sensor.setRegisterValue( 0x01, sensor.registerValue( 0x01 ) & 0x7FFF ); // Conversion finished
+	const auto transfers = pBus->transferCount();
+	ASSERT_TRUE( tmp102.setExtendedMode( true ) );
+
+	// Assert
+	EXPECT_EQ( pBus->transferCount() - transfers, 1u );
+	EXPECT_EQ( sensor.registerValue( 0x01 ) & 0x8000, 0x0000 ); // No second one-shot requested
+	EXPECT_EQ( sensor.registerValue( 0x01 ) & 0x0110, 0x0110 ); // SD and EM set
+}
+
+TEST( RegisterCacheTests, PCA9685FullOnIsSingleWrite )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	auto& pwm = bus->attach< SimulatedPCA9685 >( 0x40 );
+	BusController busController{ std::move( bus ) };
+	PCA9685Controller pca9685{ busController };
+	ASSERT_TRUE(
+		pca9685.setPWM( PCA9685Controller::CH0, PCA9685Controller::PWMState{ 10 }, PCA9685Controller::PWMState{ 20 } )
+			.has_value() );
+
+	// Act
+	const auto transfers = pBus->transferCount();
+	const auto rslt = pca9685.setFullOn( PCA9685Controller::CH0, true );
+
+	// Assert
+	ASSERT_TRUE( rslt.has_value() );
+	EXPECT_EQ( pBus->transferCount() - transfers, 1u );
+	EXPECT_EQ( pwm.onCount( 0 ), 0x100A );
+}
+
+TEST( RegisterCacheTests, MCP23017PinToggleIsOneWritePerPin )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	auto& expander = bus->attach< SimulatedMCP23017 >( 0x20 );
+	BusController busController{ std::move( bus ) };
+	MCP23017Controller mcp23017{ busController };
+
+	using Pins = MCP23017Controller::Port::Pins;
+	using PinMode = MCP23017Controller::Port::PinMode;
+	constexpr std::array kPins{
+		Pins::PIN_1, Pins::PIN_2, Pins::PIN_3, Pins::PIN_4, Pins::PIN_5, Pins::PIN_6, Pins::PIN_7, Pins::PIN_8 };
+
+	for( auto* pPort : { &mcp23017.portA(), &mcp23017.portB() } )
+	{
+		for( const auto pin : kPins )
+		{
+			ASSERT_TRUE( pPort->pin( pin ).setMode( PinMode::OUTPUT ).has_value() );
+		}
+	}
+
+	// Act
+	const auto transfers = pBus->transferCount();
+	for( auto* pPort : { &mcp23017.portA(), &mcp23017.portB() } )
+	{
+		for( const auto pin : kPins )
+		{
+			ASSERT_TRUE( pPort->pin( pin ).switchPinState().has_value() );
+		}
+	}
+
+	// Assert
+	EXPECT_EQ( pBus->transferCount() - transfers, 18u ); // One latch read per port, then a write per pin
+	EXPECT_EQ( expander.outputs( SimulatedMCP23017::Port::A ), 0xFF );
+	EXPECT_EQ( expander.outputs( SimulatedMCP23017::Port::B ), 0xFF );
+}
+
+TEST( RegisterCacheTests, MCP23017PinConfigurationUpdatesRegisters )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& expander = bus->attach< SimulatedMCP23017 >( 0x20 );
+	BusController busController{ std::move( bus ) };
+	MCP23017Controller mcp23017{ busController };
+
+	using Pins = MCP23017Controller::Port::Pins;
+	using PinMode = MCP23017Controller::Port::PinMode;
+
+	// Act
+	auto pin = mcp23017.portB().pin( Pins::PIN_3 );
+	const auto modeSet = pin.setMode( PinMode::OUTPUT );
+	const auto pullUpSet = mcp23017.portB().pin( Pins::PIN_5 ).setPullUpResistor( true );
+	const auto mode = pin.mode();
+
+	// Assert
+	ASSERT_TRUE( modeSet.has_value() );
+	ASSERT_TRUE( pullUpSet.has_value() );
+	EXPECT_EQ( expander.registerValue( 0x01 ), 0xFB ); // IODIRB, power on value with pin 3 as output
+	EXPECT_EQ( expander.registerValue( 0x0D ), 0x10 ); // GPPUB
+	ASSERT_TRUE( mode.has_value() );
+	EXPECT_EQ( mode.value(), PinMode::OUTPUT );
+}
+
+} // namespace pbl::i2c
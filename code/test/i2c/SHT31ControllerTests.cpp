@@ -0,0 +1,143 @@
+// PBL
+#include <i2c/BusController.hpp>
+#include <i2c/SHT31Controller.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <span>
+#include <array>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/// Answers every read with a measurement whose CRC bytes are wrong.
+class CorruptedSHT31 final : public SimulatedDevice
+{
+public:
+	[[nodiscard]] bool write( std::span< const std::uint8_t > ) override { return true; }
+
+	[[nodiscard]] bool read( std::span< std::uint8_t > data ) override
+	{
+		constexpr std::array< std::uint8_t, 6 > kCorrupted{ 0x66, 0x66, 0x00, 0x73, 0x33, 0x00 };
+		std::ranges::copy( std::span{ kCorrupted }.first( std::min( data.size(), kCorrupted.size() ) ), data.begin() );
+		return true;
+	}
+};
+
+} // namespace
+
+TEST( SHT31ControllerTests, MeasurementIsReadInOneTransfer )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	auto& sensor = bus->attach< SimulatedSHT31 >( 0x44 );
+	sensor.setTemperature( 23.5f );
+	sensor.setHumidity( 45.0f );
+	BusController busController{ std::move( bus ) };
+	SHT31Controller sht31{ busController };
+
+	// Act
+	const auto measurement = sht31.measure( SHT31Controller::MEDIUM );
+
+	// Assert, the command and the read
+	ASSERT_TRUE( measurement.has_value() );
+	EXPECT_NEAR( measurement->temperatureC, 23.5f, 0.01f );
+	EXPECT_NEAR( measurement->humidity, 45.0f, 0.01f );
+	EXPECT_EQ( pBus->transferCount(), 2u );
+	EXPECT_EQ( pBus->sleptFor(), 6ms );
+}
+
+TEST( SHT31ControllerTests, CrcMismatchIsRejected )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< CorruptedSHT31 >( 0x44 );
+	BusController busController{ std::move( bus ) };
+	SHT31Controller sht31{ busController };
+
+	// Act
+	const auto measurement = sht31.readMeasurement();
+	const auto temperature = sht31.getTemperatureC();
+	const auto status = sht31.readStatus();
+
+	// Assert
+	ASSERT_FALSE( measurement.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( measurement.error() ), utils::ErrorCode::INVALID_DATA );
+	EXPECT_FALSE( temperature.has_value() );
+	ASSERT_FALSE( status.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( status.error() ), utils::ErrorCode::INVALID_DATA );
+}
+
+TEST( SHT31ControllerTests, PeriodicModeFetchesEachMeasurementOnce )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& sensor = bus->attach< SimulatedSHT31 >( 0x44 );
+	sensor.setTemperature( 21.0f );
+	sensor.setHumidity( 60.0f );
+	BusController busController{ std::move( bus ) };
+	SHT31Controller sht31{ busController };
+
+	// Act
+	const auto started = sht31.startPeriodic( SHT31Controller::MPS_10 );
+	const auto early = sht31.fetch();
+	std::this_thread::sleep_for( 110ms );
+	const auto measurement = sht31.fetch();
+	const auto again = sht31.fetch();
+	const auto singleShot = sht31.triggerMeasurement();
+
+	// Assert
+	ASSERT_TRUE( started.has_value() );
+	EXPECT_TRUE( sensor.periodic() );
+	ASSERT_TRUE( early.has_value() );
+	EXPECT_FALSE( early->has_value() );
+	ASSERT_TRUE( measurement.has_value() );
+	ASSERT_TRUE( measurement->has_value() );
+	EXPECT_NEAR( ( *measurement )->temperatureC, 21.0f, 0.01f );
+	EXPECT_NEAR( ( *measurement )->humidity, 60.0f, 0.01f );
+	ASSERT_TRUE( again.has_value() );
+	EXPECT_FALSE( again->has_value() );
+	EXPECT_FALSE( singleShot.has_value() );
+
+	EXPECT_TRUE( sht31.stopPeriodic().has_value() );
+	EXPECT_FALSE( sensor.periodic() );
+	EXPECT_FALSE( sht31.periodic() );
+}
+
+TEST( SHT31ControllerTests, ModesAreSwitchedThroughABreak )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& sensor = bus->attach< SimulatedSHT31 >( 0x44 );
+	BusController busController{ std::move( bus ) };
+	SHT31Controller sht31{ busController };
+
+	// Act
+	const auto notStarted = sht31.fetch();
+	const auto first = sht31.startPeriodic( SHT31Controller::MPS_1, SHT31Controller::LOW );
+	const auto second = sht31.startPeriodic( SHT31Controller::ART );
+
+	// Assert
+	ASSERT_FALSE( notStarted.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( notStarted.error() ), utils::ErrorCode::UNSUPPORTED_OPERATION );
+	EXPECT_TRUE( first.has_value() );
+	EXPECT_TRUE( second.has_value() ); // The simulated sensor rejects a mode change without a break
+	EXPECT_TRUE( sensor.periodic() );
+	EXPECT_EQ( sensor.status() & 0x0002, 0 ); // Last command succeeded
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,281 @@
+// PBL
+#include <i2c/BusController.hpp>
+#include <i2c/SensorScheduler.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <span>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+using Data = utils::Result< std::span< const std::uint8_t > >;
+
+/// Returns a bus with an MPU6050 at 0x68 and an LM75 at 0x48.
+[[nodiscard]] std::unique_ptr< SimulatedBus > makeBus()
+{
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& mpu6050 = bus->attach< SimulatedMPU6050 >( 0x68 );
+	mpu6050.setAccelerometer( 1, 2, 3 );
+	mpu6050.setTemperature( 4 );
+	mpu6050.setGyroscope( 5, 6, 7 );
+	bus->attach< SimulatedLM75 >( 0x48 ).setTemperature( 25.0f );
+	return bus;
+}
+
+/// Returns a callback storing the last data it received.
+[[nodiscard]] SensorScheduler::ReadCallback store( std::vector< std::uint8_t >& destination )
+{
+	return [ &destination ]( Data rslt ) {
+		destination = rslt ? std::vector< std::uint8_t >( rslt->begin(), rslt->end() ) : std::vector< std::uint8_t >{};
+	};
+}
+
+} // namespace
+
+TEST( SensorSchedulerTests, RejectsInvalidTasks )
+{
+	// Arrange
+	BusController busController{ makeBus() };
+	SensorScheduler scheduler{ busController };
+
+	// Act
+	const auto empty = scheduler.addRead( 0x68, 0x3B, 0, 1ms, []( Data ) {} );
+	const auto wraps = scheduler.addRead( 0x68, 0xFF, 2, 1ms, []( Data ) {} );
+	const auto noPeriod = scheduler.addRead( 0x68, 0x3B, 6, 0ms, []( Data ) {} );
+	const auto noJob = scheduler.addTask( 1ms, {} );
+
+	// Assert
+	EXPECT_FALSE( empty.has_value() );
+	EXPECT_FALSE( wraps.has_value() );
+	EXPECT_FALSE( noPeriod.has_value() );
+	EXPECT_FALSE( noJob.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( empty.error() ), utils::ErrorCode::INVALID_ARGUMENT );
+}
+
+TEST( SensorSchedulerTests, DueReadsAreMergedIntoOneTransfer )
+{
+	// Arrange
+	BusController busController{ makeBus() };
+	SensorScheduler scheduler{ busController };
+	std::vector< std::uint8_t > accel, temperature, gyro, lm75;
+
+	ASSERT_TRUE( scheduler.addRead( 0x68, 0x3B, 6, 1ms, store( accel ) ).has_value() );
+	ASSERT_TRUE( scheduler.addRead( 0x68, 0x43, 6, 1ms, store( gyro ) ).has_value() );
+	ASSERT_TRUE( scheduler.addRead( 0x68, 0x41, 2, 10ms, store( temperature ) ).has_value() );
+	ASSERT_TRUE( scheduler.addRead( 0x48, 0x00, 2, 100ms, store( lm75 ) ).has_value() );
+
+	// Act
+	const auto next = scheduler.runDue( SensorScheduler::Clock::now() );
+
+	// Assert
+	const auto stats = scheduler.statistics();
+	EXPECT_EQ( stats.cycles, 1u );
+	EXPECT_EQ( stats.transfers, 1u );
+	EXPECT_EQ( stats.coalesced, 2u ); // Accel, temperature and gyro are contiguous
+
+	EXPECT_EQ( accel, ( std::vector< std::uint8_t >{ 0, 1, 0, 2, 0, 3 } ) );
+	EXPECT_EQ( temperature, ( std::vector< std::uint8_t >{ 0, 4 } ) );
+	EXPECT_EQ( gyro, ( std::vector< std::uint8_t >{ 0, 5, 0, 6, 0, 7 } ) );
+	EXPECT_EQ( lm75, ( std::vector< std::uint8_t >{ 0x19, 0x00 } ) );
+	ASSERT_TRUE( next.has_value() );
+}
+
+TEST( SensorSchedulerTests, CoalescingCanBeDisabled )
+{
+	// Arrange
+	BusController busController{ makeBus() };
+	SensorScheduler scheduler{ busController, SensorScheduler::Options{ .coalesce = false } };
+	std::vector< std::uint8_t > accel, gyro;
+
+	ASSERT_TRUE( scheduler.addRead( 0x68, 0x3B, 6, 1ms, store( accel ) ).has_value() );
+	ASSERT_TRUE( scheduler.addRead( 0x68, 0x43, 6, 1ms, store( gyro ) ).has_value() );
+
+	// Act
+	scheduler.runDue( SensorScheduler::Clock::now() );
+
+	// Assert
+	EXPECT_EQ( scheduler.statistics().coalesced, 0u );
+	EXPECT_EQ( scheduler.statistics().transfers, 1u );
+	EXPECT_EQ( gyro, ( std::vector< std::uint8_t >{ 0, 5, 0, 6, 0, 7 } ) );
+}
+
+TEST( SensorSchedulerTests, TasksAreReleasedOnTheirPeriods )
+{
+	// Arrange
+	BusController busController{ makeBus() };
+	SensorScheduler scheduler{ busController };
+	std::vector< std::uint8_t > fast, slow;
+	const auto fastId = scheduler.addRead( 0x68, 0x3B, 6, 1ms, store( fast ) );
+	const auto slowId = scheduler.addRead( 0x48, 0x00, 2, 10ms, store( slow ) );
+	ASSERT_TRUE( fastId.has_value() && slowId.has_value() );
+	const auto start = SensorScheduler::Clock::now();
+
+	// Act
+	for( int tick = 0; tick < 20; ++tick )
+	{
+		scheduler.runDue( start + tick * 1ms );
+	}
+
+	// Assert
+	const auto fastStats = scheduler.statistics( *fastId );
+	const auto slowStats = scheduler.statistics( *slowId );
+	ASSERT_TRUE( fastStats.has_value() && slowStats.has_value() );
+	EXPECT_EQ( fastStats->releases, 20u );
+	EXPECT_EQ( slowStats->releases, 2u );
+	EXPECT_EQ( scheduler.statistics().cycles, 20u );
+	EXPECT_FALSE( scheduler.statistics( 1234 ).has_value() );
+}
+
+TEST( SensorSchedulerTests, SkippedReleasesAreDeadlineMisses )
+{
+	// Arrange
+	BusController busController{ makeBus() };
+	SensorScheduler scheduler{ busController };
+	const auto id = scheduler.addTask( 1ms, [] {} );
+	ASSERT_TRUE( id.has_value() );
+	const auto start = SensorScheduler::Clock::now();
+
+	// Act, the scheduler oversleeps by five and a half periods
+	scheduler.runDue( start );
+	const auto next = scheduler.runDue( start + 6500us );
+
+	// Assert
+	const auto stats = scheduler.statistics( *id );
+	ASSERT_TRUE( stats.has_value() );
+	EXPECT_EQ( stats->releases, 2u );
+	EXPECT_GE( stats->deadlineMisses, 5u );
+	EXPECT_GE( stats->maxJitter, 500us );
+	ASSERT_TRUE( next.has_value() );
+	EXPECT_GT( *next, start + 6500us ); // Back on the time grid, no catch up burst
+	EXPECT_LE( *next, start + 7500us );
+}
+
+TEST( SensorSchedulerTests, ReadsPrecedeJobsInRateMonotonicOrder )
+{
+	// Arrange
+	BusController busController{ makeBus() };
+	SensorScheduler scheduler{ busController };
+	std::vector< int > order;
+
+	ASSERT_TRUE( scheduler.addTask( 50ms, [ & ] { order.push_back( 4 ); } ).has_value() );
+	ASSERT_TRUE( scheduler.addTask( 5ms, [ & ] { order.push_back( 3 ); } ).has_value() );
+	ASSERT_TRUE( scheduler.addRead( 0x48, 0x00, 2, 100ms, [ & ]( Data ) { order.push_back( 2 ); } ).has_value() );
+	ASSERT_TRUE( scheduler.addRead( 0x68, 0x3B, 6, 1ms, [ & ]( Data ) { order.push_back( 1 ); } ).has_value() );
+
+	// Act
+	scheduler.runDue( SensorScheduler::Clock::now() );
+
+	// Assert
+	EXPECT_EQ( order, ( std::vector< int >{ 1, 2, 3, 4 } ) );
+}
+
+TEST( SensorSchedulerTests, FailedReadsAreReported )
+{
+	// Arrange
+	BusController busController{ makeBus() };
+	SensorScheduler scheduler{ busController };
+	std::optional< utils::ErrorCode > error;
+	const auto id = scheduler.addRead( 0x77, 0xAA, 22, 10ms, [ & ]( Data rslt ) {
+		if( !rslt )
+		{
+			error = rslt.error();
+		}
+	} );
+	ASSERT_TRUE( id.has_value() );
+
+	// Act
+	scheduler.runDue( SensorScheduler::Clock::now() );
+
+	// Assert
+	EXPECT_EQ( error, utils::ErrorCode::NACK_RECEIVED );
+	EXPECT_EQ( scheduler.statistics( *id )->failures, 1u );
+	EXPECT_TRUE( scheduler.remove( *id ) );
+	EXPECT_FALSE( scheduler.remove( *id ) );
+	EXPECT_FALSE( scheduler.runDue( SensorScheduler::Clock::now() ).has_value() );
+}
+
+TEST( SensorSchedulerTests, FailedReadDoesNotFailTheOtherReads )
+{
+	// Arrange
+	BusController busController{ makeBus() };
+	SensorScheduler scheduler{ busController };
+	std::vector< std::uint8_t > lm75, missing{ 0xFF };
+
+	ASSERT_TRUE( scheduler.addRead( 0x48, 0x00, 2, 10ms, store( lm75 ) ).has_value() );
+	const auto id = scheduler.addRead( 0x77, 0xAA, 22, 10ms, store( missing ) );
+	ASSERT_TRUE( id.has_value() );
+
+	// Act
+	scheduler.runDue( SensorScheduler::Clock::now() );
+
+	// Assert, the shared transfer failed and both reads were repeated alone
+	EXPECT_EQ( lm75, ( std::vector< std::uint8_t >{ 0x19, 0x00 } ) );
+	EXPECT_TRUE( missing.empty() );
+	EXPECT_EQ( scheduler.statistics( *id )->failures, 1u );
+	EXPECT_EQ( scheduler.statistics().transfers, 3u );
+}
+
+TEST( SensorSchedulerTests, NonIdempotentReadIsNotRepeated )
+{
+	// Arrange
+	BusController busController{ makeBus() };
+	SensorScheduler scheduler{ busController };
+	std::vector< std::uint8_t > status{ 0xFF }, missing{ 0xFF };
+
+	// INT_STATUS clears on read, the shared transfer may have read it already
+	const auto id = scheduler.addRead( 0x68, 0x3A, 1, 10ms, store( status ), Idempotency::NON_IDEMPOTENT );
+	ASSERT_TRUE( id.has_value() );
+	ASSERT_TRUE( scheduler.addRead( 0x77, 0xAA, 22, 10ms, store( missing ) ).has_value() );
+
+	// Act
+	scheduler.runDue( SensorScheduler::Clock::now() );
+
+	// Assert, only the read of the missing device was repeated
+	EXPECT_TRUE( status.empty() );
+	EXPECT_TRUE( missing.empty() );
+	EXPECT_EQ( scheduler.statistics( *id )->failures, 1u );
+	EXPECT_EQ( scheduler.statistics().transfers, 2u );
+}
+
+TEST( SensorSchedulerTests, ThreadPollsAtTheRegisteredRates )
+{
+	// Arrange
+	BusController busController{ makeBus() };
+	SensorScheduler scheduler{ busController };
+	std::atomic< int > fast{}, slow{};
+	const auto fastId = scheduler.addRead( 0x68, 0x3B, 6, 5ms, [ & ]( Data ) { ++fast; } );
+	const auto slowId = scheduler.addRead( 0x48, 0x00, 2, 50ms, [ & ]( Data ) { ++slow; } );
+	ASSERT_TRUE( fastId.has_value() && slowId.has_value() );
+
+	// Act
+	ASSERT_TRUE( scheduler.start().has_value() );
+	EXPECT_TRUE( scheduler.running() );
+	std::this_thread::sleep_for( 200ms );
+	scheduler.stop();
+
+	// Assert
+	EXPECT_FALSE( scheduler.running() );
+	EXPECT_GE( fast.load(), 20 );
+	EXPECT_LE( fast.load(), 42 );
+	EXPECT_GE( slow.load(), 2 );
+	EXPECT_LE( slow.load(), 5 );
+	EXPECT_EQ( scheduler.statistics( *fastId )->releases, static_cast< std::uint64_t >( fast.load() ) );
+}
+
+} // namespace pbl::i2c
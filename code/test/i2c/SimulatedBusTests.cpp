@@ -0,0 +1,301 @@
+// PBL
+#include <i2c/Controllers.hpp>
+#include <i2c/SHT31Controller.hpp>
+#include <i2c/TMP102Controller.hpp>
+#include <i2c/SimulatedDevices.hpp>
+
+// C++
+#include <array>
+#include <chrono>
+#include <memory>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+using namespace std::chrono_literals;
+
+TEST( SimulatedBusTests, UnattachedDeviceIsNotAcknowledged )
+{
+	// Arrange
+	BusController busController{ std::make_unique< SimulatedBus >() };
+	std::uint8_t value{};
+
+	// Act
+	const bool rslt = busController.read( 0x48, 0x00, value );
+
+	// Assert
+	EXPECT_TRUE( busController.isOpen() );
+	EXPECT_FALSE( rslt );
+	EXPECT_FALSE( busController.lastError().empty() );
+}
+
+TEST( SimulatedBusTests, LM75ReportsTemperature )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& sensor = bus->attach< SimulatedLM75 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	LM75Controller lm75{ busController };
+
+	// Act
+	sensor.setTemperature( 21.5f );
+	const auto positive = lm75.getTemperatureC();
+	sensor.setTemperature( -10.125f );
+	const auto negative = lm75.getTemperatureC();
+
+	// Assert
+	ASSERT_TRUE( positive.has_value() );
+	EXPECT_FLOAT_EQ( positive.value(), 21.5f );
+	ASSERT_TRUE( negative.has_value() );
+	EXPECT_FLOAT_EQ( negative.value(), -10.125f );
+}
+
+TEST( SimulatedBusTests, LM75PowerModeRoundTrip )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedLM75 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	LM75Controller lm75{ busController };
+
+	// Act
+	const auto rslt = lm75.setPowerMode( LM75Controller::LOW_POWER );
+	const auto mode = lm75.getPowerMode();
+
+	// Assert
+	ASSERT_TRUE( rslt.has_value() );
+	ASSERT_TRUE( mode.has_value() );
+	EXPECT_EQ( mode.value(), LM75Controller::LOW_POWER );
+}
+
+TEST( SimulatedBusTests, TMP102ReportsTemperature )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& sensor = bus->attach< SimulatedTMP102 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	TMP102Controller tmp102{ busController };
+
+	// Act
+	sensor.setTemperature( 25.0625f );
+	const auto positive = tmp102.getTemperatureC();
+	sensor.setTemperature( -10.25f );
+	const auto negative = tmp102.getTemperatureC();
+
+	// Assert
+	ASSERT_TRUE( positive.has_value() );
+	EXPECT_FLOAT_EQ( positive.value(), 25.0625f );
+	ASSERT_TRUE( negative.has_value() );
+	EXPECT_FLOAT_EQ( negative.value(), -10.25f );
+}
+
+TEST( SimulatedBusTests, SHT31MeasuresTemperatureAndHumidity )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& sensor = bus->attach< SimulatedSHT31 >( 0x44 );
+	BusController busController{ std::move( bus ) };
+	SHT31Controller sht31{ busController };
+
+	sensor.setTemperature( 23.5f );
+	sensor.setHumidity( 45.0f );
+
+	// Act
+	const auto measurement = sht31.triggerMeasurement( SHT31Controller::Repeatability::HIGH );
+	const auto temperature = sht31.getTemperatureC();
+	const auto humidity = sht31.getHumidity();
+
+	// Assert
+	ASSERT_TRUE( measurement.has_value() );
+	ASSERT_TRUE( temperature.has_value() );
+	EXPECT_NEAR( temperature.value(), 23.5f, 0.01f );
+	ASSERT_TRUE( humidity.has_value() );
+	EXPECT_NEAR( humidity.value(), 45.0f, 0.01f );
+}
+
+TEST( SimulatedBusTests, SHT31ReadWithoutMeasurementFails )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedSHT31 >( 0x44 );
+	BusController busController{ std::move( bus ) };
+	SHT31Controller sht31{ busController };
+
+	// Act
+	const auto temperature = sht31.getTemperatureC();
+
+	// Assert
+	EXPECT_FALSE( temperature.has_value() );
+}
+
+TEST( SimulatedBusTests, BMP180CompensatesDatasheetExample )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedBMP180 >( 0x77 );
+	BusController busController{ std::move( bus ) };
+	BMP180Controller bmp180{ busController, BMP180Controller::DEFAULT, BMP180Controller::ULTRA_LOW_POWER };
+
+	// Act
+	const auto temperature = bmp180.getTrueTemperatureC();
+	const auto pressure = bmp180.getTruePressurePa();
+
+	// Assert
+	ASSERT_TRUE( temperature.has_value() );
+	EXPECT_NEAR( temperature.value(), 15.0f, 1e-4f );
+	ASSERT_TRUE( pressure.has_value() );
+	EXPECT_NEAR( pressure.value(), 69964.0f, 1.0f );
+	EXPECT_GT( pBus->sleptFor(), 0us );
+}
+
+TEST( SimulatedBusTests, MPU6050ReportsAngles )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& imu = bus->attach< SimulatedMPU6050 >( 0x68 );
+	BusController busController{ std::move( bus ) };
+	MPU6050Controller mpu6050{ busController };
+
+	imu.setAccelerometer( 0, 0, 16384 );
+	imu.setGyroscope( 0, 0, 131 );
+
+	// Act
+	const auto angles = mpu6050.angles();
+
+	// Assert
+	ASSERT_TRUE( angles.has_value() );
+	EXPECT_FLOAT_EQ( angles.value().x(), 0.0f );
+	EXPECT_FLOAT_EQ( angles.value().y(), 0.0f );
+	EXPECT_FLOAT_EQ( angles.value().z(), 1.0f );
+}
+
+TEST( SimulatedBusTests, MPU6050PowerModeWritesRegister )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& imu = bus->attach< SimulatedMPU6050 >( 0x68 );
+	BusController busController{ std::move( bus ) };
+	MPU6050Controller mpu6050{ busController };
+
+	// Act
+	const auto rslt = mpu6050.setPowerMode( MPU6050Controller::NORMAL );
+
+	// Assert
+	ASSERT_TRUE( rslt.has_value() );
+	EXPECT_EQ( imu.registerValue( 0x6B ) & 0x40, 0x00 );
+}
+
+TEST( SimulatedBusTests, PCA9685FrequencyAndDutyCycle )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& pwm = bus->attach< SimulatedPCA9685 >( 0x40 );
+	BusController busController{ std::move( bus ) };
+	PCA9685Controller pca9685{ busController };
+
+	// Act
+	const auto frequency = pca9685.setPWMFrequency( 50 );
+	const auto duty = pca9685.setPWM(
+		PCA9685Controller::CH3, PCA9685Controller::PWMState{ 100 }, PCA9685Controller::PWMState{ 2148 } );
+
+	// Assert
+	ASSERT_TRUE( frequency.has_value() );
+	EXPECT_EQ( pwm.prescale(), 121 );
+	ASSERT_TRUE( duty.has_value() );
+	EXPECT_EQ( pwm.onCount( 3 ), 100 );
+	EXPECT_EQ( pwm.offCount( 3 ), 2148 );
+}
+
+TEST( SimulatedBusTests, ADS1015GainUpdatesConfigRegister )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& adc = bus->attach< SimulatedADS1015 >( 0x48 );
+	BusController busController{ std::move( bus ) };
+	ADS1015Controller ads1015{ busController };
+
+	// Act
+	const auto rslt = ads1015.setGain( ADS1015Controller::Gain::FS_1_024V );
+
+	// Assert
+	ASSERT_TRUE( rslt.has_value() );
+	EXPECT_EQ( adc.registerValue( 0x01 ) & 0x0E00, 0x0600 );
+}
+
+TEST( SimulatedBusTests, MCP23017DrivesOutputsAndCapturesInterrupts )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto& expander = bus->attach< SimulatedMCP23017 >( 0x20 );
+	BusController busController{ std::move( bus ) };
+
+	// Act, port A outputs, port B inputs with interrupt on change
+	ASSERT_TRUE( busController.write( 0x20, 0x00, 0x00 ) );
+	ASSERT_TRUE( busController.write( 0x20, 0x12, 0xA5 ) );
+	ASSERT_TRUE( busController.write( 0x20, 0x05, 0xFF ) );
+	expander.setInputs( SimulatedMCP23017::Port::B, 0x3C );
+
+	std::uint8_t flags{};
+	std::uint8_t levels{};
+	std::uint8_t flagsAfterRead{};
+	ASSERT_TRUE( busController.read( 0x20, 0x0F, flags ) );
+	ASSERT_TRUE( busController.read( 0x20, 0x13, levels ) );
+	ASSERT_TRUE( busController.read( 0x20, 0x0F, flagsAfterRead ) );
+
+	// Assert
+	EXPECT_EQ( expander.outputs( SimulatedMCP23017::Port::A ), 0xA5 );
+	EXPECT_EQ( flags, 0x3C );
+	EXPECT_EQ( levels, 0x3C );
+	EXPECT_EQ( flagsAfterRead, 0x00 );
+}
+
+TEST( SimulatedBusTests, TransactionIsOneTransfer )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedLM75 >( 0x48 ).setTemperature( 20.0f );
+	bus->attach< SimulatedMPU6050 >( 0x68 ).setAccelerometer( 1, 2, 3 );
+	BusController busController{ std::move( bus ) };
+
+	Transaction tx;
+	std::array< std::uint8_t, 2 > temperature{};
+	std::array< std::uint8_t, 6 > accel{};
+	ASSERT_TRUE( tx.read( 0x48, 0x00, temperature ) );
+	ASSERT_TRUE( tx.read( 0x68, 0x3B, accel ) );
+
+	// Act
+	const bool rslt = busController.submit( tx );
+
+	// Assert
+	ASSERT_TRUE( rslt );
+	EXPECT_TRUE( tx.succeeded() );
+	EXPECT_EQ( pBus->transferCount(), 1u );
+	EXPECT_EQ( temperature[ 0 ], 20 );
+	EXPECT_EQ( accel[ 5 ], 3 );
+}
+
+TEST( SimulatedBusTests, LatencyDelaysTransfers )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedLM75 >( 0x48 );
+	bus->setLatency( 200us );
+	BusController busController{ std::move( bus ) };
+	std::uint8_t value{};
+
+	// Act
+	const auto start = std::chrono::steady_clock::now();
+	const bool rslt = busController.read( 0x48, 0x01, value );
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+
+	// Assert
+	EXPECT_TRUE( rslt );
+	EXPECT_GE( elapsed, 200us );
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,112 @@
+// PBL
+#include <i2c/BusController.hpp>
+#include <i2c/LM75Controller.hpp>
+#include <i2c/TMP102Controller.hpp>
+#include <i2c/SimulatedDevices.hpp>
+#include <i2c/TemperatureSensorGroup.hpp>
+
+// C++
+#include <array>
+#include <cmath>
+#include <memory>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+TEST( TemperatureSensorGroupTests, SweepIsOneTransfer )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	auto* pBus = bus.get();
+	bus->attach< SimulatedLM75 >( 0x48 ).setTemperature( 25.125f );
+	bus->attach< SimulatedLM75 >( 0x49 ).setTemperature( -10.5f );
+	bus->attach< SimulatedTMP102 >( 0x4A ).setTemperature( 31.0625f );
+	auto& extended = bus->attach< SimulatedTMP102 >( 0x4B );
+	extended.setRegisterValue( 0x01, 0x60B0 ); // EM set
+	extended.setTemperature( 140.5f );
+	BusController busController{ std::move( bus ) };
+
+	LM75Controller lm75a{ busController, LM75Controller::H48 };
+	LM75Controller lm75b{ busController, LM75Controller::H49 };
+	TMP102Controller tmp102a{ busController, TMP102Controller::H4A };
+	TMP102Controller tmp102b{ busController, TMP102Controller::H4B };
+
+	TemperatureSensorGroup group{ busController };
+	ASSERT_TRUE( group.add( lm75a ).has_value() );
+	ASSERT_TRUE( group.add( lm75b ).has_value() );
+	ASSERT_TRUE( group.add( tmp102a ).has_value() );
+	const auto index = group.add( tmp102b );
+	const auto transfers = pBus->transferCount();
+
+	// Act
+	std::array< float, 4 > temperatures{};
+	const auto count = group.readTemperaturesC( temperatures );
+
+	// Assert
+	ASSERT_TRUE( index.has_value() );
+	EXPECT_EQ( *index, 3u );
+	ASSERT_TRUE( count.has_value() );
+	EXPECT_EQ( *count, 4u );
+	EXPECT_EQ( pBus->transferCount() - transfers, 1u );
+	EXPECT_FLOAT_EQ( temperatures[ 0 ], 25.125f );
+	EXPECT_FLOAT_EQ( temperatures[ 1 ], -10.5f );
+	EXPECT_FLOAT_EQ( temperatures[ 2 ], 31.0625f );
+	EXPECT_FLOAT_EQ( temperatures[ 3 ], 140.5f ); // Beyond the 12-bit range
+}
+
+TEST( TemperatureSensorGroupTests, ResolutionIsApplied )
+{
+	// Arrange, a 9-bit LM75 leaves the low bits undefined
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedLM75 >( 0x48 ).setRegisterValue( 0x00, 0xE6FF ); // -25.5°C, noise below bit 7
+	BusController busController{ std::move( bus ) };
+	LM75Controller lm75{ busController };
+
+	TemperatureSensorGroup group{ busController };
+	const auto invalid = group.add( lm75, 8 );
+	ASSERT_TRUE( group.add( lm75, 9 ).has_value() );
+	const auto duplicate = group.add( lm75 );
+
+	// Act
+	std::array< float, 1 > temperatures{};
+	const auto count = group.readTemperaturesC( temperatures );
+	const auto tooSmall = group.readTemperaturesC( {} );
+
+	// Assert
+	ASSERT_FALSE( invalid.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( invalid.error() ), utils::ErrorCode::INVALID_ARGUMENT );
+	ASSERT_FALSE( duplicate.has_value() );
+	EXPECT_EQ( group.size(), 1u );
+	ASSERT_TRUE( count.has_value() );
+	EXPECT_FLOAT_EQ( temperatures[ 0 ], -25.5f );
+	ASSERT_FALSE( tooSmall.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( tooSmall.error() ), utils::ErrorCode::INVALID_ARGUMENT );
+}
+
+TEST( TemperatureSensorGroupTests, MissingSensorFailsTheSweep )
+{
+	// Arrange
+	auto bus = std::make_unique< SimulatedBus >();
+	bus->attach< SimulatedLM75 >( 0x48 ).setTemperature( 25.0f );
+	BusController busController{ std::move( bus ) };
+	LM75Controller present{ busController, LM75Controller::H48 };
+	LM75Controller missing{ busController, LM75Controller::H4F };
+
+	TemperatureSensorGroup group{ busController };
+	ASSERT_TRUE( group.add( present ).has_value() );
+	ASSERT_TRUE( group.add( missing ).has_value() );
+
+	// Act
+	std::array< float, 2 > temperatures{};
+	const auto count = group.readTemperaturesC( temperatures );
+
+	// Assert
+	ASSERT_FALSE( count.has_value() );
+	EXPECT_TRUE( std::isnan( temperatures[ 0 ] ) );
+	EXPECT_TRUE( std::isnan( temperatures[ 1 ] ) );
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,186 @@
+// PBL
+#include <i2c/Transaction.hpp>
+
+// C++
+#include <array>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::i2c
+{
+
+TEST( TransactionTests, DefaultTransactionIsEmpty )
+{
+	// Arrange
+	Transaction tx;
+
+	// Assert
+	EXPECT_TRUE( tx.empty() );
+	EXPECT_EQ( tx.size(), 0u );
+	EXPECT_EQ( tx.messageCount(), 0u );
+}
+
+TEST( TransactionTests, ReadOccupiesRegisterWriteAndReadMessages )
+{
+	// Arrange
+	Transaction tx;
+	std::array< std::uint8_t, 6 > data{};
+
+	// Act
+	ASSERT_TRUE( tx.read( 0x68, 0x3B, data ) );
+
+	// Assert
+	ASSERT_EQ( tx.messageCount(), 2u );
+	const auto messages = tx.messages();
+
+	EXPECT_EQ( messages[ 0 ].address, 0x68 );
+	EXPECT_FALSE( messages[ 0 ].read );
+	ASSERT_EQ( messages[ 0 ].buffer.size(), 1u );
+	EXPECT_EQ( messages[ 0 ].buffer[ 0 ], 0x3B );
+
+	EXPECT_EQ( messages[ 1 ].address, 0x68 );
+	EXPECT_TRUE( messages[ 1 ].read );
+	EXPECT_EQ( messages[ 1 ].buffer.data(), data.data() );
+	EXPECT_EQ( messages[ 1 ].buffer.size(), data.size() );
+}
+
+TEST( TransactionTests, PlainReadOccupiesOneMessage )
+{
+	// Arrange
+	Transaction tx;
+	std::array< std::uint8_t, 6 > data{};
+
+	// Act
+	ASSERT_TRUE( tx.read( 0x44, data ) );
+
+	// Assert
+	ASSERT_EQ( tx.size(), 1u );
+	ASSERT_EQ( tx.messageCount(), 1u );
+	const auto message = tx.messages()[ 0 ];
+	EXPECT_EQ( message.address, 0x44 );
+	EXPECT_TRUE( message.read );
+	EXPECT_EQ( message.buffer.data(), data.data() );
+	EXPECT_EQ( message.buffer.size(), data.size() );
+	EXPECT_FALSE( tx.read( 0x44, std::span< std::uint8_t >{} ) );
+}
+
+TEST( TransactionTests, WriteCopiesRegisterAndPayload )
+{
+	// Arrange
+	Transaction tx;
+	const std::array< std::uint8_t, 3 > payload{ 0x01, 0x02, 0x03 };
+
+	// Act
+	ASSERT_TRUE( tx.write( 0x40, 0x06, payload ) );
+
+	// Assert
+	ASSERT_EQ( tx.messageCount(), 1u );
+	const auto& message = tx.messages()[ 0 ];
+
+	EXPECT_EQ( message.address, 0x40 );
+	EXPECT_FALSE( message.read );
+	ASSERT_EQ( message.buffer.size(), 4u );
+	EXPECT_EQ( message.buffer[ 0 ], 0x06 );
+	EXPECT_EQ( message.buffer[ 1 ], 0x01 );
+	EXPECT_EQ( message.buffer[ 2 ], 0x02 );
+	EXPECT_EQ( message.buffer[ 3 ], 0x03 );
+}
+
+TEST( TransactionTests, OperationsToDifferentDevicesKeepTheirOrder )
+{
+	// Arrange
+	Transaction tx;
+	std::uint8_t config{};
+	std::array< std::uint8_t, 2 > temperature{};
+
+	// Act
+	ASSERT_TRUE( tx.read( 0x48, 0x00, temperature ) );
+	ASSERT_TRUE( tx.write( 0x20, 0x12, 0xFF ) );
+	ASSERT_TRUE( tx.read( 0x77, 0xD0, config ) );
+
+	// Assert
+	EXPECT_EQ( tx.size(), 3u );
+	ASSERT_EQ( tx.messageCount(), 5u );
+
+	const auto messages = tx.messages();
+	EXPECT_EQ( messages[ 0 ].address, 0x48 );
+	EXPECT_EQ( messages[ 2 ].address, 0x20 );
+	EXPECT_EQ( messages[ 4 ].address, 0x77 );
+	EXPECT_EQ( messages[ 4 ].buffer.data(), &config );
+}
+
+TEST( TransactionTests, RejectsOperationsBeyondKernelMessageLimit )
+{
+	// Arrange
+	Transaction tx;
+	std::array< std::uint8_t, Transaction::kMaxMessages > data{};
+
+	// Act, every read takes two messages
+	for( std::size_t i = 0; i < Transaction::kMaxMessages / 2; ++i )
+	{
+		ASSERT_TRUE( tx.read( 0x48, 0x00, data[ i ] ) );
+	}
+
+	// Assert
+	EXPECT_EQ( tx.messageCount(), Transaction::kMaxMessages );
+	EXPECT_FALSE( tx.read( 0x48, 0x00, data.back() ) );
+	EXPECT_FALSE( tx.write( 0x48, 0x01, 0x00 ) );
+	EXPECT_EQ( tx.size(), Transaction::kMaxMessages / 2 );
+}
+
+TEST( TransactionTests, RejectsWritesExceedingPayloadCapacity )
+{
+	// Arrange
+	Transaction tx;
+	const std::array< std::uint8_t, Transaction::kMaxWriteBytes > payload{};
+
+	// Act & Assert, register byte does not fit next to a full payload
+	EXPECT_FALSE( tx.write( 0x40, 0x06, payload ) );
+	EXPECT_TRUE( tx.empty() );
+}
+
+TEST( TransactionTests, RejectsEmptyReads )
+{
+	// Arrange
+	Transaction tx;
+
+	// Act & Assert
+	EXPECT_FALSE( tx.read( 0x48, 0x00, std::span< std::uint8_t >{} ) );
+	EXPECT_TRUE( tx.empty() );
+}
+
+TEST( TransactionTests, ResultOfUnsubmittedOperationIsPending )
+{
+	// Arrange
+	Transaction tx;
+	ASSERT_TRUE( tx.write( 0x48, 0x01, 0x00 ) );
+
+	// Act
+	const auto pending = tx.result( 0 );
+	const auto outOfRange = tx.result( 1 );
+
+	// Assert
+	ASSERT_FALSE( pending.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( pending.error() ), utils::ErrorCode::BUS_BUSY );
+	ASSERT_FALSE( outOfRange.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( outOfRange.error() ), utils::ErrorCode::INVALID_ARGUMENT );
+	EXPECT_FALSE( tx.succeeded() );
+}
+
+TEST( TransactionTests, ClearAllowsReuse )
+{
+	// Arrange
+	Transaction tx;
+	ASSERT_TRUE( tx.write( 0x48, 0x01, 0x00 ) );
+
+	// Act
+	tx.clear();
+
+	// Assert
+	EXPECT_TRUE( tx.empty() );
+	EXPECT_EQ( tx.messageCount(), 0u );
+	EXPECT_TRUE( tx.write( 0x48, 0x01, 0x00 ) );
+}
+
+} // namespace pbl::i2c
@@ -0,0 +1,68 @@
+// PBL
+#include <spi/LoopbackTransport.hpp>
+
+// C++
+#include <array>
+#include <cstdint>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::spi
+{
+
+TEST( LoopbackTransportTests, SegmentsAreOneMessage )
+{
+	// Arrange
+	LoopbackTransport transport;
+	const std::array< std::uint8_t, 2 > command{ 0x9F, 0x01 };
+	std::array< std::uint8_t, 2 > echo{};
+	std::array< std::uint8_t, 3 > response{ 0xFF, 0xFF, 0xFF };
+	const std::array segments{
+		Segment{ .tx = command, .rx = echo, .config = { .csChange = true } },
+		Segment{ .tx = command }, // Transmit only
+		Segment{ .rx = response }, // Receive only
+	};
+
+	// Act
+	const auto rslt = transport.transfer( segments );
+
+	// Assert
+	ASSERT_TRUE( rslt.has_value() );
+	EXPECT_EQ( echo, command );
+	EXPECT_EQ( response, ( std::array< std::uint8_t, 3 >{} ) ); // Zeros clocked out
+	EXPECT_EQ( transport.messages(), 1u );
+	EXPECT_EQ( transport.bytes(), 7u );
+	EXPECT_EQ( transport.selects(), 2u );
+}
+
+TEST( LoopbackTransportTests, MalformedMessagesAreRejected )
+{
+	// Arrange
+	LoopbackTransport transport{ 8 };
+	std::array< std::uint8_t, 4 > small{};
+	std::array< std::uint8_t, 5 > other{};
+	const std::array mismatched{ Segment{ .tx = small, .rx = other } };
+	const std::array empty{ Segment{} };
+	const std::array tooLarge{ Segment{ .tx = small }, Segment{ .tx = other } }; // 9 bytes sent
+	const std::array halfDuplex{ Segment{ .tx = small }, Segment{ .rx = small } }; // 4 bytes each way
+
+	// Act
+	const auto rslt1 = transport.transfer( mismatched );
+	const auto rslt2 = transport.transfer( empty );
+	const auto rslt3 = transport.transfer( tooLarge );
+	const auto rslt4 = transport.transfer( {} );
+	const auto rslt5 = transport.transfer( halfDuplex );
+
+	// Assert
+	for( const auto* pRslt : { &rslt1, &rslt2, &rslt3, &rslt4 } )
+	{
+		ASSERT_FALSE( pRslt->has_value() );
+		EXPECT_EQ( static_cast< utils::ErrorCode >( pRslt->error() ), utils::ErrorCode::INVALID_ARGUMENT );
+	}
+
+	EXPECT_TRUE( rslt5.has_value() );
+	EXPECT_EQ( transport.messages(), 1u );
+}
+
+} // namespace pbl::spi
@@ -0,0 +1,186 @@
+// PBL
+#include <spi/MCP3008Controller.hpp>
+#include <utils/RingBuffer.hpp>
+
+// C++
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::spi
+{
+
+namespace
+{
+
+/// Answers MCP3008 conversion frames with fixed input codes, a frame converts only on a fresh chip select.
+class SimulatedMCP3008 final : public Transport
+{
+public:
+	explicit SimulatedMCP3008( const std::array< std::uint16_t, 8 >& codes )
+		: m_codes{ codes }
+	{ }
+
+	[[nodiscard]] Result< void > transfer( std::span< const Segment > segments ) override
+	{
+		if( auto rslt = validate( segments, maxMessageSize() ); !rslt )
+		{
+			return rslt;
+		}
+
+		if( m_failing.load() )
+		{
+			return utils::MakeError( utils::ErrorCode::FAILED_TO_WRITE );
+		}
+
+		bool selected{ false };
+		for( const auto& segment : segments )
+		{
+			if( segment.tx.size() != 3 || segment.rx.size() != 3 )
+			{
+				return utils::MakeError( utils::ErrorCode::INVALID_ARGUMENT );
+			}
+
+			std::fill( segment.rx.begin(), segment.rx.end(), std::uint8_t{} );
+			if( !selected && ( segment.tx[ 0 ] & 0x01 ) != 0 )
+			{
+				const auto input = segment.tx[ 1 ] >> 4;
+				const auto channel = input & 0x07;
+				const int code = ( input & 0x08 ) != 0 ? m_codes[ channel ]
+													   : m_codes[ channel ] - m_codes[ channel ^ 1 ];
+				const auto clamped = static_cast< std::uint16_t >( std::max( code, 0 ) );
+
+				segment.rx[ 1 ] = static_cast< std::uint8_t >( 0xF8 | ( clamped >> 8 ) ); // Undriven bits high
+				segment.rx[ 2 ] = static_cast< std::uint8_t >( clamped & 0xFF );
+				m_conversions.fetch_add( 1 );
+			}
+
+			selected = !segment.config.csChange;
+			m_speedHz.store( segment.config.speedHz );
+		}
+
+		m_messages.fetch_add( 1 );
+		return utils::MakeSuccess();
+	}
+
+	[[nodiscard]] std::size_t maxMessageSize() const noexcept override { return 4096; }
+
+	void setFailing( const bool failing ) noexcept { m_failing.store( failing ); }
+
+	[[nodiscard]] std::uint64_t messages() const noexcept { return m_messages.load(); }
+	[[nodiscard]] std::uint64_t conversions() const noexcept { return m_conversions.load(); }
+	[[nodiscard]] std::uint32_t speedHz() const noexcept { return m_speedHz.load(); }
+
+private:
+	const std::array< std::uint16_t, 8 > m_codes;
+	std::atomic_bool m_failing{ false };
+	std::atomic< std::uint64_t > m_messages{};
+	std::atomic< std::uint64_t > m_conversions{};
+	std::atomic< std::uint32_t > m_speedHz{};
+};
+
+constexpr std::array< std::uint16_t, 8 > kCodes{ 0, 1, 255, 256, 512, 700, 1000, 1023 };
+
+} // namespace
+
+TEST( MCP3008ControllerTests, SingleConversions )
+{
+	// Arrange
+	SimulatedMCP3008 device{ kCodes };
+	MCP3008Controller adc{ device, 3.3f, MCP3008Controller::kMaxClockHzLowVoltage };
+
+	// Act
+	const auto single = adc.readSingleEnded( MCP3008Controller::Channel::CH6 );
+	const auto positive = adc.readDifferential( MCP3008Controller::DifferentialPair::CH5_CH4 );
+	const auto negative = adc.readDifferential( MCP3008Controller::DifferentialPair::CH4_CH5 );
+	const auto invalid = adc.readSingleEnded( static_cast< MCP3008Controller::Channel >( 8 ) );
+
+	// Assert
+	ASSERT_TRUE( single.has_value() );
+	EXPECT_EQ( *single, 1000u );
+	ASSERT_TRUE( positive.has_value() );
+	EXPECT_EQ( *positive, 188u );
+	ASSERT_TRUE( negative.has_value() );
+	EXPECT_EQ( *negative, 0u );
+	ASSERT_FALSE( invalid.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( invalid.error() ), utils::ErrorCode::INVALID_ARGUMENT );
+	EXPECT_EQ( device.speedHz(), MCP3008Controller::kMaxClockHzLowVoltage );
+	EXPECT_FLOAT_EQ( adc.toVolts( 512 ), 1.65f );
+}
+
+TEST( MCP3008ControllerTests, ScanIsOneMessage )
+{
+	// Arrange
+	SimulatedMCP3008 device{ kCodes };
+	MCP3008Controller adc{ device };
+	std::array< std::uint16_t, MCP3008Controller::kChannels > codes{};
+
+	// Act
+	const auto rslt = adc.scan( codes );
+
+	// Assert, every frame got its own chip select
+	ASSERT_TRUE( rslt.has_value() );
+	EXPECT_EQ( codes, kCodes );
+	EXPECT_EQ( device.messages(), 1u );
+	EXPECT_EQ( device.conversions(), 8u );
+	EXPECT_EQ( device.speedHz(), MCP3008Controller::kMaxClockHz );
+}
+
+TEST( MCP3008ControllerTests, ContinuousModeFeedsTheRing )
+{
+	// Arrange
+	SimulatedMCP3008 device{ kCodes };
+	MCP3008Controller adc{ device };
+	utils::RingBuffer< MCP3008Controller::Scan > ring{ 64 };
+	const auto before = MCP3008Controller::Clock::now();
+
+	// Act
+	const auto notStarted = adc.readContinuous( ring );
+	ASSERT_TRUE( adc.startContinuous( 4 ).has_value() );
+	const auto restarted = adc.startContinuous( 4 );
+	const auto read = adc.readContinuous( ring );
+	adc.stopContinuous();
+
+	// Assert
+	ASSERT_FALSE( notStarted.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( notStarted.error() ), utils::ErrorCode::UNSUPPORTED_OPERATION );
+	ASSERT_FALSE( restarted.has_value() );
+	ASSERT_TRUE( read.has_value() );
+	EXPECT_GE( *read, 4u );
+	EXPECT_EQ( ring.size(), std::min< std::size_t >( *read, ring.capacity() ) );
+	EXPECT_FALSE( adc.continuousRunning() );
+
+	auto previous = before;
+	while( auto scan = ring.pop() )
+	{
+		EXPECT_EQ( scan->codes, kCodes );
+		EXPECT_LE( previous, scan->timestamp );
+		previous = scan->timestamp;
+	}
+}
+
+TEST( MCP3008ControllerTests, FailedTransferStopsContinuousMode )
+{
+	// Arrange
+	SimulatedMCP3008 device{ kCodes };
+	device.setFailing( true );
+	MCP3008Controller adc{ device };
+	utils::RingBuffer< MCP3008Controller::Scan > ring{ 8 };
+
+	// Act
+	ASSERT_TRUE( adc.startContinuous().has_value() );
+	const auto rslt = adc.readContinuous( ring );
+
+	// Assert
+	ASSERT_FALSE( rslt.has_value() );
+	EXPECT_EQ( static_cast< utils::ErrorCode >( rslt.error() ), utils::ErrorCode::FAILED_TO_READ );
+	EXPECT_FALSE( adc.continuousRunning() );
+	EXPECT_EQ( adc.continuousStatistics().failures, 1u );
+	EXPECT_TRUE( ring.empty() );
+}
+
+} // namespace pbl::spi
@@ -0,0 +1,206 @@
+// PBL
+#include <spi/StreamingEngine.hpp>
+#include <spi/LoopbackTransport.hpp>
+
+// C++
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::spi
+{
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+// MCP3008 style single-ended conversions of CH0 and CH1, the device is deselected after each
+constexpr std::array< std::uint8_t, 3 > kChannel0{ 0x01, 0x80, 0x00 };
+constexpr std::array< std::uint8_t, 3 > kChannel1{ 0x01, 0x90, 0x00 };
+
+const std::array kMessage{
+	StreamingEngine::Step{ .tx = kChannel0, .rxSize = 3, .config = { .csChange = true } },
+	StreamingEngine::Step{ .tx = kChannel1, .rxSize = 3, .config = { .csChange = true } },
+};
+
+/// A loopback device counting the messages prepared and the path every message took.
+class CountingTransport final : public Transport
+{
+public:
+	[[nodiscard]] Result< void > transfer( std::span< const Segment > segments ) override
+	{
+		m_transfers.fetch_add( 1 );
+		return m_loopback.transfer( segments );
+	}
+
+	[[nodiscard]] std::size_t maxMessageSize() const noexcept override { return m_loopback.maxMessageSize(); }
+
+	[[nodiscard]] Result< std::unique_ptr< PreparedMessage > >
+	prepare( std::span< const Segment > segments ) const override
+	{
+		m_prepares.fetch_add( 1 );
+		return Transport::prepare( segments );
+	}
+
+	[[nodiscard]] Result< void > transferPrepared( const PreparedMessage& message ) override
+	{
+		m_preparedTransfers.fetch_add( 1 );
+		return m_loopback.transfer( message.segments() );
+	}
+
+	[[nodiscard]] std::uint64_t prepares() const noexcept { return m_prepares.load(); }
+	[[nodiscard]] std::uint64_t transfers() const noexcept { return m_transfers.load(); }
+	[[nodiscard]] std::uint64_t preparedTransfers() const noexcept { return m_preparedTransfers.load(); }
+
+private:
+	LoopbackTransport m_loopback;
+	mutable std::atomic< std::uint64_t > m_prepares{};
+	std::atomic< std::uint64_t > m_transfers{};
+	std::atomic< std::uint64_t > m_preparedTransfers{};
+};
+
+} // namespace
+
+TEST( StreamingEngineTests, BlocksHoldTheReceivedData )
+{
+	// Arrange
+	LoopbackTransport transport;
+	transport.setLatency( 50us );
+	StreamingEngine engine{ transport, kMessage, { .messagesPerBlock = 2 } };
+
+	// Act
+	ASSERT_TRUE( engine.start().has_value() );
+	std::vector< StreamingEngine::Block > blocks;
+	for( int i{}; i < 3; ++i )
+	{
+		auto block = engine.acquire();
+		ASSERT_TRUE( block.has_value() );
+		blocks.push_back( *block );
+
+		const std::vector< std::uint8_t > data{ block->data.begin(), block->data.end() };
+		const std::vector< std::uint8_t > expected{ 0x01, 0x80, 0x00, 0x01, 0x90, 0x00,
+													0x01, 0x80, 0x00, 0x01, 0x90, 0x00 };
+		EXPECT_EQ( data, expected );
+		engine.release( *block );
+	}
+
+	engine.stop();
+
+	// Assert
+	EXPECT_EQ( engine.blockSize(), 12u );
+	EXPECT_FALSE( engine.running() );
+	EXPECT_LT( blocks[ 0 ].sequence, blocks[ 1 ].sequence );
+	EXPECT_LT( blocks[ 1 ].sequence, blocks[ 2 ].sequence );
+	EXPECT_LE( blocks[ 0 ].start, blocks[ 0 ].end );
+	EXPECT_LE( blocks[ 0 ].end, blocks[ 1 ].start );
+	EXPECT_GE( engine.statistics().blocks, 3u );
+	EXPECT_EQ( engine.statistics().failures, 0u );
+}
+
+TEST( StreamingEngineTests, MessagesArePreparedOnce )
+{
+	// Arrange
+	CountingTransport transport;
+	StreamingEngine engine{ transport, kMessage, { .messagesPerBlock = 2 } };
+
+	// Act, a restart reuses the prepared messages
+	for( int run{}; run < 2; ++run )
+	{
+		ASSERT_TRUE( engine.start().has_value() );
+		auto block = engine.acquire();
+		ASSERT_TRUE( block.has_value() );
+		engine.release( *block );
+		engine.stop();
+	}
+
+	// Assert, two messages for each of the two buffers and the scratch buffer
+	EXPECT_EQ( transport.prepares(), 6u );
+	EXPECT_EQ( transport.transfers(), 0u );
+	EXPECT_GE( transport.preparedTransfers(), 4u );
+}
+
+TEST( StreamingEngineTests, HeldBuffersCountOverruns )
+{
+	// Arrange
+	LoopbackTransport transport;
+	transport.setLatency( 100us );
+	StreamingEngine engine{ transport, kMessage };
+	ASSERT_TRUE( engine.start().has_value() );
+
+	// Act, the consumer keeps both buffers
+	const auto first = engine.acquire();
+	const auto second = engine.acquire();
+	ASSERT_TRUE( first.has_value() && second.has_value() );
+
+	const auto deadline = std::chrono::steady_clock::now() + 5s;
+	while( engine.statistics().overruns < 3 && std::chrono::steady_clock::now() < deadline )
+	{
+		std::this_thread::sleep_for( 1ms );
+	}
+
+	const auto overruns = engine.statistics().overruns;
+	engine.release( *first );
+	engine.release( *second );
+	const auto next = engine.acquire();
+
+	// Assert, the dropped blocks leave a gap in the sequence
+	ASSERT_GE( overruns, 3u );
+	ASSERT_TRUE( next.has_value() );
+	EXPECT_GE( next->sequence, second->sequence + 1 + overruns );
+}
+
+TEST( StreamingEngineTests, FailureStopsTheEngine )
+{
+	// Arrange
+	LoopbackTransport transport;
+	transport.setFailing( true );
+	StreamingEngine engine{ transport, kMessage };
+
+	// Act
+	ASSERT_TRUE( engine.start().has_value() );
+	const auto failed = engine.acquire();
+	const bool runningAfterFailure = engine.running();
+
+	transport.setFailing( false );
+	const auto restarted = engine.start();
+	const auto block = engine.acquire();
+
+	// Assert
+	EXPECT_FALSE( failed.has_value() );
+	EXPECT_FALSE( runningAfterFailure );
+	EXPECT_EQ( engine.statistics().failures, 1u );
+	ASSERT_TRUE( restarted.has_value() );
+	ASSERT_TRUE( block.has_value() );
+	EXPECT_EQ( block->sequence, 0u );
+}
+
+TEST( StreamingEngineTests, MalformedMessageIsRejected )
+{
+	// Arrange
+	LoopbackTransport transport{ 4 };
+	const std::array mismatched{ StreamingEngine::Step{ .tx = kChannel0, .rxSize = 2 } };
+	StreamingEngine mismatchedEngine{ transport, mismatched };
+	StreamingEngine emptyEngine{ transport, {} };
+	StreamingEngine tooLargeEngine{ transport, kMessage }; // 6 bytes per message
+
+	// Act
+	const auto rslt1 = mismatchedEngine.start();
+	const auto rslt2 = emptyEngine.start();
+	const auto rslt3 = tooLargeEngine.start();
+
+	// Assert
+	for( const auto* pRslt : { &rslt1, &rslt2, &rslt3 } )
+	{
+		ASSERT_FALSE( pRslt->has_value() );
+		EXPECT_EQ( static_cast< utils::ErrorCode >( pRslt->error() ), utils::ErrorCode::INVALID_ARGUMENT );
+	}
+}
+
+} // namespace pbl::spi
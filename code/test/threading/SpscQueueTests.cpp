@@ -0,0 +1,86 @@
+// PBL
+#include <threading/SpscQueue.hpp>
+
+// C++
+#include <thread>
+#include <cstdint>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::threading
+{
+
+TEST( SpscQueueTests, CapacityIsRoundedUpToAPowerOfTwo )
+{
+	// Arrange
+	SpscQueue< int > queue{ 5 };
+
+	// Assert
+	EXPECT_EQ( queue.capacity(), 8u );
+	EXPECT_TRUE( queue.empty() );
+}
+
+TEST( SpscQueueTests, PushFailsWhenFull )
+{
+	// Arrange
+	SpscQueue< int > queue{ 2 };
+
+	// Act
+	const bool first = queue.push( 1 );
+	const bool second = queue.push( 2 );
+	const bool third = queue.push( 3 );
+	const auto popped = queue.pop();
+	const bool fourth = queue.push( 4 );
+
+	// Assert
+	EXPECT_TRUE( first );
+	EXPECT_TRUE( second );
+	EXPECT_FALSE( third );
+	ASSERT_TRUE( popped.has_value() );
+	EXPECT_EQ( *popped, 1 );
+	EXPECT_TRUE( fourth );
+	EXPECT_EQ( queue.pop(), 2 );
+	EXPECT_EQ( queue.pop(), 4 );
+	EXPECT_FALSE( queue.pop().has_value() );
+}
+
+TEST( SpscQueueTests, ElementsCrossThreadsInOrder )
+{
+	// Arrange
+	constexpr std::uint32_t kCount{ 10'000 };
+	SpscQueue< std::uint32_t > queue{ 64 };
+
+	// Act
+	std::jthread producer{ [ &queue ] {
+		for( std::uint32_t i = 0; i < kCount; )
+		{
+			if( queue.push( i ) )
+			{
+				++i;
+				continue;
+			}
+
+			std::this_thread::yield();
+		}
+	} };
+
+	bool ordered{ true };
+	for( std::uint32_t expected = 0; expected < kCount; )
+	{
+		if( const auto value = queue.pop() )
+		{
+			ordered &= *value == expected;
+			++expected;
+			continue;
+		}
+
+		std::this_thread::yield();
+	}
+
+	// Assert
+	EXPECT_TRUE( ordered );
+	EXPECT_TRUE( queue.empty() );
+}
+
+} // namespace pbl::threading
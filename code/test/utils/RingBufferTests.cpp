@@ -0,0 +1,66 @@
+// PBL
+#include <utils/RingBuffer.hpp>
+
+// Third Party
+#include <gtest/gtest.h>
+
+namespace pbl::utils
+{
+
+TEST( RingBufferTest, PopsInPushOrder )
+{
+	RingBuffer< int > ring{ 3 };
+	EXPECT_TRUE( ring.empty() );
+	EXPECT_TRUE( ring.push( 1 ) );
+	EXPECT_TRUE( ring.push( 2 ) );
+	EXPECT_EQ( ring.size(), 2u );
+	EXPECT_EQ( ring.front(), 1 );
+	EXPECT_EQ( ring.back(), 2 );
+	EXPECT_EQ( ring.pop(), 1 );
+	EXPECT_EQ( ring.pop(), 2 );
+	EXPECT_FALSE( ring.pop().has_value() );
+}
+
+TEST( RingBufferTest, FullRingOverwritesTheOldest )
+{
+	RingBuffer< int > ring{ 3 };
+	for( int i = 0; i < 3; ++i )
+	{
+		EXPECT_TRUE( ring.push( i ) );
+	}
+
+	EXPECT_TRUE( ring.full() );
+	EXPECT_FALSE( ring.push( 3 ) );
+	EXPECT_FALSE( ring.push( 4 ) );
+	EXPECT_EQ( ring.size(), 3u );
+	EXPECT_EQ( ring.dropped(), 2u );
+	EXPECT_EQ( ring[ 0 ], 2 );
+	EXPECT_EQ( ring[ 1 ], 3 );
+	EXPECT_EQ( ring[ 2 ], 4 );
+}
+
+TEST( RingBufferTest, WrapsAroundTheStorage )
+{
+	RingBuffer< int > ring{ 2 };
+	for( int i = 0; i < 5; ++i )
+	{
+		ring.push( i );
+		EXPECT_EQ( ring.pop(), i );
+	}
+
+	EXPECT_EQ( ring.dropped(), 0u );
+	ring.push( 5 );
+	ring.clear();
+	EXPECT_TRUE( ring.empty() );
+	EXPECT_EQ( ring.capacity(), 2u );
+}
+
+TEST( RingBufferTest, ZeroCapacityDropsEverything )
+{
+	RingBuffer< int > ring;
+	EXPECT_FALSE( ring.push( 1 ) );
+	EXPECT_TRUE( ring.empty() );
+	EXPECT_EQ( ring.dropped(), 1u );
+}
+
+} // namespace pbl::utils
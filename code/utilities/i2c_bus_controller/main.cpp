@@ -1,32 +1,70 @@
 
 // I2C
 #include <i2c/Controllers.hpp>
+#include <i2c/DeviceRegistry.hpp>
 
 // C++
 #include <print>
 #include <vector>
 #include <chrono>
 #include <format>
+#include <memory>
+#include <string>
+#include <algorithm>
 #include <iostream>
 #include <string_view>
 
 int main( const int argc, const char* const* const argv )
 {
+	using namespace pbl::i2c;
+
 	std::vector< std::string_view > args( argv, std::next( argv, static_cast< std::ptrdiff_t >( argc ) ) );
 
-	std::string deviceName{ "/dev/i2c-1" };
+	// Scans the given bus, or every i2c-dev adapter of the system when none is given
+	std::vector< std::unique_ptr< BusController > > buses;
+	for( const auto& name : args.size() >= 2 ? std::vector< std::string >{ std::string{ args[ 1 ] } }
+											 : DeviceRegistry::enumerate() )
+	{
+		if( auto busController = std::make_unique< BusController >( name ); busController->isOpen() )
+		{
+			buses.push_back( std::move( busController ) );
+		}
+		else
+		{
+			std::println( "{}: {}", name, busController->lastError() );
+		}
+	}
 
-	if( args.size() >= 2 )
+	const auto registry = DeviceRegistry::discover( std::move( buses ) );
+
+	for( const auto& bus : registry.buses() )
 	{
-		deviceName = args[ 1 ];
+		std::println( "{}:", bus.controller->bus() );
+		for( const auto& device : bus.devices )
+		{
+			std::println( "  0x{:02X} {}", device.address, toStringView( device.part ) );
+		}
 	}
 
-	pbl::i2c::BusController busController{ deviceName };
-	pbl::i2c::LM75Controller lm75{ busController };
+	// The LM75 shares its addresses with other parts, take the first device that may be one
+	std::unique_ptr< ICBase > lm75Device;
+	for( const auto& bus : registry.buses() )
+	{
+		for( const auto& device : bus.devices )
+		{
+			if( !lm75Device && std::ranges::find( device.candidates, Part::LM75 ) != device.candidates.end() )
+			{
+				lm75Device = DeviceRegistry::create( *bus.controller, device.address, Part::LM75 );
+			}
+		}
+	}
 
-	if( const auto temp = lm75.getTemperatureC(); temp.has_value() )
+	if( auto* lm75 = static_cast< LM75Controller* >( lm75Device.get() ) )
 	{
-		std::println( "Temperature: {}°C", temp.value() );
+		if( const auto temp = lm75->getTemperatureC(); temp.has_value() )
+		{
+			std::println( "Temperature: {}°C", temp.value() );
+		}
 	}
 
 	// We will use MCP here to control LED's, configure ports A & B as output
@@ -38,8 +76,15 @@ int main( const int argc, const char* const* const argv )
 
 	// mcp23017.setOffPortA( pbl::i2c::MCP23017Controller::Pins::PIN_8 );
 
-	pbl::i2c::BMP180Controller bmp180{
-		busController, pbl::i2c::BMP180Controller::DEFAULT, pbl::i2c::BMP180Controller::ULTRA_HIGH_RESOLUTION };
+	const auto bmp180Location = registry.find( Part::BMP180 );
+	if( !bmp180Location )
+	{
+		return 0;
+	}
+
+	BMP180Controller bmp180{ *bmp180Location->first,
+							 static_cast< BMP180Controller::Address >( bmp180Location->second ),
+							 BMP180Controller::ULTRA_HIGH_RESOLUTION };
 
 	if( const auto temp = bmp180.getTrueTemperatureC(); temp.has_value() )
 	{